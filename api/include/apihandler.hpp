@@ -36,6 +36,7 @@
 #include <lib/system/concurrent.hpp>
 #include <lib/system/process.hpp>
 
+#include "responsecache.hpp"
 #include "tokens.hpp"
 
 #include <tuple>
@@ -718,8 +719,6 @@ public:
 
     void ExecuteCountGet(ExecuteCountGetResult& _return, const std::string& executeMethod) override;
     ////////new
-    void iterateOverTokenTransactions(const csdb::Address&, const std::function<bool(const csdb::Pool&, const csdb::Transaction&)>);
-    ////////new
     api::SmartContractInvocation getSmartContract(const csdb::Address&, bool&);
     std::vector<general::ByteCodeObject> getSmartByteCode(const csdb::Address&, bool&);
     void SmartContractDataGet(api::SmartContractDataResult&, const general::Address&) override;
@@ -749,7 +748,14 @@ public:
         return executor_;
     }
 
+    ResponseCache& getResponseCache() {
+        return responseCache_;
+    }
+
     bool isBDLoaded() { return isBDLoaded_; }
+
+    // API checks of money, max fee and signature, error description if transaction is rejected
+    static std::optional<std::string> checkTransaction(const BlockChain&, const csdb::Transaction&);
     
 private:
     ::csstats::AllStats stats_;
@@ -857,6 +863,9 @@ private:
 
     api::Pool convertPool(const csdb::PoolHash& poolHash);
 
+    void fillPoolList(api::PoolListGetResult& _return, cs::Sequence sequence, int64_t limit);
+    void fillTransactionsList(api::TransactionsGetResult& _return, int64_t offset, int64_t limit);
+
     // bool convertAddrToPublicKey(const csdb::Address& address);
 
     template <typename Mapper>
@@ -873,6 +882,7 @@ private:
     std::optional<std::string> checkTransaction(const ::api::Transaction&);
 
     TokensMaster tm_;
+    ResponseCache responseCache_;
 
     const uint8_t ERROR_CODE = 1;
 
@@ -881,9 +891,12 @@ private:
     std::condition_variable_any newBlockCv_;
     std::mutex dbLock_;
 
+public slots:
+    void store_block_slot(const csdb::Pool& pool);
+    void remove_block_slot(const cs::Sequence sequence);
+
 private slots:
     void updateSmartCachesPool(const csdb::Pool& pool);
-    void store_block_slot(const csdb::Pool& pool);
     void collect_all_stats_slot(const csdb::Pool& pool);
 };
 }  // namespace api
@@ -0,0 +1,40 @@
+#ifndef APISERVER_HPP
+#define APISERVER_HPP
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+// 4245: 'return': conversion from 'int' to 'SOCKET', signed/unsigned mismatch
+#pragma warning(disable : 4245)
+#endif
+
+#include <thrift/TProcessor.h>
+#include <thrift/server/TServer.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#include <cstdint>
+
+namespace csconnector {
+struct ServerOptions {
+    uint16_t port = 0;
+    int sendTimeout = 0;
+    int receiveTimeout = 0;
+    bool nonblocking = false;
+    int workerThreads = 16;
+    int ioThreads = 1;
+    int maxConnections = 0;
+};
+
+// returns true if event-driven server is compiled in (API_NONBLOCKING_SERVER cmake option)
+bool isNonblockingServerAvailable();
+
+// creates binary protocol server:
+// threaded - thread per connection over buffered transport,
+// nonblocking - libevent loops over framed transport, requests are handled by bounded workers pool
+::apache::thrift::stdcxx::shared_ptr<::apache::thrift::server::TServer> createBinaryServer(
+    const ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::TProcessor>& processor, const ServerOptions& options);
+}  // namespace csconnector
+
+#endif  // APISERVER_HPP
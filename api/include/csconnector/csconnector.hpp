@@ -16,6 +16,8 @@
 #pragma warning(pop)
 #endif
 
+#include <csconnector/apiserver.hpp>
+
 #include <client/config.hpp>
 #include <client/params.hpp>
 #include <csdb/pool.hpp>
@@ -60,6 +62,10 @@ public:
         api_handler->store_block_slot(pool);
     }
 
+    void onRemoveBlock(const cs::Sequence sequence) {
+        api_handler->remove_block_slot(sequence);
+    }
+
     void run();
 
     // interface
@@ -74,9 +80,10 @@ private:
     ::apache::thrift::stdcxx::shared_ptr<ApiProcessor> p_api_processor;
     ::apache::thrift::stdcxx::shared_ptr<::apiexec::APIEXECProcessor> p_apiexec_processor;
 #ifdef BINARY_TCP_API
-    ::apache::thrift::server::TThreadedServer server;
+    ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::server::TServer> server;
     std::thread thread;
     uint16_t server_port;
+    bool server_nonblocking;
 #endif
 #ifdef AJAX_IFACE
     ::apache::thrift::server::TThreadedServer ajax_server;
@@ -0,0 +1,169 @@
+#ifndef RESPONSECACHE_HPP
+#define RESPONSECACHE_HPP
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+// 4245 - 'return' : conversion from 'int' to 'SOCKET', signed / unsigned mismatch
+#pragma warning(disable : 4245)
+#endif
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <lib/system/common.hpp>
+
+namespace api {
+// Caches serialized responses of read-heavy API calls, entries are dropped
+// when a block from their sequence range is stored or removed, when TTL
+// expires or when the memory budget is exceeded (least recently used first)
+class ResponseCache {
+public:
+    enum Method : uint8_t {
+        PoolList,
+        PoolListStable,
+        TransactionsList,
+        Stats,
+        WalletData,
+        MethodsCount
+    };
+
+    // blocks response depends on, tip dependent responses use [lastSequence + 1, kWrongSequence]
+    struct Range {
+        cs::Sequence from;
+        cs::Sequence to;
+    };
+
+    struct MethodStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t expirations = 0;
+        uint64_t invalidations = 0;
+        uint64_t computeMicroseconds = 0;  // spent to build responses on misses
+        uint64_t serveMicroseconds = 0;    // spent to deserialize responses on hits
+    };
+
+    struct CacheStats {
+        std::array<MethodStats, MethodsCount> methods;
+        uint64_t evictions = 0;
+        size_t bytes = 0;
+        size_t count = 0;
+    };
+
+    static constexpr size_t kDefaultMemoryLimit = 64 * 1024 * 1024;
+
+    explicit ResponseCache(size_t memoryLimit = kDefaultMemoryLimit);
+
+    // zero TTL disables cache for method
+    void setTtl(Method method, std::chrono::milliseconds ttl);
+    void setMemoryLimit(size_t bytes);
+
+    // returns cached response or computes, stores and returns a new one
+    template <typename Result, typename Func>
+    void get(Result& result, Method method, const std::string& arguments, const Range& range, Func&& compute);
+
+    // drops every entry depending on block sequence
+    void invalidate(cs::Sequence sequence);
+    void clear();
+
+    CacheStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        Method method;
+        Range range;
+        Clock::time_point expiration;
+        std::string data;
+    };
+
+    using Entries = std::list<Entry>;
+
+    bool find(Method method, const std::string& key, std::string& data);
+    void insert(Method method, std::string&& key, const Range& range, std::string&& data, uint64_t generation);
+    void erase(Entries::iterator iter);
+    void shrink();
+
+    static std::string makeKey(Method method, const std::string& arguments);
+
+    template <typename Result>
+    static std::string serialize(const Result& result);
+
+    template <typename Result>
+    static void deserialize(Result& result, const std::string& data);
+
+    mutable std::mutex mutex_;
+
+    Entries entries_;  // front is most recently used
+    std::unordered_map<std::string, Entries::iterator> index_;
+
+    std::array<std::chrono::milliseconds, MethodsCount> ttl_;
+    size_t memoryLimit_;
+
+    // incremented by every invalidation, responses computed across invalidation are not stored
+    std::atomic<uint64_t> generation_{0};
+
+    CacheStats stats_;
+};
+
+template <typename Result, typename Func>
+void ResponseCache::get(Result& result, Method method, const std::string& arguments, const Range& range, Func&& compute) {
+    std::string key = makeKey(method, arguments);
+    std::string data;
+
+    auto start = Clock::now();
+
+    if (find(method, key, data)) {
+        deserialize(result, data);
+
+        std::lock_guard lock(mutex_);
+        stats_.methods[method].serveMicroseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+        return;
+    }
+
+    const uint64_t generation = generation_.load(std::memory_order_acquire);
+
+    start = Clock::now();
+    compute(result);
+
+    {
+        std::lock_guard lock(mutex_);
+        stats_.methods[method].computeMicroseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    }
+
+    insert(method, std::move(key), range, serialize(result), generation);
+}
+
+template <typename Result>
+std::string ResponseCache::serialize(const Result& result) {
+    auto buffer = ::apache::thrift::stdcxx::make_shared<::apache::thrift::transport::TMemoryBuffer>();
+    ::apache::thrift::protocol::TBinaryProtocol protocol(buffer);
+
+    result.write(&protocol);
+    return buffer->getBufferAsString();
+}
+
+template <typename Result>
+void ResponseCache::deserialize(Result& result, const std::string& data) {
+    auto buffer = ::apache::thrift::stdcxx::make_shared<::apache::thrift::transport::TMemoryBuffer>(
+        reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())), static_cast<uint32_t>(data.size()));
+    ::apache::thrift::protocol::TBinaryProtocol protocol(buffer);
+
+    result.read(&protocol);
+}
+}  // namespace api
+
+#endif  // RESPONSECACHE_HPP
@@ -2,6 +2,7 @@
 #define TOKENS_HPP
 
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <set>
@@ -9,9 +10,14 @@
 #include <thread>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/functional/hash.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/ranked_index.hpp>
 #include <csdb/address.hpp>
+#include <csdb/transaction.hpp>
 
 #include <ContractExecutor.h>
 
@@ -23,6 +29,30 @@ class SmartContractInvocation;
 using TokenId = csdb::Address;
 using HolderKey = csdb::Address;
 
+// compact id of token invocation transaction, indexes are ordered by it
+struct TokenTransactionRef {
+    cs::Sequence sequence;
+    uint32_t index;
+
+    bool operator<(const TokenTransactionRef& other) const {
+        return sequence < other.sequence || (sequence == other.sequence && index < other.index);
+    }
+
+    bool operator==(const TokenTransactionRef& other) const {
+        return sequence == other.sequence && index == other.index;
+    }
+
+    csdb::TransactionID id() const {
+        return csdb::TransactionID(sequence, index);
+    }
+};
+
+// holders ordered by the key, ranked index gives page start by position in O(log n)
+template <typename Key>
+using HoldersIndex = boost::multi_index::multi_index_container<
+    std::pair<Key, HolderKey>,
+    boost::multi_index::indexed_by<boost::multi_index::ranked_unique<boost::multi_index::identity<std::pair<Key, HolderKey>>>>>;
+
 enum TokenStandard {
     NotAToken = 0,
     CreditsBasic = 1,
@@ -44,12 +74,32 @@ struct Token {
     struct HolderInfo {
         std::string balance { "0" };
         uint64_t transfersCount = 0;
+        std::vector<TokenTransactionRef> transfers;  // Ordered by transaction id
     };
     std::map<HolderKey, HolderInfo> holders;  // Including guys with zero balance
+
+    // Holders with non-zero balance only, maintained by TokensMaster on every holder change
+    HoldersIndex<double> holdersByBalance;
+    HoldersIndex<uint64_t> holdersByTransfers;
+
+    // Invocations of token contract ordered by transaction id
+    std::vector<TokenTransactionRef> transactions;
+    std::vector<TokenTransactionRef> transfers;
+
+    // counts invocation and indexes it if id is valid, transfer parties are valid for transfers only
+    void addInvocation(const csdb::TransactionID& id, bool transfer, const HolderKey& from = HolderKey{}, const HolderKey& to = HolderKey{});
+
+    // drops indexed invocations of the sequence and above along with the counters they added
+    void removeFrom(cs::Sequence sequence);
+
+    // the only way to change holder fields the indexes depend on
+    void updateHolder(const HolderKey& holder, const std::function<void(HolderInfo&)>& change);
+    void setHolderBalance(const HolderKey& holder, const std::string& balance);
 };
 
 using TokensMap = std::unordered_map<TokenId, Token>;
 using HoldersMap = std::unordered_map<HolderKey, std::set<TokenId>>;
+using TransfersList = std::vector<std::pair<TokenTransactionRef, TokenId>>;  // Transfers of all tokens ordered by transaction id
 
 class TokensMaster {
 public:
@@ -58,9 +108,14 @@ public:
 
     void checkNewDeploy(const csdb::Address& sc, const csdb::Address& deployer, const api::SmartContractInvocation&);
 
-    void checkNewState(const csdb::Address& sc, const csdb::Address& initiator, const api::SmartContractInvocation&, const std::string& newState);
+    void checkNewState(const csdb::Address& sc, const csdb::Address& initiator, const api::SmartContractInvocation&, const std::string& newState,
+                       const csdb::TransactionID& id = csdb::TransactionID());
+
+    // drops indexed invocations from the removed block and above
+    void removeBlock(cs::Sequence sequence);
 
     void loadTokenInfo(const std::function<void(const TokensMap&, const HoldersMap&)>);
+    void loadTransfersInfo(const std::function<void(const TokensMap&, const TransfersList&)>);
 
     static bool isTransfer(const std::string& method, const std::vector<general::Variant>& params);
 
@@ -75,6 +130,7 @@ public:
     struct TokenInvocationData {
         struct Params {
             csdb::Address initiator;
+            csdb::TransactionID id;
             std::string method;
             std::vector<general::Variant> params;
         };
@@ -88,7 +144,7 @@ public:
     void refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance = false);
 
 private:
-    void initiateHolder(Token&, const csdb::Address& token, const csdb::Address& holder, bool increaseTransfers = false);
+    void initiateHolder(Token&, const csdb::Address& token, const csdb::Address& holder);
 
     api::APIHandler* api_;
 
@@ -103,6 +159,7 @@ private:
     std::mutex dataMut_;
     TokensMap tokens_;
     HoldersMap holders_;
+    TransfersList transfers_;
 };
 
 #endif  // TOKENS_HPP
@@ -1,17 +1,27 @@
 #include <apihandler.hpp>
 
 #include <csnode/conveyer.hpp>
-#include <csnode/transactionsiterator.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 #include <solver/smartcontracts.hpp>
 #include <src/priv_crypto.hpp>
 #include "csconnector/csconnector.hpp"
 #include "stdafx.h"
 #include <csnode/fee.hpp>
+#include <csnode/signaturecache.hpp>
 
 #include <base58.h>
 
+#include <tuple>
+
+namespace {
+cs::metrics::Histogram& executorLatency(const std::string& method) {
+    return cs::metrics::Registry::instance().histogram("cs_executor_call_seconds", "Duration of executor calls", cs::metrics::Histogram::latencyBounds(),
+                                                       {{"method", method}});
+}
+}  // namespace
+
 using namespace api;
 using namespace ::apache;
 
@@ -19,6 +29,17 @@ inline int64_t limitPage(int64_t value) {
     return std::clamp(value, int64_t(0), int64_t(100));
 }
 
+template <typename... Args>
+std::string cacheArguments(const Args&... args) {
+    std::string result;
+    ((result.append(args).push_back(':')), ...);
+    return result;
+}
+
+inline ResponseCache::Range tipRange(cs::Sequence lastSequence) {
+    return ResponseCache::Range{lastSequence + 1, cs::kWrongSequence};
+}
+
 apiexec::APIEXECHandler::APIEXECHandler(BlockChain& blockchain, cs::SolverCore& solver, executor::Executor& executor, const Config& config)
 : executor_(executor)
 , blockchain_(blockchain)
@@ -26,14 +47,15 @@ apiexec::APIEXECHandler::APIEXECHandler(BlockChain& blockchain, cs::SolverCore&
     csunused(config);
 }
 
-APIHandler::APIHandler(BlockChain& blockchain, cs::SolverCore& _solver, executor::Executor& executor, const Config&)
+APIHandler::APIHandler(BlockChain& blockchain, cs::SolverCore& _solver, executor::Executor& executor, const Config& config)
 : executor_(executor)
 , s_blockchain(blockchain)
 , solver(_solver)
 #ifdef MONITOR_NODE
 , stats(blockchain)
 #endif
-, tm_(this) {
+, tm_(this)
+, responseCache_(static_cast<size_t>(config.getApiSettings().responseCacheSize)) {
 #ifdef MONITOR_NODE
     if (static bool firstTime = true; firstTime) {
         stats_.second.resize(::csstats::collectionPeriods.size());
@@ -128,18 +150,20 @@ void APIHandlerBase::SetResponseStatus(general::APIResponse& response, bool comm
 }
 
 void APIHandler::WalletDataGet(WalletDataGetResult& _return, const general::Address& address) {
-    const csdb::Address addr = BlockChain::getAddressFromKey(address);
-    BlockChain::WalletData wallData{};
-    BlockChain::WalletId wallId{};
-    if (!s_blockchain.findWalletData(addr, wallData, wallId))
-        return;
-    _return.walletData.walletId = wallId;
-    _return.walletData.balance.integral = wallData.balance_.integral();
-    _return.walletData.balance.fraction = static_cast<decltype(_return.walletData.balance.fraction)>(wallData.balance_.fraction());
-    const cs::TransactionsTail& tail = wallData.trxTail_;
-    _return.walletData.lastTransactionId = tail.empty() ? 0 : tail.getLastTransactionId();
+    responseCache_.get(_return, ResponseCache::WalletData, address, tipRange(s_blockchain.getLastSeq()), [&](WalletDataGetResult& result) {
+        const csdb::Address addr = BlockChain::getAddressFromKey(address);
+        BlockChain::WalletData wallData{};
+        BlockChain::WalletId wallId{};
+        if (!s_blockchain.findWalletData(addr, wallData, wallId))
+            return;
+        result.walletData.walletId = wallId;
+        result.walletData.balance.integral = wallData.balance_.integral();
+        result.walletData.balance.fraction = static_cast<decltype(result.walletData.balance.fraction)>(wallData.balance_.fraction());
+        const cs::TransactionsTail& tail = wallData.trxTail_;
+        result.walletData.lastTransactionId = tail.empty() ? 0 : tail.getLastTransactionId();
 
-    SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
+        SetResponseStatus(result.status, APIRequestStatusType::SUCCESS);
+    });
 }
 
 void APIHandler::WalletIdGet(api::WalletIdGetResult& _return, const general::Address& address) {
@@ -668,11 +692,15 @@ std::optional<std::string> APIHandler::checkTransaction(const Transaction& trans
         trxn.add_user_field(cs::trx_uf::ordinary::UsedContracts, uf);
     }
 
+    return checkTransaction(s_blockchain, trxn);
+}
+
+std::optional<std::string> APIHandler::checkTransaction(const BlockChain& blockchain, const csdb::Transaction& trxn) {
     // check money
-    const auto source_addr = s_blockchain.getAddressByType(trxn.source(), BlockChain::AddressType::PublicKey);
+    const auto source_addr = blockchain.getAddressByType(trxn.source(), BlockChain::AddressType::PublicKey);
     BlockChain::WalletData wallData{};
     BlockChain::WalletId wallId{};
-    if (!s_blockchain.findWalletData(source_addr, wallData, wallId))
+    if (!blockchain.findWalletData(source_addr, wallData, wallId))
         return "not enough money!";
 
     const auto max_fee = trxn.max_fee().to_double();
@@ -686,11 +714,9 @@ std::optional<std::string> APIHandler::checkTransaction(const Transaction& trans
         return "max fee is not enough, counted fee will be " + std::to_string(countedFee.to_double());
 
     // check signature
-    const auto byteStream = trxn.to_byte_stream_for_sig();
-    if (!cscrypto::verifySignature(trxn.signature(), s_blockchain.getAddressByType(trxn.source(), BlockChain::AddressType::PublicKey).public_key(),
-        byteStream.data(), byteStream.size())) {
+    if (!cs::SignatureCache::instance().verify(trxn, source_addr.public_key())) {
         cslog() << "API: reject transaction with wrong signature";
-        return "wrong signature! ByteStream: " + cs::Utils::byteStreamToHex(fromByteArray(byteStream));
+        return "wrong signature! ByteStream: " + cs::Utils::byteStreamToHex(fromByteArray(trxn.to_byte_stream_for_sig()));
     }
     return {};
 }
@@ -846,10 +872,12 @@ void APIHandler::PoolListGet(api::PoolListGetResult& _return, const int64_t offs
         return;
     }
 
-    _return.pools.reserve(limit);
+    responseCache_.get(_return, ResponseCache::PoolList, cacheArguments(std::to_string(offset), std::to_string(limit)), tipRange(sequence), [&](api::PoolListGetResult& result) {
+        result.pools.reserve(limit);
 
-    PoolListGetStable(_return, sequence - offset, limit);
-    _return.count = uint32_t(sequence + 1);
+        fillPoolList(result, sequence - offset, static_cast<int64_t>(limit));
+        result.count = uint32_t(sequence + 1);
+    });
 }
 
 void APIHandler::PoolTransactionsGet(PoolTransactionsGetResult& _return, const int64_t sequence, const int64_t offset, const int64_t const_limit) {
@@ -879,28 +907,30 @@ void APIHandler::PoolInfoGet(PoolInfoGetResult& _return, const int64_t sequence,
 }
 
 void APIHandler::StatsGet(api::StatsGetResult& _return) {
+    responseCache_.get(_return, ResponseCache::Stats, std::string{}, tipRange(s_blockchain.getLastSeq()), [&](api::StatsGetResult& result) {
 #ifdef MONITOR_NODE
-    csstats::StatsPerPeriod stats_inst = this->stats.getStats();
-
-    for (auto& s : stats_inst) {
-        api::PeriodStats ps = {};
-        ps.periodDuration = s.periodSec;
-        ps.poolsCount = s.poolsCount;
-        ps.transactionsCount = s.transactionsCount;
-        ps.smartContractsCount = s.smartContractsCount;
-        ps.transactionsSmartCount = s.transactionsSmartCount;
+        csstats::StatsPerPeriod stats_inst = this->stats.getStats();
+
+        for (auto& s : stats_inst) {
+            api::PeriodStats ps = {};
+            ps.periodDuration = s.periodSec;
+            ps.poolsCount = s.poolsCount;
+            ps.transactionsCount = s.transactionsCount;
+            ps.smartContractsCount = s.smartContractsCount;
+            ps.transactionsSmartCount = s.transactionsSmartCount;
+
+            for (auto& t : s.balancePerCurrency) {
+                api::CumulativeAmount amount;
+                amount.integral = t.second.integral;
+                amount.fraction = t.second.fraction;
+                ps.balancePerCurrency[t.first] = amount;
+            }
 
-        for (auto& t : s.balancePerCurrency) {
-            api::CumulativeAmount amount;
-            amount.integral = t.second.integral;
-            amount.fraction = t.second.fraction;
-            ps.balancePerCurrency[t.first] = amount;
+            result.stats.push_back(ps);
         }
-
-        _return.stats.push_back(ps);
-    }
 #endif
-    SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
+        SetResponseStatus(result.status, APIRequestStatusType::SUCCESS);
+    });
 }
 
 void APIHandler::SmartContractGet(api::SmartContractGetResult& _return, const general::Address& address) {
@@ -931,6 +961,7 @@ void APIHandler::SmartContractGet(api::SmartContractGetResult& _return, const ge
 }
 
 void APIHandler::store_block_slot(const csdb::Pool& pool) {
+    responseCache_.invalidate(pool.sequence());
     updateSmartCachesPool(pool);
 #ifdef TOKENS_CACHE   
     if(!isBDLoaded_) {
@@ -950,6 +981,11 @@ void APIHandler::store_block_slot(const csdb::Pool& pool) {
 #endif
 }
 
+void APIHandler::remove_block_slot(const cs::Sequence sequence) {
+    responseCache_.invalidate(sequence);
+    tm_.removeBlock(sequence);
+}
+
 void APIHandler::collect_all_stats_slot(const csdb::Pool& pool) {
     const ::csstats::Periods periods = ::csstats::collectionPeriods;
 
@@ -1113,7 +1149,7 @@ bool APIHandler::updateSmartCachesTransaction(csdb::Transaction trxn, cs::Sequen
                     newStateStr = cs::SmartContracts::get_contract_state(s_blockchain, target_pk);
                 }
                 if (!newStateStr.empty()) {
-                    tm_.checkNewState(target_pk, caller_pk, smart, newStateStr);
+                    tm_.checkNewState(target_pk, caller_pk, smart, newStateStr, execTrans.id());
                 }
             }
         }
@@ -1212,6 +1248,17 @@ void APIHandler::GetLastHash(api::PoolHash& _return) {
 void APIHandler::PoolListGetStable(api::PoolListGetResult& _return, const int64_t sequence, const int64_t const_limit) {
     auto limit = limitPage(const_limit);
     cs::Sequence seq = cs::Sequence(sequence);
+    cs::Sequence lastSequence = s_blockchain.getLastSeq();
+
+    // the response depends on [seq - limit + 1, seq] blocks only, unless some of them are not stored yet
+    ResponseCache::Range range{seq >= cs::Sequence(limit) ? seq - cs::Sequence(limit) + 1 : 0, seq <= lastSequence ? seq : cs::kWrongSequence};
+
+    responseCache_.get(_return, ResponseCache::PoolListStable, cacheArguments(std::to_string(seq), std::to_string(limit)), range, [&](api::PoolListGetResult& result) {
+        fillPoolList(result, seq, limit);
+    });
+}
+
+void APIHandler::fillPoolList(api::PoolListGetResult& _return, cs::Sequence seq, int64_t limit) {
     if (seq < 0) {
         return;
     }
@@ -1450,6 +1497,41 @@ void putTokenInfo(api::TokenInfo& ti, const general::Address& addr, const Token&
     ti.tokenStandard     = (decltype(api::TokenInfo::tokenStandard))(uint32_t)(token.tokenStandard);
 }
 
+// newest first page of ordered token index
+static std::vector<TokenTransactionRef> tokenIndexPage(const std::vector<TokenTransactionRef>& index, int64_t offset, int64_t limit) {
+    std::vector<TokenTransactionRef> page;
+    if (static_cast<uint64_t>(offset) >= index.size()) {
+        return page;
+    }
+
+    const auto first = index.rbegin() + offset;
+    const auto last = (index.rend() - first > limit) ? first + limit : index.rend();
+    page.assign(first, last);
+
+    return page;
+}
+
+// pool is reused while consecutive references point into the same block
+template <typename ResultType>
+static void addIndexedTokenResult(ResultType& _return, APIHandler& handler, csdb::Pool& pool, const TokenTransactionRef& ref, const csdb::Address& token,
+                                  const std::string& code) {
+    if (!pool.is_valid() || pool.sequence() != ref.sequence) {
+        pool = handler.getExecutor().loadBlockApi(ref.sequence);
+    }
+
+    const csdb::Transaction tr = pool.transaction(ref.id());
+    if (!tr.is_valid()) {
+        return;
+    }
+
+    auto& s_blockchain = handler.get_s_blockchain();
+    const auto smart = fetch_smart(tr);
+    const csdb::Address addr_pk = s_blockchain.getAddressByType(tr.source(), BlockChain::AddressType::PublicKey);
+    const auto addrPair = TokensMaster::getTransferData(addr_pk, smart.method, smart.params);
+
+    addTokenResult(_return, token, code, pool, tr, smart, addrPair, s_blockchain);
+}
+
 template <typename ResultType>
 void tokenTransactionsInternal(ResultType& _return, APIHandler& handler, TokensMaster& tm_, const general::Address& token, bool transfersOnly, bool filterByWallet, int64_t offset,
                                int64_t limit, const csdb::Address& wallet = csdb::Address()) {
@@ -1460,22 +1542,26 @@ void tokenTransactionsInternal(ResultType& _return, APIHandler& handler, TokensM
     const csdb::Address addr = BlockChain::getAddressFromKey(token);
     bool tokenFound = false;
     std::string code;
+    std::vector<TokenTransactionRef> page;
 
-    tm_.loadTokenInfo([&addr, &tokenFound, &transfersOnly, &filterByWallet, &code, &wallet, &_return](const TokensMap& tm_, const HoldersMap&) {
+    tm_.loadTokenInfo([&addr, &tokenFound, &transfersOnly, &filterByWallet, &code, &wallet, &offset, &limit, &page, &_return](const TokensMap& tm_, const HoldersMap&) {
         auto it = tm_.find(addr);
         tokenFound = !(it == tm_.end());
         if (tokenFound) {
             code = it->second.symbol;
             if (transfersOnly && !filterByWallet) {
                 _return.count = it->second.transfersCount;
+                page = tokenIndexPage(it->second.transfers, offset, limit);
             }
             else if (!transfersOnly) {
                 _return.count = it->second.transactionsCount;
+                page = tokenIndexPage(it->second.transactions, offset, limit);
             }
             else if (transfersOnly && filterByWallet) {
                 auto hIt = it->second.holders.find(wallet);
                 if (hIt != it->second.holders.end()) {
                     _return.count = hIt->second.transfersCount;
+                    page = tokenIndexPage(hIt->second.transfers, offset, limit);
                 }
                 else {
                     _return.count = 0;
@@ -1489,51 +1575,14 @@ void tokenTransactionsInternal(ResultType& _return, APIHandler& handler, TokensM
         return;
     }
 
-    handler.iterateOverTokenTransactions(addr, [&_return, &offset, &limit, &addr, &code, &transfersOnly, &filterByWallet, &wallet, &s_blockchain = handler.get_s_blockchain()](
-                                                   const csdb::Pool& pool, const csdb::Transaction& tr) {
-        auto smart = fetch_smart(tr);
-        if (transfersOnly && !TokensMaster::isTransfer(smart.method, smart.params)) {
-            return true;
-        }
-
-        csdb::Address addr_pk = s_blockchain.getAddressByType(tr.source(), BlockChain::AddressType::PublicKey);
-        auto addrPair = TokensMaster::getTransferData(addr_pk, smart.method, smart.params);
-
-        if (filterByWallet && addrPair.first != wallet && addrPair.second != wallet) {
-            return true;
-        }
-
-        if (--offset >= 0) {
-            return true;
-        }
-
-        addTokenResult(_return, addr, code, pool, tr, smart, addrPair, s_blockchain);
-        return !(--limit == 0);
-    });
+    csdb::Pool pool;
+    for (const auto& ref : page) {
+        addIndexedTokenResult(_return, handler, pool, ref, addr, code);
+    }
 
     handler.SetResponseStatus(_return.status, APIHandlerBase::APIRequestStatusType::SUCCESS);
 }
 
-void APIHandler::iterateOverTokenTransactions(const csdb::Address& addr, const std::function<bool(const csdb::Pool&, const csdb::Transaction&)> func) {
-    std::list<csdb::TransactionID> l_id;
-    for (auto trIt = cs::TransactionsIterator(s_blockchain, addr); trIt.isValid(); trIt.next()) {
-        if (is_smart_state(*trIt)) {
-            cs::SmartContractRef smart_ref;
-            smart_ref.from_user_field(trIt->user_field(cs::trx_uf::new_state::RefStart));
-            l_id.emplace_back(csdb::TransactionID(smart_ref.sequence, smart_ref.transaction));
-        }
-        else if (is_smart(*trIt)) {
-            auto it = std::find(l_id.begin(), l_id.end(), trIt->id());
-            if (it != l_id.end()) {
-                l_id.erase(it);
-                if (!func(trIt.getPool(), *trIt)) {
-                    break;
-                }
-            }
-        }
-    }
-}
-
 ////////new
 api::SmartContractInvocation APIHandler::getSmartContract(const csdb::Address& addr, bool& present) {
     csdb::Address abs_addr = addr;
@@ -1715,6 +1764,13 @@ void APIHandler::TransactionsListGet(api::TransactionsGetResult& _return, int64_
     if (!validatePagination(_return, *this, offset, limit))
         return;
 
+    responseCache_.get(_return, ResponseCache::TransactionsList, cacheArguments(std::to_string(offset), std::to_string(limit)), tipRange(s_blockchain.getLastSeq()),
+                       [&](api::TransactionsGetResult& result) {
+        fillTransactionsList(result, offset, limit);
+    });
+}
+
+void APIHandler::fillTransactionsList(api::TransactionsGetResult& _return, int64_t offset, int64_t limit) {
     _return.result = false;
     _return.total_trxns_count = (uint32_t) s_blockchain.getTransactionsCount();
 
@@ -1750,65 +1806,33 @@ void APIHandler::TokenTransfersListGet(api::TokenTransfersResult& _return, int64
     }
 
     uint64_t totalTransfers = 0;
-    std::multimap<cs::Sequence, csdb::Address> tokenTransPools;
+    std::vector<std::tuple<TokenTransactionRef, csdb::Address, std::string>> page;
 
-    tm_.loadTokenInfo([&totalTransfers, &tokenTransPools, this](const TokensMap& tm_, const HoldersMap&) {
+    tm_.loadTransfersInfo([&totalTransfers, &page, offset, limit](const TokensMap& tm_, const TransfersList& transfers) {
         for (auto& t : tm_) {
             totalTransfers += t.second.transfersCount;
-            tokenTransPools.insert(std::make_pair(s_blockchain.getLastTransaction(t.first).pool_seq(), t.first));
         }
-    });
-
-    _return.count = uint32_t(totalTransfers);
-
-    cs::Sequence seq = s_blockchain.getLastNonEmptyBlock().first;
-    while (limit && seq != cs::kWrongSequence && tokenTransPools.size()) {
-        auto it = tokenTransPools.find(seq);
-        if (it != tokenTransPools.end()) {
-            auto pool = executor_.loadBlockApi(seq);
 
-            for (auto& t : pool.transactions()) {
-                if (!is_smart(t)) {
-                    continue;
-                }
-                const auto smart = fetch_smart(t);
-                if (!TokensMaster::isTransfer(smart.method, smart.params)) {
-                    continue;
-                }
-                if (--offset >= 0) {
-                    continue;
-                }
-                csdb::Address target_pk = s_blockchain.getAddressByType(t.target(), BlockChain::AddressType::PublicKey);
-                auto addrPair = TokensMaster::getTransferData(target_pk, smart.method, smart.params);
-                addTokenResult(_return, target_pk, "", pool, t, smart, addrPair, s_blockchain);
-                if (--limit == 0) {
-                    break;
-                }
-            }
-
-            do {
-                const auto lPs = s_blockchain.getPreviousPoolSeq(it->second, it->first);
-                const auto lAddr = it->second;
-
-                tokenTransPools.erase(it);
-                if (lPs != cs::kWrongSequence) {
-                    tokenTransPools.insert(std::make_pair(lPs, lAddr));
-                }
-
-                it = tokenTransPools.find(seq);
-            } while (it != tokenTransPools.end());
+        if (static_cast<uint64_t>(offset) >= transfers.size()) {
+            return;
         }
 
-        seq = s_blockchain.getPreviousNonEmptyBlock(seq).first;
-    }
+        const auto first = transfers.rbegin() + offset;
+        const auto last = (transfers.rend() - first > limit) ? first + limit : transfers.rend();
 
-    tm_.loadTokenInfo([&_return](const TokensMap& tm_, const HoldersMap&) {
-        for (auto& transfer : _return.transfers) {
-            if(auto it = tm_.find(BlockChain::getAddressFromKey(transfer.token)); it != tm_.end())
-                transfer.code = it->second.symbol;
+        for (auto it = first; it != last; ++it) {
+            auto tIt = tm_.find(it->second);
+            page.emplace_back(it->first, it->second, tIt != tm_.end() ? tIt->second.symbol : std::string());
         }
     });
 
+    _return.count = uint32_t(totalTransfers);
+
+    csdb::Pool pool;
+    for (const auto& [ref, token, code] : page) {
+        addIndexedTokenResult(_return, *this, pool, ref, token, code);
+    }
+
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
 
@@ -1855,6 +1879,29 @@ static std::function<bool(const T&, const T&)> getComparator(const FieldType fie
     return [field, desc](const T& lhs, const T& rhs) { return desc ? (lhs.second.*field > rhs.second.*field) : (lhs.second.*field < rhs.second.*field); };
 }
 
+// holders index is ordered ascending, descending order walks it backwards from the ranked position
+template <typename Index>
+static void applyToHoldersPage(const Index& index, const bool desc, int64_t offset, int64_t limit, const std::function<void(const HolderKey&)> func) {
+    const auto position = static_cast<uint64_t>(offset);
+
+    if (position >= index.size()) {
+        return;
+    }
+
+    auto visit = [&](auto first, auto last) {
+        for (; first != last && limit > 0; ++first, --limit) {
+            func(first->second);
+        }
+    };
+
+    if (desc) {
+        visit(typename Index::const_reverse_iterator(index.nth(index.size() - position)), index.rend());
+    }
+    else {
+        visit(index.nth(position), index.end());
+    }
+}
+
 void APIHandler::TokenHoldersGet(api::TokenHoldersResult& _return, const general::Address& token, int64_t offset, int64_t limit, const TokenHoldersSortField order,
                                  const bool desc) {
     if (!validatePagination(_return, *this, offset, limit)) {
@@ -1863,50 +1910,34 @@ void APIHandler::TokenHoldersGet(api::TokenHoldersResult& _return, const general
 
     bool found = false;
 
-    using HMap = decltype(Token::holders);
-    using HT = HMap::value_type;
-
-    std::function<bool(const HT&, const HT&)> comparator;
-
-    switch (order) {
-        case TH_Balance:
-            comparator = [desc](const HT& lhs, const HT& rhs) { return desc ^ (stod(lhs.second.balance) < stod(rhs.second.balance)); };
-            break;
-        case TH_TransfersCount:
-            comparator = getComparator<HT>(&Token::HolderInfo::transfersCount, desc);
-            break;
-    }
-
     const csdb::Address addr = BlockChain::getAddressFromKey(token);
-    tm_.loadTokenInfo([&token, &addr, &found, &offset, &limit, &_return, comparator](const TokensMap& tm_, const HoldersMap&) {
+    tm_.loadTokenInfo([&token, &addr, &found, offset, limit, &_return, order, desc](const TokensMap& tm_, const HoldersMap&) {
         auto tIt = tm_.find(addr);
         if (tIt != tm_.end()) {
             found = true;
             _return.count = (uint32_t) tIt->second.realHoldersCount;
 
-            applyToSortedMap(tIt->second.holders, comparator, [&offset, &limit, &_return, &token](const HMap::value_type& t) {
-                if (TokensMaster::isZeroAmount(t.second.balance)) {
-                    return true;
-                }
-                if (--offset >= 0) {
-                    return true;
-                }
+            auto addHolder = [&tIt, &_return, &token](const HolderKey& holder) {
+                const auto& info = tIt->second.holders.at(holder);
 
                 api::TokenHolder th;
 
-                th.holder = fromByteArray(t.first.public_key());
+                th.holder = fromByteArray(holder.public_key());
                 th.token = token;
-                th.balance = t.second.balance;
-                th.transfersCount = (uint32_t) t.second.transfersCount;
+                th.balance = info.balance;
+                th.transfersCount = (uint32_t) info.transfersCount;
 
                 _return.holders.push_back(th);
+            };
 
-                if (--limit == 0) {
-                    return false;
-                }
-
-                return true;
-            });
+            switch (order) {
+                case TH_Balance:
+                    applyToHoldersPage(tIt->second.holdersByBalance, desc, offset, limit, addHolder);
+                    break;
+                case TH_TransfersCount:
+                    applyToHoldersPage(tIt->second.holdersByTransfers, desc, offset, limit, addHolder);
+                    break;
+            }
         }
     });
 
@@ -2233,6 +2264,9 @@ namespace executor {
         const auto access_id = generateAccessId(sequence);
         ++execCount_;
         try {
+            static auto& latency = executorLatency("executeByteCodeMultiple");
+            cs::metrics::ScopedLatency measure(latency);
+
             std::shared_lock lock(sharedErrorMutex_);
             origExecutor_->executeByteCodeMultiple(_return, static_cast<general::AccessID>(access_id), initiatorAddress, invokedContract, method, params, executionTime, EXECUTOR_VERSION);
         }
@@ -2608,6 +2642,9 @@ namespace executor {
         const auto timeBeg = std::chrono::steady_clock::now();
 
         try {
+            static auto& latency = executorLatency("executeByteCode");
+            cs::metrics::ScopedLatency measure(latency);
+
             std::shared_lock lock(sharedErrorMutex_);
             origExecutor_->executeByteCode(originExecuteRes.resp, static_cast<general::AccessID>(access_id), address, smartContractBinary, methodHeader, EXECUTION_TIME, EXECUTOR_VERSION);
         }
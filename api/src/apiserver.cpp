@@ -0,0 +1,98 @@
+#include "csconnector/apiserver.hpp"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+// 4245: 'return': conversion from 'int' to 'SOCKET', signed/unsigned mismatch
+#pragma warning(disable : 4245)
+#endif
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/server/TThreadedServer.h>
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/transport/TServerSocket.h>
+
+#ifdef NONBLOCKING_API
+#include <thrift/concurrency/PlatformThreadFactory.h>
+#include <thrift/concurrency/ThreadManager.h>
+#include <thrift/server/TNonblockingServer.h>
+#include <thrift/transport/TNonblockingServerSocket.h>
+#endif
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif  // _MSC_VER
+
+#include <algorithm>
+
+#include <lib/system/logger.hpp>
+
+namespace csconnector {
+
+using namespace ::apache::thrift::stdcxx;
+using namespace ::apache::thrift::server;
+using namespace ::apache::thrift::transport;
+using namespace ::apache::thrift::protocol;
+
+#ifdef NONBLOCKING_API
+using namespace ::apache::thrift::concurrency;
+
+// idle connections should not keep large buffers, it is the main reason of nonblocking server
+constexpr size_t kIdleBufferLimit = 8 * 1024;
+constexpr int kResizeBufferEveryN = 64;
+#endif
+
+bool isNonblockingServerAvailable() {
+#ifdef NONBLOCKING_API
+    return true;
+#else
+    return false;
+#endif
+}
+
+static shared_ptr<TServer> createThreadedServer(const shared_ptr<::apache::thrift::TProcessor>& processor, const ServerOptions& options) {
+    auto server = make_shared<TThreadedServer>(processor, make_shared<TServerSocket>(options.port, options.sendTimeout, options.receiveTimeout),
+                                               make_shared<TBufferedTransportFactory>(), make_shared<TBinaryProtocolFactory>());
+
+    if (options.maxConnections > 0) {
+        server->setConcurrentClientLimit(options.maxConnections);
+    }
+
+    return server;
+}
+
+#ifdef NONBLOCKING_API
+static shared_ptr<TServer> createNonblockingServer(const shared_ptr<::apache::thrift::TProcessor>& processor, const ServerOptions& options) {
+    auto threadManager = ThreadManager::newSimpleThreadManager(static_cast<size_t>(std::max(options.workerThreads, 1)));
+    threadManager->threadFactory(make_shared<PlatformThreadFactory>());
+    threadManager->start();
+
+    auto socket = make_shared<TNonblockingServerSocket>(options.port);
+    socket->setSendTimeout(options.sendTimeout);
+    socket->setRecvTimeout(options.receiveTimeout);
+
+    auto server = make_shared<TNonblockingServer>(processor, make_shared<TBinaryProtocolFactory>(), socket, threadManager);
+    server->setNumIOThreads(static_cast<size_t>(std::max(options.ioThreads, 1)));
+    server->setIdleReadBufferLimit(kIdleBufferLimit);
+    server->setIdleWriteBufferLimit(kIdleBufferLimit);
+    server->setResizeBufferEveryN(kResizeBufferEveryN);
+
+    if (options.maxConnections > 0) {
+        server->setMaxConnections(static_cast<size_t>(options.maxConnections));
+        server->setOverloadAction(T_OVERLOAD_CLOSE_ON_ACCEPT);
+    }
+
+    return server;
+}
+#endif
+
+shared_ptr<TServer> createBinaryServer(const shared_ptr<::apache::thrift::TProcessor>& processor, const ServerOptions& options) {
+    if (options.nonblocking) {
+#ifdef NONBLOCKING_API
+        return createNonblockingServer(processor, options);
+#else
+        cswarning() << "API server: nonblocking server is not compiled in, enable API_NONBLOCKING_SERVER cmake option. Threaded server used";
+#endif
+    }
+
+    return createThreadedServer(processor, options);
+}
+
+}  // namespace csconnector
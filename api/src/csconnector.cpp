@@ -30,8 +30,8 @@ connector::connector(BlockChain& m_blockchain, cs::SolverCore* solver, const Con
 , p_api_processor(make_shared<connector::ApiProcessor>(api_handler))
 , p_apiexec_processor(make_shared<apiexec::APIEXECProcessor>(apiexec_handler))
 #ifdef BINARY_TCP_API
-, server(p_api_processor, make_shared<TServerSocket>(config.getApiSettings().port, config.getApiSettings().serverSendTimeout, config.getApiSettings().serverReceiveTimeout),
-    make_shared<TBufferedTransportFactory>(), make_shared<TBinaryProtocolFactory>())
+, server(createBinaryServer(p_api_processor, ServerOptions{config.getApiSettings().port, config.getApiSettings().serverSendTimeout, config.getApiSettings().serverReceiveTimeout,
+    config.getApiSettings().nonblockingServer, config.getApiSettings().serverWorkerThreads, config.getApiSettings().serverIoThreads, config.getApiSettings().serverMaxConnections}))
 #endif
 #ifdef AJAX_IFACE
 , ajax_server(p_api_processor, make_shared<TServerSocket>(config.getApiSettings().ajaxPort, config.getApiSettings().ajaxServerSendTimeout, config.getApiSettings().ajaxServerReceiveTimeout),
@@ -44,7 +44,7 @@ connector::connector(BlockChain& m_blockchain, cs::SolverCore* solver, const Con
 {
 #ifdef PROFILE_API
     cs::ProfilerFileLogger::bufferSize = 1000;
-    server.setServerEventHandler(make_shared<cs::ProfilerEventHandler>());
+    server->setServerEventHandler(make_shared<cs::ProfilerEventHandler>());
 #endif
 
 #ifdef BINARY_TCP_EXECAPI
@@ -62,6 +62,7 @@ connector::connector(BlockChain& m_blockchain, cs::SolverCore* solver, const Con
 
 #ifdef BINARY_TCP_API
     server_port = uint16_t(config.getApiSettings().port);
+    server_nonblocking = config.getApiSettings().nonblockingServer && isNonblockingServerAvailable();
 #endif
 
 #ifdef AJAX_IFACE
@@ -72,10 +73,10 @@ connector::connector(BlockChain& m_blockchain, cs::SolverCore* solver, const Con
 void connector::run() {
 
 #ifdef BINARY_TCP_API
-    cslog() << "Starting public API on port " << server_port;
+    cslog() << "Starting public API on port " << server_port << (server_nonblocking ? " (nonblocking, framed transport)" : "");
     thread = std::thread([this]() {
         try {
-            server.run();
+            server->run();
         }
         catch (...) {
             cserror() << "Oh no! I'm dead :'-(";
@@ -101,7 +102,7 @@ void connector::run() {
 
 connector::~connector() {
 #ifdef BINARY_TCP_API
-    server.stop();
+    server->stop();
     if (thread.joinable()) {
         thread.join();
     }
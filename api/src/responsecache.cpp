@@ -0,0 +1,138 @@
+#include <responsecache.hpp>
+
+#include <iterator>
+
+namespace {
+// explorers repeat the same queries, block time is about one second,
+// so TTL mostly protects from the cases when invalidation was missed
+constexpr std::chrono::milliseconds kDefaultTtl[api::ResponseCache::MethodsCount] = {
+    std::chrono::milliseconds(5000),   // PoolList, tip dependent
+    std::chrono::milliseconds(60000),  // PoolListStable, depends on fixed blocks range
+    std::chrono::milliseconds(5000),   // TransactionsList, tip dependent
+    std::chrono::milliseconds(10000),  // Stats
+    std::chrono::milliseconds(2000)    // WalletData
+};
+}  // namespace
+
+namespace api {
+ResponseCache::ResponseCache(size_t memoryLimit)
+: memoryLimit_(memoryLimit) {
+    for (size_t i = 0; i < MethodsCount; ++i) {
+        ttl_[i] = kDefaultTtl[i];
+    }
+}
+
+void ResponseCache::setTtl(Method method, std::chrono::milliseconds ttl) {
+    std::lock_guard lock(mutex_);
+    ttl_[method] = ttl;
+}
+
+void ResponseCache::setMemoryLimit(size_t bytes) {
+    std::lock_guard lock(mutex_);
+    memoryLimit_ = bytes;
+    shrink();
+}
+
+void ResponseCache::invalidate(cs::Sequence sequence) {
+    std::lock_guard lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+        auto current = iter++;
+
+        if (current->range.from <= sequence && sequence <= current->range.to) {
+            ++stats_.methods[current->method].invalidations;
+            erase(current);
+        }
+    }
+}
+
+void ResponseCache::clear() {
+    std::lock_guard lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    entries_.clear();
+    index_.clear();
+
+    stats_.bytes = 0;
+    stats_.count = 0;
+}
+
+ResponseCache::CacheStats ResponseCache::stats() const {
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+bool ResponseCache::find(Method method, const std::string& key, std::string& data) {
+    std::lock_guard lock(mutex_);
+
+    auto iter = index_.find(key);
+
+    if (iter == index_.end()) {
+        ++stats_.methods[method].misses;
+        return false;
+    }
+
+    if (iter->second->expiration <= Clock::now()) {
+        ++stats_.methods[method].expirations;
+        ++stats_.methods[method].misses;
+        erase(iter->second);
+        return false;
+    }
+
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    data = iter->second->data;
+
+    ++stats_.methods[method].hits;
+    return true;
+}
+
+void ResponseCache::insert(Method method, std::string&& key, const Range& range, std::string&& data, uint64_t generation) {
+    std::lock_guard lock(mutex_);
+
+    if (ttl_[method].count() == 0 || data.size() + key.size() > memoryLimit_) {
+        return;
+    }
+
+    if (generation != generation_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (auto iter = index_.find(key); iter != index_.end()) {
+        erase(iter->second);
+    }
+
+    stats_.bytes += data.size() + key.size();
+
+    entries_.push_front(Entry{std::move(key), method, range, Clock::now() + ttl_[method], std::move(data)});
+    index_.emplace(entries_.front().key, entries_.begin());
+
+    ++stats_.count;
+    shrink();
+}
+
+void ResponseCache::erase(Entries::iterator iter) {
+    stats_.bytes -= iter->data.size() + iter->key.size();
+    --stats_.count;
+
+    index_.erase(iter->key);
+    entries_.erase(iter);
+}
+
+void ResponseCache::shrink() {
+    while (!entries_.empty() && stats_.bytes > memoryLimit_) {
+        erase(std::prev(entries_.end()));
+        ++stats_.evictions;
+    }
+}
+
+std::string ResponseCache::makeKey(Method method, const std::string& arguments) {
+    std::string key;
+    key.reserve(arguments.size() + 1);
+
+    key.push_back(static_cast<char>(method));
+    key.append(arguments);
+
+    return key;
+}
+}  // namespace api
@@ -2,11 +2,125 @@
 
 #include <base58.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cstdlib>
 #include "apihandler.hpp"
 #include "tokens.hpp"
 #include "smartcontracts.hpp"
 
+static inline double balanceKey(const std::string& balance) {
+    return std::strtod(balance.c_str(), nullptr);
+}
+
+static inline const TokenTransactionRef& refOf(const TokenTransactionRef& ref) {
+    return ref;
+}
+
+static inline const TokenTransactionRef& refOf(const TransfersList::value_type& value) {
+    return value.first;
+}
+
+// invocations come in blockchain order, so the position is almost always at the end
+template <typename T>
+static void insertOrdered(std::vector<T>& index, const T& value) {
+    auto it = index.end();
+    while (it != index.begin() && refOf(value) < refOf(*(it - 1))) {
+        --it;
+    }
+
+    if (it != index.begin() && refOf(*(it - 1)) == refOf(value)) {
+        return;
+    }
+
+    index.insert(it, value);
+}
+
+// returns count of erased elements
+template <typename T>
+static size_t eraseFrom(std::vector<T>& index, cs::Sequence sequence) {
+    auto it = std::lower_bound(index.begin(), index.end(), TokenTransactionRef{sequence, 0},
+                               [](const T& lhs, const TokenTransactionRef& rhs) { return refOf(lhs) < rhs; });
+    const auto count = static_cast<size_t>(std::distance(it, index.end()));
+    index.erase(it, index.end());
+    return count;
+}
+
+void Token::addInvocation(const csdb::TransactionID& id, bool transfer, const HolderKey& from, const HolderKey& to) {
+    const bool indexed = id.is_valid();
+    const TokenTransactionRef ref{id.pool_seq(), static_cast<uint32_t>(id.index())};
+
+    ++transactionsCount;
+
+    if (indexed) {
+        insertOrdered(transactions, ref);
+    }
+
+    if (!transfer) {
+        return;
+    }
+
+    ++transfersCount;
+
+    if (indexed) {
+        insertOrdered(transfers, ref);
+    }
+
+    // holder counts a transfer once even if it is both parties, so removeFrom rolls it back exactly
+    auto addParty = [&](const HolderKey& holder) {
+        updateHolder(holder, [&](HolderInfo& info) {
+            ++info.transfersCount;
+
+            if (indexed) {
+                insertOrdered(info.transfers, ref);
+            }
+        });
+    };
+
+    if (from.is_valid()) {
+        addParty(from);
+    }
+
+    if (to.is_valid() && to != from) {
+        addParty(to);
+    }
+}
+
+void Token::removeFrom(cs::Sequence sequence) {
+    transactionsCount -= eraseFrom(transactions, sequence);
+    transfersCount -= eraseFrom(transfers, sequence);
+
+    for (auto& h : holders) {
+        if (h.second.transfers.empty() || h.second.transfers.back().sequence < sequence) {
+            continue;
+        }
+
+        updateHolder(h.first, [sequence](HolderInfo& info) { info.transfersCount -= eraseFrom(info.transfers, sequence); });
+    }
+}
+
+void Token::updateHolder(const HolderKey& holder, const std::function<void(HolderInfo&)>& change) {
+    auto& info = holders[holder];
+
+    if (!TokensMaster::isZeroAmount(info.balance)) {
+        holdersByBalance.erase(std::make_pair(balanceKey(info.balance), holder));
+        holdersByTransfers.erase(std::make_pair(info.transfersCount, holder));
+    }
+
+    change(info);
+
+    if (!TokensMaster::isZeroAmount(info.balance)) {
+        holdersByBalance.emplace(balanceKey(info.balance), holder);
+        holdersByTransfers.emplace(info.transfersCount, holder);
+    }
+
+    realHoldersCount = holdersByBalance.size();
+}
+
+void Token::setHolderBalance(const HolderKey& holder, const std::string& balance) {
+    updateHolder(holder, [&balance](HolderInfo& info) { info.balance = balance; });
+}
+
 #ifdef TOKENS_CACHE
 
 static inline bool isStringParam(const std::string& param) {
@@ -214,13 +328,11 @@ void TokensMaster::refreshTokenState(const csdb::Address& token, const std::stri
 
         api_->getExecutor().executeByteCodeMultiple(result, dpAddr, smartContractBinary, "balanceOf", holderKeysParams, 100, executor::Executor::kUseLastSequence);
 
-        ++t.realHoldersCount = 0;
         if (!result.status.code && (result.results.size() == holders.size())) {
             for (uint32_t i = 0; i < holders.size(); ++i) {
                 const auto& res = result.results[i];
                 if (!res.status.code) {
-                    t.holders[holders[i]].balance = tryExtractAmount(getVariantAs<std::string>(res.ret_val));
-                    ++t.realHoldersCount;
+                    t.setHolderBalance(holders[i], tryExtractAmount(getVariantAs<std::string>(res.ret_val)));
                 }
             }
         }
@@ -228,12 +340,8 @@ void TokensMaster::refreshTokenState(const csdb::Address& token, const std::stri
 }
 
 /* Call under data lock only */
-void TokensMaster::initiateHolder(Token& token, const csdb::Address& address, const csdb::Address& holder, bool increaseTransfers /* = false*/) {
-    if (increaseTransfers)
-        ++token.holders[holder].transfersCount;
-    else
-        token.holders[holder];
-
+void TokensMaster::initiateHolder(Token& token, const csdb::Address& address, const csdb::Address& holder) {
+    token.holders[holder];
     holders_[holder].insert(address);
 }
 
@@ -252,22 +360,25 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
         return;  // Ignore if not-a-token
 
     initiateHolder(tIt->second, tIt->first, ps.initiator);
-    ++tIt->second.transactionsCount;
-
-    if (!ps.method.empty()) {
-        if (isTransfer(ps.method, ps.params)) {
-            ++tIt->second.transfersCount;
-            auto trPair = getTransferData(ps.initiator, ps.method, ps.params);
-            if (trPair.first.is_valid())
-                initiateHolder(tIt->second, tIt->first, trPair.first, true);
-            if (trPair.second.is_valid())
-                initiateHolder(tIt->second, tIt->first, trPair.second, true);
-        }
-        else if (tIt->second.tokenStandard == TokenStandard::CreditsExtended) {
-            csdb::Address regDude = tryGetRegisterData(ps.method, ps.params);
-            if (regDude.is_valid())
-                initiateHolder(tIt->second, tIt->first, regDude);
-        }
+
+    const bool transfer = !ps.method.empty() && isTransfer(ps.method, ps.params);
+    const auto trPair = transfer ? getTransferData(ps.initiator, ps.method, ps.params) : std::pair<csdb::Address, csdb::Address>{};
+
+    tIt->second.addInvocation(ps.id, transfer, trPair.first, trPair.second);
+
+    if (transfer) {
+        if (trPair.first.is_valid())
+            initiateHolder(tIt->second, tIt->first, trPair.first);
+        if (trPair.second.is_valid())
+            initiateHolder(tIt->second, tIt->first, trPair.second);
+
+        if (ps.id.is_valid())
+            insertOrdered(transfers_, std::make_pair(TokenTransactionRef{ps.id.pool_seq(), static_cast<uint32_t>(ps.id.index())}, tIt->first));
+    }
+    else if (!ps.method.empty() && tIt->second.tokenStandard == TokenStandard::CreditsExtended) {
+        csdb::Address regDude = tryGetRegisterData(ps.method, ps.params);
+        if (regDude.is_valid())
+            initiateHolder(tIt->second, tIt->first, regDude);
     }
 
     // Balance update   
@@ -300,34 +411,29 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
 
         auto& t = tokens_[addr];
         if (addrTo == csdb::Address{}) { // for deploy token
-            t.holders[addrFrom].balance = getCurrBalance(addrFrom);
-            ++t.realHoldersCount;
+            t.setHolderBalance(addrFrom, getCurrBalance(addrFrom));
             return;
         }
 
         // from
-        auto& currFromBalance = t.holders[addrFrom].balance;
+        const auto& currFromBalance = t.holders[addrFrom].balance;
         auto newFromBalance = [&] {
             if (isZeroAmount(currFromBalance))
                 return getCurrBalance(addrFrom);
             else
                 return std::to_string(stof(currFromBalance) - stof(amount));
         }();
-        if (isZeroAmount(newFromBalance))
-            --t.realHoldersCount;
-        currFromBalance = newFromBalance;
+        t.setHolderBalance(addrFrom, newFromBalance);
 
         // to
-        auto& currToBalance = t.holders[addrTo].balance;
+        const auto& currToBalance = t.holders[addrTo].balance;
         auto newToBalance = [&] {
             if (isZeroAmount(currToBalance))
                 return getCurrBalance(addrTo);
             else
                 return std::to_string(stof(currToBalance) + stof(amount));
         }();
-        if (isZeroAmount(currToBalance) && !isZeroAmount(newToBalance))
-            ++t.realHoldersCount;
-        currToBalance = newToBalance;
+        t.setHolderBalance(addrTo, newToBalance);
     };
 
     if(api_->isBDLoaded()){
@@ -366,19 +472,35 @@ void TokensMaster::checkNewDeploy(const csdb::Address& sc, const csdb::Address&
     }
 }
 
-void TokensMaster::checkNewState(const csdb::Address& sc, const csdb::Address& initiator, const api::SmartContractInvocation& sci, const std::string& newState) {
+void TokensMaster::checkNewState(const csdb::Address& sc, const csdb::Address& initiator, const api::SmartContractInvocation& sci, const std::string& newState,
+                                 const csdb::TransactionID& id) {
     TokenInvocationData::Params ps;
     ps.initiator = initiator;
+    ps.id = id;
     ps.method = sci.method;
     ps.params = sci.params;
     updateTokenChaches(sc, newState, ps);
 }
 
+void TokensMaster::removeBlock(cs::Sequence sequence) {
+    std::lock_guard<decltype(dataMut_)> l(dataMut_);
+
+    eraseFrom(transfers_, sequence);
+
+    for (auto& t : tokens_)
+        t.second.removeFrom(sequence);
+}
+
 void TokensMaster::loadTokenInfo(const std::function<void(const TokensMap&, const HoldersMap&)> func) {
     std::lock_guard<decltype(dataMut_)> l(dataMut_);
     func(tokens_, holders_);
 }
 
+void TokensMaster::loadTransfersInfo(const std::function<void(const TokensMap&, const TransfersList&)> func) {
+    std::lock_guard<decltype(dataMut_)> l(dataMut_);
+    func(tokens_, transfers_);
+}
+
 bool TokensMaster::isTransfer(const std::string& method, const std::vector<general::Variant>& params) {
     return isNormalTransfer(method, params) || isTransferFrom(method, params);
 }
@@ -417,10 +539,14 @@ TokensMaster::~TokensMaster() {
 }
 void TokensMaster::checkNewDeploy(const csdb::Address&, const csdb::Address&, const api::SmartContractInvocation&) {
 }
-void TokensMaster::checkNewState(const csdb::Address&, const csdb::Address&, const api::SmartContractInvocation&, const std::string&) {
+void TokensMaster::checkNewState(const csdb::Address&, const csdb::Address&, const api::SmartContractInvocation&, const std::string&, const csdb::TransactionID&) {
+}
+void TokensMaster::removeBlock(cs::Sequence) {
 }
 void TokensMaster::loadTokenInfo(const std::function<void(const TokensMap&, const HoldersMap&)>) {
 }
+void TokensMaster::loadTransfersInfo(const std::function<void(const TokensMap&, const TransfersList&)>) {
+}
 bool TokensMaster::isTransfer(const std::string&, const std::vector<general::Variant>&) {
     return false;
 }
@@ -0,0 +1,276 @@
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <framework.hpp>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/internal/shared_data.hpp>
+#include <csdb/internal/shared_data_ptr_implementation.hpp>
+#include <csdb/pool.hpp>
+#include <csdb/transaction.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kTransactions = 100000;
+constexpr size_t kWallets = 10000;
+constexpr size_t kRepeats = 10;
+
+// the former csdb::Address: heap priv with reference counter, hash is calculated on every call
+class SharedAddress {
+public:
+    SharedAddress()
+    : d(new priv) {
+    }
+
+    static SharedAddress from_public_key(const cs::PublicKey& key) {
+        SharedAddress result;
+        result.d->data_.public_key = key;
+        result.d->is_wallet_id_ = false;
+        return result;
+    }
+
+    static SharedAddress from_wallet_id(csdb::Address::WalletId id) {
+        SharedAddress result;
+        result.d->data_.wallet_id = id;
+        result.d->is_wallet_id_ = true;
+        return result;
+    }
+
+    bool operator==(const SharedAddress& other) const {
+        if (d == other.d) {
+            return true;
+        }
+
+        if (d->is_wallet_id_ != other.d->is_wallet_id_) {
+            return false;
+        }
+
+        return d->is_wallet_id_ ? d->data_.wallet_id == other.d->data_.wallet_id : d->data_.public_key == other.d->data_.public_key;
+    }
+
+    bool operator<(const SharedAddress& other) const {
+        if (d->is_wallet_id_ && other.d->is_wallet_id_) {
+            return d->data_.wallet_id < other.d->data_.wallet_id;
+        }
+
+        return d->data_.public_key < other.d->data_.public_key;
+    }
+
+    size_t calcHash() const {
+        return d->is_wallet_id_ ? boost::hash_value(d->data_.wallet_id) : boost::hash_value(d->data_.public_key);
+    }
+
+private:
+    struct priv : csdb::internal::shared_data {
+        union {
+            cs::PublicKey public_key;
+            csdb::Address::WalletId wallet_id;
+        } data_{};
+
+        bool is_wallet_id_ = false;
+    };
+
+    csdb::internal::shared_data_ptr<priv> d;
+};
+
+template <typename Address>
+struct Hasher {
+    size_t operator()(const Address& address) const {
+        return address.calcHash();
+    }
+};
+
+// transaction of block with decoded addresses, they are copied by setters and getters
+template <typename Address>
+struct Transfer {
+    Address source;
+    Address target;
+    int64_t amount = 0;
+};
+
+// addresses of block: flag of wallet id, then key or id
+struct Encoded {
+    cs::Bytes bytes;
+    size_t count = 0;
+};
+
+cs::PublicKey makeKey(size_t index) {
+    cs::PublicKey key{};
+    std::memcpy(key.data(), &index, sizeof(index));
+    return key;
+}
+
+Encoded makeBlock() {
+    Encoded block;
+
+    auto put = [&](size_t index) {
+        // every fourth address is wallet id like ones of blocks written by wallets cache
+        const bool isId = index % 4 == 0;
+        block.bytes.push_back(static_cast<cs::Byte>(isId));
+
+        if (isId) {
+            const auto id = static_cast<csdb::Address::WalletId>(index);
+            block.bytes.insert(block.bytes.end(), reinterpret_cast<const cs::Byte*>(&id), reinterpret_cast<const cs::Byte*>(&id) + sizeof(id));
+        }
+        else {
+            const auto key = makeKey(index);
+            block.bytes.insert(block.bytes.end(), key.begin(), key.end());
+        }
+    };
+
+    for (size_t i = 0; i < kTransactions; ++i) {
+        put(i % kWallets);
+        put((i * 7 + 1) % kWallets);
+        ++block.count;
+    }
+
+    return block;
+}
+
+template <typename Address>
+Address decodeAddress(const cs::Byte*& data) {
+    if (*data++) {
+        csdb::Address::WalletId id;
+        std::memcpy(&id, data, sizeof(id));
+        data += sizeof(id);
+        return Address::from_wallet_id(id);
+    }
+
+    cs::PublicKey key;
+    std::memcpy(key.data(), data, key.size());
+    data += key.size();
+    return Address::from_public_key(key);
+}
+
+template <typename Address>
+std::vector<Transfer<Address>> decode(const Encoded& block) {
+    std::vector<Transfer<Address>> transfers;
+    transfers.reserve(block.count);
+
+    const cs::Byte* data = block.bytes.data();
+
+    for (size_t i = 0; i < block.count; ++i) {
+        Transfer<Address> transfer;
+        transfer.source = decodeAddress<Address>(data);
+        transfer.target = decodeAddress<Address>(data);
+        transfer.amount = 1;
+        transfers.push_back(transfer);
+    }
+
+    return transfers;
+}
+
+struct Result {
+    double decode = 0;
+    double update = 0;
+    int64_t checksum = 0;
+};
+
+// the same block is decoded and applied to wallets: hashed index by address and ordered one like WalletsState
+template <typename Address>
+Result run(const Encoded& block) {
+    Result result;
+    std::unordered_map<Address, int64_t, Hasher<Address>> balances;
+    std::map<Address, size_t> touched;
+
+    for (size_t i = 0; i < kRepeats; ++i) {
+        auto start = Clock::now();
+        auto transfers = decode<Address>(block);
+        result.decode += std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+
+        for (const auto& transfer : transfers) {
+            balances[transfer.source] -= transfer.amount;
+            balances[transfer.target] += transfer.amount;
+            ++touched[transfer.target];
+        }
+
+        result.update += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    for (const auto& [address, count] : touched) {
+        result.checksum += balances[address] + static_cast<int64_t>(count);
+    }
+
+    return result;
+}
+
+// blocks of node with value addresses
+double decodePools() {
+    csdb::Pool pool(csdb::PoolHash{}, 1);
+
+    for (size_t i = 0; i < kTransactions; ++i) {
+        csdb::Transaction transaction;
+        transaction.set_innerID(static_cast<int64_t>(i + 1));
+        transaction.set_source(csdb::Address::from_public_key(makeKey(i % kWallets)));
+        transaction.set_target(i % 4 == 0 ? csdb::Address::from_wallet_id(static_cast<csdb::Address::WalletId>(i % kWallets))
+                                          : csdb::Address::from_public_key(makeKey((i * 7 + 1) % kWallets)));
+        transaction.set_currency(1);
+        transaction.set_amount(csdb::Amount(1, 0));
+        pool.add_transaction(transaction);
+    }
+
+    pool.compose();
+    const auto binary = pool.to_binary();
+
+    std::unordered_map<csdb::Address, size_t> wallets;
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < kRepeats; ++i) {
+        auto bytes = binary;
+        const auto decoded = csdb::Pool::from_binary(std::move(bytes));
+
+        for (const auto& transaction : decoded.transactions()) {
+            ++wallets[transaction.source()];
+            ++wallets[transaction.target()];
+        }
+    }
+
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void print(const char* name, const Result& result) {
+    const double total = static_cast<double>(kTransactions * kRepeats);
+    cs::Console::writeLine(name, ": decode ", static_cast<uint64_t>(total / result.decode), " tx/s, wallets update ",
+                           static_cast<uint64_t>(total / result.update), " tx/s");
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Addresses of ", kTransactions, " transactions to ", kWallets, " wallets, ", kRepeats, " repeats, sizeof shared ",
+                           sizeof(SharedAddress), " + heap, value ", sizeof(csdb::Address));
+
+    const auto block = makeBlock();
+
+    cs::Framework::execute(
+        [&] {
+            const auto shared = run<SharedAddress>(block);
+            const auto value = run<csdb::Address>(block);
+
+            print("shared", shared);
+            print("value", value);
+
+            return shared.checksum == value.checksum;
+        },
+        std::chrono::seconds(600), "Results of addresses differ");
+
+    cs::Framework::execute(
+        [] {
+            const double seconds = decodePools();
+            cs::Console::writeLine("csdb::Pool decode and wallets update: ", static_cast<uint64_t>(kTransactions * kRepeats / seconds), " tx/s");
+            return true;
+        },
+        std::chrono::seconds(600), "Pool decode failed");
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <framework.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <API.h>
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/transport/TSocket.h>
+
+#include <csconnector/apiserver.hpp>
+
+using namespace ::apache::thrift::stdcxx;
+using namespace ::apache::thrift::protocol;
+using namespace ::apache::thrift::transport;
+
+static constexpr uint16_t kPort = 19090;
+static constexpr size_t kActiveClients = 16;
+static constexpr auto kRunTime = std::chrono::seconds(5);
+
+struct Client {
+    shared_ptr<TTransport> transport;
+    std::unique_ptr<api::APIClient> api;
+};
+
+static Client connect(bool framed) {
+    auto socket = make_shared<TSocket>("127.0.0.1", kPort);
+    shared_ptr<TTransport> transport;
+
+    if (framed) {
+        transport = make_shared<TFramedTransport>(socket);
+    }
+    else {
+        transport = make_shared<TBufferedTransport>(socket);
+    }
+
+    transport->open();
+    return Client{transport, std::make_unique<api::APIClient>(make_shared<TBinaryProtocol>(transport))};
+}
+
+struct Result {
+    size_t requests = 0;
+    std::vector<int64_t> latencies;  // us
+};
+
+// some clients keep connections and do nothing (wallets, explorers), others call api as fast as they can
+static Result load(bool framed, size_t idleConnections) {
+    std::vector<Client> idle;
+    idle.reserve(idleConnections);
+
+    for (size_t i = 0; i < idleConnections; ++i) {
+        idle.push_back(connect(framed));
+    }
+
+    std::atomic<bool> stop = false;
+    std::vector<Result> results(kActiveClients);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < kActiveClients; ++i) {
+        threads.emplace_back([&, i] {
+            Client client = connect(framed);
+            api::SyncStateResult state;
+
+            while (!stop) {
+                const auto start = std::chrono::steady_clock::now();
+                client.api->SyncStateGet(state);
+                const auto finish = std::chrono::steady_clock::now();
+
+                results[i].latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count());
+                ++results[i].requests;
+            }
+
+            client.transport->close();
+        });
+    }
+
+    std::this_thread::sleep_for(kRunTime);
+    stop = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& client : idle) {
+        client.transport->close();
+    }
+
+    Result total;
+
+    for (auto& result : results) {
+        total.requests += result.requests;
+        total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+    }
+
+    std::sort(total.latencies.begin(), total.latencies.end());
+    return total;
+}
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double value) {
+    if (sorted.empty()) {
+        return 0;
+    }
+
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(value * static_cast<double>(sorted.size())))];
+}
+
+static void testServer(bool nonblocking) {
+    csconnector::ServerOptions options;
+    options.port = kPort;
+    options.nonblocking = nonblocking;
+    options.workerThreads = static_cast<int>(kActiveClients);
+
+    auto server = csconnector::createBinaryServer(make_shared<api::APIProcessor>(make_shared<api::APINull>()), options);
+    std::thread thread([server] { server->serve(); });
+
+    // let server bind
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    cs::Console::writeLine(nonblocking ? "\nNonblocking server, framed transport" : "\nThreaded server, buffered transport");
+
+    for (size_t idle : {size_t(0), size_t(100), size_t(1000), size_t(4000)}) {
+        const Result result = cs::Framework::execute([&] { return load(nonblocking, idle); }, std::chrono::seconds(120));
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(kRunTime).count();
+
+        cs::Console::writeLine("connections ", idle + kActiveClients, ": ", result.requests / static_cast<size_t>(seconds), " req/s",
+                               ", p50 ", percentile(result.latencies, 0.5), " us",
+                               ", p99 ", percentile(result.latencies, 0.99), " us",
+                               ", p99.9 ", percentile(result.latencies, 0.999), " us");
+    }
+
+    server->stop();
+    thread.join();
+}
+
+int main() {
+    testServer(false);
+
+    if (csconnector::isNonblockingServerAvailable()) {
+        testServer(true);
+    }
+    else {
+        cs::Console::writeLine("\nNonblocking server is not built, enable API_NONBLOCKING_SERVER cmake option");
+    }
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include <framework.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <cscrypto/cscrypto.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csdb/storage.hpp>
+#include <csnode/blockchain.hpp>
+#include <csnode/blockvalidator.hpp>
+#include <csnode/blockvalidatorplugins.hpp>
+#include <csnode/signaturecache.hpp>
+
+namespace fs = boost::filesystem;
+
+static constexpr cs::Sequence kChainLength = 1000;
+static constexpr size_t kTransactionsPerBlock = 100;
+static constexpr size_t kConfidantsCount = 5;
+static constexpr size_t kWalletsCount = 50;
+static constexpr size_t kRepeats = 3;
+
+static const csdb::Address kGenesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+static const csdb::Address kStartAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+struct Keys {
+    cs::PublicKey publicKey;
+    cscrypto::PrivateKey privateKey;
+};
+
+static std::vector<Keys> makeKeys(size_t count) {
+    std::vector<Keys> keys;
+    keys.reserve(count);
+
+    auto seed = cscrypto::keys_derivation::generateMasterSeed();
+
+    for (size_t i = 0; i < count; ++i) {
+        auto pair = cscrypto::keys_derivation::deriveKeyPair(seed, static_cast<uint32_t>(i));
+        keys.push_back(Keys{pair.first, pair.second});
+    }
+
+    return keys;
+}
+
+static std::vector<csdb::Transaction> makeTransactions(const std::vector<Keys>& wallets, cs::Sequence sequence) {
+    std::vector<csdb::Transaction> transactions;
+    transactions.reserve(kTransactionsPerBlock);
+
+    for (size_t i = 0; i < kTransactionsPerBlock; ++i) {
+        const auto& source = wallets[(sequence + i) % wallets.size()];
+        const auto& target = wallets[(sequence + i + 1) % wallets.size()];
+
+        csdb::Transaction transaction;
+        transaction.set_innerID(static_cast<int64_t>(sequence * kTransactionsPerBlock + i));
+        transaction.set_source(csdb::Address::from_public_key(source.publicKey));
+        transaction.set_target(csdb::Address::from_public_key(target.publicKey));
+        transaction.set_currency(1);
+        transaction.set_amount(csdb::Amount(1, 0));
+
+        const auto bytes = transaction.to_byte_stream_for_sig();
+        transaction.set_signature(cscrypto::generateSignature(source.privateKey, bytes.data(), bytes.size()));
+
+        transactions.push_back(transaction);
+    }
+
+    return transactions;
+}
+
+static csdb::Pool makePool(const csdb::PoolHash& previous, cs::Sequence sequence, const std::vector<csdb::Transaction>& transactions,
+                           const std::vector<cs::PublicKey>& confidants) {
+    csdb::Pool pool(previous, sequence);
+    pool.add_user_field(0, std::to_string(1500000000000 + sequence * 1000));
+    pool.set_confidants(confidants);
+    pool.add_real_trusted((uint64_t(1) << confidants.size()) - 1);
+
+    for (const auto& transaction : transactions) {
+        pool.add_transaction(transaction);
+    }
+
+    return pool;
+}
+
+// composes the same block twice, the first one gives the signed part
+static bool fillStorage(csdb::Storage& storage) {
+    const auto confidants = makeKeys(kConfidantsCount);
+    const auto wallets = makeKeys(kWalletsCount);
+
+    std::vector<cs::PublicKey> confidantKeys;
+    for (const auto& keys : confidants) {
+        confidantKeys.push_back(keys.publicKey);
+    }
+
+    csdb::PoolHash previous;
+
+    for (cs::Sequence sequence = 0; sequence < kChainLength; ++sequence) {
+        const auto transactions = makeTransactions(wallets, sequence);
+
+        csdb::Pool draft = makePool(previous, sequence, transactions, confidantKeys);
+        if (!draft.compose()) {
+            return false;
+        }
+
+        const auto binary = draft.to_binary();
+        const auto signedData = cscrypto::calculateHash(binary.data(), draft.hashingLength());
+
+        std::vector<cs::Signature> signatures;
+        for (const auto& keys : confidants) {
+            signatures.push_back(cscrypto::generateSignature(keys.privateKey, signedData.data(), signedData.size()));
+        }
+
+        csdb::Pool pool = makePool(previous, sequence, transactions, confidantKeys);
+        pool.set_signatures(signatures);
+
+        if (!pool.compose() || !storage.pool_save(pool)) {
+            return false;
+        }
+
+        previous = pool.hash();
+    }
+
+    return true;
+}
+
+// stands for BalanceChecker which needs funded wallets, stateful as well so stays on calling thread
+class AmountCounter : public cs::ValidationPlugin {
+public:
+    AmountCounter(cs::BlockValidator& validator, uint64_t& amount)
+    : cs::ValidationPlugin(validator)
+    , amount_(amount) {
+    }
+
+    ErrorType validateBlock(const csdb::Pool&) override {
+        for (const auto& transaction : getPrevBlock().transactions()) {
+            amount_ += static_cast<uint64_t>(transaction.amount().integral());
+        }
+
+        return ErrorType::noError;
+    }
+
+    cs::BlockValidator::ValidationFlags dependencies() const override {
+        return cs::BlockValidator::kReadOnlyChecks;
+    }
+
+private:
+    uint64_t& amount_;
+};
+
+static bool runValidation(const BlockChain& blockchain, const std::vector<csdb::Pool>& blocks, size_t threadsCount) {
+    constexpr cs::BlockValidator::ValidationFlags flags = cs::BlockValidator::hashIntergrity | cs::BlockValidator::blockNum |
+                                                          cs::BlockValidator::timestamp | cs::BlockValidator::blockSignatures |
+                                                          cs::BlockValidator::smartSignatures | cs::BlockValidator::balances |
+                                                          cs::BlockValidator::transactionsSignatures;
+
+    cs::BlockValidator validator(blockchain, threadsCount);
+    uint64_t amount = 0;
+    validator.setPlugin(cs::BlockValidator::balances, std::make_unique<AmountCounter>(validator, amount));
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t repeat = 0; repeat < kRepeats; ++repeat) {
+        // every repeat verifies signatures as for the first time
+        cs::SignatureCache::instance().clear();
+
+        for (size_t i = 1; i < blocks.size(); ++i) {
+            if (!validator.validateBlock(blocks[i], flags)) {
+                cs::Console::writeLine("Block ", blocks[i].sequence(), " is not valid");
+                return false;
+            }
+        }
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    const auto validated = (blocks.size() - 1) * kRepeats;
+
+    cs::Console::writeLine(threadsCount > 1 ? std::to_string(threadsCount) + " threads" : std::string("sequential"), ": ", validated, " blocks in ",
+                           duration / 1000, " ms, ", duration ? (validated * 1000000.0 / duration) : 0.0, " blocks/s, ",
+                           validated * kTransactionsPerBlock * 1000000.0 / std::max<int64_t>(duration, 1), " transactions/s");
+
+    return true;
+}
+
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    const fs::path path = fs::temp_directory_path() / fs::unique_path("blockvalidationbench-%%%%-%%%%");
+
+    {
+        csdb::Storage storage;
+
+        if (!storage.open(path.string())) {
+            cs::Console::writeLine("Can not open storage at ", path.string());
+            return 1;
+        }
+
+        cs::Console::writeLine("Fill storage by ", kChainLength, " signed pools of ", kTransactionsPerBlock, " transactions");
+
+        if (!cs::Framework::execute([&] { return fillStorage(storage); }, std::chrono::seconds(600), "Fill storage failed")) {
+            return 1;
+        }
+
+        storage.close();
+    }
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+
+        if (!blockchain.init(path.string())) {
+            cs::Console::writeLine("Can not open blockchain at ", path.string());
+            return 1;
+        }
+
+        std::vector<csdb::Pool> blocks;
+        blocks.reserve(kChainLength);
+
+        for (cs::Sequence sequence = 0; sequence < kChainLength; ++sequence) {
+            blocks.push_back(blockchain.loadBlock(sequence));
+        }
+
+        for (size_t threads : {size_t(1), size_t(2), size_t(4), size_t(8)}) {
+            cs::Framework::execute([&] { return runValidation(blockchain, blocks, threads); }, std::chrono::seconds(600), "Validation failed");
+        }
+
+        blockchain.close();
+    }
+
+    fs::remove_all(path);
+    return 0;
+}
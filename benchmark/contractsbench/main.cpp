@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <framework.hpp>
+
+#include <apihandler.hpp>
+#include <cscrypto/cscrypto.hpp>
+#include <csnode/blockchain.hpp>
+#include <lib/system/utils.hpp>
+#include <solver/consensus.hpp>
+#include <solver/smartcontracts.hpp>
+#include <solver/solvercore.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// the same as SmartContracts::StatesCacheBudget
+constexpr size_t kStatesBudget = 64 * 1024 * 1024;
+
+constexpr size_t kByteCodeSize = 4 * 1024;
+constexpr size_t kStateSize = 8 * 1024;
+
+// executions of every contract in synthetic chain
+constexpr size_t kCalls = 2;
+
+// contracts deployed or executed by every block
+constexpr size_t kBlockContracts = 100;
+
+// reads of every contract state after startup
+constexpr size_t kReads = 4;
+
+constexpr size_t kConfidantsCount = Consensus::MinTrustedNodes;
+
+const csdb::Address kGenesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address kStartAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+struct Keys {
+    cs::PublicKey publicKey;
+    cscrypto::PrivateKey privateKey;
+};
+
+// distinct non-zero keys of contracts
+csdb::Address makeAddress(size_t index) {
+    const size_t value = index + 1;
+    cs::PublicKey key{};
+    std::copy(reinterpret_cast<const uint8_t*>(&value), reinterpret_cast<const uint8_t*>(&value) + sizeof(value), key.begin());
+    return csdb::Address::from_public_key(key);
+}
+
+std::string makeState(size_t contract, size_t call) {
+    return std::string(kStateSize, static_cast<char>('a' + (contract + call) % 26));
+}
+
+///
+/// Stores deploys and executions of contracts followed by their new states to temporary blockchain,
+/// contracts are not connected while the chain is built.
+///
+class Chain {
+public:
+    Chain(BlockChain& blockchain, const std::vector<Keys>& confidants)
+    : blockchain_(blockchain)
+    , confidants_(confidants) {
+        for (const auto& keys : confidants_) {
+            confidantKeys_.push_back(keys.publicKey);
+        }
+
+        api::SmartContractInvocation deploy;
+        deploy.smartContractDeploy.byteCodeObjects.emplace_back();
+        deploy.smartContractDeploy.byteCodeObjects.back().byteCode = std::string(kByteCodeSize, 'c');
+        deploy_ = serialize(deploy);
+
+        api::SmartContractInvocation call;
+        call.method = "update";
+        call_ = serialize(call);
+    }
+
+    // deploy and calls of contracts [first, first + count)
+    bool add(size_t first, size_t count) {
+        for (size_t call = 0; call <= kCalls; ++call) {
+            std::vector<csdb::Transaction> starters;
+
+            for (size_t i = first; i < first + count; ++i) {
+                csdb::Transaction transaction(++startInnerId_, kStartAddress, makeAddress(i), 1, csdb::Amount(0), csdb::AmountCommission(1.0),
+                                              csdb::AmountCommission(0.0), cs::Zero::signature);
+                transaction.add_user_field(cs::trx_uf::deploy::Code, call == 0 ? deploy_ : call_);
+                starters.push_back(transaction);
+            }
+
+            const auto block = store(starters);
+            if (!block.has_value()) {
+                return false;
+            }
+
+            std::vector<csdb::Transaction> states;
+
+            for (size_t i = first; i < first + count; ++i) {
+                const auto address = makeAddress(i);
+                csdb::Transaction state(static_cast<int64_t>(call + 1), address, address, 1, csdb::Amount(0), csdb::AmountCommission(1.0),
+                                        csdb::AmountCommission(0.0), cs::Zero::signature);
+                state.add_user_field(cs::trx_uf::new_state::Value, makeState(i, call));
+                state.add_user_field(cs::trx_uf::new_state::RefStart, cs::SmartContractRef(block->hash(), block->sequence(), i - first).to_user_field());
+                state.add_user_field(cs::trx_uf::new_state::Fee, csdb::Amount{});
+                states.push_back(state);
+            }
+
+            if (!store(states).has_value()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // the last block is deferred until the next one is recorded
+    bool flush() {
+        return store({}).has_value();
+    }
+
+private:
+    // confidants sign the block hash as the writer collects them at stage-3
+    std::optional<csdb::Pool> store(const std::vector<csdb::Transaction>& transactions) {
+        csdb::Pool pool;
+
+        for (const auto& transaction : transactions) {
+            pool.add_transaction(transaction);
+        }
+
+        pool.set_sequence(blockchain_.getLastSeq() + 1);
+        pool.set_previous_hash(blockchain_.getLastHash());
+        pool.add_user_field(0, cs::Utils::currentTimestamp());
+        pool.add_number_trusted(static_cast<uint8_t>(confidants_.size()));
+        pool.add_real_trusted(cs::Utils::maskToBits(cs::Bytes(confidants_.size(), 0)));
+        pool.set_confidants(confidantKeys_);
+
+        if (pool.sequence() > 1) {
+            pool.add_number_confirmations(0);
+            pool.add_confirmation_mask(cs::Utils::maskToBits(cs::Bytes{}));
+            pool.add_round_confirmations(cs::Signatures{});
+        }
+
+        uint32_t size = 0;
+        pool.to_byte_stream(size);
+
+        cs::Hash hash;
+        const auto binary = pool.hash().to_binary();
+        std::copy(binary.begin(), binary.end(), hash.begin());
+
+        cs::Signatures signatures;
+
+        for (const auto& keys : confidants_) {
+            signatures.push_back(cscrypto::generateSignature(keys.privateKey, hash.data(), hash.size()));
+        }
+
+        pool.set_signatures(signatures);
+        return blockchain_.createBlock(pool);
+    }
+
+    BlockChain& blockchain_;
+    const std::vector<Keys>& confidants_;
+    cs::PublicKeys confidantKeys_;
+    std::string deploy_;
+    std::string call_;
+    int64_t startInnerId_ = 0;
+};
+
+bool build(const fs::path& path, const std::vector<Keys>& confidants, size_t contracts) {
+    BlockChain blockchain(kGenesisAddress, kStartAddress);
+
+    if (!blockchain.init(path.string())) {
+        cs::Console::writeLine("Can not open blockchain at ", path.string());
+        return false;
+    }
+
+    Chain chain(blockchain, confidants);
+    bool isOk = true;
+
+    for (size_t first = 0; isOk && first < contracts; first += kBlockContracts) {
+        isOk = chain.add(first, std::min(kBlockContracts, contracts - first));
+    }
+
+    isOk = isOk && chain.flush();
+    blockchain.close();
+
+    if (!isOk) {
+        cs::Console::writeLine("Can not store contracts blocks");
+    }
+
+    return isOk;
+}
+
+// startup reads the chain by SmartContracts as node does, then every state is read as API and new_state validation do
+bool run(const std::vector<Keys>& confidants, size_t contracts, size_t budget) {
+    const fs::path path = fs::temp_directory_path() / fs::unique_path("contractsbench-%%%%-%%%%");
+
+    if (!build(path, confidants, contracts)) {
+        fs::remove_all(path);
+        return false;
+    }
+
+    size_t checks = 0;
+    size_t misses = 0;
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+        cs::SolverCore solver(blockchain, kGenesisAddress, kStartAddress);
+
+        auto& smarts = solver.smart_contracts();
+        smarts.set_states_cache_budget(budget);
+
+        auto start = Clock::now();
+
+        if (!blockchain.init(path.string())) {
+            cs::Console::writeLine("Can not read blockchain at ", path.string());
+            fs::remove_all(path);
+            return false;
+        }
+
+        const auto startup = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const size_t statesBytes = smarts.states_cache_bytes();
+
+        start = Clock::now();
+
+        for (size_t read = 0; read < kReads; ++read) {
+            for (size_t i = 0; i < contracts; ++i) {
+                const auto address = makeAddress(i);
+                misses += !smarts.is_state_cached(address);
+                checks += smarts.get_known_contract_state(address) == makeState(i, kCalls);
+            }
+        }
+
+        const auto reads = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        cs::Console::writeLine(contracts, " contracts, budget ", budget == std::numeric_limits<size_t>::max() ? std::string("unlimited") : std::to_string(budget / 1024) + " KB",
+                               ": states ", statesBytes / 1024, " KB, startup ", static_cast<uint64_t>(startup), " ms, reads ", static_cast<uint64_t>(reads),
+                               " ms, read from DB cache ", misses);
+
+        blockchain.close();
+    }
+
+    fs::remove_all(path);
+    return checks == contracts * kReads;
+}
+}  // namespace
+
+///
+/// Startup and states memory of known contracts read from a temporary chain by SmartContracts.
+/// The unlimited budget keeps every state in memory, the default one reads evicted states back from DB cache.
+/// Executor process is not started, states are taken from new_state transactions.
+///
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    const auto seed = cscrypto::keys_derivation::generateMasterSeed();
+    std::vector<Keys> confidants;
+
+    for (uint32_t i = 0; i < kConfidantsCount; ++i) {
+        auto pair = cscrypto::keys_derivation::deriveKeyPair(seed, i);
+        confidants.push_back(Keys{pair.first, pair.second});
+    }
+
+    cs::Console::writeLine("Known contracts memory and startup, ", kByteCodeSize / 1024, " KB byte code, ", kStateSize / 1024, " KB state, ", kCalls,
+                           " calls per contract");
+
+    for (const size_t contracts : {size_t(1000), size_t(10000)}) {
+        for (const size_t budget : {std::numeric_limits<size_t>::max(), kStatesBudget}) {
+            cs::Framework::execute([&confidants, contracts, budget] { return run(confidants, contracts, budget); }, std::chrono::seconds(600),
+                                   "Known contracts states differ from chain");
+        }
+    }
+
+    return 0;
+}
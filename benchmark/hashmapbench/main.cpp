@@ -0,0 +1,116 @@
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include <framework.hpp>
+#include <lib/system/hash.hpp>
+#include <lib/system/structures.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// the same as Network::packetMap_
+constexpr uint32_t kCapacity = 100000;
+constexpr size_t kOperations = 1 << 22;
+
+struct DedupKeyHasher {
+    size_t operator()(const cs::DedupKey& key) const {
+        return static_cast<size_t>(key.value);
+    }
+};
+
+std::vector<cs::DedupKey> makeKeys(size_t count) {
+    std::vector<cs::DedupKey> keys(count);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        keys[i].value = cs::SipHash::calculate(&i, sizeof(i));
+    }
+
+    return keys;
+}
+
+void print(const char* name, const char* operation, size_t filled, Clock::time_point start, uint64_t found) {
+    const double nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    cs::Console::writeLine(name, " ", operation, " at ", filled * 100 / kCapacity, "% of capacity: ", static_cast<uint64_t>(nanoseconds / kOperations),
+                           " ns per operation (", found, " found)");
+}
+
+// lookups of stored and of absent keys in a map filled to the given part of capacity
+bool runLookups(size_t filled) {
+    const auto keys = makeKeys(filled * 2);
+
+    OpenHashMap<cs::DedupKey, uint32_t> open(kCapacity);
+    std::unordered_map<cs::DedupKey, uint32_t, DedupKeyHasher> unordered;
+    unordered.reserve(kCapacity);
+
+    for (size_t i = 0; i < filled; ++i) {
+        open.tryStore(keys[i]) = 1;
+        unordered[keys[i]] = 1;
+    }
+
+    for (const char* operation : {"hits", "misses"}) {
+        const size_t offset = operation[0] == 'h' ? 0 : filled;
+
+        auto start = Clock::now();
+        uint64_t found = 0;
+
+        for (size_t i = 0; i < kOperations; ++i) {
+            found += open.tryGet(keys[offset + i % filled]) != nullptr;
+        }
+
+        print("OpenHashMap", operation, filled, start, found);
+
+        start = Clock::now();
+        found = 0;
+
+        for (size_t i = 0; i < kOperations; ++i) {
+            found += unordered.count(keys[offset + i % filled]);
+        }
+
+        print("unordered_map", operation, filled, start, found);
+    }
+
+    return true;
+}
+
+// every received packet is new, the oldest one is evicted to store it
+bool runChurn() {
+    const auto keys = makeKeys(kOperations);
+
+    OpenHashMap<cs::DedupKey, uint32_t> open(kCapacity);
+    auto start = Clock::now();
+
+    for (const auto& key : keys) {
+        ++open.tryStore(key);
+    }
+
+    print("OpenHashMap", "store with eviction", kCapacity, start, open.size());
+
+    std::unordered_map<cs::DedupKey, uint32_t, DedupKeyHasher> unordered;
+    unordered.reserve(kCapacity);
+    start = Clock::now();
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (i >= kCapacity) {
+            unordered.erase(keys[i - kCapacity]);
+        }
+
+        ++unordered[keys[i]];
+    }
+
+    print("unordered_map", "store with eviction", kCapacity, start, unordered.size());
+    return true;
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Dedup keys map of ", kCapacity, " capacity, ", kOperations, " operations per run");
+
+    for (const uint32_t filled : {kCapacity / 4, kCapacity / 2, kCapacity * 3 / 4, kCapacity}) {
+        cs::Framework::execute([&] { return runLookups(filled); });
+    }
+
+    cs::Framework::execute(runChurn);
+
+    return 0;
+}
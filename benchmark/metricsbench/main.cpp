@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <framework.hpp>
+
+#include <lib/system/metrics.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kOperations = 10000000;
+constexpr size_t kSeries = 100;
+constexpr size_t kScrapes = 1000;
+
+std::atomic<uint64_t> sharedCounter{0};
+std::atomic<uint64_t> sink{0};
+
+// nanoseconds per operation of every thread, operations are run concurrently by all threads
+template <typename Operation>
+double measure(size_t threadsCount, Operation operation) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    std::vector<double> results(threadsCount);
+
+    for (size_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&, i] {
+            ++ready;
+
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            const auto begin = Clock::now();
+
+            for (size_t j = 0; j < kOperations; ++j) {
+                operation(j);
+            }
+
+            results[i] = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / kOperations;
+        });
+    }
+
+    while (ready.load() != threadsCount) {
+        std::this_thread::yield();
+    }
+
+    go.store(true, std::memory_order_release);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return *std::max_element(results.begin(), results.end());
+}
+
+void print(const char* name, double single, double multi) {
+    cs::Console::writeLine(name, ": ", single, " ns/op single thread, ", multi, " ns/op concurrent");
+}
+}  // namespace
+
+int main() {
+    const size_t threadsCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    cs::Console::writeLine("Metrics updates, ", kOperations, " operations per thread, ", threadsCount, " concurrent threads");
+
+    cs::Framework::execute(
+        [threadsCount] {
+            auto& counter = cs::metrics::Registry::instance().counter("bench_events_total", "Events");
+            auto& histogram = cs::metrics::Registry::instance().histogram("bench_latency_seconds", "Latency", cs::metrics::Histogram::latencyBounds());
+
+            auto baseline = [](size_t j) { sink.store(j, std::memory_order_relaxed); };
+            auto shared = [](size_t) { sharedCounter.fetch_add(1, std::memory_order_relaxed); };
+            auto sharded = [&counter](size_t) { counter.add(); };
+            auto observe = [&histogram](size_t j) { histogram.observe(static_cast<double>(j % 1000) * 1e-5); };
+            auto scoped = [&histogram](size_t) { cs::metrics::ScopedLatency latency(histogram); };
+
+            print("baseline store", measure(1, baseline), measure(threadsCount, baseline));
+            print("shared atomic", measure(1, shared), measure(threadsCount, shared));
+            print("Counter::add", measure(1, sharded), measure(threadsCount, sharded));
+            print("Histogram::observe", measure(1, observe), measure(threadsCount, observe));
+            print("ScopedLatency", measure(1, scoped), measure(threadsCount, scoped));
+
+            return counter.value() == kOperations * (threadsCount + 1);
+        },
+        std::chrono::seconds(600), "Counter lost updates");
+
+    cs::Framework::execute(
+        [] {
+            cs::metrics::Registry registry;
+            std::vector<cs::metrics::Probe> probes;
+
+            for (size_t i = 0; i < kSeries; ++i) {
+                const cs::metrics::Labels labels{{"index", std::to_string(i)}};
+                registry.counter("bench_counter_total", "Counter", labels).add(i);
+                registry.histogram("bench_histogram_seconds", "Histogram", cs::metrics::Histogram::latencyBounds(), labels).observe(0.01);
+                probes.push_back(registry.probe("bench_probe", "Probe", cs::metrics::Type::Gauge, [i] { return static_cast<double>(i); }, labels));
+            }
+
+            size_t bytes = 0;
+            const auto begin = Clock::now();
+
+            for (size_t i = 0; i < kScrapes; ++i) {
+                bytes += registry.exposition().size();
+            }
+
+            const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+            cs::Console::writeLine("Scrape of ", kSeries * 3, " series: ", seconds * 1e6 / kScrapes, " us, ", bytes / kScrapes, " bytes");
+
+            return bytes != 0;
+        },
+        std::chrono::seconds(600), "Exposition is empty");
+
+    return 0;
+}
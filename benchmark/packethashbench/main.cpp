@@ -0,0 +1,70 @@
+#include <chrono>
+#include <vector>
+
+#include <framework.hpp>
+#include <lib/system/hash.hpp>
+#include <lib/system/random.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kPackets = 1 << 20;
+constexpr size_t kMaxPacketSize = 1024;
+
+// random filled packets, a packet per iteration not to measure cache hits only
+std::vector<std::vector<uint8_t>> makePackets(size_t size) {
+    std::vector<std::vector<uint8_t>> packets(1024, std::vector<uint8_t>(size));
+
+    for (auto& packet : packets) {
+        for (auto& byte : packet) {
+            byte = cs::Random::generateValue<uint8_t>(0, 255);
+        }
+    }
+
+    return packets;
+}
+
+template <typename Func>
+bool run(const char* name, size_t size, Func func) {
+    const auto packets = makePackets(size);
+    uint64_t sink = 0;
+
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < kPackets; ++i) {
+        const auto& packet = packets[i % packets.size()];
+        sink += func(packet.data(), packet.size());
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    cs::Console::writeLine(name, " of ", size, " bytes: ", static_cast<uint64_t>(seconds * 1e9 / kPackets), " ns per packet, ",
+                           static_cast<uint64_t>(static_cast<double>(kPackets * size) / seconds / (1 << 20)), " MB/s (", sink % 2, ")");
+
+    return true;
+}
+
+uint64_t blake(const uint8_t* data, size_t size) {
+    return generateHash(data, size)[0];
+}
+
+uint64_t sip(const uint8_t* data, size_t size) {
+    return cs::SipHash::calculate(data, size);
+}
+}  // namespace
+
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    cs::Console::writeLine("Hash ", kPackets, " packets by cryptographic hash and by local dedup key");
+
+    for (const size_t size : {size_t(64), size_t(256), size_t(512), kMaxPacketSize}) {
+        cs::Framework::execute([&] { return run("generateHash", size, blake); });
+        cs::Framework::execute([&] { return run("SipHash", size, sip); });
+    }
+
+    return 0;
+}
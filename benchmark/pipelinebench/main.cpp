@@ -0,0 +1,482 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <framework.hpp>
+
+#include <apihandler.hpp>
+#include <cscrypto/cscrypto.hpp>
+#include <csdb/currency.hpp>
+#include <csnode/blockchain.hpp>
+#include <csnode/conveyer.hpp>
+#include <csnode/itervalidator.hpp>
+#include <lib/system/utils.hpp>
+#include <solver/consensus.hpp>
+#include <solver/smartcontracts.hpp>
+#include <solver/solvercontext.hpp>
+#include <solver/solvercore.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kRounds = 100;
+constexpr size_t kConfidantsCount = Consensus::MinTrustedNodes;
+constexpr double kMaxFee = 1.0;
+
+// contract calls wait for executor, its round trip on the same host
+constexpr auto kExecutionTime = std::chrono::microseconds(500);
+
+const csdb::Address kGenesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address kStartAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+const csdb::Amount kInitialBalance(1'000'000, 0);
+
+enum Stage : size_t {
+    Ingress,     // API checks and conveyer queue
+    Flush,       // packet queue to packets table and round table
+    Validation,  // characteristic of round transactions
+    Block,       // pool by characteristic signed by confidants
+    Store,       // signatures of confidants, finalized block and updated wallets cache
+    Execution,   // new states of called contracts by stub executor
+    StagesCount
+};
+
+constexpr std::array<const char*, StagesCount> kStageNames = {"ingress", "flush", "validation", "block", "store", "execution"};
+
+struct Keys {
+    cs::PublicKey publicKey;
+    cscrypto::PrivateKey privateKey;
+};
+
+struct Profile {
+    std::string name;
+    size_t senders = 0;
+    size_t roundTransactions = 0;  // given to API every round
+    size_t hotWallets = 0;         // the first senders send hotShare of transactions
+    double hotShare = 0;
+    bool isNewTargets = false;     // every transaction creates its target wallet
+    size_t roundCalls = 0;         // contract calls every round, new state packet of each takes two places at packet queue
+};
+
+// round of every profile fills the packets conveyer flushes in a round
+std::vector<Profile> profiles() {
+    constexpr size_t roundTransactions = cs::ConveyerBase::MaxPacketTransactions * cs::ConveyerBase::MaxPacketsPerRound;
+
+    Profile plain;
+    plain.name = "plain transfers";
+    plain.senders = 1000;
+    plain.roundTransactions = roundTransactions;
+
+    Profile manySenders = plain;
+    manySenders.name = "many senders";
+    manySenders.senders = kRounds * roundTransactions / 2;
+    manySenders.isNewTargets = true;
+
+    Profile hotWallets = plain;
+    hotWallets.name = "hot wallets";
+    hotWallets.hotWallets = 4;
+    hotWallets.hotShare = 0.5;
+
+    Profile smartCalls = plain;
+    smartCalls.name = "smart calls";
+    smartCalls.roundCalls = 2;
+    smartCalls.roundTransactions = roundTransactions - (2 * smartCalls.roundCalls + 1) * cs::ConveyerBase::MaxPacketTransactions;
+
+    // many senders grows wallets cache, so it goes last
+    return {plain, hotWallets, smartCalls, manySenders};
+}
+
+std::vector<Keys> makeKeys(const cscrypto::keys_derivation::MasterSeed& seed, uint32_t first, size_t count) {
+    std::vector<Keys> keys;
+    keys.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto pair = cscrypto::keys_derivation::deriveKeyPair(seed, first + static_cast<uint32_t>(i));
+        keys.push_back(Keys{pair.first, pair.second});
+    }
+
+    return keys;
+}
+
+// address without private key, target only
+csdb::Address makeAddress(const std::string& name) {
+    const auto hash = cscrypto::calculateHash(reinterpret_cast<const cs::Byte*>(name.data()), name.size());
+
+    cs::PublicKey key;
+    std::copy(hash.begin(), hash.end(), key.begin());
+
+    return csdb::Address::from_public_key(key);
+}
+
+csdb::Transaction makeTransaction(const Keys& source, const csdb::Address& target, int64_t innerId, const std::string* invocation) {
+    csdb::Transaction transaction;
+    transaction.set_innerID(innerId);
+    transaction.set_source(csdb::Address::from_public_key(source.publicKey));
+    transaction.set_target(target);
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(1, 0));
+    transaction.set_max_fee(csdb::AmountCommission(kMaxFee));
+    transaction.set_counted_fee(csdb::AmountCommission(0.0));
+
+    if (invocation != nullptr) {
+        transaction.add_user_field(cs::trx_uf::deploy::Code, *invocation);
+    }
+
+    const auto bytes = transaction.to_byte_stream_for_sig();
+    transaction.set_signature(cscrypto::generateSignature(source.privateKey, bytes.data(), bytes.size()));
+
+    return transaction;
+}
+
+// signed before measurements, so signing of wallets is not counted
+std::vector<std::vector<csdb::Transaction>> makeRounds(const Profile& profile, const std::vector<Keys>& senders, const csdb::Address& contract) {
+    std::mt19937_64 random(profile.senders);
+    std::vector<int64_t> innerIds(senders.size(), 0);
+
+    api::SmartContractInvocation call;
+    call.method = "transfer";
+    const std::string invocation = serialize(call);
+
+    const size_t hotWallets = std::min(profile.hotWallets, senders.size() - 1);
+    std::bernoulli_distribution isHot(profile.hotShare);
+    std::uniform_int_distribution<size_t> hotIndex(0, hotWallets != 0 ? hotWallets - 1 : 0);
+    std::uniform_int_distribution<size_t> coldIndex(hotWallets, senders.size() - 1);
+    std::uniform_int_distribution<size_t> anyIndex(0, senders.size() - 1);
+
+    std::vector<std::vector<csdb::Transaction>> rounds(kRounds);
+    uint64_t created = 0;
+
+    for (auto& round : rounds) {
+        round.reserve(profile.roundTransactions);
+
+        for (size_t i = 0; i < profile.roundTransactions; ++i) {
+            const size_t source = hotWallets != 0 && isHot(random) ? hotIndex(random) : coldIndex(random);
+            const bool isCall = i < profile.roundCalls;
+
+            csdb::Address target;
+
+            if (isCall) {
+                target = contract;
+            }
+            else if (profile.isNewTargets) {
+                target = makeAddress(profile.name + std::to_string(created));
+            }
+            else {
+                target = csdb::Address::from_public_key(senders[anyIndex(random)].publicKey);
+            }
+
+            round.push_back(makeTransaction(senders[source], target, ++innerIds[source], isCall ? &invocation : nullptr));
+            ++created;
+        }
+    }
+
+    return rounds;
+}
+
+double percentile(std::vector<double> values, double rank) {
+    if (values.empty()) {
+        return 0;
+    }
+
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(rank * static_cast<double>(values.size())))];
+}
+
+///
+/// Single node hot path from API to stored block: APIHandler::checkTransaction, conveyer queue and flush,
+/// round table, IterValidator::formCharacteristic, pool by characteristic, BlockChain::createBlock that
+/// finalizes the block and updates wallets cache. Node and executor are not created, solver core is created
+/// without node, round is driven by calls and the node is the writer of every round.
+///
+class Pipeline {
+public:
+    Pipeline(BlockChain& blockchain, cs::SolverCore& solver, const std::vector<Keys>& confidants)
+    : blockchain_(blockchain)
+    , context_(solver)
+    , validator_(context_.wallets())
+    , confidants_(confidants) {
+        for (const auto& keys : confidants_) {
+            confidantKeys_.push_back(keys.publicKey);
+        }
+    }
+
+    // the block of start address transfers, not validated as the genesis one
+    bool fund(const std::vector<Keys>& wallets) {
+        csdb::Pool pool;
+
+        for (const auto& keys : wallets) {
+            csdb::Transaction transaction;
+            transaction.set_innerID(++startInnerId_);
+            transaction.set_source(kStartAddress);
+            transaction.set_target(csdb::Address::from_public_key(keys.publicKey));
+            transaction.set_currency(1);
+            transaction.set_amount(kInitialBalance);
+            transaction.set_max_fee(csdb::AmountCommission(0.0));
+            transaction.set_counted_fee(csdb::AmountCommission(0.0));
+            transaction.set_signature(cs::Zero::signature);
+
+            pool.add_transaction(transaction);
+        }
+
+        pool.set_sequence(blockchain_.getLastSeq() + 1);
+        pool.set_previous_hash(blockchain_.getLastHash());
+        pool.add_user_field(0, cs::Utils::currentTimestamp());
+        pool.add_number_trusted(static_cast<uint8_t>(confidants_.size()));
+        pool.add_real_trusted(cs::Utils::maskToBits(cs::Bytes(confidants_.size(), 0)));
+
+        return store(pool).has_value();
+    }
+
+    bool runRound(const std::vector<csdb::Transaction>& transactions) {
+        auto& conveyer = cs::Conveyer::instance();
+        const auto round = static_cast<cs::RoundNumber>(blockchain_.getLastSeq() + 1);
+
+        auto begin = Clock::now();
+
+        for (const auto& transaction : transactions) {
+            if (!api::APIHandler::checkTransaction(blockchain_, transaction).has_value()) {
+                conveyer.addTransaction(transaction);
+                ++accepted_;
+            }
+            else {
+                ++rejected_;
+            }
+        }
+
+        begin = measure(Ingress, begin);
+
+        conveyer.flushTransactions();
+
+        cs::RoundTable table;
+        table.round = round;
+        table.confidants = confidantKeys_;
+
+        for (const auto& element : conveyer.transactionsPacketTable()) {
+            table.hashes.push_back(element.first);
+        }
+
+        std::sort(table.hashes.begin(), table.hashes.end());
+        conveyer.setTable(table);
+
+        begin = measure(Flush, begin);
+
+        auto packet = conveyer.createPacket();
+
+        if (!packet.has_value()) {
+            return false;
+        }
+
+        auto& [transactionsPacket, smartsPackets] = packet.value();
+        conveyer.setCharacteristic(validator_.formCharacteristic(context_, transactionsPacket.transactions(), smartsPackets), round);
+
+        begin = measure(Validation, begin);
+
+        cs::PoolMetaInfo meta;
+        meta.characteristic = *conveyer.characteristic(round);
+        meta.timestamp = cs::Utils::currentTimestamp();
+        meta.previousHash = blockchain_.getLastHash();
+        meta.sequenceNumber = round;
+        meta.realTrustedMask = cs::Bytes(confidants_.size(), 0);
+
+        auto pool = conveyer.applyCharacteristic(meta);
+
+        if (!pool.has_value()) {
+            return false;
+        }
+
+        blockchain_.addNewWalletsToPool(pool.value());
+        blockchain_.setTransactionsFees(pool.value());
+
+        begin = measure(Block, begin);
+
+        auto block = store(pool.value());
+
+        if (!block.has_value()) {
+            return false;
+        }
+
+        committed_ += block.value().transactions_count();
+        begin = measure(Store, begin);
+
+        execute(block.value());
+        measure(Execution, begin);
+
+        return true;
+    }
+
+    void print(const std::string& name, size_t transactionsCount) const {
+        double total = 0;
+
+        for (const auto& times : times_) {
+            total += std::accumulate(times.begin(), times.end(), 0.0);
+        }
+
+        cs::Console::writeLine("Profile ", name, ": ", kRounds, " rounds, ", transactionsCount, " transactions, ", accepted_, " accepted, ", rejected_,
+                               " rejected, ", committed_, " committed, ", total != 0 ? static_cast<double>(committed_) * 1e6 / total : 0.0, " tps");
+
+        for (size_t i = 0; i < StagesCount; ++i) {
+            const auto& times = times_[i];
+            const double sum = std::accumulate(times.begin(), times.end(), 0.0);
+
+            cs::Console::writeLine("  ", kStageNames[i], ": ", sum / static_cast<double>(times.size()), " us/round avg, ", percentile(times, 0.99),
+                                   " us p99, ", sum * 1000 / static_cast<double>(std::max<uint64_t>(committed_, 1)), " ns/transaction, ",
+                                   total != 0 ? sum * 100 / total : 0.0, "%");
+        }
+    }
+
+private:
+    Clock::time_point measure(Stage stage, Clock::time_point begin) {
+        const auto end = Clock::now();
+        times_[stage].push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+        return end;
+    }
+
+    // confidants sign the block hash as the writer collects them at stage-3
+    std::optional<csdb::Pool> store(csdb::Pool& pool) {
+        pool.set_confidants(confidantKeys_);
+
+        if (pool.sequence() > 1) {
+            pool.add_number_confirmations(0);
+            pool.add_confirmation_mask(cs::Utils::maskToBits(cs::Bytes{}));
+            pool.add_round_confirmations(cs::Signatures{});
+        }
+
+        uint32_t size = 0;
+        pool.to_byte_stream(size);
+
+        cs::Hash hash;
+        const auto binary = pool.hash().to_binary();
+        std::copy(binary.begin(), binary.end(), hash.begin());
+
+        cs::Signatures signatures;
+
+        for (const auto& keys : confidants_) {
+            signatures.push_back(cscrypto::generateSignature(keys.privateKey, hash.data(), hash.size()));
+        }
+
+        pool.set_signatures(signatures);
+        return blockchain_.createBlock(pool);
+    }
+
+    // stub executor: every call takes executor time and gives new state packet signed by smart confidants
+    void execute(const csdb::Pool& block) {
+        const auto& transactions = block.transactions();
+
+        for (size_t i = 0; i < transactions.size(); ++i) {
+            const auto& call = transactions[i];
+
+            if (!cs::SmartContracts::is_executable(call)) {
+                continue;
+            }
+
+            std::this_thread::sleep_for(kExecutionTime);
+
+            csdb::Transaction state(++contractInnerId_, call.target(), call.target(), call.currency(), 0, call.max_fee(), csdb::AmountCommission(0.0),
+                                    cs::Zero::signature);
+            state.add_user_field(cs::trx_uf::new_state::Value, "state " + std::to_string(contractInnerId_));
+            state.add_user_field(cs::trx_uf::new_state::RefStart, cs::SmartContractRef(block.hash(), block.sequence(), i).to_user_field());
+            state.add_user_field(cs::trx_uf::new_state::Fee, csdb::Amount{});
+
+            cs::TransactionsPacket packet;
+            packet.addTransaction(state);
+            packet.makeHash();
+
+            const auto hash = packet.hash().toBinary();
+
+            for (size_t j = 0; j < confidants_.size(); ++j) {
+                packet.addSignature(static_cast<cs::Byte>(j), cscrypto::generateSignature(confidants_[j].privateKey, hash.data(), hash.size()));
+            }
+
+            cs::Conveyer::instance().addSeparatePacket(packet);
+        }
+    }
+
+    BlockChain& blockchain_;
+    cs::SolverContext context_;
+    cs::IterValidator validator_;
+    const std::vector<Keys>& confidants_;
+    cs::PublicKeys confidantKeys_;
+
+    int64_t startInnerId_ = 0;
+    int64_t contractInnerId_ = 0;
+
+    uint64_t accepted_ = 0;
+    uint64_t rejected_ = 0;
+    uint64_t committed_ = 0;
+    std::array<std::vector<double>, StagesCount> times_;
+};
+}  // namespace
+
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    const fs::path path = fs::temp_directory_path() / fs::unique_path("pipelinebench-%%%%-%%%%");
+    const auto seed = cscrypto::keys_derivation::generateMasterSeed();
+    const auto confidants = makeKeys(seed, 0, kConfidantsCount);
+    const auto contract = makeAddress("contract");
+
+    bool isOk = true;
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+
+        if (!blockchain.init(path.string())) {
+            cs::Console::writeLine("Can not open blockchain at ", path.string());
+            return 1;
+        }
+
+        // as in node, smart contracts of solver follow the blockchain for its whole life
+        cs::SolverCore solver(blockchain, kGenesisAddress, kStartAddress);
+
+        uint32_t firstKey = kConfidantsCount;
+
+        for (const auto& profile : profiles()) {
+            const auto senders = makeKeys(seed, firstKey, profile.senders);
+            firstKey += static_cast<uint32_t>(profile.senders);
+
+            cs::Console::writeLine("Profile ", profile.name, ": sign ", kRounds * profile.roundTransactions, " transactions of ", profile.senders, " wallets");
+            const auto rounds = makeRounds(profile, senders, contract);
+
+            Pipeline pipeline(blockchain, solver, confidants);
+
+            isOk = cs::Framework::execute(
+                [&] {
+                    if (!pipeline.fund(senders)) {
+                        return false;
+                    }
+
+                    for (const auto& round : rounds) {
+                        if (!pipeline.runRound(round)) {
+                            return false;
+                        }
+                    }
+
+                    pipeline.print(profile.name, kRounds * profile.roundTransactions);
+                    return true;
+                },
+                std::chrono::seconds(600), "Pipeline failed to store block");
+
+            if (!isOk) {
+                break;
+            }
+        }
+
+        blockchain.close();
+    }
+
+    fs::remove_all(path);
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+#include <framework.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <csdb/pool.hpp>
+#include <csdb/storage.hpp>
+
+namespace fs = boost::filesystem;
+
+static constexpr cs::Sequence kChainLength = 20000;
+static constexpr size_t kTraceLength = 200000;
+static constexpr uint32_t kSeed = 0xC0FFEE;
+
+// access made by node: sync replies, api calls
+struct Access {
+    bool byHash;
+    cs::Sequence sequence;
+};
+
+using Trace = std::vector<Access>;
+
+static std::vector<csdb::PoolHash> hashes;
+
+// most blocks are small, rare blocks are huge (deploy/large transaction packs)
+static size_t blockPayloadSize(std::mt19937& generator) {
+    std::lognormal_distribution<double> distribution(6.5, 1.2);
+    return std::min<size_t>(static_cast<size_t>(distribution(generator)), 4 * 1024 * 1024);
+}
+
+static bool fillStorage(csdb::Storage& storage) {
+    std::mt19937 generator(kSeed);
+    csdb::PoolHash previous;
+
+    hashes.clear();
+    hashes.reserve(kChainLength);
+
+    for (cs::Sequence sequence = 0; sequence < kChainLength; ++sequence) {
+        csdb::Pool pool(previous, sequence);
+        pool.add_user_field(0, std::to_string(sequence));
+        pool.add_user_field(1, std::string(blockPayloadSize(generator), 'x'));
+
+        if (!pool.compose() || !storage.pool_save(pool)) {
+            return false;
+        }
+
+        previous = pool.hash();
+        hashes.push_back(previous);
+    }
+
+    return true;
+}
+
+// neighbours request consecutive ranges behind the tip, each range is usually asked by several of them
+static Trace makeSyncTrace() {
+    std::mt19937 generator(kSeed + 1);
+    std::geometric_distribution<cs::Sequence> depth(1.0 / 2000);
+    std::uniform_int_distribution<size_t> repeats(1, 4);
+
+    Trace trace;
+    trace.reserve(kTraceLength);
+
+    while (trace.size() < kTraceLength) {
+        const cs::Sequence start = kChainLength - 1 - std::min<cs::Sequence>(depth(generator), kChainLength - 1);
+        const size_t count = repeats(generator);
+
+        for (size_t i = 0; i < count; ++i) {
+            for (cs::Sequence sequence = start; sequence < std::min<cs::Sequence>(start + 25, kChainLength); ++sequence) {
+                trace.push_back({false, sequence});
+            }
+        }
+    }
+
+    trace.resize(kTraceLength);
+    return trace;
+}
+
+// explorers mostly ask for recent blocks by hash, and sometimes scan deep history
+static Trace makeApiTrace() {
+    std::mt19937 generator(kSeed + 2);
+    std::uniform_real_distribution<double> kind(0.0, 1.0);
+    std::geometric_distribution<cs::Sequence> recent(1.0 / 100);
+    std::uniform_int_distribution<cs::Sequence> anywhere(0, kChainLength - 1);
+
+    Trace trace;
+    trace.reserve(kTraceLength);
+
+    while (trace.size() < kTraceLength) {
+        const double value = kind(generator);
+
+        if (value < 0.8) {
+            trace.push_back({true, kChainLength - 1 - std::min<cs::Sequence>(recent(generator), kChainLength - 1)});
+        }
+        else if (value < 0.95) {
+            const cs::Sequence start = anywhere(generator);
+
+            for (cs::Sequence sequence = start; sequence < std::min<cs::Sequence>(start + 10, kChainLength); ++sequence) {
+                trace.push_back({false, sequence});
+            }
+        }
+        else {
+            trace.push_back({true, anywhere(generator)});
+        }
+    }
+
+    trace.resize(kTraceLength);
+    return trace;
+}
+
+static Trace makeMixedTrace(const Trace& sync, const Trace& api) {
+    Trace trace;
+    trace.reserve(sync.size() + api.size());
+
+    for (size_t i = 0; i < std::max(sync.size(), api.size()); ++i) {
+        if (i < sync.size()) {
+            trace.push_back(sync[i]);
+        }
+
+        if (i < api.size()) {
+            trace.push_back(api[i]);
+        }
+    }
+
+    return trace;
+}
+
+static void replay(const csdb::Storage& storage, const Trace& trace) {
+    for (const auto& access : trace) {
+        csdb::Pool pool = access.byHash ? storage.pool_load(hashes[access.sequence]) : storage.pool_load(access.sequence);
+
+        if (!pool.is_valid()) {
+            cs::Console::writeLine("Pool ", access.sequence, " can not be loaded");
+        }
+    }
+}
+
+static void runTrace(csdb::Storage& storage, const std::string& name, const Trace& trace, size_t limit) {
+    storage.set_pools_cache_limit(0);
+    storage.set_pools_cache_limit(limit);
+
+    const auto before = storage.pools_cache_stats();
+    cs::Framework::execute([&] { replay(storage, trace); }, std::chrono::seconds(600));
+    const auto after = storage.pools_cache_stats();
+
+    const auto hits = after.hits - before.hits;
+    const auto misses = after.misses - before.misses;
+
+    cs::Console::writeLine(name, ", budget ", limit / 1024, " KB: hits ", hits, ", misses ", misses,
+                           ", evictions ", after.evictions - before.evictions,
+                           ", hit rate ", (hits + misses) ? (100.0 * hits / (hits + misses)) : 0.0, "%",
+                           ", cached ", after.count, " pools / ", after.bytes / 1024, " KB");
+}
+
+int main() {
+    const fs::path path = fs::temp_directory_path() / fs::unique_path("poolscachebench-%%%%-%%%%");
+
+    {
+        csdb::Storage storage;
+
+        if (!storage.open(path.string())) {
+            cs::Console::writeLine("Can not open storage at ", path.string());
+            return 1;
+        }
+
+        cs::Console::writeLine("Fill storage by ", kChainLength, " pools");
+
+        if (!cs::Framework::execute([&] { return fillStorage(storage); }, std::chrono::seconds(600), "Fill storage failed")) {
+            return 1;
+        }
+
+        const Trace sync = makeSyncTrace();
+        const Trace api = makeApiTrace();
+        const Trace mixed = makeMixedTrace(sync, api);
+
+        for (size_t limit : {size_t(4) << 20, size_t(16) << 20, size_t(64) << 20, csdb::Storage::kDefaultPoolsCacheLimit}) {
+            runTrace(storage, "sync", sync, limit);
+            runTrace(storage, "api", api, limit);
+            runTrace(storage, "mixed", mixed, limit);
+        }
+
+        storage.close();
+    }
+
+    fs::remove_all(path);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <framework.hpp>
+
+#include <csnode/packstream.hpp>
+#include <lib/system/random.hpp>
+#include <net/packet.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kMessages = 200;
+constexpr size_t kStrippedDataSize = sizeof(cs::RoundNumber) + sizeof(MsgTypes);
+
+RegionAllocator allocator;
+
+struct Result {
+    double microseconds = 0;
+    size_t copied = 0;
+};
+
+// requested block reply as it comes from the network: round, type, sizes of the block and compressed bytes
+std::vector<Packet> makeFragments(size_t compressedSize) {
+    cs::Bytes payload(kStrippedDataSize + sizeof(size_t) + sizeof(uint32_t));
+    const size_t realBinSize = compressedSize * 2;
+    const auto compressSize = static_cast<uint32_t>(compressedSize);
+
+    std::memcpy(payload.data() + kStrippedDataSize, &realBinSize, sizeof(realBinSize));
+    std::memcpy(payload.data() + kStrippedDataSize + sizeof(realBinSize), &compressSize, sizeof(compressSize));
+
+    for (size_t i = 0; i < compressedSize; ++i) {
+        payload.push_back(cs::Random::generateValue<cs::Byte>(0, 255));
+    }
+
+    std::vector<Packet> fragments;
+
+    for (size_t offset = 0; offset < payload.size();) {
+        Packet pack(allocator.allocateNext(Packet::MaxSize));
+        auto data = static_cast<uint8_t*>(pack.data());
+        std::fill(data, data + Packet::MaxSize, 0);
+
+        data[0] = BaseFlags::Fragmented | BaseFlags::Broadcast;
+        pack.recalculateHeadersLength();
+
+        const size_t headersLength = pack.getHeadersLength();
+        const size_t count = std::min(payload.size() - offset, static_cast<size_t>(Packet::MaxSize) - headersLength);
+
+        std::memcpy(data + headersLength, payload.data() + offset, count);
+        pack.setSize(static_cast<uint32_t>(headersLength + count));
+
+        fragments.push_back(std::move(pack));
+        offset += count;
+    }
+
+    return fragments;
+}
+
+// reads compressed bytes as decompressPoolsBlock does
+size_t parse(cs::IPackStream& stream) {
+    stream.safeSkip<cs::Byte>(kStrippedDataSize);
+
+    size_t realBinSize = 0;
+    uint32_t compressSize = 0;
+    stream >> realBinSize >> compressSize;
+
+    const auto view = stream.readView(compressSize);
+    return stream.good() ? view.size() + view[view.size() / 2] : 0;
+}
+
+// composed by Message, then copied again to the lane task
+Result composed(const std::vector<Packet>& fragments) {
+    Result result;
+    size_t sink = 0;
+
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < kMessages; ++i) {
+        const size_t headersLength = fragments[0].getHeadersLength();
+        cs::Bytes full;
+
+        for (auto& pack : fragments) {
+            auto data = static_cast<const cs::Byte*>(pack.data());
+            full.insert(full.end(), data + headersLength, data + pack.size());
+        }
+
+        cs::Bytes bytes(full.begin(), full.end());
+
+        cs::IPackStream stream;
+        stream.init(bytes.data(), bytes.size());
+        sink += parse(stream);
+
+        result.copied += full.size() + bytes.size();
+    }
+
+    result.microseconds = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kMessages;
+    result.copied /= kMessages;
+
+    return sink ? result : Result{};
+}
+
+// fragments are read in place, only lz4 input is composed
+Result segmented(const std::vector<Packet>& fragments) {
+    Result result;
+    size_t sink = 0;
+
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < kMessages; ++i) {
+        const auto segments = Message::dataSegments(fragments);
+
+        cs::IPackStream stream;
+        stream.init(segments.data(), segments.size());
+        sink += parse(stream);
+
+        result.copied += stream.composedBytes();
+    }
+
+    result.microseconds = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kMessages;
+    result.copied /= kMessages;
+
+    return sink ? result : Result{};
+}
+
+bool run(size_t size) {
+    const auto fragments = makeFragments(size);
+
+    const auto before = composed(fragments);
+    const auto after = segmented(fragments);
+
+    cs::Console::writeLine("Message of ", size >> 10, " KB in ", fragments.size(), " fragments: composed ", static_cast<uint64_t>(before.microseconds), " us, ",
+                           before.copied >> 10, " KB copied; segmented ", static_cast<uint64_t>(after.microseconds), " us, ", after.copied >> 10, " KB copied");
+
+    return before.copied != 0 && after.copied != 0;
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Reassemble fragmented block replies and read compressed data, ", kMessages, " messages per size");
+
+    // fragments count is limited by Packet::MaxFragments
+    for (const size_t size : {size_t(64) << 10, size_t(512) << 10, size_t(1) << 20, size_t(3) << 20}) {
+        cs::Framework::execute([size] { return run(size); }, std::chrono::seconds(60), "Reassembly failed");
+    }
+
+    return 0;
+}
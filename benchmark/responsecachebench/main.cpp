@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <framework.hpp>
+
+#include <apihandler.hpp>
+#include <cscrypto/cscrypto.hpp>
+#include <csnode/blockchain.hpp>
+#include <lib/system/signals.hpp>
+#include <lib/system/utils.hpp>
+#include <solver/consensus.hpp>
+#include <solver/solvercore.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Cache = api::ResponseCache;
+
+constexpr size_t kRequestsCount = 100000;
+constexpr size_t kRequestsPerBlock = 200;
+constexpr size_t kWalletsCount = 1000;
+constexpr size_t kInitialBlocks = 1000;
+constexpr size_t kBlockTransactions = 20;
+constexpr size_t kConfidantsCount = Consensus::MinTrustedNodes;
+
+const csdb::Address kGenesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address kStartAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+struct Keys {
+    cs::PublicKey publicKey;
+    cscrypto::PrivateKey privateKey;
+};
+
+struct Request {
+    Cache::Method method;
+    int64_t first;
+    int64_t second;
+};
+
+std::vector<Keys> makeKeys(const cscrypto::keys_derivation::MasterSeed& seed, uint32_t first, size_t count) {
+    std::vector<Keys> keys;
+    keys.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto pair = cscrypto::keys_derivation::deriveKeyPair(seed, first + static_cast<uint32_t>(i));
+        keys.push_back(Keys{pair.first, pair.second});
+    }
+
+    return keys;
+}
+
+///
+/// Grows the chain by signed blocks of transfers between wallets, every stored block
+/// reaches APIHandler by storeBlockEvent as in node.
+///
+class Chain {
+public:
+    Chain(BlockChain& blockchain, const std::vector<Keys>& confidants, const std::vector<Keys>& wallets)
+    : blockchain_(blockchain)
+    , confidants_(confidants)
+    , wallets_(wallets)
+    , innerIds_(wallets.size(), 0)
+    , random_(42) {
+        for (const auto& keys : confidants_) {
+            confidantKeys_.push_back(keys.publicKey);
+        }
+    }
+
+    // the block of start address transfers, not validated as the genesis one
+    bool fund() {
+        std::vector<csdb::Transaction> transactions;
+        int64_t innerId = 0;
+
+        for (const auto& keys : wallets_) {
+            csdb::Transaction transaction;
+            transaction.set_innerID(++innerId);
+            transaction.set_source(kStartAddress);
+            transaction.set_target(csdb::Address::from_public_key(keys.publicKey));
+            transaction.set_currency(1);
+            transaction.set_amount(csdb::Amount(1'000'000, 0));
+            transaction.set_max_fee(csdb::AmountCommission(0.0));
+            transaction.set_counted_fee(csdb::AmountCommission(0.0));
+            transaction.set_signature(cs::Zero::signature);
+
+            transactions.push_back(transaction);
+        }
+
+        return store(transactions);
+    }
+
+    bool grow() {
+        std::uniform_int_distribution<size_t> index(0, wallets_.size() - 1);
+        std::vector<csdb::Transaction> transactions;
+
+        for (size_t i = 0; i < kBlockTransactions; ++i) {
+            const size_t source = index(random_);
+            const auto& keys = wallets_[source];
+
+            csdb::Transaction transaction;
+            transaction.set_innerID(++innerIds_[source]);
+            transaction.set_source(csdb::Address::from_public_key(keys.publicKey));
+            transaction.set_target(csdb::Address::from_public_key(wallets_[index(random_)].publicKey));
+            transaction.set_currency(1);
+            transaction.set_amount(csdb::Amount(1, 0));
+            transaction.set_max_fee(csdb::AmountCommission(1.0));
+            transaction.set_counted_fee(csdb::AmountCommission(0.0));
+
+            const auto bytes = transaction.to_byte_stream_for_sig();
+            transaction.set_signature(cscrypto::generateSignature(keys.privateKey, bytes.data(), bytes.size()));
+
+            transactions.push_back(transaction);
+        }
+
+        return store(transactions);
+    }
+
+private:
+    // confidants sign the block hash as the writer collects them at stage-3
+    bool store(const std::vector<csdb::Transaction>& transactions) {
+        csdb::Pool pool;
+
+        for (const auto& transaction : transactions) {
+            pool.add_transaction(transaction);
+        }
+
+        pool.set_sequence(blockchain_.getLastSeq() + 1);
+        pool.set_previous_hash(blockchain_.getLastHash());
+        pool.add_user_field(0, cs::Utils::currentTimestamp());
+        pool.add_number_trusted(static_cast<uint8_t>(confidants_.size()));
+        pool.add_real_trusted(cs::Utils::maskToBits(cs::Bytes(confidants_.size(), 0)));
+        pool.set_confidants(confidantKeys_);
+
+        blockchain_.addNewWalletsToPool(pool);
+        blockchain_.setTransactionsFees(pool);
+
+        if (pool.sequence() > 1) {
+            pool.add_number_confirmations(0);
+            pool.add_confirmation_mask(cs::Utils::maskToBits(cs::Bytes{}));
+            pool.add_round_confirmations(cs::Signatures{});
+        }
+
+        uint32_t size = 0;
+        pool.to_byte_stream(size);
+
+        cs::Hash hash;
+        const auto binary = pool.hash().to_binary();
+        std::copy(binary.begin(), binary.end(), hash.begin());
+
+        cs::Signatures signatures;
+
+        for (const auto& keys : confidants_) {
+            signatures.push_back(cscrypto::generateSignature(keys.privateKey, hash.data(), hash.size()));
+        }
+
+        pool.set_signatures(signatures);
+        return blockchain_.createBlock(pool).has_value();
+    }
+
+    BlockChain& blockchain_;
+    const std::vector<Keys>& confidants_;
+    const std::vector<Keys>& wallets_;
+    cs::PublicKeys confidantKeys_;
+    std::vector<int64_t> innerIds_;
+    std::mt19937 random_;
+};
+
+// request mix taken from explorer traffic: mostly the first pages of pools and transactions
+std::vector<Request> makeRequests() {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> kind(0.0, 1.0);
+    std::geometric_distribution<int64_t> page(0.6);
+    std::uniform_int_distribution<int64_t> wallet(0, kWalletsCount - 1);
+    std::uniform_int_distribution<int64_t> limits(0, 2);
+
+    const int64_t limitValues[] = {10, 25, 100};
+
+    std::vector<Request> requests;
+    requests.reserve(kRequestsCount);
+
+    for (size_t i = 0; i < kRequestsCount; ++i) {
+        const double value = kind(generator);
+        const int64_t limit = limitValues[limits(generator)];
+
+        if (value < 0.5) {
+            requests.push_back({Cache::PoolList, page(generator) * limit, limit});
+        }
+        else if (value < 0.7) {
+            requests.push_back({Cache::PoolListStable, std::max<int64_t>(limit, static_cast<int64_t>(kInitialBlocks) - page(generator) * limit), limit});
+        }
+        else if (value < 0.85) {
+            requests.push_back({Cache::TransactionsList, page(generator) * limit, limit});
+        }
+        else if (value < 0.95) {
+            requests.push_back({Cache::Stats, 0, 0});
+        }
+        else {
+            requests.push_back({Cache::WalletData, wallet(generator), 0});
+        }
+    }
+
+    return requests;
+}
+
+// returns time spent in handlers, chain grows between requests
+double replay(api::APIHandler& handler, Chain& chain, const std::vector<Keys>& wallets, const std::vector<Request>& requests) {
+    std::chrono::duration<double, std::milli> spent{0};
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (i % kRequestsPerBlock == 0 && !chain.grow()) {
+            return -1;
+        }
+
+        const auto& request = requests[i];
+        const auto start = Clock::now();
+
+        switch (request.method) {
+            case Cache::PoolList: {
+                api::PoolListGetResult result;
+                handler.PoolListGet(result, request.first, request.second);
+                break;
+            }
+
+            case Cache::PoolListStable: {
+                api::PoolListGetResult result;
+                handler.PoolListGetStable(result, request.first, request.second);
+                break;
+            }
+
+            case Cache::TransactionsList: {
+                api::TransactionsGetResult result;
+                handler.TransactionsListGet(result, request.first, request.second);
+                break;
+            }
+
+            case Cache::Stats: {
+                api::StatsGetResult result;
+                handler.StatsGet(result);
+                break;
+            }
+
+            case Cache::WalletData: {
+                const auto& key = wallets[static_cast<size_t>(request.first)].publicKey;
+
+                api::WalletDataGetResult result;
+                handler.WalletDataGet(result, general::Address(key.begin(), key.end()));
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        spent += Clock::now() - start;
+    }
+
+    return spent.count();
+}
+
+void print(size_t memoryLimit, double spent, const Cache::CacheStats& before, const Cache::CacheStats& after) {
+    const char* names[] = {"PoolListGet", "PoolListGetStable", "TransactionsListGet", "StatsGet", "WalletDataGet"};
+
+    cs::Console::writeLine("Memory limit ", memoryLimit / 1024, " KB, handlers time ", spent, " ms, evictions ", after.evictions - before.evictions, ", cached ",
+                           after.bytes / 1024, " KB");
+
+    for (size_t i = 0; i < Cache::MethodsCount; ++i) {
+        const auto hits = after.methods[i].hits - before.methods[i].hits;
+        const auto misses = after.methods[i].misses - before.methods[i].misses;
+        const auto total = hits + misses;
+
+        cs::Console::writeLine("  ", names[i], ": hit rate ", total ? 100.0 * static_cast<double>(hits) / static_cast<double>(total) : 0.0, "%, compute ",
+                               (after.methods[i].computeMicroseconds - before.methods[i].computeMicroseconds) / 1000, " ms, serve ",
+                               (after.methods[i].serveMicroseconds - before.methods[i].serveMicroseconds) / 1000, " ms, invalidations ",
+                               after.methods[i].invalidations - before.methods[i].invalidations);
+    }
+}
+}  // namespace
+
+///
+/// Replays explorer requests against APIHandler of a temporary chain, a new block is stored
+/// every kRequestsPerBlock requests and invalidates responses by the real store event.
+/// Executor process is not started, requests in the mix do not need it.
+///
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    const fs::path path = fs::temp_directory_path() / fs::unique_path("responsecachebench-%%%%-%%%%");
+    const auto seed = cscrypto::keys_derivation::generateMasterSeed();
+    const auto confidants = makeKeys(seed, 0, kConfidantsCount);
+    const auto wallets = makeKeys(seed, kConfidantsCount, kWalletsCount);
+    const auto requests = makeRequests();
+
+    bool isOk = true;
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+
+        if (!blockchain.init(path.string())) {
+            cs::Console::writeLine("Can not open blockchain at ", path.string());
+            return 1;
+        }
+
+        cs::SolverCore solver(blockchain, kGenesisAddress, kStartAddress);
+        Config config;
+
+        executor::ExecutorSettings::set(cs::makeReference(blockchain), cs::makeReference(solver), cs::makeReference(config));
+        api::APIHandler handler(blockchain, solver, executor::Executor::getInstance(), config);
+
+        cs::Connector::connect(&blockchain.storeBlockEvent, &handler, &api::APIHandler::store_block_slot);
+        cs::Connector::connect(&blockchain.removeBlockEvent, &handler, &api::APIHandler::remove_block_slot);
+
+        Chain chain(blockchain, confidants, wallets);
+        isOk = chain.fund();
+
+        for (size_t i = 0; isOk && i < kInitialBlocks; ++i) {
+            isOk = chain.grow();
+        }
+
+        if (!isOk) {
+            cs::Console::writeLine("Can not store initial blocks");
+        }
+
+        // zero limit never stores responses, it is the uncached baseline
+        for (size_t limit : {size_t(0), size_t(1) << 20, Cache::kDefaultMemoryLimit}) {
+            if (!isOk) {
+                break;
+            }
+
+            auto& cache = handler.getResponseCache();
+            cache.clear();
+            cache.setMemoryLimit(limit);
+
+            const auto before = cache.stats();
+
+            isOk = cs::Framework::execute(
+                [&] {
+                    const double spent = replay(handler, chain, wallets, requests);
+
+                    if (spent < 0) {
+                        return false;
+                    }
+
+                    print(limit, spent, before, cache.stats());
+                    return true;
+                },
+                std::chrono::seconds(600), "Replay failed to store block");
+        }
+
+        blockchain.close();
+    }
+
+    fs::remove_all(path);
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include <boost/asio.hpp>
+
+#include <framework.hpp>
+#include <net/network.hpp>
+
+namespace {
+using namespace boost::asio;
+using Clock = std::chrono::steady_clock;
+
+#ifdef __linux__
+using reuse_port = detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+constexpr size_t kSenders = 8;
+constexpr size_t kPacketSize = 512;
+constexpr auto kDuration = std::chrono::seconds(3);
+
+struct Result {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t processed = 0;
+    std::vector<uint64_t> perReader;
+};
+
+// blocking as input sockets of network are
+std::unique_ptr<ip::udp::socket> openSocket(io_context& context, uint16_t port) {
+    auto sock = std::make_unique<ip::udp::socket>(context, ip::udp::v4());
+    sock->set_option(ip::udp::socket::reuse_address(true));
+#ifdef __linux__
+    sock->set_option(reuse_port(true));
+#endif
+    sock->set_option(ip::udp::socket::receive_buffer_size(1 << 23));
+    sock->bind(ip::udp::endpoint(ip::address_v4::loopback(), port));
+
+    return sock;
+}
+
+Result run(size_t readersCount) {
+    io_context context;
+    std::vector<std::unique_ptr<ip::udp::socket>> sockets;
+
+    sockets.push_back(openSocket(context, 0));
+    const auto endpoint = sockets.front()->local_endpoint();
+
+    for (size_t i = 1; i < readersCount; ++i) {
+        sockets.push_back(openSocket(context, endpoint.port()));
+    }
+
+    IPacMan pacman;
+    std::atomic<bool> isStopped = false;
+    std::atomic<bool> isRead = false;
+    std::atomic<bool> isSending = true;
+    std::atomic<Network::TimePoint> lastProcessed{std::chrono::high_resolution_clock::now()};
+
+    std::vector<Network::ReaderCounters> counters(readersCount);
+    std::atomic<uint64_t> sent = 0;
+    uint64_t processed = 0;
+
+    std::vector<std::thread> readers;
+
+    // the receive loop of network readers, processor below takes the queue without waiting for notification
+    for (size_t i = 0; i < readersCount; ++i) {
+        readers.emplace_back([&, i] { Network::readPackets(*sockets[i], pacman, i, counters[i], isStopped, lastProcessed, [] {}); });
+    }
+
+    // processor thread takes packets from the shared queue as network processor does
+    std::thread processor([&] {
+        while (!isRead || pacman.getSize()) {
+            bool isEmpty = false;
+            auto task = pacman.getNextTask(isEmpty);
+
+            if (isEmpty) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            ++processed;
+            lastProcessed.store(task->timestamp, std::memory_order_relaxed);
+            task.release();
+        }
+    });
+
+    std::vector<std::thread> threads;
+
+    // every sender has its own source port, kernel spreads senders over the sockets
+    for (size_t i = 0; i < kSenders; ++i) {
+        threads.emplace_back([&] {
+            ip::udp::socket sock(context, ip::udp::v4());
+            sock.set_option(ip::udp::socket::send_buffer_size(1 << 20));
+
+            RegionAllocator allocator;
+            Packet packet(allocator.allocateNext(kPacketSize));
+            auto data = static_cast<uint8_t*>(packet.data());
+            std::fill(data, data + kPacketSize, 0);
+
+            data[0] = BaseFlags::Broadcast;
+            packet.recalculateHeadersLength();
+            data[packet.getHeadersLength()] = MsgTypes::TransactionPacket;
+
+            boost::system::error_code error;
+            uint64_t count = 0;
+
+            while (isSending) {
+                if (sock.send_to(buffer(packet.data(), kPacketSize), endpoint, 0, error) == kPacketSize) {
+                    ++count;
+                }
+            }
+
+            sent += count;
+        });
+    }
+
+    std::this_thread::sleep_for(kDuration);
+
+    isSending = false;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // let readers drain socket buffers
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    isStopped = true;
+
+    // readers block in receive, shutdown wakes them with an empty datagram
+    for (auto& sock : sockets) {
+        boost::system::error_code error;
+        sock->shutdown(ip::udp::socket::shutdown_receive, error);
+    }
+
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    isRead = true;
+    processor.join();
+
+    Result result;
+    result.sent = sent;
+    result.processed = processed;
+
+    for (const auto& reader : counters) {
+        const uint64_t count = reader.packets.load(std::memory_order_relaxed);
+        result.perReader.push_back(count);
+        result.received += count;
+    }
+
+    return result;
+}
+
+bool print(size_t readersCount, const Result& result) {
+    const double seconds = std::chrono::duration<double>(kDuration).count();
+    const auto minmax = std::minmax_element(result.perReader.begin(), result.perReader.end());
+
+    cs::Console::writeLine(readersCount, " readers: received ", static_cast<uint64_t>(static_cast<double>(result.received) / seconds), " packets/s of ",
+                           static_cast<uint64_t>(static_cast<double>(result.sent) / seconds), " sent, lost ",
+                           result.sent ? 100.0 * static_cast<double>(result.sent - result.received) / static_cast<double>(result.sent) : 0.0,
+                           "%, per reader min ", *minmax.first, " max ", *minmax.second);
+
+    return result.processed == result.received;
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Loopback receive rate of ", kSenders, " senders, ", kPacketSize, " bytes packets, ", kDuration.count(), " s per run");
+
+    for (const size_t readersCount : {1, 2, 4, 8}) {
+        cs::Framework::execute([&] { return print(readersCount, run(readersCount)); }, std::chrono::seconds(60), "Not all received packets are processed");
+    }
+
+    return 0;
+}
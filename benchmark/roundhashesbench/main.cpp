@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include <framework.hpp>
+
+#include <csnode/nodecore.hpp>
+#include <lib/system/random.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// the same as Consensus::MaxStageOneHashes and Consensus::MaxTrustedNodes
+constexpr size_t kRoundHashes = 101;
+constexpr size_t kTrusted = 10;
+constexpr size_t kRepeats = 20;
+
+// packets hash as it was: bytes vector ordered by std::map and searched by std::find
+struct VectorHash {
+    cs::Bytes bytes;
+
+    bool operator==(const VectorHash& other) const {
+        return bytes == other.bytes;
+    }
+
+    bool operator<(const VectorHash& other) const {
+        return bytes < other.bytes;
+    }
+};
+
+struct Hashes {
+    std::vector<cs::TransactionsPacketHash> inline_;
+    std::vector<VectorHash> vector;
+};
+
+Hashes makeHashes(size_t count) {
+    Hashes hashes;
+
+    for (size_t i = 0; i < count; ++i) {
+        cs::Hash hash;
+
+        for (auto& byte : hash) {
+            byte = cs::Random::generateValue<cs::Byte>(0, 255);
+        }
+
+        hashes.inline_.emplace_back(hash);
+        hashes.vector.push_back(VectorHash{cs::Bytes(hash.begin(), hash.end())});
+    }
+
+    return hashes;
+}
+
+// stage one candidates: table packets which are not in the round table, the least ones are taken
+template <typename Table, typename Hash>
+std::vector<Hash> vectorCandidates(const Table& table, const std::vector<Hash>& roundHashes) {
+    std::vector<Hash> candidates;
+
+    for (const auto& element : table) {
+        if (std::find(roundHashes.cbegin(), roundHashes.cend(), element.first) == roundHashes.cend()) {
+            candidates.push_back(element.first);
+
+            if (candidates.size() >= kRoundHashes) {
+                break;
+            }
+        }
+    }
+
+    return candidates;
+}
+
+std::vector<cs::TransactionsPacketHash> hashedCandidates(const cs::TransactionsPacketTable& table, const cs::PacketsHashes& roundHashes) {
+    const cs::PacketsHashesSet roundSet(roundHashes.cbegin(), roundHashes.cend());
+    std::vector<cs::TransactionsPacketHash> candidates;
+
+    for (const auto& element : table) {
+        if (candidates.size() >= kRoundHashes && !(element.first < candidates.front())) {
+            continue;
+        }
+
+        if (roundSet.find(element.first) != roundSet.cend()) {
+            continue;
+        }
+
+        candidates.push_back(element.first);
+        std::push_heap(candidates.begin(), candidates.end());
+
+        if (candidates.size() > kRoundHashes) {
+            std::pop_heap(candidates.begin(), candidates.end());
+            candidates.pop_back();
+        }
+    }
+
+    std::sort_heap(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+// stage three: every trusted node proposes candidates, most of them are the same
+template <typename Election, typename Hash>
+std::vector<Hash> elect(const std::vector<std::vector<Hash>>& proposals) {
+    Election election;
+
+    for (const auto& proposal : proposals) {
+        for (const auto& hash : proposal) {
+            ++election[hash];
+        }
+    }
+
+    std::vector<Hash> elected;
+
+    for (const auto& [hash, votes] : election) {
+        if (votes > kTrusted / 2) {
+            elected.push_back(hash);
+        }
+    }
+
+    std::sort(elected.begin(), elected.end());
+    return elected;
+}
+
+template <typename Table, typename Hash>
+void fill(Table& table, const std::vector<Hash>& hashes) {
+    for (const auto& hash : hashes) {
+        table.emplace(hash, cs::TransactionsPacket());
+    }
+}
+
+template <typename Table, typename Hash>
+size_t lookup(const Table& table, const std::vector<Hash>& roundHashes) {
+    size_t found = 0;
+
+    for (const auto& hash : roundHashes) {
+        found += table.find(hash) != table.end();
+    }
+
+    return found;
+}
+
+double microseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kRepeats;
+}
+
+bool run(size_t packets) {
+    const auto hashes = makeHashes(packets);
+
+    const cs::PacketsHashes roundInline(hashes.inline_.begin(), hashes.inline_.begin() + kRoundHashes);
+    const std::vector<VectorHash> roundVector(hashes.vector.begin(), hashes.vector.begin() + kRoundHashes);
+
+    double fillTime[2] = {};
+    double candidatesTime[2] = {};
+    double electionTime[2] = {};
+    size_t checks[2] = {};
+
+    for (size_t i = 0; i < kRepeats; ++i) {
+        // vector hashes in ordered containers
+        auto start = Clock::now();
+        std::map<VectorHash, cs::TransactionsPacket> vectorTable;
+        fill(vectorTable, hashes.vector);
+        checks[0] += lookup(vectorTable, roundVector);
+        fillTime[0] += microseconds(start);
+
+        start = Clock::now();
+        std::vector<std::vector<VectorHash>> vectorProposals(kTrusted, vectorCandidates(vectorTable, roundVector));
+        candidatesTime[0] += microseconds(start);
+
+        start = Clock::now();
+        checks[0] += elect<std::map<VectorHash, uint8_t>>(vectorProposals).size();
+        electionTime[0] += microseconds(start);
+
+        // inline hashes in hashed containers
+        start = Clock::now();
+        cs::TransactionsPacketTable inlineTable;
+        fill(inlineTable, hashes.inline_);
+        checks[1] += lookup(inlineTable, roundInline);
+        fillTime[1] += microseconds(start);
+
+        start = Clock::now();
+        std::vector<std::vector<cs::TransactionsPacketHash>> inlineProposals(kTrusted, hashedCandidates(inlineTable, roundInline));
+        candidatesTime[1] += microseconds(start);
+
+        start = Clock::now();
+        checks[1] += elect<std::unordered_map<cs::TransactionsPacketHash, uint8_t>>(inlineProposals).size();
+        electionTime[1] += microseconds(start);
+    }
+
+    const char* names[] = {"vector hash, ordered", "inline hash, hashed"};
+
+    for (size_t i = 0; i < 2; ++i) {
+        cs::Console::writeLine(names[i], " with ", packets, " packets: table ", static_cast<uint64_t>(fillTime[i]), " us, stage one candidates ",
+                               static_cast<uint64_t>(candidatesTime[i]), " us, election ", static_cast<uint64_t>(electionTime[i]), " us");
+    }
+
+    return checks[0] == checks[1];
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Round building cost by conveyer table size, ", kTrusted, " trusted nodes, ", kRoundHashes, " round hashes, ", kRepeats, " repeats");
+
+    for (const size_t packets : {size_t(1000), size_t(10000), size_t(50000)}) {
+        cs::Framework::execute([packets] { return run(packets); }, std::chrono::seconds(60), "Results of containers differ");
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <framework.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <cscrypto/cscrypto.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+#include <csnode/signaturecache.hpp>
+
+static constexpr size_t kBlocksCount = 200;
+static constexpr size_t kTransactionsPerBlock = 200;
+static constexpr size_t kWalletsCount = 100;
+
+struct Block {
+    std::vector<csdb::Transaction> transactions;
+    std::vector<cs::PublicKey> sources;
+};
+
+static std::vector<Block> makeBlocks() {
+    auto seed = cscrypto::keys_derivation::generateMasterSeed();
+
+    std::vector<std::pair<cs::PublicKey, cscrypto::PrivateKey>> wallets;
+    for (size_t i = 0; i < kWalletsCount; ++i) {
+        wallets.push_back(cscrypto::keys_derivation::deriveKeyPair(seed, static_cast<uint32_t>(i)));
+    }
+
+    std::vector<Block> blocks(kBlocksCount);
+
+    for (size_t b = 0; b < kBlocksCount; ++b) {
+        for (size_t i = 0; i < kTransactionsPerBlock; ++i) {
+            const auto& source = wallets[(b + i) % wallets.size()];
+            const auto& target = wallets[(b + i + 1) % wallets.size()];
+
+            csdb::Transaction transaction;
+            transaction.set_innerID(static_cast<int64_t>(b * kTransactionsPerBlock + i));
+            transaction.set_source(csdb::Address::from_public_key(source.first));
+            transaction.set_target(csdb::Address::from_public_key(target.first));
+            transaction.set_currency(1);
+            transaction.set_amount(csdb::Amount(1, 0));
+
+            const auto bytes = transaction.to_byte_stream_for_sig();
+            transaction.set_signature(cscrypto::generateSignature(source.second, bytes.data(), bytes.size()));
+
+            blocks[b].transactions.push_back(transaction);
+            blocks[b].sources.push_back(source.first);
+        }
+    }
+
+    return blocks;
+}
+
+static bool validateBlocks(cs::SignatureCache& cache, const std::vector<Block>& blocks) {
+    for (const auto& block : blocks) {
+        for (size_t i = 0; i < block.transactions.size(); ++i) {
+            if (!cache.verify(block.transactions[i], block.sources[i])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// warm cache means transactions were checked when accepted by API and during round validation
+static bool run(const std::string& name, const std::vector<Block>& blocks, size_t capacity, bool warm) {
+    cs::SignatureCache cache(capacity);
+
+    if (warm && !validateBlocks(cache, blocks)) {
+        return false;
+    }
+
+    const auto before = cache.stats();
+    const auto start = std::chrono::steady_clock::now();
+
+    const bool valid = validateBlocks(cache, blocks);
+
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    const auto after = cache.stats();
+
+    cs::Console::writeLine(name, ": ", valid ? "valid" : "INVALID", ", ", static_cast<double>(duration) / blocks.size(), " us per block of ",
+                           kTransactionsPerBlock, " transactions, hits ", after.hits - before.hits, ", misses ", after.misses - before.misses);
+
+    return valid;
+}
+
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    cs::Console::writeLine("Sign ", kBlocksCount * kTransactionsPerBlock, " transactions");
+    const auto blocks = cs::Framework::execute(makeBlocks, std::chrono::seconds(600));
+
+    cs::Framework::execute([&] { return run("no cache", blocks, 0, false); }, std::chrono::seconds(600), "Validation failed");
+    cs::Framework::execute([&] { return run("cold cache", blocks, cs::SignatureCache::kDefaultCapacity, false); }, std::chrono::seconds(600), "Validation failed");
+    cs::Framework::execute([&] { return run("warm cache", blocks, cs::SignatureCache::kDefaultCapacity, true); }, std::chrono::seconds(600), "Validation failed");
+
+    // a cache smaller than the working set falls back to verification for evicted entries
+    cs::Framework::execute([&] { return run("warm small cache", blocks, kTransactionsPerBlock * kBlocksCount / 4, true); }, std::chrono::seconds(600),
+                           "Validation failed");
+
+    return 0;
+}
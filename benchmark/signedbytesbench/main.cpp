@@ -0,0 +1,112 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <framework.hpp>
+
+#include <cscrypto/cscrypto.hpp>
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+
+#include <csnode/signaturecache.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kTransactions = 10000;
+constexpr size_t kWallets = 100;
+
+// checks after API ingress: IterValidator of trusted node and block validator
+constexpr size_t kValidations = 2;
+
+struct Signed {
+    std::vector<csdb::Transaction> transactions;
+    std::vector<cs::PublicKey> keys;
+};
+
+Signed makeTransactions() {
+    auto seed = cscrypto::keys_derivation::generateMasterSeed();
+    std::vector<std::pair<cs::PublicKey, cscrypto::PrivateKey>> wallets;
+
+    for (size_t i = 0; i < kWallets; ++i) {
+        wallets.push_back(cscrypto::keys_derivation::deriveKeyPair(seed, static_cast<uint32_t>(i)));
+    }
+
+    Signed result;
+
+    for (size_t i = 0; i < kTransactions; ++i) {
+        const auto& source = wallets[i % kWallets];
+
+        csdb::Transaction transaction;
+        transaction.set_innerID(static_cast<int64_t>(i + 1));
+        transaction.set_source(csdb::Address::from_public_key(source.first));
+        transaction.set_target(csdb::Address::from_public_key(wallets[(i + 1) % kWallets].first));
+        transaction.set_currency(1);
+        transaction.set_amount(csdb::Amount(1, 0));
+        transaction.add_user_field(1, std::string(100, 'a'));
+
+        const auto bytes = transaction.to_byte_stream_for_sig();
+        transaction.set_signature(cscrypto::generateSignature(source.second, bytes.data(), bytes.size()));
+
+        result.transactions.push_back(transaction.clone());
+        result.keys.push_back(source.first);
+    }
+
+    return result;
+}
+
+// kept bytes are dropped before every check to get the former cost of building them
+bool run(Signed& data, bool isKept) {
+    cs::SignatureCache cache;
+    size_t verified = 0;
+
+    auto check = [&] {
+        for (size_t i = 0; i < data.transactions.size(); ++i) {
+            auto& transaction = data.transactions[i];
+
+            if (!isKept) {
+                transaction.set_innerID(transaction.innerID());
+            }
+
+            verified += cache.verify(transaction, data.keys[i]);
+        }
+    };
+
+    // API ingress verifies signatures, the checks after it are cache hits
+    auto start = Clock::now();
+    check();
+    const double ingress = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+
+    for (size_t i = 0; i < kValidations; ++i) {
+        check();
+    }
+
+    const double validations = std::chrono::duration<double>(Clock::now() - start).count();
+
+    cs::Console::writeLine(isKept ? "kept" : "rebuilt", " signed bytes: ingress ", static_cast<uint64_t>(kTransactions / ingress), " transactions/s, validators ",
+                           static_cast<uint64_t>(kTransactions * kValidations / validations), " transactions/s, hits ", cache.stats().hits);
+
+    return verified == kTransactions * (kValidations + 1);
+}
+}  // namespace
+
+int main() {
+    if (!cscrypto::cryptoInit()) {
+        cs::Console::writeLine("Can not init crypto");
+        return 1;
+    }
+
+    cs::Console::writeLine("Signature checks of ", kTransactions, " transactions by API ingress and ", kValidations, " validators");
+
+    auto data = makeTransactions();
+
+    for (const bool isKept : {false, true}) {
+        cs::Framework::execute([&, isKept] { return run(data, isKept); }, std::chrono::seconds(600), "Signatures are not verified");
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include <framework.hpp>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+
+#include <csnode/transactionspacket.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kTransactions = 1 << 18;
+
+cs::TransactionsPacket makePacket(size_t size) {
+    cs::TransactionsPacket packet;
+    cs::PublicKey key{};
+
+    for (size_t i = 0; i < size; ++i) {
+        key[0] = static_cast<cs::Byte>(i);
+
+        csdb::Transaction transaction;
+        transaction.set_innerID(static_cast<int64_t>(i + 1));
+        transaction.set_source(csdb::Address::from_public_key(key));
+        transaction.set_target(csdb::Address::from_wallet_id(static_cast<csdb::Address::WalletId>(i)));
+        transaction.set_currency(1);
+        transaction.set_amount(csdb::Amount(static_cast<int32_t>(i), 0));
+        transaction.add_user_field(0, std::string(64, 'a'));
+        packet.addTransaction(transaction);
+    }
+
+    packet.makeHash();
+    return packet;
+}
+
+// the former behaviour: transactions are decoded on receiving and serialized again for hash and every sending
+cs::TransactionsPacket receiveDecoded(const cs::Bytes& binary, cs::TransactionsPacketHash& hash) {
+    auto packet = cs::TransactionsPacket::fromBinary(binary);
+    packet.transactions();
+    hash = cs::TransactionsPacketHash::calcFromData(packet.toBinary(cs::TransactionsPacket::Serialization::Transactions));
+    return packet;
+}
+
+template <typename Func>
+double measure(size_t count, Func func) {
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < count; ++i) {
+        func();
+    }
+
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / static_cast<double>(count);
+}
+
+bool run(size_t size) {
+    const auto origin = makePacket(size);
+    const auto binary = origin.toBinary();
+    const size_t count = std::max(kTransactions / size, size_t(16));
+
+    size_t sink = 0;
+    bool isSame = true;
+
+    // serialize
+    const auto kept = cs::TransactionsPacket::fromBinary(binary);
+    const double keptSerialize = measure(count, [&] { sink += kept.toBinary().size(); });
+
+    auto changed = cs::TransactionsPacket::fromBinary(binary);
+    const double changedSerialize = measure(count, [&] {
+        changed.transactions();
+        sink += changed.toBinary().size();
+    });
+
+    // receive and hash
+    const double keptHash = measure(count, [&] { isSame &= cs::TransactionsPacket::fromBinary(binary).hash() == origin.hash(); });
+    const double decodedHash = measure(count, [&] {
+        cs::TransactionsPacketHash hash;
+        receiveDecoded(binary, hash);
+        isSame &= hash == origin.hash();
+    });
+
+    // receive and send to neighbours
+    const double keptForward = measure(count, [&] { isSame &= cs::TransactionsPacket::fromBinary(binary).toBinary() == binary; });
+    const double decodedForward = measure(count, [&] {
+        cs::TransactionsPacketHash hash;
+        auto packet = receiveDecoded(binary, hash);
+        packet.transactions();
+        isSame &= packet.toBinary() == binary;
+    });
+
+    cs::Console::writeLine(size, " transactions (", binary.size(), " bytes), us per packet, kept / decoded:");
+    cs::Console::writeLine("    serialize ", keptSerialize, " / ", changedSerialize, ", hash ", keptHash, " / ", decodedHash, ", forward ", keptForward, " / ",
+                           decodedForward, " (", sink % 2, ")");
+
+    return isSame;
+}
+}  // namespace
+
+int main() {
+    cs::Console::writeLine("Transactions packet serialize, hash and forward cost with kept binary representation and with decoded transactions");
+
+    for (const size_t size : {size_t(1), size_t(10), size_t(100), size_t(1000)}) {
+        cs::Framework::execute([size] { return run(size); }, std::chrono::seconds(600), "Packets differ");
+    }
+
+    return 0;
+}
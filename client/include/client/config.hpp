@@ -8,8 +8,12 @@
 #include <boost/log/utility/setup/settings.hpp>
 #include <boost/program_options.hpp>
 
+#include <csdb/storage.hpp> // using csdb::Storage::kDefaultPoolsCacheLimit constant
+
 #include <lib/system/common.hpp>
 
+#include <csnode/blockscache.hpp> // using cs::BlocksCache::kDefaultMemoryLimit constant
+
 #include <net/neighbourhood.hpp> // using Neighbourhood::MaxNeighbours constant
 
 namespace po = boost::program_options;
@@ -27,8 +31,13 @@ const std::string DEFAULT_PATH_TO_PRIVATE_KEY = "NodePrivate.txt";
 
 const uint32_t DEFAULT_MAX_NEIGHBOURS = Neighbourhood::MaxNeighbours;
 const uint32_t DEFAULT_CONNECTION_BANDWIDTH = 1 << 19;
-const uint32_t DEFAULT_OBSERVER_WAIT_TIME = 5 * 60 * 1000;  // ms
-const size_t DEFAULT_CONVEYER_SEND_CACHE_VALUE = 10;        // rounds
+const uint32_t DEFAULT_OBSERVER_WAIT_TIME = 5 * 60 * 1000;    // ms
+const size_t DEFAULT_CONVEYER_SEND_CACHE_VALUE = 10;          // rounds
+const size_t DEFAULT_POOLS_CACHE_SIZE = csdb::Storage::kDefaultPoolsCacheLimit;  // bytes
+const size_t DEFAULT_CACHED_BLOCKS_SIZE = cs::BlocksCache::kDefaultMemoryLimit;  // bytes
+const size_t DEFAULT_READERS_COUNT = 1;                       // sockets on input port
+const uint16_t DEFAULT_METRICS_PORT = 0;                      // loopback port of Prometheus metrics : 0-disabled
+const size_t DEFAULT_ROUND_TRACE_EVENTS = 0;                  // capacity of round timeline, served by metrics port : 0-disabled
 
 using Port = short unsigned;
 
@@ -54,9 +63,9 @@ struct PoolSyncData {
     bool oneReplyBlock = true;                      // true: sendBlockRequest one pool at a time. false: equal to number of pools requested.
     bool isFastMode = false;                        // true: is silent mode synchro(sync up to the current round). false: normal mode
     uint8_t blockPoolsCount = 25;                   // max block count in one request: cannot be 0
-    uint8_t requestRepeatRoundCount = 20;           // round count for repeat request : 0-never
-    uint8_t neighbourPacketsCount = 10;             // packet count for connect another neighbor : 0-never
-    uint16_t sequencesVerificationFrequency = 350;  // sequences received verification frequency : 0-never; 1-once per round: other- in ms;
+    uint8_t requestRepeatRoundCount = 20;           // not used: requests are repeated by adaptive timeouts of sync window
+    uint8_t neighbourPacketsCount = 10;             // not used: timed out sequences are requested from any other neighbour
+    uint16_t sequencesVerificationFrequency = 350;  // requests timeout check period in ms, 0 or 1 - default period
 };
 
 struct ApiData {
@@ -72,6 +81,11 @@ struct ApiData {
     int ajaxServerReceiveTimeout = 30000;
     std::string executorHost{ "localhost" };
     std::string executorCmdLine{};
+    bool nonblockingServer = false;                 // true: event-driven binary API server, clients must use framed transport
+    int serverWorkerThreads = 16;                   // nonblocking server request handlers count
+    int serverIoThreads = 1;                        // nonblocking server event loops count
+    int serverMaxConnections = 0;                   // concurrent binary API connections limit : 0-unlimited
+    int responseCacheSize = 64 * 1024 * 1024;       // read-heavy calls responses cache budget in bytes : 0-disabled
 };
 
 class Config {
@@ -122,6 +136,14 @@ public:
         return twoSockets_;
     }
 
+    // input port is shared by sockets with SO_REUSEPORT, each one is read by its own thread
+    size_t getReadersCount() const {
+        return readersCount_;
+    }
+    bool pinReaders() const {
+        return pinReaders_;
+    }
+
     uint32_t getMaxNeighbours() const {
         return maxNeighbours_;
     }
@@ -180,6 +202,23 @@ public:
         return conveyerSendCacheValue_;
     }
 
+    size_t poolsCacheSize() const {
+        return poolsCacheSize_;
+    }
+
+    size_t cachedBlocksSize() const {
+        return cachedBlocksSize_;
+    }
+
+    // metrics are served on loopback interface only
+    uint16_t metricsPort() const {
+        return metricsPort_;
+    }
+
+    size_t roundTraceEvents() const {
+        return roundTraceEvents_;
+    }
+
     void swap(Config& config);
 
 private:
@@ -233,6 +272,14 @@ private:
     uint64_t observerWaitTime_;
 
     size_t conveyerSendCacheValue_;
+    size_t poolsCacheSize_ = DEFAULT_POOLS_CACHE_SIZE;
+    size_t cachedBlocksSize_ = DEFAULT_CACHED_BLOCKS_SIZE;
+
+    size_t readersCount_ = DEFAULT_READERS_COUNT;
+    bool pinReaders_ = false;
+
+    uint16_t metricsPort_ = DEFAULT_METRICS_PORT;
+    size_t roundTraceEvents_ = DEFAULT_ROUND_TRACE_EVENTS;
 
     friend bool operator==(const Config&, const Config&);
 };
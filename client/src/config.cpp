@@ -1,4 +1,5 @@
 /* Send blaming letters to @yrtimd */
+#include <algorithm>
 #include <iostream>
 #include <regex>
 #include <stdexcept>
@@ -18,6 +19,7 @@
 #include <lib/system/utils.hpp>
 
 #include <cscrypto/cscrypto.hpp>
+#include <net/pacmans.hpp>
 #include "config.hpp"
 
 #ifdef _WIN32
@@ -44,6 +46,12 @@ const std::string PARAM_NAME_MAX_NEIGHBOURS = "max_neighbours";
 const std::string PARAM_NAME_CONNECTION_BANDWIDTH = "connection_bandwidth";
 const std::string PARAM_NAME_OBSERVER_WAIT_TIME = "observer_wait_time";
 const std::string PARAM_NAME_CONVEYER_SEND_CACHE = "conveyer_send_cache_value";
+const std::string PARAM_NAME_POOLS_CACHE_SIZE = "pools_cache_size";
+const std::string PARAM_NAME_CACHED_BLOCKS_SIZE = "cached_blocks_size";
+const std::string PARAM_NAME_READERS_COUNT = "readers_count";
+const std::string PARAM_NAME_PIN_READERS = "pin_readers";
+const std::string PARAM_NAME_METRICS_PORT = "metrics_port";
+const std::string PARAM_NAME_ROUND_TRACE_EVENTS = "round_trace_events";
 
 const std::string PARAM_NAME_IP = "ip";
 const std::string PARAM_NAME_PORT = "port";
@@ -67,6 +75,11 @@ const std::string PARAM_NAME_AJAX_SERVER_SEND_TIMEOUT = "ajax_server_send_timeou
 const std::string PARAM_NAME_AJAX_SERVER_RECEIVE_TIMEOUT = "ajax_server_receive_timeout";
 const std::string PARAM_NAME_EXECUTOR_IP = "executor_ip";
 const std::string PARAM_NAME_EXECUTOR_CMDLINE = "executor_command";
+const std::string PARAM_NAME_NONBLOCKING_SERVER = "nonblocking_server";
+const std::string PARAM_NAME_SERVER_WORKER_THREADS = "server_worker_threads";
+const std::string PARAM_NAME_SERVER_IO_THREADS = "server_io_threads";
+const std::string PARAM_NAME_SERVER_MAX_CONNECTIONS = "server_max_connections";
+const std::string PARAM_NAME_RESPONSE_CACHE_SIZE = "response_cache_size";
 
 const std::string ARG_NAME_CONFIG_FILE = "config-file";
 const std::string ARG_NAME_DB_PATH = "db-path";
@@ -689,6 +702,15 @@ Config Config::readFromFile(const std::string& fileName) {
         result.connectionBandwidth_ = params.count(PARAM_NAME_CONNECTION_BANDWIDTH) ? params.get<uint64_t>(PARAM_NAME_CONNECTION_BANDWIDTH) : DEFAULT_CONNECTION_BANDWIDTH;
         result.observerWaitTime_ = params.count(PARAM_NAME_OBSERVER_WAIT_TIME) ? params.get<uint64_t>(PARAM_NAME_OBSERVER_WAIT_TIME) : DEFAULT_OBSERVER_WAIT_TIME;
         result.conveyerSendCacheValue_ = params.count(PARAM_NAME_CONVEYER_SEND_CACHE) ? params.get<size_t>(PARAM_NAME_CONVEYER_SEND_CACHE) : DEFAULT_CONVEYER_SEND_CACHE_VALUE;
+        result.poolsCacheSize_ = params.count(PARAM_NAME_POOLS_CACHE_SIZE) ? params.get<size_t>(PARAM_NAME_POOLS_CACHE_SIZE) : DEFAULT_POOLS_CACHE_SIZE;
+        result.cachedBlocksSize_ = params.count(PARAM_NAME_CACHED_BLOCKS_SIZE) ? params.get<size_t>(PARAM_NAME_CACHED_BLOCKS_SIZE) : DEFAULT_CACHED_BLOCKS_SIZE;
+
+        result.readersCount_ = params.count(PARAM_NAME_READERS_COUNT) ? params.get<size_t>(PARAM_NAME_READERS_COUNT) : DEFAULT_READERS_COUNT;
+        result.readersCount_ = std::clamp(result.readersCount_, size_t(1), IPacMan::MaxReaders);
+        result.pinReaders_ = params.count(PARAM_NAME_PIN_READERS) && params.get<std::string>(PARAM_NAME_PIN_READERS) == "true";
+
+        result.metricsPort_ = params.count(PARAM_NAME_METRICS_PORT) ? params.get<uint16_t>(PARAM_NAME_METRICS_PORT) : DEFAULT_METRICS_PORT;
+        result.roundTraceEvents_ = params.count(PARAM_NAME_ROUND_TRACE_EVENTS) ? params.get<size_t>(PARAM_NAME_ROUND_TRACE_EVENTS) : DEFAULT_ROUND_TRACE_EVENTS;
 
         result.nType_ = getFromMap(params.get<std::string>(PARAM_NAME_NODE_TYPE), NODE_TYPES_MAP);
 
@@ -817,6 +839,11 @@ void Config::readApiData(const boost::property_tree::ptree& config) {
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_AJAX_SERVER_SEND_TIMEOUT, apiData_.ajaxServerSendTimeout);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_AJAX_SERVER_RECEIVE_TIMEOUT, apiData_.ajaxServerReceiveTimeout);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_APIEXEC_PORT, apiData_.apiexecPort);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_NONBLOCKING_SERVER, apiData_.nonblockingServer);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_SERVER_WORKER_THREADS, apiData_.serverWorkerThreads);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_SERVER_IO_THREADS, apiData_.serverIoThreads);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_SERVER_MAX_CONNECTIONS, apiData_.serverMaxConnections);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_RESPONSE_CACHE_SIZE, apiData_.responseCacheSize);
 
     if (data.count(PARAM_NAME_EXECUTOR_IP) > 0) {
         apiData_.executorHost = data.get<std::string>(PARAM_NAME_EXECUTOR_IP);
@@ -887,7 +914,12 @@ bool operator==(const ApiData& lhs, const ApiData& rhs) {
            lhs.ajaxServerSendTimeout == rhs.ajaxServerSendTimeout &&
            lhs.ajaxServerReceiveTimeout == rhs.ajaxServerReceiveTimeout &&
            lhs.executorHost == rhs.executorHost &&
-           lhs.executorCmdLine == rhs.executorCmdLine;
+           lhs.executorCmdLine == rhs.executorCmdLine &&
+           lhs.nonblockingServer == rhs.nonblockingServer &&
+           lhs.serverWorkerThreads == rhs.serverWorkerThreads &&
+           lhs.serverIoThreads == rhs.serverIoThreads &&
+           lhs.serverMaxConnections == rhs.serverMaxConnections &&
+           lhs.responseCacheSize == rhs.responseCacheSize;
 }
 
 bool operator!=(const ApiData& lhs, const ApiData& rhs) {
@@ -917,7 +949,13 @@ bool operator==(const Config& lhs, const Config& rhs) {
            lhs.alwaysExecuteContracts_ == rhs.alwaysExecuteContracts_ &&
            lhs.recreateIndex_ == rhs.recreateIndex_ &&
            lhs.observerWaitTime_ == rhs.observerWaitTime_ &&
-           lhs.conveyerSendCacheValue_ == rhs.conveyerSendCacheValue_;
+           lhs.conveyerSendCacheValue_ == rhs.conveyerSendCacheValue_ &&
+           lhs.poolsCacheSize_ == rhs.poolsCacheSize_ &&
+           lhs.cachedBlocksSize_ == rhs.cachedBlocksSize_ &&
+           lhs.readersCount_ == rhs.readersCount_ &&
+           lhs.pinReaders_ == rhs.pinReaders_ &&
+           lhs.metricsPort_ == rhs.metricsPort_ &&
+           lhs.roundTraceEvents_ == rhs.roundTraceEvents_;
 }
 
 bool operator!=(const Config& lhs, const Config& rhs) {
@@ -8,13 +8,12 @@
 
 #include <functional>
 #include <string>
+#include <type_traits>
 
 #include <boost/functional/hash.hpp>
 
 #include <lib/system/common.hpp>
 
-#include <csdb/internal/shared_data.hpp>
-#include <csdb/internal/shared_data_ptr_implementation.hpp>
 #include <csdb/internal/types.hpp>
 
 namespace csdb {
@@ -24,11 +23,20 @@ class obstream;
 class ibstream;
 }  // namespace priv
 
+/**
+ * @brief Public key or wallet id of account.
+ *
+ * Address is kept inline and is trivially copyable, so copies of it as a key of containers and in
+ * transactions do not allocate or touch reference counters. Hash is calculated once on assignment.
+ */
 class Address {
-    SHARED_DATA_CLASS_DECLARE(Address)
 public:
     using WalletId = csdb::internal::WalletId;
 
+    Address() noexcept;
+
+    Address clone() const noexcept;
+
     bool is_valid() const noexcept;
     bool is_public_key() const noexcept;
     bool is_wallet_id() const noexcept;
@@ -63,21 +71,27 @@ private:
     friend class ::csdb::priv::obstream;
     friend class ::csdb::priv::ibstream;
     friend class Storage;
-};
 
-class Address::priv : public ::csdb::internal::shared_data {
+    void update_hash() noexcept;
+
     union {
         cs::PublicKey public_key;
         WalletId wallet_id;
     } data_{};
 
+    size_t hash_;
     bool is_wallet_id_ = false;
+};
 
-    DEFAULT_PRIV_CLONE()
+static_assert(std::is_trivially_copyable_v<Address>, "Address is copied as a value");
 
-    friend class ::csdb::Address;
-};
-SHARED_DATA_CLASS_IMPLEMENTATION_INLINE(Address)
+inline Address Address::clone() const noexcept {
+    return *this;
+}
+
+inline size_t Address::calcHash() const noexcept {
+    return hash_;
+}
 
 inline bool Address::operator!=(const Address &other) const noexcept {
     return !operator==(other);
@@ -170,6 +170,7 @@ public:
     const csdb::Amount& roundCost() const noexcept;
     const std::vector<cs::Signature>& roundConfirmations() const noexcept;
     size_t hashingLength() const noexcept;
+    size_t binary_size() const noexcept;
 
     void set_version(uint8_t version) noexcept;
     void set_previous_hash(PoolHash previous_hash) noexcept;
@@ -98,6 +98,18 @@ public:
         uint64_t poolsProcessed;
     };
 
+    /// Default pools cache budget in serialized bytes
+    static constexpr size_t kDefaultPoolsCacheLimit = 256 * 1024 * 1024;
+
+    struct PoolsCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t bytes = 0;
+        size_t count = 0;
+        size_t limit = 0;
+    };
+
     /**
      * @brief Callback для операции открытия
      * @return true, если операцию необходимо прервать.
@@ -311,6 +323,24 @@ public:
 
     csdb::PoolHash pool_hash(cs::Sequence sequence) const;
 
+    /**
+     * Sets pools cache budget in serialized bytes, least recently used pools
+     * are evicted when budget exceeds. Zero value disables cache.
+     *
+     * @param   bytes   The cache budget.
+     */
+    void set_pools_cache_limit(size_t bytes);
+
+    /**
+     * Gets pools cache hit/miss/eviction counters and current occupancy.
+     */
+    PoolsCacheStats pools_cache_stats() const;
+
+    /**
+     * Gets count of pools waiting to be written by write thread.
+     */
+    size_t write_queue_size() const;
+
 public signals:
     const ReadBlockSignal& readBlockEvent() const;
 
@@ -121,10 +121,23 @@ public:
 
     static Transaction from_byte_stream(const char* data, size_t m_size);
     std::vector<uint8_t> to_byte_stream() const;
+
+    /**
+     * @brief Signed bytes and their hash are built once and kept until a signed field is changed,
+     *        signature and counted fee are not signed
+     */
     std::vector<uint8_t> to_byte_stream_for_sig() const;
+    cs::Hash hash_for_sig() const;
 
     bool verify_signature(const cs::PublicKey& public_key) const;
 
+    /**
+     * @brief Moves stream past a serialized transaction without decoding it
+     * @return false if stream does not keep a transaction exactly in the form it is serialized to,
+     *         such transaction must be decoded and serialized again
+     */
+    static bool skip(::csdb::priv::ibstream& is);
+
     /**
      * @brief Добавляет дополнительное произвольное поле к транзакции
      * @param[in] id    Идентификатор дополнительного поля
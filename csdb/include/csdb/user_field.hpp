@@ -87,8 +87,10 @@ private:
     void put(::csdb::priv::obstream&) const;
     void put_for_sig(::csdb::priv::obstream&) const;
     bool get(::csdb::priv::ibstream&);
+    static bool skip(::csdb::priv::ibstream&);
     friend class ::csdb::priv::obstream;
     friend class ::csdb::priv::ibstream;
+    friend class Transaction;
 };
 
 class UserField::priv : public ::csdb::internal::shared_data {
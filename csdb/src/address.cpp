@@ -12,63 +12,69 @@
 
 namespace csdb {
 
+namespace {
+// hash of default address, it is not calculated on every construction, addresses may be constructed statically
+size_t emptyHash() noexcept {
+    static const size_t hash = boost::hash_value(cs::PublicKey{});
+    return hash;
+}
+}  // namespace
+
+Address::Address() noexcept
+: hash_(emptyHash()) {
+}
+
+void Address::update_hash() noexcept {
+    if (is_public_key()) {
+        hash_ = boost::hash_value(data_.public_key);
+    }
+    else {
+        hash_ = boost::hash_value(data_.wallet_id);
+    }
+}
+
 bool Address::is_valid() const noexcept {
     return is_public_key() || is_wallet_id();
 }
 
 bool Address::is_public_key() const noexcept {
-    return !d->is_wallet_id_;
+    return !is_wallet_id_;
 }
 
 bool Address::is_wallet_id() const noexcept {
-    return d->is_wallet_id_;
+    return is_wallet_id_;
 }
 
 bool Address::operator==(const Address& other) const noexcept {
-    if (d == other.d) {
-        return true;
-    }
-
-    if (is_public_key() != other.is_public_key()) {
+    if (hash_ != other.hash_ || is_public_key() != other.is_public_key()) {
         return false;
     }
 
     if (is_public_key()) {
-        return d->data_.public_key == other.d->data_.public_key;
+        return data_.public_key == other.data_.public_key;
     }
-    return d->data_.wallet_id == other.d->data_.wallet_id;
+    return data_.wallet_id == other.data_.wallet_id;
 }
 
 bool Address::operator<(const Address& other) const noexcept {
-    if (d == other.d) {
-        return false;
-    }
-
-    if (d->is_wallet_id_ && other.d->is_wallet_id_) {
-        return d->data_.wallet_id < other.d->data_.wallet_id;
+    if (is_wallet_id_ && other.is_wallet_id_) {
+        return data_.wallet_id < other.data_.wallet_id;
     }
-    if (!d->is_wallet_id_ && !other.d->is_wallet_id_) {
-        return d->data_.public_key < other.d->data_.public_key;
+    if (!is_wallet_id_ && !other.is_wallet_id_) {
+        return data_.public_key < other.data_.public_key;
     }
-    if (d->is_wallet_id_ && !other.d->is_wallet_id_) {
-        return d->data_.public_key < other.d->data_.public_key;
+    if (is_wallet_id_ && !other.is_wallet_id_) {
+        return data_.public_key < other.data_.public_key;
     }
-    if (!d->is_wallet_id_ && other.d->is_wallet_id_) {
-        return d->data_.public_key < other.d->data_.public_key;
+    if (!is_wallet_id_ && other.is_wallet_id_) {
+        return data_.public_key < other.data_.public_key;
     }
     return false;
 }
 
-size_t Address::calcHash() const noexcept {
-    if (is_public_key()) {
-        return boost::hash_value(d->data_.public_key);
-    }
-    return boost::hash_value(d->data_.wallet_id);
-}
-
 ::std::string Address::to_string() const noexcept {
     if (is_public_key()) {
-        return internal::to_hex(cs::Bytes(d->data_.public_key.begin(), d->data_.public_key.end()));
+        return internal::to_hex(cs::Bytes(data_.public_key.begin(), data_.public_key.end()));
     }
     if (is_wallet_id()) {
         return std::to_string(wallet_id());
@@ -82,8 +88,9 @@ Address Address::from_string(const ::std::string& val) {
     if (val.size() == 2 * ::csdb::priv::crypto::public_key_size) {
         const cs::Bytes data = ::csdb::internal::from_hex(val);
         if (::csdb::priv::crypto::public_key_size == data.size()) {
-            memcpy(res.d->data_.public_key.data(), data.data(), ::csdb::priv::crypto::public_key_size);
-            res.d->is_wallet_id_ = false;
+            memcpy(res.data_.public_key.data(), data.data(), ::csdb::priv::crypto::public_key_size);
+            res.is_wallet_id_ = false;
+            res.update_hash();
         }
     }
     else {
@@ -91,7 +98,6 @@ Address Address::from_string(const ::std::string& val) {
             if (!val.empty()) {
                 WalletId id = static_cast<WalletId>(std::stol(val));
                 res = from_wallet_id(id);
-                res.d->is_wallet_id_ = true;
             }
         }
         catch (...) {
@@ -103,12 +109,12 @@ Address Address::from_string(const ::std::string& val) {
 }
 
 const cs::PublicKey& Address::public_key() const noexcept {
-    return d->data_.public_key;
+    return data_.public_key;
 }
 
 Address::WalletId Address::wallet_id() const noexcept {
     if (is_wallet_id()) {
-        return d->data_.wallet_id;
+        return data_.wallet_id;
     }
     return static_cast<Address::WalletId>(-1);
 }
@@ -117,8 +123,9 @@ Address Address::from_public_key(const cs::Bytes& key) {
     Address res;
 
     if (::csdb::priv::crypto::public_key_size == key.size()) {
-        std::copy(key.begin(), key.end(), res.d->data_.public_key.data());
-        res.d->is_wallet_id_ = false;
+        std::copy(key.begin(), key.end(), res.data_.public_key.data());
+        res.is_wallet_id_ = false;
+        res.update_hash();
     }
 
     return res;
@@ -126,45 +133,52 @@ Address Address::from_public_key(const cs::Bytes& key) {
 
 Address Address::from_public_key(const cs::PublicKey& key) {
     Address res;
-    res.d->data_.public_key = key;
-    res.d->is_wallet_id_ = false;
+    res.data_.public_key = key;
+    res.is_wallet_id_ = false;
+    res.update_hash();
 
     return res;
 }
 
 Address Address::from_public_key(const char* key) {
     Address res;
-    std::copy(key, key + ::csdb::priv::crypto::public_key_size, res.d->data_.public_key.begin());
-    res.d->is_wallet_id_ = false;
+    std::copy(key, key + ::csdb::priv::crypto::public_key_size, res.data_.public_key.begin());
+    res.is_wallet_id_ = false;
+    res.update_hash();
     return res;
 }
 
 std::string Address::to_api_addr() const {
-    return std::string(d->data_.public_key.begin(), d->data_.public_key.end());
+    return std::string(data_.public_key.begin(), data_.public_key.end());
 }
 
 Address Address::from_wallet_id(WalletId id) {
     Address res;
-    res.d->data_.wallet_id = id;
-    res.d->is_wallet_id_ = true;
+    res.data_.wallet_id = id;
+    res.is_wallet_id_ = true;
+    res.update_hash();
     return res;
 }
 
 void Address::put(::csdb::priv::obstream& os) const {
     if (is_public_key()) {
-        os.put(d->data_.public_key);
+        os.put(data_.public_key);
     }
     else {
-        os.put(d->data_.wallet_id);
+        os.put(data_.wallet_id);
     }
 }
 
 bool Address::get(::csdb::priv::ibstream& is) {
     if (is.size() == ::csdb::priv::crypto::public_key_size) {
-        bool ok = is.get(d->data_.public_key);
+        bool ok = is.get(data_.public_key);
+        update_hash();
         return ok;
     }
-    return is.get(d->data_.wallet_id);
+
+    bool ok = is.get(data_.wallet_id);
+    update_hash();
+    return ok;
 }
 
 }  // namespace csdb
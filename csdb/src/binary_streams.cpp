@@ -33,6 +33,16 @@ bool ibstream::get(void *buf, size_t size) {
     return true;
 }
 
+bool ibstream::skip(size_t size) {
+    if (size > size_) {
+        return false;
+    }
+
+    size_ -= size;
+    data_ = static_cast<const void *>(static_cast<const uint8_t *>(data_) + size);
+    return true;
+}
+
 bool ibstream::get(std::string &value) {
     uint32_t size;
     if (!get(size)) {
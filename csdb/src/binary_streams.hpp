@@ -72,6 +72,9 @@ public:
     bool get(std::string& value);
     bool get(cs::Bytes& value);
 
+    // moves past size bytes without reading them
+    bool skip(size_t size);
+
     template <typename T>
     typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, bool>::type get(T& value);
 
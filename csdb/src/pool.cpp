@@ -583,6 +583,10 @@ size_t Pool::hashingLength() const noexcept {
     return d->hashingLength_;
 }
 
+size_t Pool::binary_size() const noexcept {
+    return d->binary_representation_.size();
+}
+
 Storage Pool::storage() const noexcept {
     return Storage(d->storage_);
 }
@@ -14,6 +14,7 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
 
 #include <lib/system/logger.hpp>
 #include <lib/system/utils.hpp>
@@ -152,8 +153,10 @@ private:
         cs::Sequence seq; struct bySequence {};
         PoolHash hash;  struct byHash {};
         Pool pool;
+        size_t size; struct byUsage {};
     };
 
+    // sequenced index keeps recency order: front is the most recently used element
     typedef multi_index_container<
         PoolElement,
         indexed_by<
@@ -166,18 +169,102 @@ private:
                 tag<PoolElement::byHash>, member<
                     PoolElement, PoolHash, &PoolElement::hash
                 >
+            >,
+            sequenced<
+                tag<PoolElement::byUsage>
             >
         >
     > PoolCache;
+
     PoolCache pools_cache;
-    static const size_t cacheSize = 10000;
+    mutable std::mutex cache_lock;
+    Storage::PoolsCacheStats cache_stats{0, 0, 0, 0, 0, Storage::kDefaultPoolsCacheLimit};
+
+    void pools_cache_shrink(size_t limit) {
+        auto& usage = pools_cache.get<PoolElement::byUsage>();
+
+        while (!usage.empty() && cache_stats.bytes > limit) {
+            cache_stats.bytes -= usage.back().size;
+            usage.pop_back();
+            ++cache_stats.evictions;
+        }
+
+        cache_stats.count = pools_cache.size();
+    }
 
     void pools_cache_insert(const cs::Sequence& seq, const PoolHash &hash, const Pool &pool) {
-        if (pools_cache.size() == cacheSize) {
-            auto random = pools_cache.begin();
-            pools_cache.erase(random);
+        const size_t size = pool.binary_size();
+
+        std::lock_guard<std::mutex> lock(cache_lock);
+
+        if (size > cache_stats.limit) {
+            return;
+        }
+
+        auto& bySeq = pools_cache.get<PoolElement::bySequence>();
+        auto& usage = pools_cache.get<PoolElement::byUsage>();
+
+        if (auto it = bySeq.find(seq); it != bySeq.end()) {
+            if (it->hash == hash) {
+                usage.relocate(usage.begin(), pools_cache.project<PoolElement::byUsage>(it));
+                return;
+            }
+
+            cache_stats.bytes -= it->size;
+            bySeq.erase(it);
+        }
+
+        auto [it, isInserted] = usage.push_front({seq, hash, pool, size});
+
+        if (isInserted) {
+            cache_stats.bytes += size;
+        }
+        else {
+            // the same hash is cached under another sequence, the new element replaces it
+            const size_t oldSize = it->size;
+
+            if (!usage.replace(it, {seq, hash, pool, size})) {
+                return;
+            }
+
+            usage.relocate(usage.begin(), it);
+            cache_stats.bytes = cache_stats.bytes - oldSize + size;
+        }
+
+        pools_cache_shrink(cache_stats.limit);
+    }
+
+    template <typename Tag, typename Key>
+    bool pools_cache_find(const Key& key, Pool& pool) {
+        std::lock_guard<std::mutex> lock(cache_lock);
+
+        auto& index = pools_cache.get<Tag>();
+        auto it = index.find(key);
+
+        if (it == index.end()) {
+            ++cache_stats.misses;
+            return false;
+        }
+
+        auto& usage = pools_cache.get<PoolElement::byUsage>();
+        usage.relocate(usage.begin(), pools_cache.project<PoolElement::byUsage>(it));
+
+        pool = it->pool;
+        ++cache_stats.hits;
+        return true;
+    }
+
+    void pools_cache_remove(const cs::Sequence& seq) {
+        std::lock_guard<std::mutex> lock(cache_lock);
+
+        auto& bySeq = pools_cache.get<PoolElement::bySequence>();
+        auto it = bySeq.find(seq);
+
+        if (it != bySeq.end()) {
+            cache_stats.bytes -= it->size;
+            bySeq.erase(it);
+            cache_stats.count = pools_cache.size();
         }
-        pools_cache.insert({seq, hash, pool});
     }
 
     friend class ::csdb::Storage;
@@ -493,10 +580,7 @@ Pool Storage::pool_load_internal(const PoolHash& hash, const bool metaOnly, size
     bool needParseData = true;
     cs::Bytes data;
 
-    const auto &index = d->pools_cache.get<Storage::priv::PoolElement::byHash>();
-    auto it = index.find(hash);
-    if (it != index.end()) {
-        res = (*it).pool;
+    if (d->pools_cache_find<Storage::priv::PoolElement::byHash>(hash, res)) {
         if (!res.is_valid()) {
             d->set_last_error(DataIntegrityError, "%s: Error decoding pool [hash: %s]", funcName(), hash.to_string().c_str());
             return Pool{};
@@ -589,10 +673,7 @@ Pool Storage::pool_load(const cs::Sequence sequence) const {
     bool needParseData = true;
     cs::Bytes data;
 
-    const auto &index = d->pools_cache.get<Storage::priv::PoolElement::bySequence>();
-    auto it = index.find(sequence);
-    if (it != index.end()) {
-        res = (*it).pool;
+    if (d->pools_cache_find<Storage::priv::PoolElement::bySequence>(sequence, res)) {
         if (!res.is_valid()) {
             d->set_last_error(DataIntegrityError);
             return Pool{};
@@ -681,6 +762,7 @@ Pool Storage::pool_remove_last() {
 
     if (found) {
         d->last_hash = res.previous_hash();
+        d->pools_cache_remove(res.sequence());
         return res;
     }
 
@@ -704,6 +786,7 @@ Pool Storage::pool_remove_last() {
     }
 
     d->db->remove(last_hash().to_binary());
+    d->pools_cache_remove(res.sequence());
 
     --d->count_pool;
     d->last_hash = res.previous_hash();
@@ -940,6 +1023,11 @@ csdb::PoolHash Storage::pool_hash(cs::Sequence sequence) const {
     Pool res;
     cs::Bytes data;
 
+    if (d->pools_cache_find<Storage::priv::PoolElement::bySequence>(sequence, res)) {
+        d->set_last_error();
+        return res.hash();
+    }
+
     if (!d->db->get(static_cast<uint32_t>(sequence), &data)) {
         {
             std::unique_lock<std::mutex> lock2(d->write_lock);
@@ -969,4 +1057,20 @@ csdb::PoolHash Storage::pool_hash(cs::Sequence sequence) const {
     return res.hash();
 }
 
+void Storage::set_pools_cache_limit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(d->cache_lock);
+    d->cache_stats.limit = bytes;
+    d->pools_cache_shrink(bytes);
+}
+
+Storage::PoolsCacheStats Storage::pools_cache_stats() const {
+    std::lock_guard<std::mutex> lock(d->cache_lock);
+    return d->cache_stats;
+}
+
+size_t Storage::write_queue_size() const {
+    std::lock_guard<std::mutex> lock(d->write_lock);
+    return d->write_queue.size();
+}
+
 }  // namespace csdb
@@ -142,36 +142,42 @@ const cs::Signature& Transaction::signature() const noexcept {
 void Transaction::set_innerID(int64_t innerID) {
     if (!d.constData()->read_only_) {
         d->innerID_ = innerID;
+        d->_drop_sig_data();
     }
 }
 
 void Transaction::set_source(Address source) {
     if (!d.constData()->read_only_) {
         d->source_ = source;
+        d->_drop_sig_data();
     }
 }
 
 void Transaction::set_target(Address target) {
     if (!d.constData()->read_only_) {
         d->target_ = target;
+        d->_drop_sig_data();
     }
 }
 
 void Transaction::set_currency(Currency currency) {
     if (!d.constData()->read_only_) {
         d->currency_ = currency;
+        d->_drop_sig_data();
     }
 }
 
 void Transaction::set_amount(Amount amount) {
     if (!d.constData()->read_only_) {
         d->amount_ = amount;
+        d->_drop_sig_data();
     }
 }
 
 void Transaction::set_max_fee(AmountCommission max_fee) {
     if (!d.constData()->read_only_) {
         d->max_fee_ = max_fee;
+        d->_drop_sig_data();
     }
 }
 
@@ -201,6 +207,7 @@ bool Transaction::add_user_field(user_field_id_t id, UserField field) noexcept {
         return false;
     }
     d->user_fields_[id] = field;
+    d->_drop_sig_data();
     return true;
 }
 
@@ -257,13 +264,36 @@ std::vector<uint8_t> Transaction::to_byte_stream() const {
 }
 
 bool Transaction::verify_signature(const cs::PublicKey& public_key) const {
-    const auto byteStream = to_byte_stream_for_sig();
-    return cscrypto::verifySignature(signature().data(), public_key.data(), byteStream.data(), byteStream.size());
+    const auto data = d.constData()->_sig_data();
+    return cscrypto::verifySignature(signature().data(), public_key.data(), data->bytes.data(), data->bytes.size());
 }
 
 std::vector<uint8_t> Transaction::to_byte_stream_for_sig() const {
+    return d.constData()->_sig_data()->bytes;
+}
+
+cs::Hash Transaction::hash_for_sig() const {
+    return d.constData()->_sig_data()->hash;
+}
+
+std::shared_ptr<const Transaction::priv::sig_data> Transaction::priv::_sig_data() const {
+    auto result = std::atomic_load(&sig_data_);
+
+    if (!result) {
+        auto data = std::make_shared<sig_data>();
+        data->bytes = _sig_bytes();
+        data->hash = cscrypto::calculateHash(data->bytes.data(), data->bytes.size());
+
+        result = std::move(data);
+        std::atomic_store(&sig_data_, result);
+    }
+
+    return result;
+}
+
+cs::Bytes Transaction::priv::_sig_bytes() const {
     ::csdb::priv::obstream os;
-    const priv* data = d.constData();
+    const priv* data = this;
     uint8_t innerID[6];
     {
         auto ptr = reinterpret_cast<const uint8_t*>(&data->innerID_);
@@ -335,6 +365,7 @@ void Transaction::put(::csdb::priv::obstream& os) const {
 
 bool Transaction::get(::csdb::priv::ibstream& is) {
     priv* data = d.data();
+    data->_drop_sig_data();
     bool res;
 
     {
@@ -420,6 +451,53 @@ bool Transaction::get(::csdb::priv::ibstream& is) {
     return is.get(data->signature_) && is.get(data->counted_fee_);
 }
 
+bool Transaction::skip(::csdb::priv::ibstream& is) {
+    uint16_t lo = 0;
+    uint32_t hi = 0;
+
+    if (!is.get(lo) || !is.get(hi)) {
+        return false;
+    }
+
+    const size_t sourceSize = (hi & 0x80000000) ? sizeof(internal::WalletId) : sizeof(cs::PublicKey);
+    const size_t targetSize = (hi & 0x40000000) ? sizeof(internal::WalletId) : sizeof(cs::PublicKey);
+
+    Amount amount;
+    AmountCommission fee;
+    uint8_t currency;
+
+    if (!is.skip(sourceSize + targetSize) || !is.get(amount) || !is.get(fee) || !is.get(currency)) {
+        return false;
+    }
+
+    uint8_t fieldsCount;
+    if (!is.get(fieldsCount)) {
+        return false;
+    }
+
+    user_field_id_t previous = 0;
+
+    for (uint8_t i = 0; i < fieldsCount; ++i) {
+        user_field_id_t id;
+        if (!is.get(id)) {
+            return false;
+        }
+
+        // user fields are serialized in map order without duplicates, other order is not reproduced
+        if (i > 0 && id <= previous) {
+            return false;
+        }
+
+        if (!UserField::skip(is)) {
+            return false;
+        }
+
+        previous = id;
+    }
+
+    return is.skip(sizeof(cs::Signature)) && is.get(fee);
+}
+
 void Transaction::set_time(const uint64_t ts) {
     d->time_ = ts;
 }
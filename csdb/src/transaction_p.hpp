@@ -11,6 +11,7 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 
 #include <csdb/address.hpp>
 #include <csdb/amount.hpp>
@@ -67,7 +68,8 @@ class Transaction::priv : public ::csdb::internal::shared_data {
     , counted_fee_(other.counted_fee_)
     , signature_(other.signature_)
     , user_fields_(other.user_fields_)
-    , time_(other.time_) {
+    , time_(other.time_)
+    , sig_data_(std::atomic_load(&other.sig_data_)) {
     }
 
     inline priv(int64_t innerID, Address source, Address target, Currency currency, Amount amount, AmountCommission max_fee, AmountCommission counted_fee, cs::Signature signature)
@@ -105,10 +107,25 @@ class Transaction::priv : public ::csdb::internal::shared_data {
             result.user_fields_[uf.first] = uf.second.clone();
 
         result.time_ = time_;
+        result.sig_data_ = std::atomic_load(&sig_data_);
 
         return result;
     }
 
+    struct sig_data {
+        cs::Bytes bytes;
+        cs::Hash hash;
+    };
+
+    // builds signed bytes and their hash on first use, concurrent readers may build it at once
+    std::shared_ptr<const sig_data> _sig_data() const;
+    cs::Bytes _sig_bytes() const;
+
+    // setters of signed fields drop built data
+    inline void _drop_sig_data() {
+        sig_data_.reset();
+    }
+
     bool read_only_;
     TransactionID id_;
     int64_t innerID_;
@@ -123,6 +140,9 @@ class Transaction::priv : public ::csdb::internal::shared_data {
 
     uint64_t time_{};  // optional, not set automatically
 
+    // immutable once built, replaced by atomic operations only
+    mutable std::shared_ptr<const sig_data> sig_data_;
+
     friend class Transaction;
     friend class Pool;
     friend class ::csdb::internal::shared_data_ptr<priv>;
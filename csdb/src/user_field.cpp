@@ -154,4 +154,31 @@ bool UserField::get(::csdb::priv::ibstream& is) {
     return d->get(is);
 }
 
+bool UserField::skip(::csdb::priv::ibstream& is) {
+    UserField::Type type;
+    if (!is.get(type)) {
+        return false;
+    }
+
+    switch (type) {
+        case UserField::Integer: {
+            uint64_t value;
+            return is.get(value);
+        }
+
+        case UserField::String: {
+            uint32_t size;
+            return is.get(size) && is.skip(size);
+        }
+
+        case UserField::Amount: {
+            ::csdb::Amount value;
+            return is.get(value);
+        }
+
+        default:
+            return false;
+    }
+}
+
 }  // namespace csdb
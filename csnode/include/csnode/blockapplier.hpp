@@ -0,0 +1,80 @@
+#ifndef BLOCKAPPLIER_HPP
+#define BLOCKAPPLIER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <csdb/pool.hpp>
+
+#include <lib/system/common.hpp>
+#include <lib/system/signals.hpp>
+
+namespace cs {
+using BlockRejectedSignal = cs::Signal<void(const cs::Sequence)>;
+
+///
+/// @brief Reorder buffer with own thread, which validates and stores blocks strictly by sequence order.
+/// Blocks come from many peers in any order, each one waits in buffer until all previous are applied.
+///
+class BlockApplier {
+public:
+    // both are called from apply thread
+    using Validator = std::function<bool(const csdb::Pool&)>;
+    using Store = std::function<bool(csdb::Pool&)>;
+
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit BlockApplier(Validator validator, Store store, std::size_t capacity = kDefaultCapacity);
+    ~BlockApplier();
+
+    BlockApplier(const BlockApplier&) = delete;
+    BlockApplier& operator=(const BlockApplier&) = delete;
+
+    // drops buffered blocks, result of block in progress is ignored
+    void reset(cs::Sequence next);
+
+    // moves expected sequence forward if blocks were applied by another way
+    void advance(cs::Sequence next);
+
+    // returns false if block is outdated, duplicated or buffer is full
+    bool push(csdb::Pool&& pool);
+
+    // waits until all blocks up to sequence are applied
+    bool wait(cs::Sequence sequence, std::chrono::milliseconds timeout);
+
+    cs::Sequence next() const;
+    std::size_t size() const;
+    uint64_t appliedCount() const;
+
+public signals:
+    // emitted from apply thread, block should be requested again
+    BlockRejectedSignal rejected;
+
+private:
+    void run();
+    void dropOutdated();
+    bool isReady() const;
+
+    Validator validator_;
+    Store store_;
+    const std::size_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable bufferCondition_;
+    std::condition_variable appliedCondition_;
+
+    std::map<cs::Sequence, csdb::Pool> buffer_;
+    cs::Sequence next_ = 0;
+    uint64_t generation_ = 0;
+    uint64_t applied_ = 0;
+    bool isStopped_ = false;
+
+    std::thread thread_;
+};
+}  // namespace cs
+
+#endif  // BLOCKAPPLIER_HPP
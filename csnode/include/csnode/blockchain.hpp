@@ -20,6 +20,7 @@
 #include <csdb/storage.hpp>
 
 #include <csdb/internal/types.hpp>
+#include <csnode/blockscache.hpp>
 #include <csnode/nodecore.hpp>
 #include <csnode/walletscache.hpp>
 #include <csnode/walletsids.hpp>
@@ -27,6 +28,7 @@
 #include <roundpackage.hpp>
 
 #include <lib/system/concurrent.hpp>
+#include <lib/system/metrics.hpp>
 
 #include <condition_variable>
 #include <mutex>
@@ -62,7 +64,8 @@ public:
                         bool recreateIndex = false);
     ~BlockChain();
 
-    bool init(const std::string& path);
+    bool init(const std::string& path, size_t poolsCacheLimit = csdb::Storage::kDefaultPoolsCacheLimit,
+              size_t cachedBlocksLimit = cs::BlocksCache::kDefaultMemoryLimit);
     bool isGood() const;
 
     // return unique id of database if at least one unique block has written, otherwise (only genesis block) 0
@@ -295,6 +298,8 @@ private:
 
     void updateNonEmptyBlocks(const csdb::Pool&);
 
+    void registerMetrics();
+
     bool good_;
 
     mutable std::recursive_mutex dbLock_;
@@ -336,14 +341,9 @@ private:
 
     std::optional<csdb::Pool> recordBlock(csdb::Pool& pool, bool isTrusted);
 
-    // to store outrunning blocks until the time to insert comes;
-    // stores pairs of <sequence, metadata>
-    struct BlockMeta {
-        csdb::Pool pool;
-        // indicates that block has got by sync, so it is checked & tested in other way than ordinary ones
-        bool by_sync;
-    };
-    std::map<cs::Sequence, BlockMeta> cachedBlocks_;
+    // to store outrunning blocks until the time to insert comes,
+    // blocks over memory limit are spilled to disk
+    cs::BlocksCache cachedBlocks_;
 
     // block storage to defer storing it in blockchain until confirmation from other nodes got
     // (idea is it is more easy not to store block immediately then to revert it after storing)
@@ -371,5 +371,8 @@ private:
     std::map<csdb::Address, cs::Sequence> lapoos;
 	std::atomic<cs::Sequence> lastSequence_;
 	cs::Sequence blocksToBeRemoved_ = 0;
+
+    // storage state read on metrics scrape, unregistered before storage is destroyed
+    std::vector<cs::metrics::Probe> probes_;
 };
 #endif  //  BLOCKCHAIN_HPP
@@ -0,0 +1,99 @@
+#ifndef BLOCKSCACHE_HPP
+#define BLOCKSCACHE_HPP
+
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include <csdb/pool.hpp>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// @brief Blocks got ahead of the last written one, kept until they can be stored in sequence order.
+/// Blocks are kept decoded while their serialized size fits memory budget, the farthest ones from the write
+/// position are spilled to files of temporary directory in serialized form and read back when extracted.
+///
+class BlocksCache {
+public:
+    struct Item {
+        csdb::Pool pool;
+        // indicates that block has got by sync, so it is checked & tested in other way than ordinary ones
+        bool bySync;
+    };
+
+    static constexpr std::size_t kDefaultMemoryLimit = 128 * 1024 * 1024;
+
+    // the directory is created on first spill and removed with the cache, default is in system temporary path
+    explicit BlocksCache(std::size_t memoryLimit = kDefaultMemoryLimit, boost::filesystem::path directory = {});
+    ~BlocksCache();
+
+    BlocksCache(const BlocksCache&) = delete;
+    BlocksCache& operator=(const BlocksCache&) = delete;
+
+    // returns false if block is duplicated
+    bool insert(cs::Sequence sequence, csdb::Pool pool, bool bySync);
+
+    // removes block from cache, reads it back if it is spilled
+    std::optional<Item> extract(cs::Sequence sequence);
+
+    // removes blocks before sequence
+    void eraseBefore(cs::Sequence sequence);
+
+    bool contains(cs::Sequence sequence) const;
+    bool empty() const;
+    std::size_t size() const;
+
+    std::optional<cs::Sequence> first() const;
+    std::optional<cs::Sequence> last() const;
+
+    // continuous ranges of cached sequences including spilled ones, ordered
+    std::vector<std::pair<cs::Sequence, cs::Sequence>> ranges() const;
+
+    // spills or loads blocks to fit the new limit
+    void setMemoryLimit(std::size_t memoryLimit);
+
+    std::size_t memoryLimit() const;
+    std::size_t memoryBytes() const;
+    std::size_t spilledCount() const;
+    std::size_t spilledBytes() const;
+
+private:
+    struct Entry {
+        // empty if spilled
+        std::optional<csdb::Pool> pool;
+        std::size_t bytes = 0;
+        bool bySync = false;
+    };
+
+    using Entries = std::map<cs::Sequence, Entry>;
+
+    void shrink();
+    void refill();
+
+    bool spill(cs::Sequence sequence, Entry& entry);
+    std::optional<csdb::Pool> load(cs::Sequence sequence) const;
+    void remove(Entries::iterator it);
+
+    boost::filesystem::path path(cs::Sequence sequence) const;
+
+    std::size_t memoryLimit_;
+    boost::filesystem::path directory_;
+    bool isDirectoryCreated_ = false;
+
+    Entries entries_;
+    std::size_t memoryBytes_ = 0;
+    std::size_t spilledBytes_ = 0;
+
+    // sequences of decoded and spilled blocks, the farthest decoded are spilled first, the nearest spilled are loaded first
+    std::set<cs::Sequence> resident_;
+    std::set<cs::Sequence> spilled_;
+};
+}  // namespace cs
+
+#endif  // BLOCKSCACHE_HPP
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include <csdb/pool.hpp>
+#include <lib/system/taskgraph.hpp>
 
 class Node;
 class BlockChain;
@@ -31,22 +32,39 @@ public:
         accountBalance = 1 << 8
     };
 
+    // checks which do not change any state, plugins changing wallets or executor state must wait for all of them
+    static constexpr ValidationFlags kReadOnlyChecks = hashIntergrity | blockNum | timestamp | blockSignatures | smartSignatures |
+                                                       transactionsSignatures;
+
     enum SeverityLevel : uint8_t {
         warningsAsErrors = 1,
         greaterThanWarnings,
         onlyFatalErrors
     };
 
+    // plugins run on their own threads to not be blocked by other users of common thread pool
+    static constexpr size_t kMaxValidationThreads = 4;
+
     explicit BlockValidator(Node&);
+
+    // validation of stored blocks without node, smart states which need contracts executor are not validated,
+    // zero threads count means hardware concurrency limited by kMaxValidationThreads
+    explicit BlockValidator(const BlockChain&, size_t threadsCount = 0);
+
     ~BlockValidator();
     bool validateBlock(const csdb::Pool&, ValidationFlags = hashIntergrity, SeverityLevel = greaterThanWarnings);
 
+    // replaces plugin validating the level, the new one must not depend on plugins depending on it
+    void setPlugin(ValidationLevel, std::unique_ptr<ValidationPlugin>);
+
     BlockValidator(const BlockValidator&) = delete;
     BlockValidator(BlockValidator&&) = delete;
     BlockValidator& operator=(const BlockValidator&) = delete;
     BlockValidator& operator=(BlockValidator&&) = delete;
 
 private:
+    BlockValidator(const BlockChain&, Node*, size_t threadsCount);
+
     enum ErrorType : uint8_t {
         noError = 0,
         warning = 1 << 1,
@@ -55,12 +73,17 @@ private:
     };
 
     bool return_(ErrorType, SeverityLevel);
+    bool runPlugins(const csdb::Pool&, ValidationFlags, SeverityLevel);
 
-    Node& node_;
+    Node* node_;
     const BlockChain& bc_;
 
     std::map<ValidationLevel, std::unique_ptr<ValidationPlugin>> plugins_;
 
+    // plugins graph of current validation, nullptr threads means sequential validation
+    TaskGraph graph_;
+    std::unique_ptr<Threads> threads_;
+
     friend class ValidationPlugin;
 
     std::shared_ptr<WalletsState> wallets_;
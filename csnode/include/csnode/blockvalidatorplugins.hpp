@@ -1,6 +1,7 @@
 #ifndef BLOCK_VALIDATOR_PLUGINS_HPP
 #define BLOCK_VALIDATOR_PLUGINS_HPP
 
+#include <functional>
 #include <vector>
 #include <list>
 
@@ -27,9 +28,25 @@ public:
     using ErrorType = BlockValidator::ErrorType;
     virtual ErrorType validateBlock(const csdb::Pool&) = 0;
 
+    // plugins of lower levels which must pass before this one starts
+    virtual BlockValidator::ValidationFlags dependencies() const {
+        return BlockValidator::noValidation;
+    }
+
+    // read-only plugins, safe to run concurrently with others
+    virtual bool isConcurrent() const {
+        return false;
+    }
+
 protected:
-    Node& getNode() {
-        return blockValidator_.node_;    
+    // result of validation is already decided, long running checks may stop
+    bool isCancelled() const {
+        return blockValidator_.graph_.isCancelled();
+    }
+
+    // nullptr if blocks are validated without node
+    Node* getNode() {
+        return blockValidator_.node_;
     }
 
     const BlockChain& getBlockChain() {
@@ -55,6 +72,11 @@ public:
     SmartStateValidator(BlockValidator& bv) : ValidationPlugin(bv) {}
     ErrorType validateBlock(const csdb::Pool&) override;
 
+    // contracts re-execution changes executor state and is expensive, do not start it for a malformed block
+    BlockValidator::ValidationFlags dependencies() const override {
+        return BlockValidator::kReadOnlyChecks;
+    }
+
 private:
     bool checkNewState(const csdb::Transaction&);
 };
@@ -65,6 +87,10 @@ public:
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+
+    bool isConcurrent() const override {
+        return true;
+    }
 };
 
 class BlockNumValidator : public ValidationPlugin {
@@ -73,6 +99,10 @@ public:
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+
+    bool isConcurrent() const override {
+        return true;
+    }
 };
 
 class TimestampValidator : public ValidationPlugin {
@@ -81,6 +111,10 @@ public:
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+
+    bool isConcurrent() const override {
+        return true;
+    }
 };
 
 class BlockSignaturesValidator : public ValidationPlugin {
@@ -89,6 +123,13 @@ public:
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+
+    // signatures of real trusted confidants, also checks blocks of pool synchronizer before they reach validator
+    static ErrorType checkSignatures(const csdb::Pool&, const std::function<bool()>& isCancelled = nullptr);
+
+    bool isConcurrent() const override {
+        return true;
+    }
 };
 
 class SmartSourceSignaturesValidator : public ValidationPlugin {
@@ -102,6 +143,10 @@ public:
     }
     ErrorType validateBlock(const csdb::Pool&) override;
 
+    bool isConcurrent() const override {
+        return true;
+    }
+
 private:
     bool containsNewState(const Transactions&);
     Packets grepNewStatesPacks(const Transactions&, bool switchFees);
@@ -122,6 +167,11 @@ public:
     }
     ErrorType validateBlock(const csdb::Pool&) override;
 
+    // updates wallets state, so the block must be known to be valid
+    BlockValidator::ValidationFlags dependencies() const override {
+        return BlockValidator::kReadOnlyChecks;
+    }
+
 private:
     static constexpr csdb::Amount zeroBalance_ = 0;
 };
@@ -133,6 +183,10 @@ public:
     }
     ErrorType validateBlock(const csdb::Pool&) override;
 
+    bool isConcurrent() const override {
+        return true;
+    }
+
 private:
     bool checkSignature(const csdb::Transaction&);
 };
@@ -145,6 +199,11 @@ public:
 
     ErrorType validateBlock(const csdb::Pool&) override;
 
+    // reads wallets state after balances are updated and keeps totals across blocks
+    BlockValidator::ValidationFlags dependencies() const override {
+        return BlockValidator::kReadOnlyChecks | BlockValidator::balances;
+    }
+
 private:
 
     csdb::Address abs_addr;
@@ -5,6 +5,7 @@
 #include <csnode/packetqueue.hpp>
 
 #include <lib/system/common.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/signals.hpp>
 
 #include <memory>
@@ -290,6 +291,11 @@ public:
     ///
     size_t sendCacheCount() const;
 
+    ///
+    /// @brief Returns current round packets table size
+    ///
+    size_t packetsTableSize() const;
+
     // sync, try do not use it :]
     std::unique_lock<cs::SharedMutex> lock() const;
 
@@ -338,6 +344,9 @@ private:
     std::unique_ptr<Impl> pimpl_;
 
     mutable cs::SharedMutex sharedMutex_;
+
+    // read on metrics scrape under shared mutex, so declared after it
+    std::vector<cs::metrics::Probe> probes_;
 };
 
 class Conveyer : public ConveyerBase {
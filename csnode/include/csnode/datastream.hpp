@@ -410,7 +410,7 @@ public:
         size_t size = parseValue<size_t>();
 
         if (isAvailable(size)) {
-            bytesView = cs::BytesView(reinterpret_cast<cs::Byte*>(data_), size);
+            bytesView = cs::BytesView(reinterpret_cast<cs::Byte*>(data_ + index_), size);
             index_ += size;
         }
         else {
@@ -521,11 +521,10 @@ inline DataStream& operator>>(DataStream& stream, FixedString<size>& fixedString
 }
 
 inline DataStream& operator>>(DataStream& stream, cs::TransactionsPacketHash& hash) {
-    cs::Bytes bytes;
-    stream >> bytes;
+    const cs::BytesView bytes = stream.parseBytesView();
 
     if (!bytes.empty()) {
-        hash = cs::TransactionsPacketHash::fromBinary(bytes);
+        hash = cs::TransactionsPacketHash::fromBinary(bytes.data(), bytes.size());
     }
 
     return stream;
@@ -641,7 +640,8 @@ inline DataStream& operator<<(DataStream& stream, const boost::asio::ip::udp::en
 }
 
 inline DataStream& operator<<(DataStream& stream, const cs::TransactionsPacketHash& hash) {
-    stream << hash.toBinary();
+    // the same as bytes of hash
+    stream.addBytesView(cs::BytesView(hash.data(), hash.size()));
     return stream;
 }
 
@@ -0,0 +1,86 @@
+#ifndef DISPATCHLANES_HPP
+#define DISPATCHLANES_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <net/packet.hpp>
+
+namespace cs {
+///
+/// @brief Inbound messages dispatch by message class.
+/// Every lane except consensus runs posted tasks strictly in order on its own thread,
+/// consensus lane is the calling (processor) thread itself as its handlers talk to solver directly.
+/// Lane tasks must not touch node state, they return results to node thread by deliver(),
+/// delivered calls go through CallsQueue and keep the order of the lane.
+///
+class DispatchLanes {
+public:
+    enum class Lane : uint8_t {
+        Consensus,
+        Transactions,
+        Sync,
+        Smart
+    };
+
+    using Task = std::function<void()>;
+
+    constexpr static size_t LanesCount = 4;
+
+    // tasks above the limit are dropped, all lane messages are requested again by their protocols
+    constexpr static size_t MaxQueueSize = 4096;
+
+    DispatchLanes();
+    ~DispatchLanes();
+
+    DispatchLanes(const DispatchLanes&) = delete;
+    DispatchLanes& operator=(const DispatchLanes&) = delete;
+
+    static Lane laneOf(MsgTypes type);
+
+    // returns false if the lane is stopped or overloaded
+    bool post(Lane lane, Task task);
+
+    // called from lane task, runs the call on node thread after the calls delivered by the lane before
+    void deliver(Lane lane, Task task);
+
+    // joins lane threads, not processed tasks are dropped
+    void stop();
+
+    size_t size(Lane lane) const;
+    uint64_t droppedCount(Lane lane) const;
+
+private:
+    struct Worker {
+        mutable std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Task> tasks;
+        uint64_t dropped = 0;
+
+        std::mutex resultsMutex;
+        std::deque<Task> results;
+        std::atomic<bool> isDrainScheduled = false;
+
+        std::atomic<bool> isStopped = false;
+        std::thread thread;
+    };
+
+    // scheduled drain keeps the worker alive, so calls queue never refers to destroyed lanes
+    using WorkerPtr = std::shared_ptr<Worker>;
+
+    static void run(Worker& worker);
+    static void drain(const WorkerPtr& worker);
+
+    Worker& worker(Lane lane) const;
+
+    std::array<WorkerPtr, LanesCount> workers_;
+};
+}  // namespace cs
+
+#endif  // DISPATCHLANES_HPP
@@ -0,0 +1,44 @@
+#ifndef METRICSSERVER_HPP
+#define METRICSSERVER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <boost/asio.hpp>
+
+namespace cs {
+///
+/// @brief Serves metrics registry in Prometheus text format by GET /metrics on loopback port,
+/// and timeline of last N rounds in Chrome trace format by GET /trace?rounds=N.
+/// Connections are handled asynchronously by own thread, every connection is closed after response.
+///
+class MetricsServer {
+public:
+    static constexpr size_t kMaxRequestSize = 8 * 1024;
+
+    MetricsServer() = default;
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // returns false if the port can not be listened, port 0 selects any free one
+    bool start(uint16_t port);
+    void stop();
+
+    // listened port, valid after start
+    uint16_t port() const;
+
+private:
+    class Connection;
+
+    void accept();
+
+    boost::asio::io_context context_;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
+    std::thread thread_;
+};
+}  // namespace cs
+
+#endif  // METRICSSERVER_HPP
@@ -16,6 +16,8 @@
 
 #include "blockchain.hpp"
 #include "confirmationlist.hpp"
+#include "dispatchlanes.hpp"
+#include "metricsserver.hpp"
 #include "packstream.hpp"
 #include "roundstat.hpp"
 
@@ -75,7 +77,8 @@ public:
     // incoming requests processing
     void getBigBang(const uint8_t* data, const size_t size, const cs::RoundNumber rNum);
     void getRoundTableSS(const uint8_t* data, const size_t size, const cs::RoundNumber);
-    void getTransactionsPacket(const uint8_t* data, const std::size_t size);
+    // called from transactions lane
+    void getTransactionsPacket(cs::IPackStream& stream);
     void getNodeStopRequest(const cs::RoundNumber round, const uint8_t* data, const std::size_t size);
     // critical is true if network near to be down, all capable trusted node required
     bool canBeTrusted(bool critical);
@@ -110,11 +113,12 @@ public:
 
     // smart-contracts consensus communicatioin
     void sendSmartStageOne(const cs::ConfidantsKeys& smartConfidants, const cs::StageOneSmarts& stageOneInfo);
-    void getSmartStageOne(const uint8_t* data, const size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender);
+    // called from smart lane
+    void getSmartStageOne(cs::IPackStream& stream, const cs::RoundNumber rNum, const cs::PublicKey& sender);
     void sendSmartStageTwo(const cs::ConfidantsKeys& smartConfidants, cs::StageTwoSmarts& stageTwoInfo);
-    void getSmartStageTwo(const uint8_t* data, const size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender);
+    void getSmartStageTwo(cs::IPackStream& stream, const cs::RoundNumber rNum, const cs::PublicKey& sender);
     void sendSmartStageThree(const cs::ConfidantsKeys& smartConfidants, cs::StageThreeSmarts& stageThreeInfo);
-    void getSmartStageThree(const uint8_t* data, const size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender);
+    void getSmartStageThree(cs::IPackStream& stream, const cs::RoundNumber rNum, const cs::PublicKey& sender);
     void smartStageEmptyReply(uint8_t requesterNumber);
     void smartStageRequest(MsgTypes msgType, uint64_t smartID, cs::PublicKey confidant, uint8_t respondent, uint8_t required);
     void getSmartStageRequest(const MsgTypes msgType, const uint8_t* data, const size_t size, const cs::PublicKey& requester);
@@ -155,7 +159,8 @@ public:
 
     // transaction's pack syncro
     void getPacketHashesRequest(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey&);
-    void getPacketHashesReply(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
+    // called from transactions lane
+    void getPacketHashesReply(cs::IPackStream&, const cs::RoundNumber, const cs::PublicKey& sender);
 
     void getCharacteristic(cs::RoundPackage& rPackage);
 
@@ -170,7 +175,8 @@ public:
 
     // syncro get functions
     void getBlockRequest(const uint8_t*, const size_t, const cs::PublicKey& sender);
-    void getBlockReply(const uint8_t*, const size_t);
+    // called from sync lane
+    void getBlockReply(cs::IPackStream&);
 
     // transaction's pack syncro
     void sendTransactionsPacket(const cs::TransactionsPacket& packet);
@@ -226,6 +232,10 @@ public:
         return solver_;
     }
 
+    cs::DispatchLanes& getDispatchLanes() {
+        return dispatchLanes_;
+    }
+
 #ifdef NODE_API
     csconnector::connector* getConnector() {
         return api_.get();
@@ -323,7 +333,7 @@ private:
     void writeDefaultStream(Args&&... args);
 
     RegionPtr compressPoolsBlock(const cs::PoolsBlock& poolsBlock, std::size_t& realBinSize);
-    cs::PoolsBlock decompressPoolsBlock(const uint8_t* data, const size_t size);
+    static cs::PoolsBlock decompressPoolsBlock(cs::IPackStream& stream);
 
     // TODO: C++ 17 static inline?
     static const csdb::Address genesisAddress_;
@@ -428,6 +438,12 @@ private:
     bool alwaysExecuteContracts_ = false;
 
     cs::config::Observer& observer_;
+
+    // inbound messages processing off the processor thread
+    cs::DispatchLanes dispatchLanes_;
+
+    // runtime metrics for local collector, not created if disabled by config
+    std::unique_ptr<cs::MetricsServer> metricsServer_;
 };
 
 std::ostream& operator<<(std::ostream& os, Node::Level nodeLevel);
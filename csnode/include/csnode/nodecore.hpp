@@ -15,16 +15,19 @@
 #include <lib/system/metastorage.hpp>
 
 namespace std {
-// transactions packet hash specialization
+// transactions packet hash specialization, bucket key is calculated once by hash itself
 template <>
 struct hash<cs::TransactionsPacketHash> {
-    std::size_t operator()(const cs::TransactionsPacketHash& packetHash) const noexcept;
+    std::size_t operator()(const cs::TransactionsPacketHash& packetHash) const noexcept {
+        return static_cast<std::size_t>(packetHash.key());
+    }
 };
 }  // namespace std
 
 namespace cs {
-// table for fast transactions storage
-using TransactionsPacketTable = std::map<TransactionsPacketHash, TransactionsPacket>;  // TODO: check performance of map/unordered_map
+// table for fast transactions storage, it is not ordered, sort hashes if nodes have to agree on order
+using TransactionsPacketTable = std::unordered_map<TransactionsPacketHash, TransactionsPacket>;
+using PacketsHashesSet = std::unordered_set<TransactionsPacketHash>;
 
 // send transactions packet cache for conveyer
 using TransactionPacketSendCache = std::multimap<cs::RoundNumber, TransactionsPacketHash>;
@@ -2,7 +2,9 @@
 #define PACKSTREAM_HPP
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <vector>
 #include <type_traits>
 
 #include <csnode/nodecore.hpp>
@@ -16,27 +18,58 @@
 #include <net/packet.hpp>
 
 namespace cs {
+///
+/// @brief Reads message from contiguous memory or in place from the ordered list of segments,
+/// usually payloads of message fragments. Values crossing segments bounds are copied, the rest
+/// of message is composed to contiguous memory only if it is requested by pointer.
+///
 class IPackStream {
 public:
     void init(const cs::Byte* ptr, const size_t size) {
         ptr_ = ptr;
         end_ = ptr_ + size;
         good_ = true;
+
+        segment_ = nullptr;
+        segmentsEnd_ = nullptr;
+        restSize_ = 0;
+        composed_.clear();
+    }
+
+    // segments must outlive the stream
+    void init(const cs::BytesView* segments, const size_t count) {
+        init(static_cast<const cs::Byte*>(nullptr), 0);
+
+        segment_ = segments;
+        segmentsEnd_ = segments + count;
+
+        for (auto segment = segment_; segment != segmentsEnd_; ++segment) {
+            restSize_ += segment->size();
+        }
+
+        nextSegment();
     }
 
     template <typename T>
     bool canPeek() const {
-        return static_cast<uint32_t>(end_ - ptr_) >= sizeof(T);
+        return remainsBytes() >= sizeof(T);
     }
 
     template <typename T>
     const T& peek() const {
-        return *(reinterpret_cast<const T*>(ptr_));
+        if (static_cast<size_t>(end_ - ptr_) >= sizeof(T)) {
+            return *(reinterpret_cast<const T*>(ptr_));
+        }
+
+        static_assert(sizeof(T) <= MaxPeekSize, "Type is too large to be peeked across segments");
+        copyTo(peekBuffer_.data(), sizeof(T));
+
+        return *(reinterpret_cast<const T*>(peekBuffer_.data()));
     }
 
     template <typename T>
     void skip() {
-        ptr_ += sizeof(T);
+        advance(sizeof(T));
     }
 
     template <typename T>
@@ -47,7 +80,7 @@ public:
             good_ = false;
         }
         else {
-            ptr_ += size;
+            advance(size);
         }
     }
 
@@ -66,27 +99,13 @@ public:
 
     template <size_t Length>
     IPackStream& operator>>(FixedString<Length>& str) {
-        if (!isBytesAvailable(Length)) {
-            good_ = false;
-        }
-        else {
-            std::copy(ptr_, ptr_ + Length, str.data());
-            ptr_ += Length;
-        }
-
+        read(str.data(), Length);
         return *this;
     }
 
     template <size_t Length>
     IPackStream& operator>>(cs::ByteArray<Length>& byteArray) {
-        if (!isBytesAvailable(Length)) {
-            good_ = false;
-        }
-        else {
-            std::copy(ptr_, ptr_ + Length, byteArray.data());
-            ptr_ += Length;
-        }
-
+        read(byteArray.data(), Length);
         return *this;
     }
 
@@ -153,33 +172,147 @@ public:
     }
 
     bool end() const {
-        return ptr_ == end_;
+        return remainsBytes() == 0;
     }
 
     operator bool() const {
         return good() && !end();
     }
 
-    const cs::Byte* getCurrentPtr() const {
+    // the rest of segmented message is composed to contiguous memory
+    const cs::Byte* getCurrentPtr() {
+        compose();
         return ptr_;
     }
 
-    const cs::Byte* getEndPtr() const {
+    const cs::Byte* getEndPtr() {
+        compose();
         return end_;
     }
 
+    // returns the next size bytes as contiguous memory valid while the stream is not initialized again,
+    // only bytes crossing segments bounds are copied
+    cs::BytesView readView(size_t size) {
+        if (!isBytesAvailable(size)) {
+            good_ = false;
+            return cs::BytesView();
+        }
+
+        if (static_cast<size_t>(end_ - ptr_) >= size) {
+            cs::BytesView view(ptr_, size);
+            advance(size);
+            return view;
+        }
+
+        auto& bytes = composed_.emplace_back(size);
+        read(bytes.data(), size);
+
+        return cs::BytesView(bytes.data(), bytes.size());
+    }
+
     size_t remainsBytes() const {
-        return static_cast<size_t>(end_ - ptr_);
+        return static_cast<size_t>(end_ - ptr_) + restSize_;
     }
 
     bool isBytesAvailable(size_t bytes) const {
         return remainsBytes() >= bytes;
     }
 
+    // bytes copied from segments to contiguous memory
+    size_t composedBytes() const {
+        size_t result = 0;
+
+        for (const auto& bytes : composed_) {
+            result += bytes.size();
+        }
+
+        return result;
+    }
+
 private:
+    constexpr static size_t MaxPeekSize = 128;
+
+    void read(void* destination, size_t size) {
+        if (!isBytesAvailable(size)) {
+            good_ = false;
+            return;
+        }
+
+        copyTo(static_cast<cs::Byte*>(destination), size);
+        advance(size);
+    }
+
+    void copyTo(cs::Byte* destination, size_t size) const {
+        auto ptr = ptr_;
+        auto end = end_;
+        auto segment = segment_;
+
+        while (size) {
+            if (ptr == end) {
+                ptr = segment->data();
+                end = ptr + segment->size();
+                ++segment;
+                continue;
+            }
+
+            const size_t count = std::min(size, static_cast<size_t>(end - ptr));
+            std::copy(ptr, ptr + count, destination);
+
+            ptr += count;
+            destination += count;
+            size -= count;
+        }
+    }
+
+    void advance(size_t size) {
+        while (size > static_cast<size_t>(end_ - ptr_)) {
+            if (segment_ == segmentsEnd_) {
+                ptr_ = end_;
+                return;
+            }
+
+            size -= static_cast<size_t>(end_ - ptr_);
+            ptr_ = end_;
+            nextSegment();
+        }
+
+        ptr_ += size;
+        nextSegment();
+    }
+
+    void nextSegment() {
+        while (ptr_ == end_ && segment_ != segmentsEnd_) {
+            ptr_ = segment_->data();
+            end_ = ptr_ + segment_->size();
+            restSize_ -= segment_->size();
+            ++segment_;
+        }
+    }
+
+    void compose() {
+        if (!restSize_) {
+            return;
+        }
+
+        auto& bytes = composed_.emplace_back(remainsBytes());
+        copyTo(bytes.data(), bytes.size());
+
+        ptr_ = bytes.data();
+        end_ = ptr_ + bytes.size();
+        segment_ = segmentsEnd_;
+        restSize_ = 0;
+    }
+
     const cs::Byte* ptr_ = nullptr;
     const cs::Byte* end_ = nullptr;
     bool good_ = false;
+
+    const cs::BytesView* segment_ = nullptr;
+    const cs::BytesView* segmentsEnd_ = nullptr;
+    size_t restSize_ = 0;
+
+    mutable std::array<cs::Byte, MaxPeekSize> peekBuffer_;
+    std::vector<cs::Bytes> composed_;
 };
 
 class OPackStream {
@@ -420,10 +553,8 @@ inline cs::IPackStream& cs::IPackStream::operator>>(std::string& str) {
         good_ = false;
     }
     else {
-        auto nextPtr = ptr_ + size;
-        str = std::string(ptr_, nextPtr);
-
-        ptr_ = nextPtr;
+        str.resize(size);
+        read(str.data(), size);
     }
 
     return *this;
@@ -442,10 +573,8 @@ inline cs::IPackStream& cs::IPackStream::operator>>(cs::Bytes& bytes) {
         good_ = false;
     }
     else {
-        auto nextPtr = ptr_ + size;
-        bytes = cs::Bytes(ptr_, nextPtr);
-
-        ptr_ = nextPtr;
+        bytes.resize(size);
+        read(bytes.data(), size);
     }
 
     return *this;
@@ -461,48 +590,56 @@ inline cs::IPackStream& cs::IPackStream::operator>>(csdb::Pool& pool) {
 
 template <>
 inline cs::IPackStream& cs::IPackStream::operator>>(ip::address& addr) {
-    if (!canPeek<uint8_t>()) {
-        good_ = false;
-    }
-    else {
-        if (*(ptr_++) & 1) {
-            if (static_cast<uint32_t>(end_ - ptr_) < 16) {
-                good_ = false;
-            }
-            else {
-                ip::address_v6::bytes_type bt;
+    cs::Byte isV6 = 0;
+    (*this) >> isV6;
 
-                for (auto& b : bt) {
-                    (*this) >> b;
-                }
+    if (!good_) {
+        return *this;
+    }
 
-                addr = ip::make_address_v6(bt);
-            }
+    if (isV6 & 1) {
+        if (!isBytesAvailable(16)) {
+            good_ = false;
         }
         else {
-            uint32_t ipnum;
+            ip::address_v6::bytes_type bt;
 
-            for (auto ptr = reinterpret_cast<cs::Byte*>(&ipnum) + 3; ptr >= reinterpret_cast<cs::Byte*>(&ipnum); --ptr) {
-                (*this) >> *ptr;
+            for (auto& b : bt) {
+                (*this) >> b;
             }
 
-            addr = ip::make_address_v4(ipnum);
+            addr = ip::make_address_v6(bt);
         }
     }
+    else {
+        uint32_t ipnum;
+
+        for (auto ptr = reinterpret_cast<cs::Byte*>(&ipnum) + 3; ptr >= reinterpret_cast<cs::Byte*>(&ipnum); --ptr) {
+            (*this) >> *ptr;
+        }
+
+        addr = ip::make_address_v4(ipnum);
+    }
 
     return *this;
 }
 
 template <>
 inline cs::IPackStream& cs::IPackStream::operator>>(cs::TransactionsPacketHash& hash) {
-    cs::Bytes bytes;
-    (*this) >> bytes;
+    std::size_t size = 0;
+    (*this) >> size;
 
     if (!good()) {
         return *this;
     }
 
-    hash = cs::TransactionsPacketHash::fromBinary(std::move(bytes));
+    const cs::BytesView bytes = readView(size);
+
+    if (!good()) {
+        return *this;
+    }
+
+    hash = cs::TransactionsPacketHash::fromBinary(bytes.data(), bytes.size());
     return *this;
 }
 
@@ -532,14 +669,7 @@ inline cs::IPackStream& cs::IPackStream::operator>>(cs::BytesView& view) {
         return *this;
     }
 
-    if (!isBytesAvailable(size)) {
-        good_ = false;
-    }
-    else {
-        view = cs::BytesView(ptr_, size);
-        ptr_ += size;
-    }
-
+    view = readView(size);
     return *this;
 }
 
@@ -547,14 +677,7 @@ template <>
 inline cs::IPackStream& cs::IPackStream::operator>>(RegionPtr& regionPtr) {
     std::size_t size = regionPtr->size();
 
-    if (!isBytesAvailable(size)) {
-        good_ = false;
-    }
-    else {
-        std::copy(ptr_, ptr_ + size, reinterpret_cast<char*>(regionPtr->data()));
-        ptr_ += size;
-    }
-
+    read(regionPtr->data(), size);
     return *this;
 }
 
@@ -612,7 +735,9 @@ inline cs::OPackStream& cs::OPackStream::operator<<(const csdb::Pool& pool) {
 
 template <>
 inline cs::OPackStream& cs::OPackStream::operator<<(const cs::TransactionsPacketHash& hash) {
-    (*this) << hash.toBinary();
+    // the same as bytes of hash
+    (*this) << hash.size();
+    insertBytes(reinterpret_cast<const char*>(hash.data()), static_cast<uint32_t>(hash.size()));
     return *this;
 }
 
@@ -1,10 +1,16 @@
 #ifndef POOLSYNCHRONIZER_HPP
 #define POOLSYNCHRONIZER_HPP
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 #include <csdb/pool.hpp>
+#include <csnode/blockapplier.hpp>
 #include <csnode/blockchain.hpp>
 #include <csnode/nodecore.hpp>
 #include <csnode/packstream.hpp>
+#include <csnode/syncwindow.hpp>
 
 #include <lib/system/signals.hpp>
 #include <lib/system/timer.hpp>
@@ -39,178 +45,39 @@ public:
 
     static const cs::RoundNumber roundDifferentForSync = cs::values::kDefaultMetaStorageMaxSize;
 
+    // blocks are requested not further than this value ahead of last written one, it bounds reorder buffer
+    static constexpr cs::Sequence kMaxBlocksAhead = cs::BlockApplier::kDefaultCapacity;
+
 public signals:
     PoolSynchronizerRequestSignal sendRequest;
 
 private slots:
     void onTimeOut();
-    void onRoundSimulation();
 
     void onWriteBlock(const csdb::Pool pool);
     void onWriteBlock(const cs::Sequence sequence);
     void onRemoveBlock(const cs::Sequence sequence);
+    void onBlockRejected(const cs::Sequence sequence);
 
 private:
-    enum class CounterType;
-    enum class SequenceRemovalAccuracy;
-    class NeighboursSetElemet;
-
     // pool sync progress
     bool showSyncronizationProgress(const cs::Sequence lastWrittenSequence) const;
 
-    bool checkActivity(const CounterType counterType);
-
-    void sendBlock(const NeighboursSetElemet& neighbour);
-
-    bool getNeededSequences(NeighboursSetElemet& neighbour);
-
-    void checkNeighbourSequence(const cs::Sequence sequence, const SequenceRemovalAccuracy accuracy);
-
-    void removeExistingSequence(const cs::Sequence sequence, const SequenceRemovalAccuracy accuracy);
-
     void refreshNeighbours();
+    void updateRange();
+    void restart();
 
-    bool isLastRequest() const;
+    // called from apply thread
+    bool validateBlock(const csdb::Pool& pool) const;
+    bool passBlock(csdb::Pool& pool);
 
-    bool isAvailableRequest(const cs::PoolSynchronizer::NeighboursSetElemet& nh) const;
+    // stores validated blocks on node thread
+    void storeBlocks();
 
     void synchroFinished();
 
-    ConnectionPtr getConnection(const NeighboursSetElemet& neighbour) const;
-
     void printNeighbours(const std::string& funcName) const;
 
-private:
-    enum class CounterType {
-        ROUND,
-        TIMER
-    };
-
-    enum class SequenceRemovalAccuracy {
-        EXACT,
-        LOWER_BOUND,
-        UPPER_BOUND
-    };
-
-    class NeighboursSetElemet {
-    public:
-        explicit NeighboursSetElemet(uint8_t neighbourIndex, const cs::PublicKey& publicKey, uint8_t blockPoolsCount)
-        : neighbourIndex_(neighbourIndex)
-        , key_(publicKey)
-        , roundCounter_(0) {
-            sequences_.reserve(blockPoolsCount);
-        }
-
-        inline bool removeSequnce(const cs::Sequence sequence, const SequenceRemovalAccuracy accuracy) {
-            if (sequences_.empty()) {
-                return false;
-            }
-
-            bool success = false;
-
-            switch (accuracy) {
-                case SequenceRemovalAccuracy::EXACT: {
-                    auto it = std::find(sequences_.begin(), sequences_.end(), sequence);
-                    if (it != sequences_.end()) {
-                        sequences_.erase(it);
-                        success = true;
-                    }
-                    break;
-                }
-                case SequenceRemovalAccuracy::LOWER_BOUND: {
-                    auto it = std::upper_bound(sequences_.begin(), sequences_.end(), sequence);
-                    if (it != sequences_.begin()) {
-                        sequences_.erase(sequences_.begin(), it);
-                        success = true;
-                    }
-                    break;
-                }
-                case SequenceRemovalAccuracy::UPPER_BOUND: {
-                    auto it = std::lower_bound(sequences_.begin(), sequences_.end(), sequence);
-                    if (it != sequences_.end()) {
-                        sequences_.erase(it, sequences_.end());
-                        success = true;
-                    }
-                    break;
-                }
-            }
-            return success;
-        }
-        inline void setSequences(const PoolsRequestedSequences& sequences) {
-            resetSequences();
-            sequences_ = sequences;
-        }
-        inline void addSequences(const cs::Sequence sequence) {
-            sequences_.push_back(sequence);
-        }
-        inline void reset() {
-            resetSequences();
-            resetRoundCounter();
-        }
-        inline void resetSequences() {
-            sequences_.clear();
-        }
-        inline void resetRoundCounter() {
-            roundCounter_ = 0;
-        }
-        inline void setIndex(const uint8_t num) {
-            neighbourIndex_ = num;
-        }
-        inline void setPublicKey(const cs::PublicKey& publicKey) {
-            key_ = publicKey;
-        }
-
-        inline uint8_t index() const {
-            return neighbourIndex_;
-        }
-        inline const cs::PublicKey& publicKey() const {
-            return key_;
-        }
-        inline const PoolsRequestedSequences& sequences() const {
-            return sequences_;
-        }
-        inline cs::RoundNumber roundCounter() const {
-            return roundCounter_;
-        }
-
-        inline void increaseRoundCounter() {
-            if (!sequences_.empty()) {
-                ++roundCounter_;
-            }
-        }
-
-        bool operator<(const NeighboursSetElemet& other) const {
-            if (sequences_.empty() || other.sequences_.empty()) {
-                return sequences_.size() > other.sequences_.size();
-            }
-
-            return sequences_.front() < other.sequences_.front();
-        }
-
-        friend std::ostream& operator<<(std::ostream& os, const NeighboursSetElemet& el) {
-            os << "idx: " << cs::numeric_cast<int>(el.neighbourIndex_) << ", seqs:";
-
-            if (el.sequences_.empty()) {
-                os << " empty";
-            }
-            else {
-                for (const auto seq : el.sequences_) {
-                    os << " " << seq;
-                }
-            }
-
-            os << ", round counter: " << el.roundCounter_;
-
-            return os;
-        }
-
-    private:
-        uint8_t neighbourIndex_;             // neighbour number
-        cs::PublicKey key_;                  // neighbour public key
-        PoolsRequestedSequences sequences_;  // requested sequence
-        cs::RoundNumber roundCounter_;
-    };
-
 private:
     const PoolSyncData syncData_;
 
@@ -219,48 +86,20 @@ private:
 
     // flag starting  syncronization
     bool isSyncroStarted_ = false;
-    // [key] = sequence,
-    // [value] =  packet counter
-    // value: increase each new round
-    std::map<cs::Sequence, cs::RoundNumber> requestedSequences_;
+    cs::Sequence targetSequence_ = 0;
+
+    SyncWindow window_;
 
-    std::vector<NeighboursSetElemet> neighbours_;
+    // validated blocks passed from apply thread
+    std::mutex blocksMutex_;
+    std::deque<csdb::Pool> validatedBlocks_;
+    std::atomic<bool> isStoreScheduled_ = false;
 
     cs::Timer timer_;
-    cs::Timer roundSimulation_;
 
-    friend std::ostream& operator<<(std::ostream&, const PoolSynchronizer::CounterType);
-    friend std::ostream& operator<<(std::ostream&, const PoolSynchronizer::SequenceRemovalAccuracy);
+    // the last member, apply thread is stopped before other members destruction
+    BlockApplier applier_;
 };
-
-inline std::ostream& operator<<(std::ostream& os, const PoolSynchronizer::CounterType type) {
-    switch (type) {
-        case PoolSynchronizer::CounterType::ROUND:
-            os << "ROUND";
-            break;
-        case PoolSynchronizer::CounterType::TIMER:
-            os << "TIMER";
-            break;
-    }
-
-    return os;
-}
-
-inline std::ostream& operator<<(std::ostream& os, const PoolSynchronizer::SequenceRemovalAccuracy type) {
-    switch (type) {
-        case PoolSynchronizer::SequenceRemovalAccuracy::EXACT:
-            os << "EXACT";
-            break;
-        case PoolSynchronizer::SequenceRemovalAccuracy::LOWER_BOUND:
-            os << "LOWER_BOUND";
-            break;
-        case PoolSynchronizer::SequenceRemovalAccuracy::UPPER_BOUND:
-            os << "UPPER_BOUND";
-            break;
-    }
-
-    return os;
-}
 }  // namespace cs
 
 #endif  // POOLSYNCHRONIZER_HPP
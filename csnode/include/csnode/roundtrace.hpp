@@ -0,0 +1,146 @@
+#ifndef ROUNDTRACE_HPP
+#define ROUNDTRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// @brief Timeline of consensus rounds: timestamped events of solver states, stages, blocks and round tables
+/// kept in a fixed ring, the oldest events are overwritten. Until the ring is enabled recording is a single
+/// atomic load, enabled recording takes a slot by atomic increment and fills it without locks from any thread.
+/// Only pointers to event names are stored, so names must be string literals.
+///
+class RoundTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // timeline rows of trace viewer
+    enum class Track : uint8_t {
+        Round,
+        Solver,
+        Stages,
+        Blocks,
+        Smarts
+    };
+
+    enum class Phase : uint8_t {
+        Begin,
+        End,
+        Instant
+    };
+
+    struct Event {
+        uint64_t index = 0;  // order of recording
+        Clock::time_point time;
+        RoundNumber round = 0;
+        const char* name = nullptr;
+        Track track = Track::Round;
+        Phase phase = Phase::Instant;
+        int32_t arg = 0;  // confidant index, sequence or any other value, kNoArg if absent
+    };
+
+    static constexpr int32_t kNoArg = -1;
+
+    ///
+    /// @brief Instance of round trace, singleton.
+    /// @return Returns static round trace object reference, Meyers singleton.
+    ///
+    static RoundTrace& instance();
+
+    RoundTrace() = default;
+    ~RoundTrace();
+
+    RoundTrace(const RoundTrace&) = delete;
+    RoundTrace& operator=(const RoundTrace&) = delete;
+
+    // allocates ring of capacity rounded up to power of 2, only the first call with non zero capacity does it
+    void enable(size_t capacity);
+    bool isEnabled() const noexcept;
+    size_t capacity() const noexcept;
+
+    // following events belong to this round
+    void startRound(RoundNumber round) noexcept;
+
+    void record(const char* name, Track track, Phase phase, int32_t arg = kNoArg) noexcept {
+        Ring* ring = ring_.load(std::memory_order_acquire);
+
+        if (ring != nullptr) {
+            push(*ring, name, track, phase, arg);
+        }
+    }
+
+    void instant(const char* name, Track track, int32_t arg = kNoArg) noexcept {
+        record(name, track, Phase::Instant, arg);
+    }
+
+    // events of the last rounds in recording order, 0 rounds returns all kept events
+    std::vector<Event> events(size_t rounds) const;
+
+    // Chrome trace event format, opened by chrome://tracing or Perfetto UI
+    void writeChromeTrace(std::ostream& stream, size_t rounds) const;
+    std::string chromeTrace(size_t rounds) const;
+
+private:
+    // sequence is odd while slot is written and even when slot keeps event of index (sequence / 2 - 1)
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<int64_t> time{0};
+        std::atomic<RoundNumber> round{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> info{0};
+    };
+
+    struct Ring {
+        explicit Ring(size_t size);
+
+        std::unique_ptr<Slot[]> slots;
+        size_t mask;
+        std::atomic<uint64_t> next{0};
+    };
+
+    void push(Ring& ring, const char* name, Track track, Phase phase, int32_t arg) noexcept;
+
+    std::atomic<Ring*> ring_{nullptr};
+    std::unique_ptr<Ring> storage_;
+    std::mutex enableMutex_;
+
+    std::atomic<RoundNumber> round_{0};
+};
+
+///
+/// @brief Records begin of event at construction and its end at destruction.
+///
+class RoundTraceScope {
+public:
+    RoundTraceScope(const char* name, RoundTrace::Track track, int32_t arg = RoundTrace::kNoArg, RoundTrace& trace = RoundTrace::instance()) noexcept
+    : trace_(trace)
+    , name_(name)
+    , track_(track)
+    , arg_(arg) {
+        trace_.record(name_, track_, RoundTrace::Phase::Begin, arg_);
+    }
+
+    ~RoundTraceScope() {
+        trace_.record(name_, track_, RoundTrace::Phase::End, arg_);
+    }
+
+    RoundTraceScope(const RoundTraceScope&) = delete;
+    RoundTraceScope& operator=(const RoundTraceScope&) = delete;
+
+private:
+    RoundTrace& trace_;
+    const char* name_;
+    RoundTrace::Track track_;
+    int32_t arg_;
+};
+}  // namespace cs
+
+#endif  // ROUNDTRACE_HPP
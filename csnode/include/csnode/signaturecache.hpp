@@ -0,0 +1,109 @@
+#ifndef SIGNATURE_CACHE_HPP
+#define SIGNATURE_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <lib/system/common.hpp>
+
+namespace csdb {
+class Transaction;
+}
+
+namespace cs {
+///
+/// @brief Process wide cache of successfully verified signatures.
+/// Transaction signature is checked by API, by trusted nodes during round and by block validation,
+/// with cache it is checked once per node. Only positive results are stored, key covers signed data,
+/// signature and public key, so missed or evicted entry leads to a new verification only.
+///
+class SignatureCache {
+public:
+    // entries verified earlier than this number of rounds ago are expired
+    static constexpr RoundNumber kRoundsToLive = 100;
+    static constexpr size_t kDefaultCapacity = 1 << 17;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t failures = 0;
+        uint64_t evictions = 0;
+    };
+
+    ///
+    /// @brief Instance of signature cache, singleton.
+    /// @return Returns static signature cache object reference, Meyers singleton.
+    ///
+    static SignatureCache& instance();
+
+    explicit SignatureCache(size_t capacity = kDefaultCapacity);
+
+    bool verify(const Signature& signature, const PublicKey& publicKey, const Byte* data, size_t size);
+    bool verify(const csdb::Transaction& transaction, const PublicKey& publicKey);
+
+    // new round expires old entries
+    void setRound(RoundNumber round);
+
+    // zero capacity disables cache
+    void setCapacity(size_t capacity);
+    void clear();
+
+    Stats stats() const;
+
+private:
+    static constexpr size_t kShardsCount = 16;
+
+    struct KeyHash {
+        size_t operator()(const Hash& hash) const noexcept {
+            size_t result;
+            std::memcpy(&result, hash.data(), sizeof(result));
+            return result;
+        }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<Hash, RoundNumber, KeyHash> entries;
+        std::deque<std::pair<Hash, RoundNumber>> order;  // insertion order, rounds are not decreasing
+    };
+
+    // dataHash is the hash of signed data
+    static Hash makeKey(const Signature& signature, const PublicKey& publicKey, const Hash& dataHash);
+
+    // counts hit or miss
+    bool lookup(const Hash& key);
+
+    // counts failure or inserts key of verified signature, returns isVerified
+    bool remember(const Hash& key, bool isVerified);
+
+    bool find(const Hash& key);
+    void insert(const Hash& key);
+
+    // pops expired and exceeding entries from shard front, called under shard lock
+    void shrink(Shard& shard, size_t capacity, RoundNumber round);
+
+    Shard& shardOf(const Hash& key) {
+        return shards_[key.back() % kShardsCount];
+    }
+
+    bool isExpired(RoundNumber verified, RoundNumber round) const {
+        return verified + kRoundsToLive < round;
+    }
+
+    std::array<Shard, kShardsCount> shards_;
+
+    std::atomic<size_t> capacity_;
+    std::atomic<RoundNumber> round_ = 0;
+
+    std::atomic<uint64_t> hits_ = 0;
+    std::atomic<uint64_t> misses_ = 0;
+    std::atomic<uint64_t> failures_ = 0;
+    std::atomic<uint64_t> evictions_ = 0;
+};
+}  // namespace cs
+
+#endif  // SIGNATURE_CACHE_HPP
@@ -0,0 +1,125 @@
+#ifndef SYNCWINDOW_HPP
+#define SYNCWINDOW_HPP
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <csnode/nodecore.hpp>
+
+namespace cs {
+///
+/// @brief Sliding window of block requests spread across all good peers.
+/// Every peer has its own window of outstanding requests: it grows after each completed reply
+/// and halves on timeout, request timeout follows smoothed reply time of the peer.
+/// Class is not thread safe, it is used from node thread only.
+///
+class SyncWindow {
+public:
+    using Clock = std::chrono::steady_clock;
+    using RequestId = std::size_t;
+
+    static constexpr double kMinWindow = 1.0;
+    static constexpr double kMaxWindow = 32.0;
+    static constexpr std::chrono::milliseconds kInitialTimeout{5000};
+    static constexpr std::chrono::milliseconds kMinTimeout{200};
+    static constexpr std::chrono::milliseconds kMaxTimeout{30000};
+
+    struct Peer {
+        cs::PublicKey key;
+        cs::Sequence lastSequence = 0;
+    };
+
+    struct Request {
+        RequestId id = 0;
+        cs::PublicKey peer;
+        PoolsRequestedSequences sequences;
+    };
+
+    struct PeerState {
+        cs::Sequence lastSequence = 0;
+        double window = 0;
+        double threshold = kMaxWindow;
+        std::size_t inFlight = 0;
+        Clock::duration smoothedReply = Clock::duration::zero();
+        Clock::duration replyVariation = Clock::duration::zero();
+        bool isMeasured = false;
+        uint64_t replies = 0;
+        uint64_t timeouts = 0;
+
+        Clock::duration timeout() const;
+    };
+
+    explicit SyncWindow(std::size_t blocksPerRequest, double initialWindow = 2.0);
+
+    // sequences [from, to] are needed, requests below from are forgotten
+    void setRange(cs::Sequence from, cs::Sequence to);
+
+    // requests to peers absent in the list are forgotten and their sequences go to retry
+    void setPeers(const std::vector<Peer>& peers);
+
+    // new requests allowed by peer windows, round robin by peers
+    std::vector<Request> schedule(Clock::time_point now = Clock::now());
+
+    // returns false if request is unknown (timed out or cancelled), received sequences are counted anyway
+    bool onReply(RequestId id, const PoolsRequestedSequences& received, Clock::time_point now = Clock::now());
+
+    // block got by any way, it is not requested anymore
+    void onReceived(cs::Sequence sequence);
+
+    // block got but failed validation, it is requested again
+    void onRejected(cs::Sequence sequence);
+
+    // request was not sent, sequences are requested again without penalty
+    void cancel(RequestId id);
+
+    // expires timed out requests, returns count of them
+    std::size_t expire(Clock::time_point now = Clock::now());
+
+    // forgets requests and received sequences, peers statistics is kept
+    void clear();
+
+    bool isDone() const;
+    std::size_t outstanding() const;
+    const PeerState* peerState(const cs::PublicKey& key) const;
+
+private:
+    struct Pending {
+        cs::PublicKey peer;
+        std::set<cs::Sequence> sequences;
+        Clock::time_point sent;
+        bool isReplied = false;
+    };
+
+    using Requests = std::unordered_map<RequestId, Pending>;
+
+    bool isNeeded(cs::Sequence sequence) const;
+    PoolsRequestedSequences takeSequences(cs::Sequence limit);
+
+    void measure(PeerState& peer, Clock::duration reply);
+
+    // removes request, returns its not received sequences to retry
+    Requests::iterator release(Requests::iterator iter);
+
+    const std::size_t blocksPerRequest_;
+    const double initialWindow_;
+
+    std::map<cs::PublicKey, PeerState> peers_;
+    Requests requests_;
+
+    // [key] = sequence, [value] = request id
+    std::unordered_map<cs::Sequence, RequestId> inFlight_;
+    std::set<cs::Sequence> received_;
+    std::set<cs::Sequence> retry_;
+
+    cs::Sequence from_ = 1;
+    cs::Sequence to_ = 0;
+    cs::Sequence next_ = 1;
+
+    RequestId lastId_ = 0;
+};
+}  // namespace cs
+
+#endif  // SYNCWINDOW_HPP
@@ -3,13 +3,18 @@
 
 #include <csdb/transaction.hpp>
 #include <lib/system/common.hpp>
+#include <lib/system/hash.hpp>
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace cs {
 ///
-/// Wrapper of std::vector<uint8_t> to represent hash
+/// Transactions packet hash, bytes are kept inline with the bucket key calculated once,
+/// so the hash is copied without allocations and hashed containers do not rehash its bytes
 ///
 class TransactionsPacketHash {
 public:  // Static interface
@@ -28,7 +33,7 @@ public:  // Static interface
     ///         If the binary representation is incorrect, an empty hash is returned.
     ///
     static TransactionsPacketHash fromBinary(const cs::Bytes& data);
-    static TransactionsPacketHash fromBinary(cs::Bytes&& data);
+    static TransactionsPacketHash fromBinary(const cs::Byte* data, size_t size);
 
     ///
     /// @brief Calculates hash from binary data
@@ -36,26 +41,42 @@ public:  // Static interface
     /// @return hash
     ///
     static TransactionsPacketHash calcFromData(const cs::Bytes& data);
+    static TransactionsPacketHash calcFromData(const cs::Byte* data, size_t size);
 
 public:  // Interface
     TransactionsPacketHash() = default;
-    TransactionsPacketHash(const TransactionsPacketHash&) = default;
-    TransactionsPacketHash(TransactionsPacketHash&&) = default;
-
-    TransactionsPacketHash& operator=(const TransactionsPacketHash&) = default;
-    TransactionsPacketHash& operator=(TransactionsPacketHash&&) = default;
+    explicit TransactionsPacketHash(const cs::Hash& hash) noexcept;
 
     ///
     /// @brief Сhecks hash size bytes on 0
     /// @return true if hash size == 0
     ///
-    bool isEmpty() const noexcept;
+    bool isEmpty() const noexcept {
+        return m_isEmpty;
+    }
 
     ///
     /// @brief Returns hash bytes count
     /// @return hash bytes count
     ///
-    size_t size() const noexcept;
+    size_t size() const noexcept {
+        return m_isEmpty ? 0 : m_bytes.size();
+    }
+
+    ///
+    /// @brief Returns pointer to hash bytes, size() bytes are valid
+    ///
+    const cs::Byte* data() const noexcept {
+        return m_bytes.data();
+    }
+
+    ///
+    /// @brief Returns bucket key of hashed containers, it is mixed with the process key
+    /// and must not be sent or used to order hashes
+    ///
+    uint64_t key() const noexcept {
+        return m_key;
+    }
 
     ///
     /// @brief Coverts transactions packet hash to string.
@@ -67,18 +88,37 @@ public:  // Interface
     /// @brief Coverts transactions packet hash to binary.
     /// @return vector of bytes
     ///
-    const cs::Bytes& toBinary() const noexcept;
+    cs::Bytes toBinary() const noexcept;
+
+    bool operator==(const TransactionsPacketHash& other) const noexcept {
+        return m_key == other.m_key && m_isEmpty == other.m_isEmpty && m_bytes == other.m_bytes;
+    }
+
+    bool operator!=(const TransactionsPacketHash& other) const noexcept {
+        return !operator==(other);
+    }
+
+    // the same order as of binary representations
+    bool operator<(const TransactionsPacketHash& other) const noexcept {
+        if (m_isEmpty || other.m_isEmpty) {
+            return m_isEmpty && !other.m_isEmpty;
+        }
 
-    bool operator==(const TransactionsPacketHash& other) const noexcept;
-    bool operator!=(const TransactionsPacketHash& other) const noexcept;
-    bool operator<(const TransactionsPacketHash& other) const noexcept;
+        return m_bytes < other.m_bytes;
+    }
 
 private:  // Members
-    cs::Bytes m_bytes;
+    cs::Hash m_bytes{};
+    uint64_t m_key = 0;
+    bool m_isEmpty = true;
 };
 
+static_assert(std::is_trivially_copyable_v<TransactionsPacketHash>, "Transactions packet hash must be copied as is");
+
 ///
-/// Flexible strorage for transactions
+/// Flexible strorage for transactions.
+/// Packet keeps its binary representation once serialized or received, so hash and retransmission reuse it,
+/// received transactions are decoded on first access. Const methods are safe to call concurrently
 ///
 class TransactionsPacket {
 public:  // Static interface
@@ -111,14 +151,15 @@ public:  // Interface
 
     TransactionsPacket() = default;
 
-    TransactionsPacket(const TransactionsPacket& packet) = default;
+    TransactionsPacket(const TransactionsPacket& packet);
     TransactionsPacket(TransactionsPacket&& packet);
 
     TransactionsPacket& operator=(const TransactionsPacket& packet);
+    TransactionsPacket& operator=(TransactionsPacket&& packet);
 
     ///
     /// @brief Coverts transactions packet to binary representation.
-    /// @return packet as binary representation
+    /// @return packet as binary representation, parts of the kept one
     ///
     cs::Bytes toBinary(Serialization options = Serialization::All) const noexcept;
 
@@ -144,7 +185,7 @@ public:  // Interface
     /// @brief Returns transactions count
     /// @return Size of transactions vector
     ///
-    size_t transactionsCount() const noexcept;
+    size_t transactionsCount() const;
 
     ///
     /// @brief Adds signature to transaction vector
@@ -169,17 +210,17 @@ public:  // Interface
     /// @brief Returns transactions
     /// @return Reference to transactions vector
     ///
-    const std::vector<csdb::Transaction>& transactions() const noexcept;
+    const std::vector<csdb::Transaction>& transactions() const;
 
     ///
     /// @brief Returns transactions
     /// @return Reference to signatures vector
     ///
-    const cs::BlockSignatures& signatures() const noexcept;
+    const cs::BlockSignatures& signatures() const;
 
     ///
     /// @brief Returns trabsactions, non const version
-    /// @return Reference to transactions vector
+    /// @return Reference to transactions vector, kept binary representation is dropped as they may be changed
     ///
     std::vector<csdb::Transaction>& transactions();
 
@@ -187,22 +228,44 @@ public:  // Interface
     /// @brief Returns state trabsactions, non const version
     /// @return Reference to transactions vector
     ///
-    const std::vector<csdb::Transaction>& stateTransactions() const noexcept;
+    const std::vector<csdb::Transaction>& stateTransactions() const;
 
     ///
     /// @brief Clears transactions vector
     ///
-    void clear() noexcept;
+    void clear();
 
 private:  // Service
     void put(::csdb::priv::obstream& os, Serialization options) const;
-    bool get(::csdb::priv::ibstream& is);
+    bool get(::csdb::priv::ibstream& is) const;
+
+    // keeps binary representation if it is the same as serialized one, nothing is decoded
+    bool split(const char* data, size_t size);
+
+    // decodes kept binary representation on first access
+    void decode() const;
+
+    // serializes packet if binary representation is not kept, must be called under m_mutex
+    const cs::Bytes& binary() const;
+
+    // drops binary representation of changed packet
+    void invalidate();
 
 private:  // Members
     TransactionsPacketHash m_hash;
-    std::vector<csdb::Transaction> m_transactions;
-    std::vector<csdb::Transaction> m_stateTransactions;
-    cs::BlockSignatures m_signatures;
+
+    // decoded from m_binary on first access
+    mutable std::vector<csdb::Transaction> m_transactions;
+    mutable std::vector<csdb::Transaction> m_stateTransactions;
+    mutable cs::BlockSignatures m_signatures;
+
+    // serialized with Serialization::All, the sections of states and signatures start at offsets
+    mutable cs::Bytes m_binary;
+    mutable size_t m_statesOffset = 0;
+    mutable size_t m_signaturesOffset = 0;
+
+    mutable std::atomic<bool> m_isDecoded{true};
+    mutable std::mutex m_mutex;
 };
 }  // namespace cs
 
@@ -0,0 +1,148 @@
+#include <csnode/blockapplier.hpp>
+
+#include <algorithm>
+
+cs::BlockApplier::BlockApplier(Validator validator, Store store, std::size_t capacity)
+: validator_(std::move(validator))
+, store_(std::move(store))
+, capacity_(capacity)
+, thread_(&BlockApplier::run, this) {
+}
+
+cs::BlockApplier::~BlockApplier() {
+    {
+        std::lock_guard lock(mutex_);
+        isStopped_ = true;
+    }
+
+    bufferCondition_.notify_all();
+    appliedCondition_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void cs::BlockApplier::reset(cs::Sequence next) {
+    {
+        std::lock_guard lock(mutex_);
+        buffer_.clear();
+        next_ = next;
+        ++generation_;
+    }
+
+    appliedCondition_.notify_all();
+}
+
+void cs::BlockApplier::advance(cs::Sequence next) {
+    {
+        std::lock_guard lock(mutex_);
+
+        if (next <= next_) {
+            return;
+        }
+
+        next_ = next;
+        dropOutdated();
+    }
+
+    bufferCondition_.notify_one();
+    appliedCondition_.notify_all();
+}
+
+bool cs::BlockApplier::push(csdb::Pool&& pool) {
+    const cs::Sequence sequence = pool.sequence();
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (sequence < next_) {
+            return false;
+        }
+
+        // the expected block is always accepted, otherwise the full buffer would stall
+        if (buffer_.size() >= capacity_ && sequence != next_) {
+            return false;
+        }
+
+        if (!buffer_.try_emplace(sequence, std::move(pool)).second) {
+            return false;
+        }
+
+        if (sequence != next_) {
+            return true;
+        }
+    }
+
+    bufferCondition_.notify_one();
+    return true;
+}
+
+bool cs::BlockApplier::wait(cs::Sequence sequence, std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    return appliedCondition_.wait_for(lock, timeout, [&] { return isStopped_ || next_ > sequence; }) && next_ > sequence;
+}
+
+cs::Sequence cs::BlockApplier::next() const {
+    std::lock_guard lock(mutex_);
+    return next_;
+}
+
+std::size_t cs::BlockApplier::size() const {
+    std::lock_guard lock(mutex_);
+    return buffer_.size();
+}
+
+uint64_t cs::BlockApplier::appliedCount() const {
+    std::lock_guard lock(mutex_);
+    return applied_;
+}
+
+void cs::BlockApplier::run() {
+    std::unique_lock lock(mutex_);
+
+    while (!isStopped_) {
+        bufferCondition_.wait(lock, [this] { return isStopped_ || isReady(); });
+
+        if (isStopped_) {
+            break;
+        }
+
+        auto node = buffer_.extract(buffer_.begin());
+        const uint64_t generation = generation_;
+
+        // validation and storing do not block peers pushing new blocks
+        lock.unlock();
+
+        csdb::Pool& pool = node.mapped();
+        const bool isApplied = validator_(pool) && store_(pool);
+
+        lock.lock();
+
+        // reset while block was applied, the result belongs to previous state
+        if (generation != generation_) {
+            continue;
+        }
+
+        if (isApplied) {
+            // store may advance expected sequence by itself while the block is applied unlocked
+            next_ = std::max(next_, node.key() + 1);
+            ++applied_;
+            dropOutdated();
+            appliedCondition_.notify_all();
+        }
+        else {
+            lock.unlock();
+            emit rejected(node.key());
+            lock.lock();
+        }
+    }
+}
+
+void cs::BlockApplier::dropOutdated() {
+    buffer_.erase(buffer_.begin(), buffer_.lower_bound(next_));
+}
+
+bool cs::BlockApplier::isReady() const {
+    return !buffer_.empty() && buffer_.begin()->first == next_;
+}
@@ -11,6 +11,7 @@
 #include <csnode/datastream.hpp>
 #include <csnode/fee.hpp>
 #include <csnode/nodeutils.hpp>
+#include <csnode/roundtrace.hpp>
 #include <csnode/transactionsiterator.hpp>
 #include <solver/smartcontracts.hpp>
 
@@ -123,9 +124,29 @@ BlockChain::BlockChain(csdb::Address genesisAddress, csdb::Address startAddress,
 BlockChain::~BlockChain() {
 }
 
-bool BlockChain::init(const std::string& path) {
+void BlockChain::registerMetrics() {
+    auto& registry = cs::metrics::Registry::instance();
+    probes_.clear();
+
+    probes_.push_back(registry.probe("cs_storage_write_queue_depth", "Blocks waiting to be written to database", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(storage_.write_queue_size()); }));
+    probes_.push_back(registry.probe("cs_pools_cache_hits_total", "Blocks got from pools cache", cs::metrics::Type::Counter,
+                                     [this] { return static_cast<double>(storage_.pools_cache_stats().hits); }));
+    probes_.push_back(registry.probe("cs_pools_cache_misses_total", "Blocks not found in pools cache", cs::metrics::Type::Counter,
+                                     [this] { return static_cast<double>(storage_.pools_cache_stats().misses); }));
+    probes_.push_back(registry.probe("cs_pools_cache_evictions_total", "Blocks evicted from pools cache", cs::metrics::Type::Counter,
+                                     [this] { return static_cast<double>(storage_.pools_cache_stats().evictions); }));
+    probes_.push_back(registry.probe("cs_pools_cache_bytes", "Serialized size of blocks in pools cache", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(storage_.pools_cache_stats().bytes); }));
+}
+
+bool BlockChain::init(const std::string& path, size_t poolsCacheLimit, size_t cachedBlocksLimit) {
     cslog() << "Trying to open DB...";
 
+    storage_.set_pools_cache_limit(poolsCacheLimit);
+    cachedBlocks_.setMemoryLimit(cachedBlocksLimit);
+    registerMetrics();
+
     size_t totalLoaded = 0;
     lastSequence_ = 0;
     csdb::Storage::OpenCallback progress = [&](const csdb::Storage::OpenProgress& progress) {
@@ -569,6 +590,8 @@ void BlockChain::logBlockInfo(csdb::Pool& pool) {
 }
 
 bool BlockChain::finalizeBlock(csdb::Pool& pool, bool isTrusted, cs::PublicKeys lastConfidants) {
+    cs::RoundTraceScope trace("finalize block", cs::RoundTrace::Track::Blocks, static_cast<int32_t>(pool.sequence()));
+
     if (!pool.compose()) {
         csmeta(cserror) << "Couldn't compose block: " << pool.sequence();
         return false;
@@ -1225,6 +1248,7 @@ bool BlockChain::deferredBlockExchange(cs::RoundPackage& rPackage, const csdb::P
 
 bool BlockChain::storeBlock(csdb::Pool& pool, bool bySync) {
     csdebug() << csfunc() << ":";
+    cs::RoundTraceScope trace("store block", cs::RoundTrace::Track::Blocks, static_cast<int32_t>(pool.sequence()));
 
     const auto lastSequence = getLastSeq();
     const auto poolSequence = pool.sequence();
@@ -1300,15 +1324,14 @@ bool BlockChain::storeBlock(csdb::Pool& pool, bool bySync) {
         return false;
     }
 
-    if (cachedBlocks_.count(poolSequence) > 0) {
+    // cache block for future recording
+    if (!cachedBlocks_.insert(poolSequence, pool, bySync)) {
         csdebug() << "BLOCKCHAIN> ignore duplicated block #" << poolSequence << " in cache";
         // it is not error, so caller code nothing to do with it
         return true;
     }
-    // cache block for future recording
-    cachedBlocks_.emplace(poolSequence, BlockMeta{pool, bySync});
     csdebug() << "BLOCKCHAIN> cache block #" << poolSequence << " signed by " << pool.signatures().size()
-        << " nodes for future (" << cachedBlocks_.size() << " total)";
+        << " nodes for future (" << cachedBlocks_.size() << " total, " << cachedBlocks_.spilledCount() << " spilled to disk)";
     cachedBlockEvent(poolSequence);
     // cache always successful
     return true;
@@ -1323,23 +1346,24 @@ void BlockChain::testCachedBlocks() {
 
     auto lastSeq = getLastSeq() + 1;
     // clear unnecessary sequence
-    if (cachedBlocks_.cbegin()->first < lastSeq) {
-        auto it = cachedBlocks_.lower_bound(lastSeq);
-        if (it != cachedBlocks_.begin()) {
-            csdebug() << "BLOCKCHAIN> Remove outdated blocks up to #" << (*it).first << " from cache";
-            cachedBlocks_.erase(cachedBlocks_.begin(), it);
-        }
+    if (cachedBlocks_.first().value() < lastSeq) {
+        csdebug() << "BLOCKCHAIN> Remove outdated blocks up to #" << lastSeq << " from cache";
+        cachedBlocks_.eraseBefore(lastSeq);
     }
 
     while (!cachedBlocks_.empty()) {
-        auto firstBlockInCache = cachedBlocks_.begin();
+        const auto firstBlockInCache = cachedBlocks_.first().value();
 
-        if ((*firstBlockInCache).first == lastSeq) {
+        if (firstBlockInCache == lastSeq) {
             csdebug() << "BLOCKCHAIN> Retrieve required block #" << lastSeq << " from cache";
-            // retrieve and use block if it is exactly what we need:
+            // retrieve and use block if it is exactly what we need, spilled block is read back from disk:
+            auto block = cachedBlocks_.extract(lastSeq);
+            if (!block.has_value()) {
+                cserror() << "BLOCKCHAIN> Failed to read cached block #" << lastSeq << ", wait to request again";
+                break;
+            }
 
-            const bool ok = storeBlock((*firstBlockInCache).second.pool, (*firstBlockInCache).second.by_sync);
-            cachedBlocks_.erase(firstBlockInCache);
+            const bool ok = storeBlock(block.value().pool, block.value().bySync);
             if (!ok) {
                 cserror() << "BLOCKCHAIN> Failed to record cached block to chain, drop it & wait to request again";
                 break;
@@ -1348,7 +1372,7 @@ void BlockChain::testCachedBlocks() {
         }
         else {
             // stop processing, we have not got required block in cache yet
-            csdebug() << "BLOCKCHAIN> Stop store block from cache. Next blocks in cache #" << (*firstBlockInCache).first;
+            csdebug() << "BLOCKCHAIN> Stop store block from cache. Next blocks in cache #" << firstBlockInCache;
             break;
         }
     }
@@ -1376,25 +1400,29 @@ std::vector<BlockChain::SequenceInterval> BlockChain::getRequiredBlocks() const
     // return at least [next, 0] or [next, currentRoundNumber]:
     std::vector<SequenceInterval> vec{std::make_pair(firstSequence, roundNumber)};
 
-    // always point to last interval
-    auto firstUpper = cachedBlocks_.upper_bound(firstSequence);
+    // gaps between cached ranges, both in memory and spilled ones
+    std::optional<cs::Sequence> previousEnd;
 
-    if (firstUpper != cachedBlocks_.end()) {
-        auto sequence = firstUpper->first;
-        vec[0].second = sequence - 1;
+    for (const auto& [from, to] : cachedBlocks_.ranges()) {
+        if (to <= firstSequence) {
+            continue;
+        }
 
-        while ((++firstUpper) != cachedBlocks_.end()) {
-            ++sequence;
-            if (firstUpper->first != sequence) {
-                vec.emplace_back(std::make_pair(sequence, firstUpper->first - 1));
-                sequence = firstUpper->first;
-            }
+        const auto begin = std::max(from, firstSequence + 1);
+
+        if (!previousEnd.has_value()) {
+            vec[0].second = begin - 1;
+        }
+        else {
+            vec.emplace_back(std::make_pair(previousEnd.value() + 1, begin - 1));
         }
+
+        previousEnd = to;
     }
 
     // add last interval [final + 1, end]
     if (!cachedBlocks_.empty()) {
-        const auto lastCahedBlock = cachedBlocks_.crbegin()->first;
+        const auto lastCahedBlock = cachedBlocks_.last().value();
         if (roundNumber > lastCahedBlock) {
             vec.emplace_back(std::make_pair(lastCahedBlock, roundNumber));
         }
@@ -0,0 +1,282 @@
+#include <csnode/blockscache.hpp>
+
+#include <fstream>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <lib/system/logger.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace {
+std::size_t serializedSize(csdb::Pool& pool) {
+    uint32_t size = 0;
+    pool.to_byte_stream(size);
+    return size;
+}
+}  // namespace
+
+cs::BlocksCache::BlocksCache(std::size_t memoryLimit, fs::path directory)
+: memoryLimit_(memoryLimit)
+, directory_(std::move(directory)) {
+    if (directory_.empty()) {
+        boost::system::error_code code;
+        const auto temp = fs::temp_directory_path(code);
+
+        // blocks are not spilled without directory
+        if (!code) {
+            directory_ = temp / fs::unique_path("cs-blocks-%%%%-%%%%-%%%%", code);
+        }
+    }
+}
+
+cs::BlocksCache::~BlocksCache() {
+    boost::system::error_code code;
+
+    for (const auto sequence : spilled_) {
+        fs::remove(path(sequence), code);
+    }
+
+    if (isDirectoryCreated_) {
+        fs::remove_all(directory_, code);
+    }
+}
+
+bool cs::BlocksCache::insert(cs::Sequence sequence, csdb::Pool pool, bool bySync) {
+    if (entries_.count(sequence) > 0) {
+        return false;
+    }
+
+    Entry entry;
+    entry.bytes = serializedSize(pool);
+    entry.bySync = bySync;
+    entry.pool = std::move(pool);
+
+    memoryBytes_ += entry.bytes;
+    entries_.emplace(sequence, std::move(entry));
+    resident_.insert(sequence);
+
+    shrink();
+    return true;
+}
+
+std::optional<cs::BlocksCache::Item> cs::BlocksCache::extract(cs::Sequence sequence) {
+    auto it = entries_.find(sequence);
+
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+
+    const bool isResident = resident_.count(sequence) > 0;
+    std::optional<csdb::Pool> pool = isResident ? std::move(it->second.pool) : load(sequence);
+    const bool bySync = it->second.bySync;
+    remove(it);
+    refill();
+
+    if (!pool.has_value()) {
+        return std::nullopt;
+    }
+
+    return Item{std::move(pool).value(), bySync};
+}
+
+void cs::BlocksCache::eraseBefore(cs::Sequence sequence) {
+    while (!entries_.empty() && entries_.begin()->first < sequence) {
+        remove(entries_.begin());
+    }
+
+    refill();
+}
+
+bool cs::BlocksCache::contains(cs::Sequence sequence) const {
+    return entries_.count(sequence) > 0;
+}
+
+bool cs::BlocksCache::empty() const {
+    return entries_.empty();
+}
+
+std::size_t cs::BlocksCache::size() const {
+    return entries_.size();
+}
+
+std::optional<cs::Sequence> cs::BlocksCache::first() const {
+    if (entries_.empty()) {
+        return std::nullopt;
+    }
+
+    return entries_.cbegin()->first;
+}
+
+std::optional<cs::Sequence> cs::BlocksCache::last() const {
+    if (entries_.empty()) {
+        return std::nullopt;
+    }
+
+    return entries_.crbegin()->first;
+}
+
+std::vector<std::pair<cs::Sequence, cs::Sequence>> cs::BlocksCache::ranges() const {
+    std::vector<std::pair<cs::Sequence, cs::Sequence>> result;
+
+    for (const auto& [sequence, entry] : entries_) {
+        if (!result.empty() && result.back().second + 1 == sequence) {
+            result.back().second = sequence;
+        }
+        else {
+            result.emplace_back(sequence, sequence);
+        }
+    }
+
+    return result;
+}
+
+void cs::BlocksCache::setMemoryLimit(std::size_t memoryLimit) {
+    memoryLimit_ = memoryLimit;
+    shrink();
+    refill();
+}
+
+std::size_t cs::BlocksCache::memoryLimit() const {
+    return memoryLimit_;
+}
+
+std::size_t cs::BlocksCache::memoryBytes() const {
+    return memoryBytes_;
+}
+
+std::size_t cs::BlocksCache::spilledCount() const {
+    return spilled_.size();
+}
+
+std::size_t cs::BlocksCache::spilledBytes() const {
+    return spilledBytes_;
+}
+
+void cs::BlocksCache::shrink() {
+    while (memoryBytes_ > memoryLimit_ && !resident_.empty()) {
+        const auto sequence = *resident_.rbegin();
+        auto& entry = entries_.at(sequence);
+
+        if (!spill(sequence, entry)) {
+            // keep blocks in memory, the next insertion tries again
+            break;
+        }
+
+        memoryBytes_ -= entry.bytes;
+        spilledBytes_ += entry.bytes;
+        entry.pool.reset();
+
+        resident_.erase(sequence);
+        spilled_.insert(sequence);
+    }
+}
+
+void cs::BlocksCache::refill() {
+    while (!spilled_.empty()) {
+        const auto sequence = *spilled_.begin();
+        auto& entry = entries_.at(sequence);
+
+        if (memoryBytes_ + entry.bytes > memoryLimit_) {
+            break;
+        }
+
+        entry.pool = load(sequence);
+        spilled_.erase(sequence);
+        spilledBytes_ -= entry.bytes;
+
+        // lost block leaves a gap in ranges and is requested again
+        if (!entry.pool.has_value()) {
+            entries_.erase(sequence);
+            continue;
+        }
+
+        memoryBytes_ += entry.bytes;
+        resident_.insert(sequence);
+    }
+}
+
+bool cs::BlocksCache::spill(cs::Sequence sequence, Entry& entry) {
+    if (directory_.empty()) {
+        return false;
+    }
+
+    if (!isDirectoryCreated_) {
+        boost::system::error_code code;
+        fs::create_directories(directory_, code);
+
+        if (code) {
+            cswarning() << "BLOCKS CACHE> failed to create " << directory_.string() << ", blocks are kept in memory";
+            directory_.clear();
+            return false;
+        }
+
+        isDirectoryCreated_ = true;
+    }
+
+    uint32_t size = 0;
+    const char* data = entry.pool.value().to_byte_stream(size);
+
+    std::ofstream file(path(sequence).string(), std::ios::binary | std::ios::trunc);
+    file.write(data, size);
+
+    if (!file.good()) {
+        cswarning() << "BLOCKS CACHE> failed to spill block #" << sequence << ", blocks are kept in memory";
+        return false;
+    }
+
+    return true;
+}
+
+std::optional<csdb::Pool> cs::BlocksCache::load(cs::Sequence sequence) const {
+    const auto file = path(sequence);
+    cs::Bytes bytes;
+
+    {
+        std::ifstream stream(file.string(), std::ios::binary | std::ios::ate);
+
+        if (stream.good()) {
+            bytes.resize(static_cast<std::size_t>(stream.tellg()));
+            stream.seekg(0);
+            stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        if (!stream.good()) {
+            bytes.clear();
+        }
+    }
+
+    boost::system::error_code code;
+    fs::remove(file, code);
+
+    csdb::Pool pool = bytes.empty() ? csdb::Pool{} : csdb::Pool::from_binary(std::move(bytes));
+
+    if (!pool.is_valid()) {
+        cserror() << "BLOCKS CACHE> failed to load spilled block #" << sequence << ", it is requested again";
+        return std::nullopt;
+    }
+
+    return pool;
+}
+
+void cs::BlocksCache::remove(Entries::iterator it) {
+    const auto sequence = it->first;
+
+    if (resident_.count(sequence) > 0) {
+        memoryBytes_ -= it->second.bytes;
+        resident_.erase(sequence);
+    }
+    else {
+        spilledBytes_ -= it->second.bytes;
+        spilled_.erase(sequence);
+
+        boost::system::error_code code;
+        fs::remove(path(sequence), code);
+    }
+
+    entries_.erase(it);
+}
+
+fs::path cs::BlocksCache::path(cs::Sequence sequence) const {
+    return directory_ / std::to_string(sequence);
+}
@@ -1,5 +1,9 @@
 #include <csnode/blockvalidator.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
 #include <csnode/node.hpp>
 #include <csnode/blockchain.hpp>
 #include <csnode/walletsstate.hpp>
@@ -9,8 +13,16 @@
 namespace cs {
 
 BlockValidator::BlockValidator(Node& node)
+: BlockValidator(node.getBlockChain(), &node, 0) {
+}
+
+BlockValidator::BlockValidator(const BlockChain& blockchain, size_t threadsCount)
+: BlockValidator(blockchain, nullptr, threadsCount) {
+}
+
+BlockValidator::BlockValidator(const BlockChain& blockchain, Node* node, size_t threadsCount)
 : node_(node)
-, bc_(node_.getBlockChain())
+, bc_(blockchain)
 , wallets_(::std::make_shared<WalletsState>(bc_.getCacheUpdater())) {
     plugins_.insert(std::make_pair(hashIntergrity, std::make_unique<HashValidator>(*this)));
     plugins_.insert(std::make_pair(blockNum, std::make_unique<BlockNumValidator>(*this)));
@@ -19,16 +31,33 @@ BlockValidator::BlockValidator(Node& node)
     plugins_.insert(std::make_pair(smartSignatures, std::make_unique<SmartSourceSignaturesValidator>(*this)));
     plugins_.insert(std::make_pair(balances, std::make_unique<BalanceChecker>(*this)));
     plugins_.insert(std::make_pair(transactionsSignatures, std::make_unique<TransactionsChecker>(*this)));
-    plugins_.insert(std::make_pair(smartStates, std::make_unique<SmartStateValidator>(*this)));
+
+    if (node_ != nullptr) {
+        plugins_.insert(std::make_pair(smartStates, std::make_unique<SmartStateValidator>(*this)));
+    }
+
     /*HL99dwfM3YPQnauN1djBvVLZNbC3b1FHwe5vPv8pDZ1y - 0xAAE*/
     /*CSa4DTfTcenryQAifiPKVpY9jzWshYY11g3mXQR6B7rJ - dAp*/
     /*8Vr9JA4AessnxVthGjp2ae7YLWQPU7jMvWYiPZA6vpDH - -253CS*/
     /*HtimoDtTYGSVotnQ5Eo4eud3FkDv5r2QYiKSZcdWP7Z8 - Timo*/
     plugins_.insert(std::make_pair(accountBalance, std::make_unique<AccountBalanceChecker>(*this, "HtimoDtTYGSVotnQ5Eo4eud3FkDv5r2QYiKSZcdWP7Z8")));
+
+    if (threadsCount == 0) {
+        threadsCount = std::min<size_t>(std::thread::hardware_concurrency(), kMaxValidationThreads);
+    }
+
+    if (threadsCount > 1) {
+        threads_ = std::make_unique<Threads>(threadsCount);
+    }
 }
 
 BlockValidator::~BlockValidator() {}
 
+void BlockValidator::setPlugin(ValidationLevel level, std::unique_ptr<ValidationPlugin> plugin) {
+    assert((plugin->dependencies() & level) == 0);
+    plugins_[level] = std::move(plugin);
+}
+
 inline bool BlockValidator::return_(ErrorType error, SeverityLevel severity) {
     return !(error >> severity);
 }
@@ -51,17 +80,57 @@ bool BlockValidator::validateBlock(const csdb::Pool& block, ValidationFlags flag
         }
     }
 
-    ErrorType validationResult = noError;
-    for (auto& plugin : plugins_) {
-        if (flags & plugin.first) {
-            validationResult = plugin.second->validateBlock(block);
-            if (!return_(validationResult, severity)) {
-                return false;
-            }
-        }
+    if (!runPlugins(block, flags, severity)) {
+        return false;
     }
 
     prevBlock_ = block;
     return true;
 }
+
+bool BlockValidator::runPlugins(const csdb::Pool& block, ValidationFlags flags, SeverityLevel severity) {
+    std::map<ValidationLevel, size_t> indexes;
+    graph_.clear();
+
+    ValidationFlags waiting = noValidation;
+
+    for (const auto& [level, plugin] : plugins_) {
+        if (flags & level) {
+            waiting |= level;
+        }
+    }
+
+    // plugin is added after all of its dependencies taking part in validation, so graph gets them before dependent plugins
+    while (waiting) {
+        const ValidationFlags added = waiting;
+
+        for (auto& [level, plugin] : plugins_) {
+            if (!(waiting & level) || (plugin->dependencies() & waiting)) {
+                continue;
+            }
+
+            TaskGraph::Mask dependencies = 0;
+
+            for (const auto& [dependency, index] : indexes) {
+                if (plugin->dependencies() & dependency) {
+                    dependencies |= TaskGraph::Mask(1) << index;
+                }
+            }
+
+            auto task = [this, &block, severity, validator = plugin.get()] {
+                return return_(validator->validateBlock(block), severity);
+            };
+
+            indexes.emplace(level, graph_.add(std::move(task), dependencies, plugin->isConcurrent()));
+            waiting &= ~level;
+        }
+
+        if (waiting == added) {
+            cserror() << "BlockValidator: cyclic dependencies of validation plugins";
+            return false;
+        }
+    }
+
+    return graph_.run(threads_.get());
+}
 }  // namespace cs
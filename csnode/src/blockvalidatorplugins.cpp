@@ -6,6 +6,7 @@
 
 #include <csdb/pool.hpp>
 #include <csnode/blockchain.hpp>
+#include <csnode/signaturecache.hpp>
 #include <lib/system/logger.hpp>
 #include <lib/system/common.hpp>
 #include <csnode/walletsstate.hpp>
@@ -31,7 +32,10 @@ const uint8_t kBlockVerToSwitchCountedFees = 0;
 namespace cs {
 
 const cs::SmartContracts* ValidationPlugin::getSmartContracts() const {
-    const auto ptr = blockValidator_.node_.getSolver();
+    if (blockValidator_.node_ == nullptr) {
+        return nullptr;
+    }
+    const auto ptr = blockValidator_.node_->getSolver();
     if (ptr == nullptr) {
         return nullptr;
     }
@@ -76,7 +80,7 @@ bool SmartStateValidator::checkNewState(const csdb::Transaction& t) {
         cserror() << "load block with init trx failed";
         return false;
     }
-    auto connectorPtr = getNode().getConnector();
+    auto connectorPtr = getNode()->getConnector();
     if (connectorPtr == nullptr) {
         cserror() << kLogPrefix << "unavailable connector ptr";
         return false;
@@ -199,6 +203,10 @@ ValidationPlugin::ErrorType TimestampValidator::validateBlock(const csdb::Pool&
 }
 
 ValidationPlugin::ErrorType BlockSignaturesValidator::validateBlock(const csdb::Pool& block) {
+  return checkSignatures(block, [this] { return isCancelled(); });
+}
+
+ValidationPlugin::ErrorType BlockSignaturesValidator::checkSignatures(const csdb::Pool& block, const std::function<bool()>& isCancelled) {
   uint64_t realTrustedMask = block.realTrusted();
 #ifdef _MSC_VER
   size_t numOfRealTrusted = static_cast<decltype(numOfRealTrusted)>(__popcnt64(realTrustedMask));
@@ -225,12 +233,12 @@ ValidationPlugin::ErrorType BlockSignaturesValidator::validateBlock(const csdb::
 
   size_t checkingSignature = 0;
   auto signedData = cscrypto::calculateHash(block.to_binary().data(), block.hashingLength());
-  for (size_t i = 0; i < confidants.size(); ++i) {
+  for (size_t i = 0; i < confidants.size() && !(isCancelled && isCancelled()); ++i) {
     if (realTrustedMask & (1ull << i)) {
-      if (!cscrypto::verifySignature(signatures[checkingSignature],
-                                     confidants[i],
-                                     signedData.data(),
-                                     cscrypto::kHashSize)) {
+      if (!SignatureCache::instance().verify(signatures[checkingSignature],
+                                             confidants[i],
+                                             signedData.data(),
+                                             cscrypto::kHashSize)) {
         cserror() << kLogPrefix << "block " << block.sequence()
                   << " has invalid signatures";
         return ErrorType::error;
@@ -273,6 +281,10 @@ bool SmartSourceSignaturesValidator::checkSignatures(const SmartSignatures& sigs
   }
 
   for (const auto& pack : smartPacks) {
+    if (isCancelled()) {
+      break;
+    }
+
     auto it = std::find_if(sigs.begin(), sigs.end(),
                            [&pack] (const csdb::Pool::SmartSignature& s) {
                            return pack.transactions()[0].source().public_key() == s.smartKey; });
@@ -292,7 +304,7 @@ bool SmartSourceSignaturesValidator::checkSignatures(const SmartSignatures& sigs
                   << s.first << " in init pool with sequence " << initPool.sequence();
         return false;
       }
-      if (!cscrypto::verifySignature(s.second, confidants[s.first], pack.hash().toBinary().data(), cscrypto::kHashSize)) {
+      if (!cscrypto::verifySignature(s.second, confidants[s.first], pack.hash().data(), cscrypto::kHashSize)) {
         cserror() << kLogPrefix << "incorrect signature of smart "
                   << pack.transactions()[0].source().to_string() << " of confidant " << s.first
                   << " from init pool with sequence " << initPool.sequence();
@@ -373,6 +385,10 @@ ValidationPlugin::ErrorType TransactionsChecker::validateBlock(const csdb::Pool&
   const auto& trxs = block.transactions();
   std::set<csdb::Address> newStates;
   for (const auto& t : trxs) {
+    if (isCancelled()) {
+      break;
+    }
+
     if (SmartContracts::is_new_state(t)) {
       // already checked by another plugin
       newStates.insert(t.source());
@@ -399,9 +415,9 @@ bool TransactionsChecker::checkSignature(const csdb::Transaction& t) {
   if (t.source().is_wallet_id()) {
     const auto& bc = getBlockChain();
     auto pub = bc.getAddressByType(t.source(), BlockChain::AddressType::PublicKey);
-    return t.verify_signature(pub.public_key());
+    return SignatureCache::instance().verify(t, pub.public_key());
   } else {
-    return t.verify_signature(t.source().public_key());
+    return SignatureCache::instance().verify(t, t.source().public_key());
   }
 }
 
@@ -68,6 +68,14 @@ cs::ConveyerBase::ConveyerBase() {
     pimpl_ = std::make_unique<cs::ConveyerBase::Impl>(MaxQueueSize, MaxPacketTransactions, MaxPacketsPerRound, MetaCapacity);
     pimpl_->metaStorage.append(cs::ConveyerMetaStorage::Element());
 
+    auto& registry = cs::metrics::Registry::instance();
+    probes_.push_back(registry.probe("cs_conveyer_packets_table_size", "Packets of current round at conveyer", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(packetsTableSize()); }));
+    probes_.push_back(registry.probe("cs_conveyer_queue_transactions", "Transactions waiting to be flushed by conveyer", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(packetQueueTransactionsCount()); }));
+    probes_.push_back(registry.probe("cs_conveyer_send_cache_size", "Packets at conveyer send cache", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(sendCacheCount()); }));
+
     std::call_once(::onceFlag, &::setup, this);
 }
 
@@ -668,6 +676,11 @@ size_t cs::ConveyerBase::sendCacheCount() const {
     return pimpl_->sendPacketsCache.size();
 }
 
+size_t cs::ConveyerBase::packetsTableSize() const {
+    cs::SharedLock lock(sharedMutex_);
+    return pimpl_->packetsTable.size();
+}
+
 std::unique_lock<cs::SharedMutex> cs::ConveyerBase::lock() const {
     return std::unique_lock<cs::SharedMutex>(sharedMutex_);
 }
@@ -0,0 +1,161 @@
+#include <csnode/dispatchlanes.hpp>
+
+#include <lib/system/structures.hpp>
+
+cs::DispatchLanes::DispatchLanes() {
+    for (size_t i = 0; i < LanesCount; ++i) {
+        workers_[i] = std::make_shared<Worker>();
+
+        if (static_cast<Lane>(i) != Lane::Consensus) {
+            auto& worker = *workers_[i];
+            worker.thread = std::thread([&worker] { run(worker); });
+        }
+    }
+}
+
+cs::DispatchLanes::~DispatchLanes() {
+    stop();
+}
+
+cs::DispatchLanes::Lane cs::DispatchLanes::laneOf(MsgTypes type) {
+    switch (type) {
+        case MsgTypes::TransactionPacket:
+        case MsgTypes::TransactionsPacketReply:
+            return Lane::Transactions;
+        case MsgTypes::RequestedBlock:
+            return Lane::Sync;
+        case MsgTypes::FirstSmartStage:
+        case MsgTypes::SecondSmartStage:
+        case MsgTypes::ThirdSmartStage:
+            return Lane::Smart;
+        default:
+            // round, stages and requests served from node state are processed on processor thread
+            return Lane::Consensus;
+    }
+}
+
+bool cs::DispatchLanes::post(Lane lane, Task task) {
+    auto& target = worker(lane);
+
+    if (target.isStopped) {
+        return false;
+    }
+
+    if (lane == Lane::Consensus) {
+        task();
+        return true;
+    }
+
+    {
+        std::lock_guard lock(target.mutex);
+
+        if (target.tasks.size() >= MaxQueueSize) {
+            ++target.dropped;
+            return false;
+        }
+
+        target.tasks.push_back(std::move(task));
+    }
+
+    target.condition.notify_one();
+    return true;
+}
+
+void cs::DispatchLanes::deliver(Lane lane, Task task) {
+    const auto& target = workers_[static_cast<size_t>(lane)];
+
+    if (target->isStopped) {
+        return;
+    }
+
+    // consensus lane is already on node thread
+    if (lane == Lane::Consensus) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard lock(target->resultsMutex);
+        target->results.push_back(std::move(task));
+    }
+
+    // calls queue is not ordered, so only one call drains all results of the lane
+    if (!target->isDrainScheduled.exchange(true)) {
+        CallsQueue::instance().insert([target] { drain(target); });
+    }
+}
+
+void cs::DispatchLanes::stop() {
+    for (auto& target : workers_) {
+        {
+            std::lock_guard lock(target->mutex);
+
+            if (target->isStopped) {
+                continue;
+            }
+
+            target->isStopped = true;
+            target->tasks.clear();
+        }
+
+        target->condition.notify_all();
+
+        if (target->thread.joinable()) {
+            target->thread.join();
+        }
+    }
+}
+
+size_t cs::DispatchLanes::size(Lane lane) const {
+    auto& target = worker(lane);
+    std::lock_guard lock(target.mutex);
+    return target.tasks.size();
+}
+
+uint64_t cs::DispatchLanes::droppedCount(Lane lane) const {
+    auto& target = worker(lane);
+    std::lock_guard lock(target.mutex);
+    return target.dropped;
+}
+
+void cs::DispatchLanes::run(Worker& worker) {
+    std::unique_lock lock(worker.mutex);
+
+    while (true) {
+        worker.condition.wait(lock, [&] { return worker.isStopped || !worker.tasks.empty(); });
+
+        if (worker.isStopped) {
+            break;
+        }
+
+        Task task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+void cs::DispatchLanes::drain(const WorkerPtr& worker) {
+    worker->isDrainScheduled = false;
+
+    std::deque<Task> results;
+
+    {
+        std::lock_guard lock(worker->resultsMutex);
+        results.swap(worker->results);
+    }
+
+    for (auto& result : results) {
+        if (worker->isStopped) {
+            break;
+        }
+
+        result();
+    }
+}
+
+cs::DispatchLanes::Worker& cs::DispatchLanes::worker(Lane lane) const {
+    return *workers_[static_cast<size_t>(lane)];
+}
@@ -2,6 +2,7 @@
 
 #include <cstring>
 
+#include <csnode/signaturecache.hpp>
 #include <csnode/walletsstate.hpp>
 #include <smartcontracts.hpp>
 #include <solvercontext.hpp>
@@ -164,9 +165,9 @@ bool IterValidator::checkTransactionSignature(SolverContext& context, const csdb
     if (!SmartContracts::is_new_state(transaction) && !smartSourceTransaction) {
         if (src.is_wallet_id()) {
             auto pub = context.blockchain().getAddressByType(src, BlockChain::AddressType::PublicKey);
-            return transaction.verify_signature(pub.public_key());
+            return SignatureCache::instance().verify(transaction, pub.public_key());
         }
-        return transaction.verify_signature(src.public_key());
+        return SignatureCache::instance().verify(transaction, src.public_key());
     }
     else {
         // special rule for new_state transactions
@@ -216,7 +217,7 @@ void IterValidator::checkSignaturesSmartSource(SolverContext& context, cs::Packe
             for (const auto& signature : signatures) {
                 if (signature.first < confidants.size()) {
                     const auto& confidantPublicKey = confidants[signature.first];
-                    const cs::Byte* signedHash = smartContractPacket.hash().toBinary().data();
+                    const cs::Byte* signedHash = smartContractPacket.hash().data();
                     if (cscrypto::verifySignature(signature.second, confidantPublicKey, signedHash, cscrypto::kHashSize)) {
                         ++correctSignaturesCounter;
                     }
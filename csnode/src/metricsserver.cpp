@@ -0,0 +1,172 @@
+#include <csnode/metricsserver.hpp>
+
+#include <string>
+
+#include <csnode/roundtrace.hpp>
+
+#include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+namespace {
+std::string response(const std::string& status, const std::string& contentType, const std::string& body) {
+    return "HTTP/1.1 " + status + "\r\nContent-Type: " + contentType + "\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\nConnection: close\r\n\r\n" + body;
+}
+
+// rounds=N of query, default count if absent or invalid
+size_t traceRounds(const std::string& query) {
+    constexpr size_t kDefaultRounds = 10;
+    const std::string key = "rounds=";
+
+    for (size_t start = 0; start < query.size();) {
+        auto end = query.find('&', start);
+        end = (end == std::string::npos) ? query.size() : end;
+
+        if (query.compare(start, key.size(), key) == 0 && start + key.size() < end) {
+            const auto value = query.substr(start + key.size(), end - start - key.size());
+
+            if (value.find_first_not_of("0123456789") == std::string::npos && value.size() < 10) {
+                return std::stoul(value);
+            }
+        }
+
+        start = end + 1;
+    }
+
+    return kDefaultRounds;
+}
+
+std::string handle(const std::string& request) {
+    const auto lineEnd = request.find("\r\n");
+    const auto line = request.substr(0, lineEnd);
+
+    const auto methodEnd = line.find(' ');
+    const auto method = line.substr(0, methodEnd);
+
+    if (method != "GET") {
+        return response("405 Method Not Allowed", "text/plain", "method is not allowed\n");
+    }
+
+    const auto targetEnd = line.find(' ', methodEnd + 1);
+    auto target = line.substr(methodEnd + 1, targetEnd == std::string::npos ? std::string::npos : targetEnd - methodEnd - 1);
+    const auto queryStart = target.find('?');
+    const auto query = queryStart == std::string::npos ? std::string() : target.substr(queryStart + 1);
+    target = target.substr(0, queryStart);
+
+    if (target == "/metrics") {
+        return response("200 OK", "text/plain; version=0.0.4; charset=utf-8", cs::metrics::Registry::instance().exposition());
+    }
+
+    if (target == "/trace") {
+        return response("200 OK", "application/json", cs::RoundTrace::instance().chromeTrace(traceRounds(query)));
+    }
+
+    return response("404 Not Found", "text/plain", "metrics are served by /metrics, round timeline by /trace?rounds=N\n");
+}
+}  // namespace
+
+class cs::MetricsServer::Connection : public std::enable_shared_from_this<Connection> {
+public:
+    explicit Connection(tcp::socket socket)
+    : socket_(std::move(socket))
+    , buffer_(kMaxRequestSize) {
+    }
+
+    void start() {
+        auto self = shared_from_this();
+
+        asio::async_read_until(socket_, buffer_, "\r\n\r\n", [self](const boost::system::error_code& code, size_t) {
+            if (code) {
+                // not completed request or too large one
+                self->reply(response("400 Bad Request", "text/plain", "bad request\n"));
+                return;
+            }
+
+            std::string request(asio::buffers_begin(self->buffer_.data()), asio::buffers_end(self->buffer_.data()));
+            self->reply(handle(request));
+        });
+    }
+
+private:
+    void reply(std::string text) {
+        auto self = shared_from_this();
+        response_ = std::move(text);
+
+        asio::async_write(socket_, asio::buffer(response_), [self](const boost::system::error_code&, size_t) {
+            boost::system::error_code code;
+            self->socket_.shutdown(tcp::socket::shutdown_both, code);
+            self->socket_.close(code);
+        });
+    }
+
+    tcp::socket socket_;
+    asio::streambuf buffer_;
+    std::string response_;
+};
+
+cs::MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool cs::MetricsServer::start(uint16_t port) {
+    boost::system::error_code code;
+
+    // the metrics are not public, they are served to local collector only
+    const tcp::endpoint endpoint(asio::ip::address_v4::loopback(), port);
+    acceptor_ = std::make_unique<tcp::acceptor>(context_);
+
+    acceptor_->open(endpoint.protocol(), code);
+
+    if (!code) {
+        acceptor_->set_option(tcp::acceptor::reuse_address(true), code);
+        acceptor_->bind(endpoint, code);
+    }
+
+    if (!code) {
+        acceptor_->listen(asio::socket_base::max_listen_connections, code);
+    }
+
+    if (code) {
+        cserror() << "METRICS> can not listen " << endpoint << ": " << code.message();
+        acceptor_.reset();
+        return false;
+    }
+
+    accept();
+    thread_ = std::thread([this] { context_.run(); });
+
+    cslog() << "METRICS> served on http://" << acceptor_->local_endpoint() << "/metrics";
+    return true;
+}
+
+void cs::MetricsServer::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    context_.stop();
+    thread_.join();
+
+    acceptor_.reset();
+}
+
+uint16_t cs::MetricsServer::port() const {
+    return acceptor_ ? acceptor_->local_endpoint().port() : 0;
+}
+
+void cs::MetricsServer::accept() {
+    acceptor_->async_accept([this](const boost::system::error_code& code, tcp::socket socket) {
+        if (code == asio::error::operation_aborted) {
+            return;
+        }
+
+        if (!code) {
+            std::make_shared<Connection>(std::move(socket))->start();
+        }
+
+        accept();
+    });
+}
@@ -15,6 +15,8 @@
 #include <csnode/poolsynchronizer.hpp>
 #include <csnode/blockvalidator.hpp>
 #include <csnode/roundpackage.hpp>
+#include <csnode/roundtrace.hpp>
+#include <csnode/signaturecache.hpp>
 
 #include <lib/system/logger.hpp>
 #include <lib/system/progressbar.hpp>
@@ -76,6 +78,7 @@ Node::Node(const Config& config, cs::config::Observer& observer)
 Node::~Node() {
     std::cout << "Desturctor called\n";
     sendingTimer_.stop();
+    dispatchLanes_.stop();
 
     delete solver_;
     delete transport_;
@@ -92,13 +95,14 @@ bool Node::init(const Config& config) {
 
     cs::Connector::connect(&blockChain_.readBlockEvent(), api_.get(), &csconnector::connector::onReadFromDB);
     cs::Connector::connect(&blockChain_.storeBlockEvent, api_.get(), &csconnector::connector::onStoreBlock);
+    cs::Connector::connect(&blockChain_.removeBlockEvent, api_.get(), &csconnector::connector::onRemoveBlock);
 #endif  // NODE_API
 
     // must call prior to blockChain_.init():
     solver_->init(nodeIdKey_, nodeIdPrivate_);
     solver_->startDefault();
 
-    if (!blockChain_.init(config.getPathToDB())) {
+    if (!blockChain_.init(config.getPathToDB(), config.poolsCacheSize(), config.cachedBlocksSize())) {
         return false;
     }
     cslog() << "Blockchain is ready, contains " << WithDelimiters(stat_.total_transactions()) << " transactions";
@@ -120,6 +124,16 @@ bool Node::init(const Config& config) {
     std::cout << "Everything is init\n";
 
     cs::Conveyer::instance().setSendCacheValue(config.conveyerSendCacheValue());
+    cs::RoundTrace::instance().enable(config.roundTraceEvents());
+
+    if (config.metricsPort() != 0) {
+        metricsServer_ = std::make_unique<cs::MetricsServer>();
+
+        // node works without metrics if the port is busy
+        if (!metricsServer_->start(config.metricsPort())) {
+            metricsServer_.reset();
+        }
+    }
 
     cs::Connector::connect(&sendingTimer_.timeOut, this, &Node::processTimer);
     cs::Connector::connect(&cs::Conveyer::instance().packetFlushed, this, &Node::onTransactionsPacketFlushed);
@@ -156,6 +170,11 @@ void Node::stop() {
 
     observer_.stop();
     cswarning() << "[CONFIG OBSERVER STOPPED]";
+
+    if (metricsServer_) {
+        metricsServer_->stop();
+        cswarning() << "[METRICS SERVER STOPPED]";
+    }
 }
 
 /* Requests */
@@ -307,17 +326,18 @@ void Node::getRoundTableSS(const uint8_t* data, const size_t size, const cs::Rou
     poolSynchronizer_->sync(rNum);
 }
 
-void Node::getTransactionsPacket(const uint8_t* data, const std::size_t size) {
-    istream_.init(data, size);
+void Node::getTransactionsPacket(cs::IPackStream& stream) {
     cs::TransactionsPacket packet;
-    istream_ >> packet;
+    stream >> packet;
 
     if (packet.hash().isEmpty()) {
         cswarning() << "Received transaction packet hash is empty";
         return;
     }
 
-    processTransactionsPacket(std::move(packet));
+    dispatchLanes_.deliver(cs::DispatchLanes::Lane::Transactions, [this, packet = std::move(packet)]() mutable {
+        processTransactionsPacket(std::move(packet));
+    });
 }
 
 void Node::getNodeStopRequest(const cs::RoundNumber round, const uint8_t* data, const std::size_t size) {
@@ -414,16 +434,9 @@ void Node::getPacketHashesRequest(const uint8_t* data, const std::size_t size, c
     processPacketsRequest(std::move(hashes), round, sender);
 }
 
-void Node::getPacketHashesReply(const uint8_t* data, const std::size_t size, const cs::RoundNumber round, const cs::PublicKey& sender) {
-    if (cs::Conveyer::instance().isSyncCompleted(round)) {
-        csdebug() << "NODE> sync packets have already finished in round " << round;
-        return;
-    }
-
-    istream_.init(data, size);
-
+void Node::getPacketHashesReply(cs::IPackStream& stream, const cs::RoundNumber round, const cs::PublicKey& sender) {
     cs::Packets packets;
-    istream_ >> packets;
+    stream >> packets;
 
     if (packets.empty()) {
         csmeta(cserror) << "Packet hashes reply, bad packets parsing";
@@ -433,7 +446,14 @@ void Node::getPacketHashesReply(const uint8_t* data, const std::size_t size, con
     csdebug() << "NODE> Get packet hashes reply: sender " << cs::Utils::byteStreamToHex(sender);
     csdebug() << "NODE> Hashes reply got packets count: " << packets.size();
 
-    processPacketsReply(std::move(packets), round);
+    dispatchLanes_.deliver(cs::DispatchLanes::Lane::Transactions, [this, round, packets = std::move(packets)]() mutable {
+        if (cs::Conveyer::instance().isSyncCompleted(round)) {
+            csdebug() << "NODE> sync packets have already finished in round " << round;
+            return;
+        }
+
+        processPacketsReply(std::move(packets), round);
+    });
 }
 
 void Node::getCharacteristic(cs::RoundPackage& rPackage) {
@@ -784,29 +804,31 @@ void Node::getBlockRequest(const uint8_t* data, const size_t size, const cs::Pub
     }
 }
 
-void Node::getBlockReply(const uint8_t* data, const size_t size) {
-    if (!poolSynchronizer_->isSyncroStarted()) {
-        csdebug() << "NODE> Get block reply> Pool synchronizer already syncro";
-        return;
-    }
-
+void Node::getBlockReply(cs::IPackStream& stream) {
     csdebug() << "NODE> Get Block Reply";
 
-    cs::PoolsBlock poolsBlock = decompressPoolsBlock(data, size);
+    cs::PoolsBlock poolsBlock = decompressPoolsBlock(stream);
 
     if (poolsBlock.empty()) {
         cserror() << "NODE> Get block reply> Pools count is 0";
         return;
     }
 
-    for (const auto& pool : poolsBlock) {
-        transport_->syncReplied(pool.sequence());
-    }
-
     std::size_t packetNum = 0;
-    istream_ >> packetNum;
+    stream >> packetNum;
+
+    dispatchLanes_.deliver(cs::DispatchLanes::Lane::Sync, [this, packetNum, poolsBlock = std::move(poolsBlock)]() mutable {
+        if (!poolSynchronizer_->isSyncroStarted()) {
+            csdebug() << "NODE> Get block reply> Pool synchronizer already syncro";
+            return;
+        }
+
+        for (const auto& pool : poolsBlock) {
+            transport_->syncReplied(pool.sequence());
+        }
 
-    poolSynchronizer_->getBlockReply(std::move(poolsBlock), packetNum);
+        poolSynchronizer_->getBlockReply(std::move(poolsBlock), packetNum);
+    });
 }
 
 void Node::sendBlockReply(const cs::PoolsBlock& poolsBlock, const cs::PublicKey& target, std::size_t packetNum) {
@@ -1325,31 +1347,38 @@ RegionPtr Node::compressPoolsBlock(const cs::PoolsBlock& poolsBlock, std::size_t
     return memPtr;
 }
 
-cs::PoolsBlock Node::decompressPoolsBlock(const uint8_t* data, const size_t size) {
-    istream_.init(data, size);
+cs::PoolsBlock Node::decompressPoolsBlock(cs::IPackStream& stream) {
     std::size_t realBinSize = 0;
-    istream_ >> realBinSize;
+    stream >> realBinSize;
 
     std::uint32_t compressSize = 0;
-    istream_ >> compressSize;
+    stream >> compressSize;
+
+    // region allocator belongs to node thread, compressed data is read in place,
+    // lz4 needs it contiguous, so it is composed only if the message came in fragments
+    const cs::BytesView compressedView = stream.readView(compressSize);
 
-    RegionPtr memPtr = allocator_.allocateNext(compressSize);
-    istream_ >> memPtr;
+    if (!stream.good()) {
+        csmeta(cserror) << "Bad compressed pools block size";
+        return cs::PoolsBlock{};
+    }
+
+    const char* compressed = reinterpret_cast<const char*>(compressedView.data());
 
     cs::Bytes bytes;
     bytes.resize(realBinSize);
     char* bytesData = reinterpret_cast<char*>(bytes.data());
 
-    const int uncompressedSize = LZ4_decompress_safe(static_cast<char*>(memPtr->data()), bytesData, cs::numeric_cast<int>(compressSize), cs::numeric_cast<int>(realBinSize));
+    const int uncompressedSize = LZ4_decompress_safe(compressed, bytesData, cs::numeric_cast<int>(compressSize), cs::numeric_cast<int>(realBinSize));
 
     if (uncompressedSize < 0) {
         csmeta(cserror) << "Decompress poools block error";
     }
 
-    cs::DataStream stream(bytes.data(), bytes.size());
+    cs::DataStream poolsStream(bytes.data(), bytes.size());
     cs::PoolsBlock poolsBlock;
 
-    stream >> poolsBlock;
+    poolsStream >> poolsBlock;
 
     return poolsBlock;
 }
@@ -1755,15 +1784,13 @@ void Node::sendSmartStageOne(const cs::ConfidantsKeys& smartConfidants, const cs
     csmeta(csdebug) << "done";
 }
 
-void Node::getSmartStageOne(const uint8_t* data, const size_t size, const cs::RoundNumber, const cs::PublicKey& sender) {
+void Node::getSmartStageOne(cs::IPackStream& stream, const cs::RoundNumber, const cs::PublicKey& sender) {
     csdebug() << __func__ << ": starting";
 
-    istream_.init(data, size);
-
     cs::StageOneSmarts stage;
-    istream_ >> stage.message >> stage.signature;
+    stream >> stage.message >> stage.signature;
 
-    if (!istream_.good() || !istream_.end()) {
+    if (!stream.good() || !stream.end()) {
         cserror() << "Bad Smart Stage One packet format";
         return;
     }
@@ -1787,13 +1814,15 @@ void Node::getSmartStageOne(const uint8_t* data, const size_t size, const cs::Ro
 
     csdebug() << "NODE> SmartStage One from T[" << static_cast<int>(stage.sender) << "] is OK!";
 
-    if (std::find(activeSmartConsensuses_.cbegin(), activeSmartConsensuses_.cend(), stage.id) == activeSmartConsensuses_.cend()) {
-        csdebug() << "The SmartConsensus {" << block << '.' << transaction << "} is not active now, storing the stage";
-        smartStageOneStorage_.push_back(stage);
-        return;
-    }
+    dispatchLanes_.deliver(cs::DispatchLanes::Lane::Smart, [this, block, transaction, stage = std::move(stage)]() mutable {
+        if (std::find(activeSmartConsensuses_.cbegin(), activeSmartConsensuses_.cend(), stage.id) == activeSmartConsensuses_.cend()) {
+            csdebug() << "The SmartConsensus {" << block << '.' << transaction << "} is not active now, storing the stage";
+            smartStageOneStorage_.push_back(stage);
+            return;
+        }
 
-    emit gotSmartStageOne(stage, false);
+        emit gotSmartStageOne(stage, false);
+    });
 }
 
 void Node::sendSmartStageTwo(const cs::ConfidantsKeys& smartConfidants, cs::StageTwoSmarts& stageTwoInfo) {
@@ -1827,18 +1856,16 @@ void Node::sendSmartStageTwo(const cs::ConfidantsKeys& smartConfidants, cs::Stag
     csmeta(csdebug) << "done";
 }
 
-void Node::getSmartStageTwo(const uint8_t* data, const size_t size, const cs::RoundNumber, const cs::PublicKey& sender) {
+void Node::getSmartStageTwo(cs::IPackStream& istream, const cs::RoundNumber, const cs::PublicKey& sender) {
     csmeta(csdebug);
 
     csdebug() << "NODE> Getting SmartStage Two from " << cs::Utils::byteStreamToHex(sender.data(), sender.size());
 
-    istream_.init(data, size);
-
     cs::StageTwoSmarts stage;
     cs::Bytes bytes;
-    istream_ >> bytes >> stage.signature;
+    istream >> bytes >> stage.signature;
 
-    if (!istream_.good() || !istream_.end()) {
+    if (!istream.good() || !istream.end()) {
         cserror() << "NODE> Bad SmartStageTwo packet format";
         return;
     }
@@ -1861,7 +1888,9 @@ void Node::getSmartStageTwo(const uint8_t* data, const size_t size, const cs::Ro
 
     csmeta(csdetails) << "Signature is OK";
 
-    emit gotSmartStageTwo(stage, false);
+    dispatchLanes_.deliver(cs::DispatchLanes::Lane::Smart, [this, stage = std::move(stage)]() mutable {
+        emit gotSmartStageTwo(stage, false);
+    });
 }
 
 void Node::sendSmartStageThree(const cs::ConfidantsKeys& smartConfidants, cs::StageThreeSmarts& stageThreeInfo) {
@@ -1896,17 +1925,15 @@ void Node::sendSmartStageThree(const cs::ConfidantsKeys& smartConfidants, cs::St
     csmeta(csdebug) << "done";
 }
 
-void Node::getSmartStageThree(const uint8_t* data, const size_t size, const cs::RoundNumber, const cs::PublicKey& sender) {
+void Node::getSmartStageThree(cs::IPackStream& istream, const cs::RoundNumber, const cs::PublicKey& sender) {
     csmeta(csdetails) << "started";
     csunused(sender);
 
-    istream_.init(data, size);
-
     cs::StageThreeSmarts stage;
     cs::Bytes bytes;
-    istream_ >> bytes >> stage.signature;
+    istream >> bytes >> stage.signature;
 
-    if (!istream_.good() || !istream_.end()) {
+    if (!istream.good() || !istream.end()) {
         cserror() << "NODE> Bad SmartStage Three packet format";
         return;
     }
@@ -1927,7 +1954,9 @@ void Node::getSmartStageThree(const uint8_t* data, const size_t size, const cs::
 
     csdebug() << "NODE> SmartStage-3 from T[" << static_cast<int>(stage.sender) << "] is OK!";
 
-    emit gotSmartStageThree(stage, false);
+    dispatchLanes_.deliver(cs::DispatchLanes::Lane::Smart, [this, stage = std::move(stage)]() mutable {
+        emit gotSmartStageThree(stage, false);
+    });
 }
 
 void Node::smartStageRequest(MsgTypes msgType, uint64_t smartID, cs::PublicKey confidant, uint8_t respondent, uint8_t required) {
@@ -2136,6 +2165,7 @@ bool Node::receivingSignatures(cs::RoundPackage& rPackage, cs::PublicKeys& curre
 void Node::getRoundTable(const uint8_t* data, const size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender) {
     csdebug() << "NODE> next round table received, round: " << rNum;
     csmeta(csdetails) << "started";
+    cs::RoundTrace::instance().instant("round table received", cs::RoundTrace::Track::Round);
 
     if (myLevel_ == Level::Writer) {
         csmeta(cserror) << "Writers don't receive round table";
@@ -2641,6 +2671,9 @@ void Node::onRoundStart(const cs::RoundTable& roundTable) {
         }
     }
 
+    cs::SignatureCache::instance().setRound(roundTable.round);
+    cs::RoundTrace::instance().startRound(roundTable.round);
+
     // TODO: think how to improve this code.
     stageOneMessage_.clear();
     stageOneMessage_.resize(roundTable.confidants.size());
@@ -1,5 +1,6 @@
 #include <csdb/pool.hpp>
 #include <csnode/nodeutils.hpp>
+#include <csnode/signaturecache.hpp>
 
 namespace
 {
@@ -51,7 +52,7 @@ bool NodeUtils::checkGroupSignature(const cs::ConfidantsKeys& confidants, const
     csdebug() << log_prefix << "hash: " << cs::Utils::byteStreamToHex(hash);
     for (auto it : mask) {
         if (it != cs::ConfidantConsts::InvalidConfidantIndex) {
-            if (cscrypto::verifySignature(signatures[signatureCount], confidants[cnt], hash.data(), hash.size())) {
+            if (cs::SignatureCache::instance().verify(signatures[signatureCount], confidants[cnt], hash.data(), hash.size())) {
                 csdetails() << log_prefix << "signature of [" << cnt << "] is valid";
                 ++signatureCount;
                 ++cntValid;
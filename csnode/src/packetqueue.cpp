@@ -14,7 +14,7 @@ bool cs::PacketQueue::push(const csdb::Transaction& transaction) {
         return false;
     }
 
-    if (queue_.empty() || queue_.back().transactions().size() >= maxTransactionsSize_) {
+    if (queue_.empty() || queue_.back().transactionsCount() >= maxTransactionsSize_) {
         queue_.push_back(cs::TransactionsPacket{});
     }
 
@@ -2,8 +2,10 @@
 
 #include <lib/system/logger.hpp>
 #include <lib/system/progressbar.hpp>
+#include <lib/system/structures.hpp>
 #include <lib/system/utils.hpp>
 
+#include <csnode/blockvalidatorplugins.hpp>
 #include <csnode/conveyer.hpp>
 
 #include <net/transport.hpp>
@@ -11,13 +13,11 @@
 cs::PoolSynchronizer::PoolSynchronizer(const PoolSyncData& data, Transport* transport, BlockChain* blockChain)
 : syncData_(data)
 , transport_(transport)
-, blockChain_(blockChain) {
-    neighbours_.reserve(transport_->getMaxNeighbours());
-
-    refreshNeighbours();
-
+, blockChain_(blockChain)
+, window_(data.blockPoolsCount)
+, applier_([this](const csdb::Pool& pool) { return validateBlock(pool); }, [this](csdb::Pool& pool) { return passBlock(pool); }) {
     cs::Connector::connect(&timer_.timeOut, this, &cs::PoolSynchronizer::onTimeOut);
-    cs::Connector::connect(&roundSimulation_.timeOut, this, &cs::PoolSynchronizer::onRoundSimulation);
+    cs::Connector::connect(&applier_.rejected, this, &cs::PoolSynchronizer::onBlockRejected);
 
     // Print Pool Sync Data Info
     const uint8_t hl = 25;
@@ -26,8 +26,6 @@ cs::PoolSynchronizer::PoolSynchronizer(const PoolSyncData& data, Transport* tran
                     << std::setw(hl) << "Fast mode:        " << std::setw(vl) << syncData_.isFastMode << "\n"
                     << std::setw(hl) << "One reply block:  " << std::setw(vl) << syncData_.oneReplyBlock << "\n"
                     << std::setw(hl) << "Block pools:      " << std::setw(vl) << static_cast<int>(syncData_.blockPoolsCount) << "\n"
-                    << std::setw(hl) << "Request round:    " << std::setw(vl) << static_cast<int>(syncData_.requestRepeatRoundCount) << "\n"
-                    << std::setw(hl) << "Neighbour packets:" << std::setw(vl) << static_cast<int>(syncData_.neighbourPacketsCount) << "\n"
                     << std::setw(hl) << "Polling frequency:" << std::setw(vl) << syncData_.sequencesVerificationFrequency;
 }
 
@@ -51,7 +49,7 @@ void cs::PoolSynchronizer::sync(cs::RoundNumber roundNum, cs::RoundNumber differ
         return;
     }
 
-    csmeta(csdetails) << "Started";
+    csmeta(csdetails) << "Started, big bang: " << isBigBand;
 
     if (isSyncroStarted_ && roundNum > 0) {
         --roundNum;
@@ -79,21 +77,7 @@ void cs::PoolSynchronizer::sync(cs::RoundNumber roundNum, cs::RoundNumber differ
         return;
     }
 
-    const bool useTimer = syncData_.sequencesVerificationFrequency > 1;
-    const int delay = useTimer ? static_cast<int>(syncData_.sequencesVerificationFrequency) : static_cast<int>(cs::NeighboursRequestDelay);
-
-    // already synchro start
-    if (isSyncroStarted_ && !useTimer) {
-        // no BigBang, but no use timer
-        if (!isBigBand && timer_.isRunning()) {
-            timer_.stop();
-        }
-
-        // BigBang received
-        if (isBigBand && !timer_.isRunning()) {
-            timer_.start(delay, Timer::Type::Standard, RunPolicy::CallQueuePolicy);
-        }
-    }
+    targetSequence_ = roundNum;
 
     if (!isSyncroStarted_) {
         isSyncroStarted_ = true;
@@ -101,103 +85,71 @@ void cs::PoolSynchronizer::sync(cs::RoundNumber roundNum, cs::RoundNumber differ
         cs::Connector::connect(&blockChain_->cachedBlockEvent, this, static_cast<void (PoolSynchronizer::*)(const cs::Sequence)>(&cs::PoolSynchronizer::onWriteBlock));
         cs::Connector::connect(&blockChain_->removeBlockEvent, this, &cs::PoolSynchronizer::onRemoveBlock);
 
-        refreshNeighbours();
-        sendBlockRequest();
-
-        if (isBigBand || useTimer) {
-            timer_.start(delay, Timer::Type::Standard, RunPolicy::CallQueuePolicy);
-        }
+        restart();
 
-        roundSimulation_.start(60000, cs::Timer::Type::HighPrecise, RunPolicy::CallQueuePolicy);  // 1 Min
+        // timer expires requests which were not replied in time, replies themselves move the window
+        const int delay = syncData_.sequencesVerificationFrequency > 1 ? static_cast<int>(syncData_.sequencesVerificationFrequency)
+                                                                       : static_cast<int>(cs::NeighboursRequestDelay);
+        timer_.start(delay, Timer::Type::Standard, RunPolicy::CallQueuePolicy);
     }
-    else if (syncData_.requestRepeatRoundCount > 0) {
-        roundSimulation_.restart();
-        const bool isNeedRequest = checkActivity(CounterType::ROUND);
-        bool isAvailable = false;
-
-        if (syncData_.sequencesVerificationFrequency == 1) {
-            isAvailable = checkActivity(CounterType::TIMER);
-        }
 
-        if (isNeedRequest || isAvailable) {
-            sendBlockRequest();
-        }
-    }
+    sendBlockRequest();
 }
 
 void cs::PoolSynchronizer::getBlockReply(cs::PoolsBlock&& poolsBlock, std::size_t packetNum) {
     csmeta(csdebug) << "Get Block Reply <<<<<<< : count: " << poolsBlock.size() << ", seqs: [" << poolsBlock.front().sequence() << ", " << poolsBlock.back().sequence()
                     << "], id: " << packetNum;
 
-    /// TODO Fix numeric cast from RoundNum to cs::Sequence
-    cs::Sequence lastWrittenSequence = blockChain_->getLastSeq();
-    const cs::Sequence oldLastWrittenSequence = lastWrittenSequence;
-    const std::size_t oldCachedBlocksSize = blockChain_->getCachedBlocksSize();
+    PoolsRequestedSequences received;
+    received.reserve(poolsBlock.size());
 
-    // TODO Think, do really need this here?!
-    // refreshNeighbours();
+    for (const auto& pool : poolsBlock) {
+        received.push_back(pool.sequence());
+    }
 
-    for (auto& pool : poolsBlock) {
-        const auto sequence = pool.sequence();
+    if (!window_.onReply(packetNum, received)) {
+        csmeta(csdetails) << "Reply " << packetNum << " is not expected already";
+    }
 
-        removeExistingSequence(sequence, SequenceRemovalAccuracy::EXACT);
+    const cs::Sequence lastWrittenSequence = blockChain_->getLastSeq();
 
-        if (lastWrittenSequence > sequence) {
-            continue;
-        }
+    // blocks are validated and ordered by apply thread
+    for (auto& pool : poolsBlock) {
+        const auto sequence = pool.sequence();
 
-        if (pool.signatures().size() == 0) {
-            cserror() << "PoolSyncronizer> No signatures in pool #" << pool.sequence();
+        if (sequence <= lastWrittenSequence) {
             continue;
         }
 
-        if (blockChain_->storeBlock(pool, true /*by_sync*/)) {
-            blockChain_->testCachedBlocks();
-            lastWrittenSequence = blockChain_->getLastSeq();
+        if (!applier_.push(std::move(pool)) && sequence >= applier_.next()) {
+            csmeta(csdetails) << "Block " << sequence << " is not buffered";
         }
     }
 
-    if (oldCachedBlocksSize != blockChain_->getCachedBlocksSize() || oldLastWrittenSequence != lastWrittenSequence) {
-        const bool isFinished = showSyncronizationProgress(lastWrittenSequence);
-        if (isFinished) {
-            synchroFinished();
-        }
-    }
+    sendBlockRequest();
 }
 
 void cs::PoolSynchronizer::sendBlockRequest() {
-    if (neighbours_.empty()) {
+    if (!isSyncroStarted_) {
         return;
     }
 
-    csmeta(csdetails) << "Start";
-
-    for (const auto& el : requestedSequences_) {
-        csmeta(csdetails) << "Requested sequence: " << el.first << "(" << el.second << ")";
-    }
-    if (requestedSequences_.empty()) {
-        csmeta(csdetails) << "Requested sequence size: 0";
-    }
+    refreshNeighbours();
+    updateRange();
 
-    bool success = false;
+    for (auto& request : window_.schedule()) {
+        ConnectionPtr target = transport_->getConnectionByKey(request.peer);
 
-    for (auto& neighbour : neighbours_) {
-        if (!getNeededSequences(neighbour)) {
-            csmeta(csdetails) << "Neighbor: " << static_cast<int>(neighbour.index()) << " is busy";
+        if (!target) {
+            csmeta(cserror) << "Target is not valid";
+            window_.cancel(request.id);
             continue;
         }
 
-        if (neighbour.sequences().empty()) {
-            csmeta(csdetails) << "All sequences already requested";
-            break;
-        }
-
-        success = true;
-        sendBlock(neighbour);
-    }
+        cslog() << "SYNC: requesting for " << request.sequences.size() << " blocks [" << request.sequences.front() << ", " << request.sequences.back() << "] from "
+                << target->getOut() << ", id " << request.id;
 
-    if (success) {
-        printNeighbours("Info:");
+        emit sendRequest(target, request.sequences, request.id);
     }
 }
 
@@ -227,36 +179,14 @@ void cs::PoolSynchronizer::onTimeOut() {
         return;
     }
 
-    bool isAvailable = false;
-
-    if (isFastMode()) {
-        static uint8_t fastCounter = 0;
-        ++fastCounter;
-        if (fastCounter > 20) {
-            fastCounter = 0;
-            csmeta(csdetails) << "OnTimeOut Fast: " << syncData_.sequencesVerificationFrequency * 20;
-            isAvailable = checkActivity(cs::PoolSynchronizer::CounterType::ROUND);
-        }
-    }
+    const std::size_t expired = window_.expire();
 
-    if (!isAvailable) {
-        csmeta(csdetails) << "OnTimeOut: " << syncData_.sequencesVerificationFrequency;
-        isAvailable = checkActivity(cs::PoolSynchronizer::CounterType::TIMER);
+    if (expired) {
+        csmeta(csdetails) << "Expired requests: " << expired;
+        printNeighbours("Timeout:");
     }
 
-    if (isAvailable) {
-        sendBlockRequest();
-    }
-}
-
-void cs::PoolSynchronizer::onRoundSimulation() {
-    csmeta(csdetails) << "on round simulation";
-
-    bool isAvailable = checkActivity(cs::PoolSynchronizer::CounterType::ROUND);
-
-    if (isAvailable) {
-        sendBlockRequest();
-    }
+    sendBlockRequest();
 }
 
 void cs::PoolSynchronizer::onWriteBlock(const csdb::Pool pool) {
@@ -264,12 +194,20 @@ void cs::PoolSynchronizer::onWriteBlock(const csdb::Pool pool) {
 }
 
 void cs::PoolSynchronizer::onWriteBlock(const cs::Sequence sequence) {
-    removeExistingSequence(sequence, SequenceRemovalAccuracy::EXACT);
+    window_.onReceived(sequence);
 }
 
 void cs::PoolSynchronizer::onRemoveBlock(const cs::Sequence sequence) {
     csmeta(csdetails) << sequence;
-    removeExistingSequence(sequence, SequenceRemovalAccuracy::UPPER_BOUND);
+    restart();
+}
+
+void cs::PoolSynchronizer::onBlockRejected(const cs::Sequence sequence) {
+    CallsQueue::instance().insert([this, sequence] {
+        csmeta(csdebug) << "Block " << sequence << " is rejected, request it again";
+        window_.onRejected(sequence);
+        sendBlockRequest();
+    });
 }
 
 //
@@ -301,321 +239,114 @@ bool cs::PoolSynchronizer::showSyncronizationProgress(const cs::Sequence lastWri
     return remaining == 0;
 }
 
-bool cs::PoolSynchronizer::checkActivity(const CounterType counterType) {
-    refreshNeighbours();
-
-    if (neighbours_.empty()) {
-        csmeta(csdetails) << "Neighbours count is 0";
-        return false;
-    }
-
-    csmeta(csdetails) << counterType;
-    bool isNeedRequest = false;
-
-    switch (counterType) {
-        case CounterType::ROUND:
-            for (auto& neighbour : neighbours_) {
-                neighbour.increaseRoundCounter();
-                if (!isNeedRequest && isAvailableRequest(neighbour)) {
-                    isNeedRequest = true;
-                }
-            }
-            csmeta(csdetails) << "isNeedRequest: " << isNeedRequest;
-            printNeighbours("Activity Round:");
-            break;
-
-        case CounterType::TIMER:
-            for (auto& neighbour : neighbours_) {
-                isNeedRequest = neighbour.sequences().empty();
-                if (isNeedRequest) {
-                    break;
-                }
-            }
-            csmeta(csdetails) << "isNeedRequest: " << isNeedRequest;
-            break;
-    }
-
-    return isNeedRequest;
-}
-
-void cs::PoolSynchronizer::sendBlock(const NeighboursSetElemet& neighbour) {
-    ConnectionPtr target = getConnection(neighbour);
-
-    if (!target) {
-        csmeta(cserror) << "Target is not valid";
-        return;
-    }
+void cs::PoolSynchronizer::refreshNeighbours() {
+    std::vector<SyncWindow::Peer> peers;
+    const uint32_t neighboursCount = transport_->getNeighboursCount();
 
-    std::size_t packet = 0;
-    const auto& sequences = neighbour.sequences();
+    for (uint32_t i = 0; i < neighboursCount; ++i) {
+        ConnectionPtr neighbour = transport_->getConnectionByNumber(i);
 
-    for (const auto& sequence : sequences) {
-        if (!requestedSequences_.count(sequence)) {
-            requestedSequences_.emplace(std::make_pair(sequence, 0));
+        if (neighbour && !neighbour->isSignal && neighbour->lastSeq) {
+            peers.push_back(SyncWindow::Peer{neighbour->key, neighbour->lastSeq});
         }
-        packet = ++(requestedSequences_.at(sequence));
     }
 
-    cslog() << "SYNC: requesting for " << sequences.size() << " blocks [" << sequences.front() << ", " << sequences.back()
-        << "] from " << target->getOut() << ", repeat " << packet;
-
-    emit sendRequest(target, sequences, packet);
+    window_.setPeers(peers);
 }
 
-bool cs::PoolSynchronizer::getNeededSequences(NeighboursSetElemet& neighbour) {
-    const bool isLastPacket = isLastRequest();
-    if (isLastPacket && !requestedSequences_.empty()) {
-        csmeta(csdetails) << "Is last packet: requested sequences: [" << requestedSequences_.begin()->first << ", " << requestedSequences_.rbegin()->first << "]";
-
-        const auto& sequences = neighbour.sequences();
-        if (!sequences.empty() && requestedSequences_.find(sequences.front()) != requestedSequences_.end()) {
-            csmeta(csdetails) << "Is last packet: this neighbour is already requested";
-            if (isAvailableRequest(neighbour)) {
-                neighbour.resetRoundCounter();
-                return true;
-            }
-            return false;
-        }
-
-        neighbour.reset();
-        const int nhIdx = static_cast<int>(neighbour.index());
-        for (const auto& [sequence, packet] : requestedSequences_) {
-            (void)packet;
-            neighbour.addSequences(sequence);
-            csmeta(csdetails) << "Is last packet: nh: " << nhIdx << ", add seq: " << sequence;
-        }
-        csmeta(csdetails) << "Needed sequences size: " << neighbour.sequences().size();
-        return true;
-    }
-
-    const std::vector<BlockChain::SequenceInterval> requiredBlocks = blockChain_->getRequiredBlocks();
-
-    if (requiredBlocks.empty()) {
-        csmeta(csdebug) << "Required blocks is empty !!!";
-        return true;
-    }
-
+void cs::PoolSynchronizer::updateRange() {
     const cs::Sequence lastWrittenSequence = blockChain_->getLastSeq();
 
-    // remove unnecessary sequnces
-    removeExistingSequence(lastWrittenSequence, SequenceRemovalAccuracy::LOWER_BOUND);
-
-    cs::Sequence sequence = lastWrittenSequence;
-
-    auto isNeededHelpIt = requestedSequences_.end();
-    if (syncData_.neighbourPacketsCount > 0 && !isLastPacket) {
-        isNeededHelpIt = std::find_if(requestedSequences_.begin(), requestedSequences_.end(), [this](const auto& pair) { return pair.second >= syncData_.neighbourPacketsCount; });
-    }
-
-    // if storage requested sequences is impty
-    if (requestedSequences_.empty()) {
-        sequence = lastWrittenSequence;
-        csmeta(csdetails) << "From blockchain: " << sequence;
-    }
-    // Needed help another neighbour
-    else if (isNeededHelpIt != requestedSequences_.end()) {
-        sequence = isNeededHelpIt->first;
-
-        csmeta(csdetails) << "From needed help: " << sequence;
+    applier_.advance(lastWrittenSequence + 1);
+    window_.setRange(lastWrittenSequence + 1, std::min(targetSequence_, lastWrittenSequence + kMaxBlocksAhead));
+}
 
-        auto needyNeighbour = std::find_if(neighbours_.begin(), neighbours_.end(),
-                                           [sequence](const NeighboursSetElemet& el) { return (!el.sequences().empty() && el.sequences().front() == sequence); });
+void cs::PoolSynchronizer::restart() {
+    const cs::Sequence next = blockChain_->getLastSeq() + 1;
 
-        if (needyNeighbour == neighbours_.end()) {
-            csmeta(cserror) << "Needy neighbour is not valid";
-            return false;
-        }
-
-        if (neighbour.sequences() == needyNeighbour->sequences()) {
-            return true;
-        }
+    csmeta(csdebug) << "Sync from " << next;
 
-        if (!neighbour.sequences().empty() && sequence != neighbour.sequences().front()) {
-            for (const auto& seq : neighbour.sequences()) {
-                requestedSequences_.erase(seq);
-            }
-            neighbour.reset();
-        }
+    applier_.reset(next);
 
-        neighbour.setSequences(needyNeighbour->sequences());
-        return true;
+    {
+        std::lock_guard lock(blocksMutex_);
+        validatedBlocks_.clear();
     }
-    // Repeat request
-    else if (isAvailableRequest(neighbour)) {
-        if (!neighbour.sequences().empty()) {
-            csmeta(csdetails) << "From repeat request: [" << neighbour.sequences().front() << ", " << neighbour.sequences().back() << "]";
-        }
 
-        neighbour.resetRoundCounter();
-        return true;
-    }
-    else {
-        sequence = std::max(requestedSequences_.rbegin()->first, lastWrittenSequence);
-        csmeta(csdetails) << "From other: " << sequence;
-    }
+    window_.clear();
+    updateRange();
+}
 
-    if (!neighbour.sequences().empty()) {
+bool cs::PoolSynchronizer::validateBlock(const csdb::Pool& pool) const {
+    if (pool.signatures().empty()) {
+        cserror() << "PoolSyncronizer> No signatures in pool #" << pool.sequence();
         return false;
     }
 
-    neighbour.resetSequences();
-
-    for (std::size_t i = 0; i < syncData_.blockPoolsCount; ++i) {
-        ++sequence;
-
-        // max sequence
-        if (requiredBlocks.back().second != 0 && sequence > requiredBlocks.back().second) {
-            csmeta(csdetails) << "Max sequence reached";
-            break;
-        }
-
-        for (std::size_t j = 1; j < requiredBlocks.size(); ++j) {
-            // Within a valid pair
-            if (sequence > requiredBlocks[j].first && sequence < requiredBlocks[j].second) {
-                csmeta(csdetails) << "Check sequence interval: seq: " << sequence << ", Within a valid pair (" << j << "): [" << requiredBlocks[j].first << ", "
-                                  << requiredBlocks[j].second << "]";
-                break;
-            }
-            // Between pairs
-            if (sequence > requiredBlocks[j - 1].second && sequence < requiredBlocks[j].first) {
-                sequence = requiredBlocks[j].first;
-                csmeta(csdetails) << "Between pairs: " << sequence;
-                break;
-            }
-        }
+    // the same check as block validator does, verified signatures are cached for it
+    return BlockSignaturesValidator::checkSignatures(pool) == ValidationPlugin::ErrorType::noError;
+}
 
-        csmeta(csdetails) << "Add sequence for request: " << sequence;
+bool cs::PoolSynchronizer::passBlock(csdb::Pool& pool) {
+    {
+        std::lock_guard lock(blocksMutex_);
+        validatedBlocks_.push_back(std::move(pool));
+    }
 
-        neighbour.addSequences(sequence);
+    // calls queue is not ordered, so only one call drains all passed blocks
+    if (!isStoreScheduled_.exchange(true)) {
+        CallsQueue::instance().insert([this] { storeBlocks(); });
     }
 
     return true;
 }
 
-void cs::PoolSynchronizer::checkNeighbourSequence(const cs::Sequence sequence, const SequenceRemovalAccuracy accuracy) {
-    if (neighbours_.empty() || neighbours_.front().sequences().empty()) {
-        return;
-    }
+void cs::PoolSynchronizer::storeBlocks() {
+    isStoreScheduled_ = false;
 
-    csmeta(csdetails) << sequence;
-
-    bool success = false;
-
-    for (auto& neighbour : neighbours_) {
-        success |= neighbour.removeSequnce(sequence, accuracy);
+    std::deque<csdb::Pool> blocks;
 
-        if (neighbour.sequences().empty()) {
-            neighbour.resetRoundCounter();
-        }
+    {
+        std::lock_guard lock(blocksMutex_);
+        blocks.swap(validatedBlocks_);
     }
 
-    if (success) {
-        std::sort(neighbours_.begin(), neighbours_.end());
-        csmeta(csdetails) << "Remove success sequence: " << sequence;
-        printNeighbours("Check seq:");
-    }
-}
-
-void cs::PoolSynchronizer::removeExistingSequence(const cs::Sequence sequence, const SequenceRemovalAccuracy accuracy) {
-    csmeta(csdetails) << "sequence: " << sequence << ", accuracy: " << accuracy;
-    checkNeighbourSequence(sequence, accuracy);
-
-    if (!requestedSequences_.empty()) {
-        switch (accuracy) {
-            case SequenceRemovalAccuracy::EXACT: {
-                auto it = requestedSequences_.find(sequence);
-                if (it != requestedSequences_.end()) {
-                    requestedSequences_.erase(it);
-                }
-                break;
-            }
-            case SequenceRemovalAccuracy::LOWER_BOUND:
-                requestedSequences_.erase(requestedSequences_.begin(), requestedSequences_.upper_bound(sequence));
-                break;
-            case SequenceRemovalAccuracy::UPPER_BOUND:
-                requestedSequences_.erase(requestedSequences_.lower_bound(sequence), requestedSequences_.end());
-                break;
-        }
-    }
-}
-
-void cs::PoolSynchronizer::refreshNeighbours() {
-    const uint8_t neededNeighboursCount = static_cast<uint8_t>(transport_->getNeighboursCountWithoutSS());
-    const uint8_t nSize = static_cast<uint8_t>(neighbours_.size());
-
-    if (nSize == neededNeighboursCount) {
+    if (blocks.empty()) {
         return;
     }
 
-    csmeta(csdetails) << "Neighbours count without ss: " << static_cast<int>(neededNeighboursCount);
-
-    const uint8_t allNeighboursCount = static_cast<uint8_t>(transport_->getNeighboursCount());
-
-    // Add new neighbours
-    if (nSize < neededNeighboursCount) {
-        for (uint8_t i = nSize; i < allNeighboursCount; ++i) {
-            ConnectionPtr neighbour = transport_->getConnectionByNumber(i);
-            if (neighbour && !neighbour->isSignal && neighbour->lastSeq) {
-                auto isAlreadyHave = std::find_if(neighbours_.begin(), neighbours_.end(), [=](const auto& el) { return el.index() == i; });
+    cs::Sequence lastWrittenSequence = blockChain_->getLastSeq();
+    const cs::Sequence oldLastWrittenSequence = lastWrittenSequence;
+    const std::size_t oldCachedBlocksSize = blockChain_->getCachedBlocksSize();
 
-                if (isAlreadyHave == neighbours_.end()) {
-                    neighbours_.emplace_back(NeighboursSetElemet(i, neighbour->key, syncData_.blockPoolsCount));
-                }
-            }
+    for (auto& pool : blocks) {
+        if (pool.sequence() <= lastWrittenSequence) {
+            continue;
         }
-        csmeta(csdetails) << "Neighbours saved count is: " << neighbours_.size();
-        return;
-    }
 
-    // refresh neighbours index
-    std::size_t currentNh = 0;
-    for (uint8_t i = 0; i < allNeighboursCount; ++i) {
-        ConnectionPtr neighbour = transport_->getConnectionByNumber(i);
-        if (neighbour && !neighbour->isSignal) {
-            neighbours_[currentNh].setIndex(i);
-            neighbours_[currentNh].setPublicKey(neighbour->key);
-            ++currentNh;
+        if (!blockChain_->storeBlock(pool, true /*by_sync*/)) {
+            cserror() << "PoolSyncronizer> Failed to store pool #" << pool.sequence();
+            restart();
+            break;
         }
-    }
 
-    // remove extra neighbour
-    for (uint8_t i = neededNeighboursCount; i < nSize; ++i) {
-        const auto& seqs = neighbours_.back().sequences();
-        for (const auto& seq : seqs) {
-            bool isAvailable = true;
-
-            if (neighbours_.size() > 1) {
-                auto res = std::find_if(neighbours_.begin(), neighbours_.end() - 1,
-                                        [seq](const NeighboursSetElemet& el) { return std::find(el.sequences().begin(), el.sequences().end(), seq) != el.sequences().end(); });
-                if (res != neighbours_.end() - 1) {
-                    isAvailable = false;
-                }
-            }
-
-            if (isAvailable) {
-                requestedSequences_.erase(seq);
-            }
-        }
-        neighbours_.pop_back();
+        blockChain_->testCachedBlocks();
+        lastWrittenSequence = blockChain_->getLastSeq();
     }
 
-    csmeta(csdetails) << "Neighbours saved count is: " << neighbours_.size();
-    printNeighbours("Refresh:");
-}
-
-bool cs::PoolSynchronizer::isLastRequest() const {
-    const auto sum = cs::Conveyer::instance().currentRoundNumber() - blockChain_->getLastSeq() - blockChain_->getCachedBlocksSize();
-    return sum <= syncData_.blockPoolsCount;
-}
-
-bool cs::PoolSynchronizer::isAvailableRequest(const cs::PoolSynchronizer::NeighboursSetElemet& nh) const {
-    const auto value = nh.roundCounter();
+    if (!isSyncroStarted_) {
+        return;
+    }
 
-    if (value != 0) {
-        return ((value % syncData_.requestRepeatRoundCount) == 0);
+    if (oldCachedBlocksSize != blockChain_->getCachedBlocksSize() || oldLastWrittenSequence != lastWrittenSequence) {
+        const bool isFinished = showSyncronizationProgress(lastWrittenSequence);
+        if (isFinished) {
+            synchroFinished();
+            return;
+        }
     }
 
-    return false;
+    sendBlockRequest();
 }
 
 void cs::PoolSynchronizer::synchroFinished() {
@@ -626,36 +357,29 @@ void cs::PoolSynchronizer::synchroFinished() {
     if (timer_.isRunning()) {
         timer_.stop();
     }
-    if (roundSimulation_.isRunning()) {
-        roundSimulation_.stop();
-    }
+
     isSyncroStarted_ = false;
-    requestedSequences_.clear();
-    neighbours_.clear();
+    window_.clear();
 
     csmeta(csdebug) << "Synchro finished";
 }
 
-ConnectionPtr cs::PoolSynchronizer::getConnection(const NeighboursSetElemet& neighbour) const {
-    ConnectionPtr target = transport_->getConnectionByKey(neighbour.publicKey());
+void cs::PoolSynchronizer::printNeighbours(const std::string& funcName) const {
+    const uint32_t neighboursCount = transport_->getNeighboursCount();
 
-    if (!target) {
-        target = transport_->getConnectionByNumber(neighbour.index());
-    }
+    for (uint32_t i = 0; i < neighboursCount; ++i) {
+        ConnectionPtr neighbour = transport_->getConnectionByNumber(i);
 
-    return target;
-}
+        if (!neighbour) {
+            continue;
+        }
 
-void cs::PoolSynchronizer::printNeighbours(const std::string& funcName) const {
-    for (const auto& neighbour : neighbours_) {
-        ConnectionPtr target = getConnection(neighbour);
+        const auto state = window_.peerState(neighbour->key);
 
-        if (target) {
-            csmeta(csdebug) << funcName << " Neighbour: " << target->getOut() << ", " << neighbour;
-        }
-        else {
-            csmeta(csdebug) << funcName << " Neighbour index: " << neighbour.index() << ", does not contained in transport. Neighbours сount: " << transport_->getNeighboursCount()
-                            << ", neighbour key: " << cs::Utils::byteStreamToHex(neighbour.publicKey().data(), neighbour.publicKey().size());
+        if (state) {
+            csmeta(csdebug) << funcName << " Neighbour: " << neighbour->getOut() << ", last seq: " << state->lastSequence << ", window: " << state->window
+                            << ", in flight: " << state->inFlight << ", reply: " << std::chrono::duration_cast<std::chrono::milliseconds>(state->smoothedReply).count()
+                            << " ms, replies: " << state->replies << ", timeouts: " << state->timeouts;
         }
     }
 }
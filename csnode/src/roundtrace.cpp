@@ -0,0 +1,198 @@
+#include <csnode/roundtrace.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+constexpr size_t kTracksCount = 5;
+constexpr const char* kTrackNames[kTracksCount] = {"round", "solver", "stages", "blocks", "smarts"};
+
+uint64_t packInfo(cs::RoundTrace::Track track, cs::RoundTrace::Phase phase, int32_t arg) {
+    return (static_cast<uint64_t>(track) << 40) | (static_cast<uint64_t>(phase) << 32) | static_cast<uint32_t>(arg);
+}
+
+size_t roundUpToPowerOf2(size_t value) {
+    size_t result = 1;
+
+    while (result < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+void writeEscaped(std::ostream& stream, const char* value) {
+    for (; *value != '\0'; ++value) {
+        if (*value == '"' || *value == '\\') {
+            stream << '\\';
+        }
+
+        stream << *value;
+    }
+}
+
+char phaseSymbol(cs::RoundTrace::Phase phase) {
+    switch (phase) {
+        case cs::RoundTrace::Phase::Begin:
+            return 'B';
+        case cs::RoundTrace::Phase::End:
+            return 'E';
+        case cs::RoundTrace::Phase::Instant:
+            return 'i';
+    }
+
+    return 'i';
+}
+}  // namespace
+
+cs::RoundTrace::Ring::Ring(size_t size)
+: slots(std::make_unique<Slot[]>(size))
+, mask(size - 1) {
+}
+
+cs::RoundTrace& cs::RoundTrace::instance() {
+    static RoundTrace trace;
+    return trace;
+}
+
+cs::RoundTrace::~RoundTrace() {
+    ring_.store(nullptr, std::memory_order_release);
+}
+
+void cs::RoundTrace::enable(size_t capacity) {
+    std::lock_guard lock(enableMutex_);
+
+    // ring is never replaced, recording threads may hold it
+    if (capacity == 0 || storage_) {
+        return;
+    }
+
+    storage_ = std::make_unique<Ring>(roundUpToPowerOf2(capacity));
+    ring_.store(storage_.get(), std::memory_order_release);
+}
+
+bool cs::RoundTrace::isEnabled() const noexcept {
+    return ring_.load(std::memory_order_acquire) != nullptr;
+}
+
+size_t cs::RoundTrace::capacity() const noexcept {
+    const Ring* ring = ring_.load(std::memory_order_acquire);
+    return ring != nullptr ? ring->mask + 1 : 0;
+}
+
+void cs::RoundTrace::startRound(RoundNumber round) noexcept {
+    round_.store(round, std::memory_order_release);
+    instant("round", Track::Round);
+}
+
+void cs::RoundTrace::push(Ring& ring, const char* name, Track track, Phase phase, int32_t arg) noexcept {
+    const auto index = ring.next.fetch_add(1, std::memory_order_relaxed);
+    const auto time = Clock::now().time_since_epoch().count();
+    Slot& slot = ring.slots[index & ring.mask];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.time.store(time, std::memory_order_relaxed);
+    slot.round.store(round_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.info.store(packInfo(track, phase, arg), std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+std::vector<cs::RoundTrace::Event> cs::RoundTrace::events(size_t rounds) const {
+    std::vector<Event> result;
+    const Ring* ring = ring_.load(std::memory_order_acquire);
+
+    if (ring == nullptr) {
+        return result;
+    }
+
+    const uint64_t capacity = ring->mask + 1;
+    const uint64_t next = ring->next.load(std::memory_order_acquire);
+    const uint64_t first = next > capacity ? next - capacity : 0;
+
+    result.reserve(static_cast<size_t>(next - first));
+    RoundNumber lastRound = 0;
+
+    for (uint64_t index = first; index < next; ++index) {
+        const Slot& slot = ring->slots[index & ring->mask];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        Event event;
+        event.index = index;
+        event.time = Clock::time_point(Clock::duration(slot.time.load(std::memory_order_relaxed)));
+        event.round = slot.round.load(std::memory_order_relaxed);
+        event.name = slot.name.load(std::memory_order_relaxed);
+
+        const uint64_t info = slot.info.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // slot is being written or already reused by newer event
+        if (sequence != 2 * index + 2 || slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        event.track = static_cast<Track>((info >> 40) & 0xff);
+        event.phase = static_cast<Phase>((info >> 32) & 0xff);
+        event.arg = static_cast<int32_t>(static_cast<uint32_t>(info));
+
+        lastRound = std::max(lastRound, event.round);
+        result.push_back(event);
+    }
+
+    if (rounds != 0) {
+        result.erase(std::remove_if(result.begin(), result.end(), [=](const Event& event) { return lastRound - event.round >= rounds; }), result.end());
+    }
+
+    return result;
+}
+
+void cs::RoundTrace::writeChromeTrace(std::ostream& stream, size_t rounds) const {
+    const auto list = events(rounds);
+    auto origin = Clock::time_point::max();
+
+    // recording order may differ from time order of events from different threads a bit
+    for (const auto& event : list) {
+        origin = std::min(origin, event.time);
+    }
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (size_t track = 0; track < kTracksCount; ++track) {
+        stream << (track == 0 ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track << ",\"args\":{\"name\":\"" << kTrackNames[track]
+               << "\"}}";
+    }
+
+    stream << std::fixed << std::setprecision(3);
+
+    for (const auto& event : list) {
+        const auto timestamp = std::chrono::duration<double, std::micro>(event.time - origin).count();
+
+        stream << ",\n{\"name\":\"";
+        writeEscaped(stream, event.name != nullptr ? event.name : "");
+        stream << "\",\"cat\":\"" << kTrackNames[static_cast<size_t>(event.track) % kTracksCount] << "\",\"ph\":\"" << phaseSymbol(event.phase) << "\",";
+
+        if (event.phase == Phase::Instant) {
+            stream << "\"s\":\"t\",";
+        }
+
+        stream << "\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << static_cast<size_t>(event.track) << ",\"args\":{\"round\":" << event.round;
+
+        if (event.arg != kNoArg) {
+            stream << ",\"arg\":" << event.arg;
+        }
+
+        stream << "}}";
+    }
+
+    stream << "\n]}\n";
+}
+
+std::string cs::RoundTrace::chromeTrace(size_t rounds) const {
+    std::ostringstream stream;
+    writeChromeTrace(stream, rounds);
+    return stream.str();
+}
@@ -0,0 +1,171 @@
+#include <csnode/signaturecache.hpp>
+
+#include <algorithm>
+
+#include <csdb/transaction.hpp>
+
+namespace cs {
+SignatureCache& SignatureCache::instance() {
+    static SignatureCache cache;
+    return cache;
+}
+
+SignatureCache::SignatureCache(size_t capacity)
+: capacity_(capacity) {
+}
+
+bool SignatureCache::verify(const Signature& signature, const PublicKey& publicKey, const Byte* data, size_t size) {
+    if (capacity_.load(std::memory_order_acquire) == 0) {
+        return cscrypto::verifySignature(signature, publicKey, data, size);
+    }
+
+    const Hash key = makeKey(signature, publicKey, cscrypto::calculateHash(data, size));
+
+    if (lookup(key)) {
+        return true;
+    }
+
+    return remember(key, cscrypto::verifySignature(signature, publicKey, data, size));
+}
+
+bool SignatureCache::verify(const csdb::Transaction& transaction, const PublicKey& publicKey) {
+    if (capacity_.load(std::memory_order_acquire) == 0) {
+        return transaction.verify_signature(publicKey);
+    }
+
+    // signed bytes and their hash are kept by transaction
+    const Hash key = makeKey(transaction.signature(), publicKey, transaction.hash_for_sig());
+
+    if (lookup(key)) {
+        return true;
+    }
+
+    return remember(key, transaction.verify_signature(publicKey));
+}
+
+void SignatureCache::setRound(RoundNumber round) {
+    RoundNumber current = round_.load(std::memory_order_acquire);
+
+    while (current < round && !round_.compare_exchange_weak(current, round, std::memory_order_acq_rel)) {
+    }
+
+    const size_t capacity = capacity_.load(std::memory_order_acquire);
+    round = round_.load(std::memory_order_acquire);
+
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        shrink(shard, capacity, round);
+    }
+}
+
+void SignatureCache::setCapacity(size_t capacity) {
+    capacity_.store(capacity, std::memory_order_release);
+
+    const RoundNumber round = round_.load(std::memory_order_acquire);
+
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        shrink(shard, capacity, round);
+    }
+}
+
+void SignatureCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        shard.entries.clear();
+        shard.order.clear();
+    }
+}
+
+SignatureCache::Stats SignatureCache::stats() const {
+    Stats result;
+    result.hits = hits_.load(std::memory_order_relaxed);
+    result.misses = misses_.load(std::memory_order_relaxed);
+    result.failures = failures_.load(std::memory_order_relaxed);
+    result.evictions = evictions_.load(std::memory_order_relaxed);
+    return result;
+}
+
+Hash SignatureCache::makeKey(const Signature& signature, const PublicKey& publicKey, const Hash& dataHash) {
+    std::array<Byte, kHashLength + kSignatureLength + kPublicKeyLength> material;
+    auto iter = std::copy(dataHash.begin(), dataHash.end(), material.begin());
+    iter = std::copy(signature.begin(), signature.end(), iter);
+    std::copy(publicKey.begin(), publicKey.end(), iter);
+
+    return cscrypto::calculateHash(material.data(), material.size());
+}
+
+bool SignatureCache::lookup(const Hash& key) {
+    if (find(key)) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool SignatureCache::remember(const Hash& key, bool isVerified) {
+    if (!isVerified) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    insert(key);
+    return true;
+}
+
+bool SignatureCache::find(const Hash& key) {
+    auto& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto iter = shard.entries.find(key);
+    if (iter == shard.entries.end()) {
+        return false;
+    }
+
+    if (isExpired(iter->second, round_.load(std::memory_order_acquire))) {
+        shard.entries.erase(iter);
+        return false;
+    }
+
+    return true;
+}
+
+void SignatureCache::insert(const Hash& key) {
+    const RoundNumber round = round_.load(std::memory_order_acquire);
+    const size_t capacity = capacity_.load(std::memory_order_acquire);
+
+    auto& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto [iter, inserted] = shard.entries.emplace(key, round);
+    if (!inserted) {
+        if (iter->second >= round) {
+            return;
+        }
+
+        iter->second = round;
+    }
+
+    shard.order.emplace_back(key, round);
+    shrink(shard, capacity, round);
+}
+
+void SignatureCache::shrink(Shard& shard, size_t capacity, RoundNumber round) {
+    const size_t shardCapacity = capacity ? std::max<size_t>(capacity / kShardsCount, 1) : 0;
+
+    while (!shard.order.empty() && (shard.entries.size() > shardCapacity || isExpired(shard.order.front().second, round))) {
+        const auto& [key, verified] = shard.order.front();
+
+        // entry could be refreshed after this record was pushed, then the record is stale
+        auto iter = shard.entries.find(key);
+        if (iter != shard.entries.end() && iter->second == verified) {
+            shard.entries.erase(iter);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        shard.order.pop_front();
+    }
+}
+}  // namespace cs
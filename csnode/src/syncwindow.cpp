@@ -0,0 +1,305 @@
+#include <csnode/syncwindow.hpp>
+
+#include <algorithm>
+
+cs::SyncWindow::Clock::duration cs::SyncWindow::PeerState::timeout() const {
+    if (!isMeasured) {
+        return kInitialTimeout;
+    }
+
+    const Clock::duration value = smoothedReply + 4 * replyVariation;
+    return std::clamp<Clock::duration>(value, kMinTimeout, kMaxTimeout);
+}
+
+cs::SyncWindow::SyncWindow(std::size_t blocksPerRequest, double initialWindow)
+: blocksPerRequest_(std::max<std::size_t>(blocksPerRequest, 1))
+, initialWindow_(std::clamp(initialWindow, kMinWindow, kMaxWindow)) {
+}
+
+void cs::SyncWindow::setRange(cs::Sequence from, cs::Sequence to) {
+    from_ = from;
+    to_ = to;
+
+    received_.erase(received_.begin(), received_.lower_bound(from_));
+    retry_.erase(retry_.begin(), retry_.lower_bound(from_));
+
+    for (auto iter = requests_.begin(); iter != requests_.end();) {
+        auto& sequences = iter->second.sequences;
+
+        for (auto sequence = sequences.begin(); sequence != sequences.end() && *sequence < from_;) {
+            inFlight_.erase(*sequence);
+            sequence = sequences.erase(sequence);
+        }
+
+        if (sequences.empty()) {
+            iter = release(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+
+    next_ = std::max(next_, from_);
+}
+
+void cs::SyncWindow::setPeers(const std::vector<Peer>& peers) {
+    std::map<cs::PublicKey, PeerState> updated;
+
+    for (const auto& peer : peers) {
+        auto iter = peers_.find(peer.key);
+
+        PeerState state;
+        if (iter != peers_.end()) {
+            state = iter->second;
+        }
+        else {
+            state.window = initialWindow_;
+        }
+
+        state.lastSequence = peer.lastSequence;
+        updated.emplace(peer.key, state);
+    }
+
+    for (auto iter = requests_.begin(); iter != requests_.end();) {
+        if (updated.find(iter->second.peer) == updated.end()) {
+            iter = release(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+
+    peers_.swap(updated);
+}
+
+std::vector<cs::SyncWindow::Request> cs::SyncWindow::schedule(Clock::time_point now) {
+    std::vector<Request> result;
+    bool isScheduled = true;
+
+    // one request per peer at a pass, so the needed sequences are spread across all peers
+    while (isScheduled) {
+        isScheduled = false;
+
+        for (auto& [key, peer] : peers_) {
+            if (peer.inFlight >= static_cast<std::size_t>(peer.window)) {
+                continue;
+            }
+
+            auto sequences = takeSequences(peer.lastSequence);
+
+            if (sequences.empty()) {
+                continue;
+            }
+
+            const RequestId id = ++lastId_;
+
+            Pending pending;
+            pending.peer = key;
+            pending.sequences.insert(sequences.begin(), sequences.end());
+            pending.sent = now;
+
+            for (const auto sequence : sequences) {
+                inFlight_.emplace(sequence, id);
+            }
+
+            requests_.emplace(id, std::move(pending));
+            ++peer.inFlight;
+
+            result.push_back(Request{id, key, std::move(sequences)});
+            isScheduled = true;
+        }
+    }
+
+    return result;
+}
+
+bool cs::SyncWindow::onReply(RequestId id, const PoolsRequestedSequences& received, Clock::time_point now) {
+    auto iter = requests_.find(id);
+
+    if (iter == requests_.end()) {
+        for (const auto sequence : received) {
+            onReceived(sequence);
+        }
+
+        return false;
+    }
+
+    auto peer = peers_.find(iter->second.peer);
+
+    // reply may come by several packets, the first one gives reply time
+    if (!iter->second.isReplied) {
+        iter->second.isReplied = true;
+
+        if (peer != peers_.end()) {
+            measure(peer->second, now - iter->second.sent);
+            ++peer->second.replies;
+        }
+    }
+
+    for (const auto sequence : received) {
+        onReceived(sequence);
+    }
+
+    const bool isCompleted = requests_.find(id) == requests_.end();
+
+    if (isCompleted && peer != peers_.end()) {
+        auto& state = peer->second;
+        state.window += state.window < state.threshold ? 1.0 : 1.0 / state.window;
+        state.window = std::min(state.window, kMaxWindow);
+    }
+
+    return true;
+}
+
+void cs::SyncWindow::onReceived(cs::Sequence sequence) {
+    if (sequence >= from_) {
+        received_.insert(sequence);
+    }
+
+    retry_.erase(sequence);
+
+    auto flight = inFlight_.find(sequence);
+
+    if (flight == inFlight_.end()) {
+        return;
+    }
+
+    auto request = requests_.find(flight->second);
+    inFlight_.erase(flight);
+
+    if (request != requests_.end()) {
+        request->second.sequences.erase(sequence);
+
+        if (request->second.sequences.empty()) {
+            release(request);
+        }
+    }
+}
+
+void cs::SyncWindow::onRejected(cs::Sequence sequence) {
+    received_.erase(sequence);
+
+    if (isNeeded(sequence) && sequence < next_) {
+        retry_.insert(sequence);
+    }
+}
+
+void cs::SyncWindow::cancel(RequestId id) {
+    auto iter = requests_.find(id);
+
+    if (iter != requests_.end()) {
+        release(iter);
+    }
+}
+
+std::size_t cs::SyncWindow::expire(Clock::time_point now) {
+    std::size_t count = 0;
+
+    for (auto iter = requests_.begin(); iter != requests_.end();) {
+        auto peer = peers_.find(iter->second.peer);
+        const Clock::duration timeout = peer != peers_.end() ? peer->second.timeout() : Clock::duration(kInitialTimeout);
+
+        if (now - iter->second.sent < timeout) {
+            ++iter;
+            continue;
+        }
+
+        if (peer != peers_.end()) {
+            auto& state = peer->second;
+            ++state.timeouts;
+            state.threshold = std::max(state.window / 2, kMinWindow);
+            state.window = state.threshold;
+        }
+
+        iter = release(iter);
+        ++count;
+    }
+
+    return count;
+}
+
+void cs::SyncWindow::clear() {
+    requests_.clear();
+    inFlight_.clear();
+    received_.clear();
+    retry_.clear();
+
+    for (auto& [key, peer] : peers_) {
+        (void)key;
+        peer.inFlight = 0;
+    }
+
+    next_ = from_;
+}
+
+bool cs::SyncWindow::isDone() const {
+    return from_ > to_ || (next_ > to_ && retry_.empty() && requests_.empty());
+}
+
+std::size_t cs::SyncWindow::outstanding() const {
+    return requests_.size();
+}
+
+const cs::SyncWindow::PeerState* cs::SyncWindow::peerState(const cs::PublicKey& key) const {
+    auto iter = peers_.find(key);
+    return iter != peers_.end() ? &iter->second : nullptr;
+}
+
+bool cs::SyncWindow::isNeeded(cs::Sequence sequence) const {
+    return sequence >= from_ && sequence <= to_ && received_.find(sequence) == received_.end() && inFlight_.find(sequence) == inFlight_.end();
+}
+
+cs::PoolsRequestedSequences cs::SyncWindow::takeSequences(cs::Sequence limit) {
+    limit = std::min(limit, to_);
+
+    PoolsRequestedSequences result;
+    result.reserve(blocksPerRequest_);
+
+    // sequences to retry are always lower than cursor, so the result stays sorted
+    for (auto iter = retry_.begin(); iter != retry_.end() && *iter <= limit && result.size() < blocksPerRequest_;) {
+        result.push_back(*iter);
+        iter = retry_.erase(iter);
+    }
+
+    while (result.size() < blocksPerRequest_ && next_ <= limit) {
+        if (isNeeded(next_)) {
+            result.push_back(next_);
+        }
+
+        ++next_;
+    }
+
+    return result;
+}
+
+void cs::SyncWindow::measure(PeerState& peer, Clock::duration reply) {
+    if (!peer.isMeasured) {
+        peer.smoothedReply = reply;
+        peer.replyVariation = reply / 2;
+        peer.isMeasured = true;
+        return;
+    }
+
+    const Clock::duration delta = peer.smoothedReply > reply ? peer.smoothedReply - reply : reply - peer.smoothedReply;
+
+    peer.replyVariation = (3 * peer.replyVariation + delta) / 4;
+    peer.smoothedReply = (7 * peer.smoothedReply + reply) / 8;
+}
+
+cs::SyncWindow::Requests::iterator cs::SyncWindow::release(Requests::iterator iter) {
+    auto peer = peers_.find(iter->second.peer);
+
+    if (peer != peers_.end() && peer->second.inFlight > 0) {
+        --peer->second.inFlight;
+    }
+
+    for (const auto sequence : iter->second.sequences) {
+        inFlight_.erase(sequence);
+
+        if (isNeeded(sequence)) {
+            retry_.insert(sequence);
+        }
+    }
+
+    return requests_.erase(iter);
+}
@@ -16,74 +16,53 @@ TransactionsPacketHash TransactionsPacketHash::fromString(const ::std::string& s
         return TransactionsPacketHash();
     }
 
-    TransactionsPacketHash res;
     const cs::Bytes hash = ::csdb::internal::from_hex(str);
-
-    if (::csdb::priv::crypto::hash_size == hash.size()) {
-        res.m_bytes = hash;
-    }
-
-    return res;
+    return fromBinary(hash);
 }
 
 TransactionsPacketHash TransactionsPacketHash::fromBinary(const cs::Bytes& data) {
-    const size_t size = data.size();
-    TransactionsPacketHash hash;
-
-    if (::csdb::priv::crypto::hash_size == size) {
-        hash.m_bytes = data;
-    }
-
-    return hash;
+    return fromBinary(data.data(), data.size());
 }
 
-TransactionsPacketHash TransactionsPacketHash::fromBinary(cs::Bytes&& data) {
-    const size_t size = data.size();
-    TransactionsPacketHash hash;
-
-    if (::csdb::priv::crypto::hash_size == size) {
-        hash.m_bytes = std::move(data);
+TransactionsPacketHash TransactionsPacketHash::fromBinary(const cs::Byte* data, size_t size) {
+    if (::csdb::priv::crypto::hash_size != size || sizeof(cs::Hash) != size) {
+        return TransactionsPacketHash();
     }
 
-    return hash;
+    cs::Hash hash;
+    std::copy(data, data + size, hash.begin());
+
+    return TransactionsPacketHash(hash);
 }
 
 TransactionsPacketHash TransactionsPacketHash::calcFromData(const cs::Bytes& data) {
-    TransactionsPacketHash resHash;
-    resHash.m_bytes = ::csdb::priv::crypto::calc_hash(data);
-    return resHash;
+    return fromBinary(::csdb::priv::crypto::calc_hash(data));
+}
+
+TransactionsPacketHash TransactionsPacketHash::calcFromData(const cs::Byte* data, size_t size) {
+    return TransactionsPacketHash(cscrypto::calculateHash(data, size));
 }
 
 //
 // Interface
 //
 
-bool TransactionsPacketHash::isEmpty() const noexcept {
-    return m_bytes.empty();
-}
-
-size_t TransactionsPacketHash::size() const noexcept {
-    return m_bytes.size();
+TransactionsPacketHash::TransactionsPacketHash(const cs::Hash& hash) noexcept
+: m_bytes(hash)
+, m_key(getHashValue(hash))
+, m_isEmpty(false) {
 }
 
 std::string TransactionsPacketHash::toString() const noexcept {
-    return csdb::internal::to_hex(m_bytes.begin(), m_bytes.end());
-}
-
-const cs::Bytes& TransactionsPacketHash::toBinary() const noexcept {
-    return m_bytes;
-}
-
-bool TransactionsPacketHash::operator==(const TransactionsPacketHash& other) const noexcept {
-    return m_bytes == other.m_bytes;
-}
+    if (m_isEmpty) {
+        return std::string();
+    }
 
-bool TransactionsPacketHash::operator!=(const TransactionsPacketHash& other) const noexcept {
-    return !operator==(other);
+    return csdb::internal::to_hex(m_bytes.begin(), m_bytes.end());
 }
 
-bool TransactionsPacketHash::operator<(const TransactionsPacketHash& other) const noexcept {
-    return m_bytes < other.m_bytes;
+cs::Bytes TransactionsPacketHash::toBinary() const noexcept {
+    return cs::Bytes(data(), data() + size());
 }
 
 //
@@ -95,25 +74,27 @@ TransactionsPacket TransactionsPacket::fromBinary(const cs::Bytes& data) {
 }
 
 TransactionsPacket TransactionsPacket::fromByteStream(const char* data, size_t size) {
-    ::csdb::priv::ibstream is(data, size);
-
     TransactionsPacket res;
 
-    if (!res.get(is)) {
-        return TransactionsPacket();
+    // other representation is decoded and serialized again to get the same hash as other nodes
+    if (!res.split(data, size)) {
+        ::csdb::priv::ibstream is(data, size);
+
+        if (!res.get(is)) {
+            return TransactionsPacket();
+        }
     }
 
     res.makeHash();
     return res;
 }
 
-TransactionsPacket::TransactionsPacket(TransactionsPacket&& packet)
-: m_hash(std::move(packet.m_hash))
-, m_transactions(std::move(packet.m_transactions))
-, m_stateTransactions(std::move(packet.m_stateTransactions))
-, m_signatures(std::move(packet.m_signatures)) {
-    packet.m_hash = TransactionsPacketHash();
-    packet.m_transactions.clear();
+TransactionsPacket::TransactionsPacket(const TransactionsPacket& packet) {
+    *this = packet;
+}
+
+TransactionsPacket::TransactionsPacket(TransactionsPacket&& packet) {
+    *this = std::move(packet);
 }
 
 TransactionsPacket& TransactionsPacket::operator=(const TransactionsPacket& packet) {
@@ -121,11 +102,43 @@ TransactionsPacket& TransactionsPacket::operator=(const TransactionsPacket& pack
         return *this;
     }
 
+    std::lock_guard lock(packet.m_mutex);
+
     m_hash = packet.m_hash;
     m_transactions = packet.m_transactions;
     m_signatures = packet.m_signatures;
     m_stateTransactions = packet.m_stateTransactions;
 
+    m_binary = packet.m_binary;
+    m_statesOffset = packet.m_statesOffset;
+    m_signaturesOffset = packet.m_signaturesOffset;
+    m_isDecoded.store(packet.m_isDecoded.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return *this;
+}
+
+TransactionsPacket& TransactionsPacket::operator=(TransactionsPacket&& packet) {
+    if (this == &packet) {
+        return *this;
+    }
+
+    m_hash = std::move(packet.m_hash);
+    m_transactions = std::move(packet.m_transactions);
+    m_signatures = std::move(packet.m_signatures);
+    m_stateTransactions = std::move(packet.m_stateTransactions);
+
+    m_binary = std::move(packet.m_binary);
+    m_statesOffset = packet.m_statesOffset;
+    m_signaturesOffset = packet.m_signaturesOffset;
+    m_isDecoded.store(packet.m_isDecoded.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    packet.m_hash = TransactionsPacketHash();
+    packet.m_transactions.clear();
+    packet.m_signatures.clear();
+    packet.m_stateTransactions.clear();
+    packet.invalidate();
+    packet.m_isDecoded.store(true, std::memory_order_relaxed);
+
     return *this;
 }
 
@@ -134,16 +147,43 @@ TransactionsPacket& TransactionsPacket::operator=(const TransactionsPacket& pack
 //
 
 cs::Bytes TransactionsPacket::toBinary(Serialization options) const noexcept {
-    ::csdb::priv::obstream os;
-    put(os, options);
-    return os.buffer();
+    std::lock_guard lock(m_mutex);
+    const cs::Bytes& binary = this->binary();
+
+    if (options == Serialization::All) {
+        return binary;
+    }
+
+    cs::Bytes result;
+
+    auto append = [&](size_t begin, size_t end) {
+        result.insert(result.end(), binary.begin() + static_cast<std::ptrdiff_t>(begin), binary.begin() + static_cast<std::ptrdiff_t>(end));
+    };
+
+    if (options & Serialization::Transactions) {
+        append(0, m_statesOffset);
+    }
+
+    if (options & Serialization::States) {
+        append(m_statesOffset, m_signaturesOffset);
+    }
+
+    if (options & Serialization::Signatures) {
+        append(m_signaturesOffset, binary.size());
+    }
+
+    return result;
 }
 
 bool TransactionsPacket::makeHash() {
     bool isEmpty = isHashEmpty();
 
     if (isEmpty) {
-        m_hash = TransactionsPacketHash::calcFromData(toBinary(Serialization::Transactions));
+        std::lock_guard lock(m_mutex);
+
+        // transactions section is hashed only
+        const cs::Bytes& binary = this->binary();
+        m_hash = TransactionsPacketHash::calcFromData(binary.data(), m_statesOffset);
     }
 
     return isEmpty;
@@ -157,8 +197,15 @@ const TransactionsPacketHash& TransactionsPacket::hash() const noexcept {
     return m_hash;
 }
 
-size_t TransactionsPacket::transactionsCount() const noexcept {
-    return m_transactions.size();
+size_t TransactionsPacket::transactionsCount() const {
+    if (m_isDecoded.load(std::memory_order_acquire)) {
+        return m_transactions.size();
+    }
+
+    // binary representation is not changed until decoded
+    std::size_t count = 0;
+    std::copy(m_binary.data(), m_binary.data() + sizeof(count), reinterpret_cast<cs::Byte*>(&count));
+    return count;
 }
 
 bool TransactionsPacket::addTransaction(const csdb::Transaction& transaction) {
@@ -166,7 +213,10 @@ bool TransactionsPacket::addTransaction(const csdb::Transaction& transaction) {
         return false;
     }
 
+    decode();
     m_transactions.push_back(transaction);
+    invalidate();
+
     return true;
 }
 
@@ -175,11 +225,16 @@ bool TransactionsPacket::addStateTransaction(const csdb::Transaction& transactio
         return false;
     }
 
+    decode();
     m_stateTransactions.push_back(transaction);
+    invalidate();
+
     return true;
 }
 
 bool TransactionsPacket::addSignature(const cs::Byte index, const cs::Signature& signature) {
+    decode();
+
     auto iter = std::find_if(m_signatures.begin(), m_signatures.end(), [&](const auto& element) { return index == element.first; });
 
     if (iter != m_signatures.end()) {
@@ -187,27 +242,36 @@ bool TransactionsPacket::addSignature(const cs::Byte index, const cs::Signature&
     }
 
     m_signatures.push_back(std::make_pair(index, signature));
+    invalidate();
+
     return true;
 }
 
-const cs::BlockSignatures& TransactionsPacket::signatures() const noexcept {
+const cs::BlockSignatures& TransactionsPacket::signatures() const {
+    decode();
     return m_signatures;
 }
 
-const std::vector<csdb::Transaction>& TransactionsPacket::transactions() const noexcept {
+const std::vector<csdb::Transaction>& TransactionsPacket::transactions() const {
+    decode();
     return m_transactions;
 }
 
-const std::vector<csdb::Transaction>& TransactionsPacket::stateTransactions() const noexcept {
+const std::vector<csdb::Transaction>& TransactionsPacket::stateTransactions() const {
+    decode();
     return m_stateTransactions;
 }
 
 std::vector<csdb::Transaction>& TransactionsPacket::transactions() {
+    decode();
+    invalidate();
     return m_transactions;
 }
 
-void TransactionsPacket::clear() noexcept {
+void TransactionsPacket::clear() {
+    decode();
     m_transactions.clear();
+    invalidate();
 }
 
 //
@@ -241,7 +305,7 @@ void TransactionsPacket::put(::csdb::priv::obstream& os, Serialization options)
     }
 }
 
-bool TransactionsPacket::get(::csdb::priv::ibstream& is) {
+bool TransactionsPacket::get(::csdb::priv::ibstream& is) const {
     std::size_t transactionsCount = 0;
 
     if (!is.get(transactionsCount)) {
@@ -302,4 +366,111 @@ bool TransactionsPacket::get(::csdb::priv::ibstream& is) {
 
     return true;
 }
+
+bool TransactionsPacket::split(const char* data, size_t size) {
+    ::csdb::priv::ibstream is(data, size);
+    auto offset = [&] { return size - is.size(); };
+
+    std::size_t count = 0;
+
+    if (!is.get(count)) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!csdb::Transaction::skip(is)) {
+            return false;
+        }
+    }
+
+    const size_t statesOffset = offset();
+
+    // states and signatures may be absent, they are serialized as empty ones
+    bool hasStates = is.get(count);
+
+    if (hasStates) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!csdb::Transaction::skip(is)) {
+                return false;
+            }
+        }
+    }
+
+    const size_t signaturesOffset = offset();
+    bool hasSignatures = is.get(count);
+
+    if (hasSignatures) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!is.skip(sizeof(cs::Byte) + sizeof(cs::Signature))) {
+                return false;
+            }
+        }
+    }
+
+    const auto begin = reinterpret_cast<const cs::Byte*>(data);
+    m_binary.assign(begin, begin + offset());
+
+    if (!hasStates) {
+        m_binary.insert(m_binary.end(), sizeof(std::size_t), 0);
+    }
+
+    if (!hasSignatures) {
+        m_binary.insert(m_binary.end(), sizeof(std::size_t), 0);
+    }
+
+    m_statesOffset = statesOffset;
+    m_signaturesOffset = hasStates ? signaturesOffset : signaturesOffset + sizeof(std::size_t);
+    m_isDecoded.store(false, std::memory_order_release);
+
+    return true;
+}
+
+void TransactionsPacket::decode() const {
+    if (m_isDecoded.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    if (m_isDecoded.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    ::csdb::priv::ibstream is(m_binary.data(), m_binary.size());
+
+    // the representation is checked by split()
+    if (!get(is)) {
+        m_transactions.clear();
+        m_stateTransactions.clear();
+        m_signatures.clear();
+        m_binary.clear();
+    }
+
+    m_isDecoded.store(true, std::memory_order_release);
+}
+
+const cs::Bytes& TransactionsPacket::binary() const {
+    if (!m_binary.empty()) {
+        return m_binary;
+    }
+
+    ::csdb::priv::obstream os;
+
+    put(os, Serialization::Transactions);
+    m_statesOffset = os.buffer().size();
+
+    put(os, Serialization::States);
+    m_signaturesOffset = os.buffer().size();
+
+    put(os, Serialization::Signatures);
+    m_binary = os.buffer();
+
+    return m_binary;
+}
+
+void TransactionsPacket::invalidate() {
+    m_binary = cs::Bytes();
+    m_statesOffset = 0;
+    m_signaturesOffset = 0;
+}
 }  // namespace cs
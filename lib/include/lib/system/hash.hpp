@@ -2,6 +2,9 @@
 #ifndef HASH_HPP
 #define HASH_HPP
 
+#include <cstring>
+#include <random>
+
 #include <lib/system/common.hpp>
 #include "utils.hpp"
 
@@ -9,24 +12,132 @@ inline cs::Hash generateHash(const void* data, size_t length) {
     return cscrypto::calculateHash(reinterpret_cast<const uint8_t*>(data), length);
 }
 
-template <>
-inline uint16_t getHashIndex(const cs::Hash& hash) {
-    constexpr const size_t border = kHashLength / 2;
+namespace cs {
+// Keyed SipHash-2-4, fast enough to key local lookup tables by whole packets.
+// The key is random per process, so remote side can not craft colliding packets,
+// and the result must never be sent: peers know packets by generateHash only.
+class SipHash {
+public:
+    struct Key {
+        uint64_t k0;
+        uint64_t k1;
+    };
+
+    static const Key& processKey() {
+        static const Key key = [] {
+            std::random_device device;
+            auto next = [&device] { return (static_cast<uint64_t>(device()) << 32) | device(); };
+
+            Key result;
+            result.k0 = next();
+            result.k1 = next();
+            return result;
+        }();
+
+        return key;
+    }
 
-    uint16_t result = 0;
-    auto byte = reinterpret_cast<uint8_t*>(&result);
+    static uint64_t calculate(const void* data, size_t length) {
+        return calculate(data, length, processKey());
+    }
+
+    static uint64_t calculate(const void* data, size_t length, const Key& key) {
+        uint64_t v0 = 0x736f6d6570736575ULL ^ key.k0;
+        uint64_t v1 = 0x646f72616e646f6dULL ^ key.k1;
+        uint64_t v2 = 0x6c7967656e657261ULL ^ key.k0;
+        uint64_t v3 = 0x7465646279746573ULL ^ key.k1;
+
+        auto round = [&] {
+            v0 += v1;
+            v1 = rotate(v1, 13);
+            v1 ^= v0;
+            v0 = rotate(v0, 32);
+            v2 += v3;
+            v3 = rotate(v3, 16);
+            v3 ^= v2;
+            v0 += v3;
+            v3 = rotate(v3, 21);
+            v3 ^= v0;
+            v2 += v1;
+            v1 = rotate(v1, 17);
+            v1 ^= v2;
+            v2 = rotate(v2, 32);
+        };
+
+        auto compress = [&](uint64_t word) {
+            v3 ^= word;
+            round();
+            round();
+            v0 ^= word;
+        };
+
+        const auto bytes = static_cast<const uint8_t*>(data);
+        const size_t tail = length % sizeof(uint64_t);
+        const uint8_t* end = bytes + length - tail;
+
+        for (auto ptr = bytes; ptr != end; ptr += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, ptr, sizeof(word));
+            compress(word);
+        }
+
+        uint64_t last = static_cast<uint64_t>(length) << 56;
+
+        for (size_t i = 0; i < tail; ++i) {
+            last |= static_cast<uint64_t>(end[i]) << (8 * i);
+        }
+
+        compress(last);
+
+        v2 ^= 0xff;
+
+        for (size_t i = 0; i < 4; ++i) {
+            round();
+        }
+
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
 
-    for (size_t i = 0; i < border; ++i) {
-        *byte ^= hash[i];
+private:
+    static uint64_t rotate(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
     }
+};
 
-    ++byte;
+// key of packet in local dedup tables
+struct DedupKey {
+    uint64_t value = 0;
 
-    for (size_t i = border; i < kHashLength; ++i) {
-        *byte ^= hash[i];
+    bool operator==(const DedupKey& other) const {
+        return value == other.value;
     }
 
-    return result;
+    bool operator!=(const DedupKey& other) const {
+        return !(*this == other);
+    }
+};
+}  // namespace cs
+
+template <>
+inline uint64_t getHashValue(const cs::Hash& hash) {
+    // hashes come from the network, so they are mixed with the process key not to be chosen to collide
+    uint64_t value;
+    std::memcpy(&value, hash.data(), sizeof(value));
+
+    value ^= cs::SipHash::processKey().k0;
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+
+    return value;
+}
+
+template <>
+inline uint64_t getHashValue(const cs::DedupKey& key) {
+    // already keyed
+    return key.value;
 }
 
 template<int N>
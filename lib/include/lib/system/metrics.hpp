@@ -0,0 +1,216 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <lib/system/cache.hpp>
+
+namespace cs::metrics {
+using Labels = std::map<std::string, std::string>;
+
+enum class Type {
+    Counter,
+    Gauge,
+    Histogram
+};
+
+// updates of one metric by different threads go to different cache lines
+constexpr size_t kShards = 16;
+
+// shard of calling thread, threads are spread round robin
+inline size_t threadShard() noexcept {
+    static std::atomic<size_t> next = {0};
+    thread_local const size_t shard = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return shard;
+}
+
+// monotonic counter, updates are a relaxed increment of the thread shard
+class Counter {
+public:
+    void add(uint64_t value = 1) noexcept {
+        shards_[threadShard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const noexcept;
+
+private:
+    struct Shard {
+        __cacheline_aligned std::atomic<uint64_t> value = {0};
+    };
+
+    std::array<Shard, kShards> shards_;
+};
+
+// value which goes up and down, the last set one is kept
+class Gauge {
+public:
+    void set(double value) noexcept {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    void add(double value) noexcept {
+        double current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+        }
+    }
+
+    double value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> value_ = {0};
+};
+
+// distribution of values over fixed buckets, the bucket of value is the first one with upper bound not less than it
+class Histogram {
+public:
+    struct Snapshot {
+        std::vector<double> bounds;
+
+        // per bucket, the last one is for values above all bounds
+        std::vector<uint64_t> counts;
+        uint64_t count = 0;
+        double sum = 0;
+    };
+
+    // latency buckets in seconds from 100 us to 10 s
+    static std::vector<double> latencyBounds();
+
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value) noexcept {
+        const auto index = static_cast<size_t>(std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+        auto& shard = shards_[threadShard()];
+
+        shard.counts[index].fetch_add(1, std::memory_order_relaxed);
+
+        double sum = shard.sum.load(std::memory_order_relaxed);
+        while (!shard.sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+        }
+    }
+
+    Snapshot snapshot() const;
+
+    const std::vector<double>& bounds() const noexcept {
+        return bounds_;
+    }
+
+private:
+    struct Shard {
+        __cacheline_aligned std::atomic<double> sum = {0};
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;
+    };
+
+    std::vector<double> bounds_;
+    std::array<Shard, kShards> shards_;
+};
+
+// observes seconds elapsed from construction to destruction
+class ScopedLatency {
+public:
+    explicit ScopedLatency(Histogram& histogram) noexcept
+    : histogram_(histogram)
+    , start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~ScopedLatency() {
+        histogram_.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+class Registry;
+
+// registration of value read on scrape, unregisters on destruction,
+// so objects owning probes of their own state are never read after destruction
+class Probe {
+public:
+    Probe() = default;
+    ~Probe();
+
+    Probe(Probe&& other) noexcept;
+    Probe& operator=(Probe&& other) noexcept;
+
+    Probe(const Probe&) = delete;
+    Probe& operator=(const Probe&) = delete;
+
+    void reset();
+
+private:
+    Probe(Registry* registry, std::string name, std::string labels, uint64_t id);
+
+    Registry* registry_ = nullptr;
+    std::string name_;
+    std::string labels_;
+    uint64_t id_ = 0;
+
+    friend class Registry;
+};
+
+///
+/// @brief Process wide metrics exposed in Prometheus text format.
+/// Metrics are registered once, usually to static references, and are never removed, so updates do not lock.
+/// Values of probes are read on scrape only, probes of the same name and labels are summed.
+/// Registration of the same name with another type throws std::logic_error.
+///
+class Registry {
+public:
+    static Registry& instance();
+
+    Counter& counter(const std::string& name, const std::string& help, const Labels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+    Histogram& histogram(const std::string& name, const std::string& help, std::vector<double> bounds = Histogram::latencyBounds(),
+                         const Labels& labels = {});
+
+    // read is called by scraping thread under registry lock, it must not register metrics
+    [[nodiscard]] Probe probe(const std::string& name, const std::string& help, Type type, std::function<double()> read, const Labels& labels = {});
+
+    // text exposition format 0.0.4
+    std::string exposition() const;
+
+private:
+    struct Series {
+        Labels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+        std::map<uint64_t, std::function<double()>> probes;
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+
+        // by formatted labels
+        std::map<std::string, Series> series;
+    };
+
+    Series& series(const std::string& name, const std::string& help, Type type, const Labels& labels);
+    void remove(const std::string& name, const std::string& labels, uint64_t id);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+    uint64_t lastProbeId_ = 0;
+
+    friend class Probe;
+};
+}  // namespace cs::metrics
+
+#endif  // METRICS_HPP
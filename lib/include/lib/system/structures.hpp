@@ -1,10 +1,13 @@
 /* Send blaming letters to @yrtimd */
 #ifndef STRUCTURES_HPP
 #define STRUCTURES_HPP
+#include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <limits>
 
 #include "allocators.hpp"
 #include "cache.hpp"
@@ -213,116 +216,297 @@ private:
     T* end_;
 };
 
-/* A simple queue-like counting hash-map of fixed size. Not
-   thread-safe. */
-template <typename ResultType, typename ArgType>
-inline ResultType getHashIndex(const ArgType&);
-
-template <typename KeyType, typename ArgType, typename IndexType = uint16_t, uint32_t MaxSize = 100000>
-class FixedHashMap {
+/* A counting hash-map of limited capacity with open addressing and
+   Robin Hood probing. Elements are kept in insertion order, the oldest
+   ones are evicted when the map is full or, if expiry is set, when they
+   have been stored for longer. Elements are never moved, so references
+   returned by tryStore and tryGet are valid until the element is evicted.
+   Not thread-safe. */
+template <typename KeyType>
+inline uint64_t getHashValue(const KeyType&);
+
+template <typename KeyType, typename ArgType>
+class OpenHashMap {
 public:
-    struct Element {
-        Element *up, *down = nullptr;
-        Element** bucket;
+    using Clock = std::chrono::steady_clock;
 
+    struct Element {
         KeyType key;
         ArgType data = {};
 
+        uint32_t hash;
+        Clock::time_point stored;
+
         ArgType& operator*() {
             return data;
         }
 
-        Element(const KeyType& _key, Element** _bucket)
-        : bucket(_bucket)
-        , key(_key) {
+        Element(const KeyType& _key, uint32_t _hash, Clock::time_point _stored)
+        : key(_key)
+        , hash(_hash)
+        , stored(_stored) {
+        }
+    };
+
+    class Iterator {
+    public:
+        Iterator& operator++() {
+            ++position_;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& rhs) const {
+            return position_ != rhs.position_;
+        }
+
+        Element& operator*() const {
+            return map_->elementAt(position_);
         }
+
+        Element* operator->() const {
+            return &map_->elementAt(position_);
+        }
+
+    private:
+        Iterator(const OpenHashMap* map, uint32_t position)
+        : map_(map)
+        , position_(position) {
+        }
+
+        const OpenHashMap* map_;
+        uint32_t position_;
+
+        friend OpenHashMap;
     };
-    using ElementPtr = Element*;
 
-    FixedHashMap() {
-        static_assert(MaxSize >= 2, "Your member is too small");
+    // slots of index are kept at most 3/4 full when the map is full
+    explicit OpenHashMap(uint32_t capacity, std::chrono::milliseconds expiry = std::chrono::milliseconds::zero())
+    : capacity_(capacity)
+    , expiry_(expiry) {
+        assert(capacity_ >= 1 && capacity_ < Empty);
 
-        const size_t bucketsSize = 1 << (sizeof(IndexType) * 8);
-        buckets_ = new ElementPtr[bucketsSize];
-        std::memset(buckets_, 0, bucketsSize * sizeof(ElementPtr));
+        uint32_t slotsCount = 8;
+        while (slotsCount < capacity_ + capacity_ / 2) {
+            slotsCount <<= 1;
+        }
+
+        mask_ = slotsCount - 1;
+        slots_ = new Slot[slotsCount];
+        elements_ = reinterpret_cast<Element*>(new uint8_t[sizeof(Element) * capacity_]);
     }
 
-    FixedHashMap(const FixedHashMap&) = delete;
-    FixedHashMap(FixedHashMap&& rhs)
-    : buffer_(std::move(rhs.buffer_))
-    , buckets_(rhs.buckets_) {
-        rhs.buckets_ = nullptr;
+    OpenHashMap(const OpenHashMap&) = delete;
+    OpenHashMap(OpenHashMap&& rhs)
+    : capacity_(rhs.capacity_)
+    , expiry_(rhs.expiry_)
+    , mask_(rhs.mask_)
+    , slots_(rhs.slots_)
+    , elements_(rhs.elements_)
+    , head_(rhs.head_)
+    , size_(rhs.size_) {
+        rhs.slots_ = nullptr;
+        rhs.elements_ = nullptr;
+        rhs.size_ = 0;
     }
 
-    ~FixedHashMap() {
-        delete[] buckets_;
+    OpenHashMap& operator=(const OpenHashMap&) = delete;
+    OpenHashMap& operator=(OpenHashMap&&) = delete;
+
+    ~OpenHashMap() {
+        clear();
+
+        delete[] slots_;
+        delete[] reinterpret_cast<uint8_t*>(elements_);
     }
 
     ArgType& tryStore(const KeyType& key) {
-        Element** myBucket;
-        auto foundElement = getElt(key, &myBucket);
+        const auto now = expire();
+        const uint32_t hash = static_cast<uint32_t>(getHashValue<KeyType>(key));
 
-        if (foundElement) {
-            return foundElement->data;
+        if (Element* element = find(key, hash)) {
+            return element->data;
         }
 
         // Element not found, add a new one
-        if (buffer_.size() == MaxSize) {
-            preparePopLeft();
+        if (size_ == capacity_) {
+            popOldest();
         }
 
-        Element& newComer = buffer_.emplace(key, myBucket);
-        newComer.up = *myBucket;
+        uint32_t index = head_ + size_;
+        if (index >= capacity_) {
+            index -= capacity_;
+        }
+
+        Element* element = new (elements_ + index) Element(key, hash, now);
+        ++size_;
+
+        insert(Slot{hash, index});
+        return element->data;
+    }
+
+    ArgType* tryGet(const KeyType& key) {
+        expire();
+        Element* element = find(key, static_cast<uint32_t>(getHashValue<KeyType>(key)));
+        return element ? &element->data : nullptr;
+    }
+
+    // keeps the newest elements if capacity is less than size
+    void resize(uint32_t capacity) {
+        OpenHashMap result(capacity, expiry_);
+
+        while (size_ > capacity) {
+            popOldest();
+        }
 
-        if (newComer.up) {
-            newComer.up->down = &newComer;
+        for (auto& element : *this) {
+            uint32_t index = result.size_++;
+            new (result.elements_ + index) Element(std::move(element));
+            result.insert(Slot{element.hash, index});
         }
 
-        *myBucket = &newComer;
-        return newComer.data;
+        clear();
+
+        std::swap(capacity_, result.capacity_);
+        std::swap(mask_, result.mask_);
+        std::swap(slots_, result.slots_);
+        std::swap(elements_, result.elements_);
+        std::swap(head_, result.head_);
+        std::swap(size_, result.size_);
     }
 
-    auto begin() {
-        return buffer_.begin();
+    void clear() {
+        while (size_) {
+            popOldest();
+        }
+
+        head_ = 0;
     }
-    auto end() {
-        return buffer_.end();
+
+    uint32_t size() const {
+        return size_;
+    }
+
+    uint32_t capacity() const {
+        return capacity_;
+    }
+
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this, size_);
     }
 
 private:
-    Element* getElt(const KeyType& key, Element*** bucket) {
-        const IndexType idx = getHashIndex<IndexType, KeyType>(key);
-        *bucket = buckets_ + idx;
-
-        Element* eltInBucket = **bucket;
-        while (eltInBucket) {
-            if (eltInBucket->key == key) {
-                return eltInBucket;
+    constexpr static uint32_t Empty = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+        uint32_t hash = 0;
+        uint32_t element = Empty;
+    };
+
+    Element& elementAt(uint32_t position) const {
+        uint32_t index = head_ + position;
+        if (index >= capacity_) {
+            index -= capacity_;
+        }
+
+        return elements_[index];
+    }
+
+    uint32_t distance(const Slot& slot, uint32_t position) const {
+        return (position - slot.hash) & mask_;
+    }
+
+    Element* find(const KeyType& key, uint32_t hash) const {
+        uint32_t position = hash & mask_;
+
+        for (uint32_t probe = 0;; ++probe, position = (position + 1) & mask_) {
+            const Slot& slot = slots_[position];
+
+            // a richer slot means the key would have been placed before
+            if (slot.element == Empty || distance(slot, position) < probe) {
+                return nullptr;
             }
 
-            eltInBucket = eltInBucket->up;
+            if (slot.hash == hash && elements_[slot.element].key == key) {
+                return elements_ + slot.element;
+            }
         }
+    }
+
+    void insert(Slot slot) {
+        uint32_t position = slot.hash & mask_;
 
-        return nullptr;
+        for (uint32_t probe = 0;; ++probe, position = (position + 1) & mask_) {
+            Slot& current = slots_[position];
+
+            if (current.element == Empty) {
+                current = slot;
+                return;
+            }
+
+            const uint32_t currentProbe = distance(current, position);
+
+            if (currentProbe < probe) {
+                std::swap(current, slot);
+                probe = currentProbe;
+            }
+        }
     }
 
-    void preparePopLeft() {
-        auto toRemove = buffer_.frontPtr();
+    void popOldest() {
+        Element& oldest = elements_[head_];
+        uint32_t position = oldest.hash & mask_;
 
-        if (toRemove->down) {
-            toRemove->down->up = toRemove->up;
+        while (slots_[position].element != head_) {
+            position = (position + 1) & mask_;
         }
-        else {
-            *(toRemove->bucket) = toRemove->up;
+
+        // backward shift keeps probe sequences without tombstones
+        uint32_t next = (position + 1) & mask_;
+
+        while (slots_[next].element != Empty && distance(slots_[next], next) != 0) {
+            slots_[position] = slots_[next];
+            position = next;
+            next = (next + 1) & mask_;
         }
 
-        if (toRemove->up) {
-            toRemove->up->down = toRemove->down;
+        slots_[position] = Slot{};
+
+        oldest.~Element();
+
+        if (++head_ == capacity_) {
+            head_ = 0;
         }
+
+        --size_;
     }
 
-    FixedCircularBuffer<Element, MaxSize> buffer_;
-    Element** buckets_;
+    Clock::time_point expire() {
+        if (expiry_ == std::chrono::milliseconds::zero()) {
+            return Clock::time_point{};
+        }
+
+        const auto now = Clock::now();
+
+        while (size_ && now - elements_[head_].stored >= expiry_) {
+            popOldest();
+        }
+
+        return now;
+    }
+
+    uint32_t capacity_;
+    std::chrono::milliseconds expiry_;
+
+    uint32_t mask_ = 0;
+    Slot* slots_ = nullptr;
+    Element* elements_ = nullptr;
+
+    uint32_t head_ = 0;
+    uint32_t size_ = 0;
 };
 
 class CallsQueue {
@@ -0,0 +1,160 @@
+#ifndef TASKGRAPH_HPP
+#define TASKGRAPH_HPP
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <lib/system/concurrent.hpp>
+
+namespace cs {
+// runs a set of tasks respecting their dependencies,
+// concurrent tasks are posted to the thread pool, others are executed by the calling thread,
+// the first failed task cancels all tasks not started yet
+class TaskGraph {
+public:
+    using Task = std::function<bool()>;
+    using Mask = uint64_t;
+
+    static constexpr size_t kMaxTasks = sizeof(Mask) * 8;
+
+    // dependencies is a mask of indexes of tasks added before, returns index of added task
+    size_t add(Task task, Mask dependencies = 0, bool concurrent = false) {
+        assert(nodes_.size() < kMaxTasks);
+        assert((dependencies >> nodes_.size()) == 0);
+
+        nodes_.push_back(Node{std::move(task), dependencies, concurrent});
+        return nodes_.size() - 1;
+    }
+
+    void clear() {
+        nodes_.clear();
+    }
+
+    size_t size() const noexcept {
+        return nodes_.size();
+    }
+
+    // long running tasks may check it to stop earlier
+    bool isCancelled() const noexcept {
+        return cancelled_.load(std::memory_order_acquire);
+    }
+
+    // without pool all tasks are executed by calling thread in order of adding,
+    // exception of any task is rethrown after all started tasks are finished
+    bool run(Threads* pool = nullptr);
+
+private:
+    struct Node {
+        Task task;
+        Mask dependencies;
+        bool concurrent;
+    };
+
+    static Mask bit(size_t index) {
+        return Mask(1) << index;
+    }
+
+    std::vector<Node> nodes_;
+    std::atomic<bool> cancelled_ = false;
+};
+
+inline bool TaskGraph::run(Threads* pool) {
+    cancelled_.store(false, std::memory_order_release);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::exception_ptr exception;
+
+    Mask pending = (nodes_.size() == kMaxTasks) ? ~Mask(0) : bit(nodes_.size()) - 1;
+    Mask done = 0;
+    size_t running = 0;
+
+    // called under lock
+    auto complete = [&](size_t index, bool result, std::exception_ptr error) {
+        done |= bit(index);
+
+        if (!result) {
+            cancelled_.store(true, std::memory_order_release);
+        }
+
+        if (error && !exception) {
+            exception = error;
+        }
+    };
+
+    auto execute = [this](size_t index, std::exception_ptr& error) {
+        if (isCancelled()) {
+            return false;
+        }
+
+        try {
+            return nodes_[index].task();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        return false;
+    };
+
+    std::unique_lock lock(mutex);
+
+    while (pending && !isCancelled()) {
+        size_t index = kMaxTasks;
+
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if ((pending & bit(i)) && (nodes_[i].dependencies & done) == nodes_[i].dependencies) {
+                index = i;
+                break;
+            }
+        }
+
+        // dependencies point to earlier tasks only, so the first pending one waits for running tasks
+        if (index == kMaxTasks) {
+            condition.wait(lock);
+            continue;
+        }
+
+        pending &= ~bit(index);
+
+        if (pool != nullptr && nodes_[index].concurrent) {
+            ++running;
+
+            boost::asio::post(*pool, [&, index] {
+                std::exception_ptr error;
+                const bool result = execute(index, error);
+
+                // notify under lock, waiting thread destroys condition right after wake up
+                std::lock_guard guard(mutex);
+                complete(index, result, error);
+                --running;
+                condition.notify_all();
+            });
+        }
+        else {
+            lock.unlock();
+
+            std::exception_ptr error;
+            const bool result = execute(index, error);
+
+            lock.lock();
+            complete(index, result, error);
+        }
+    }
+
+    condition.wait(lock, [&] { return running == 0; });
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    return !isCancelled();
+}
+}  // namespace cs
+
+#endif  // TASKGRAPH_HPP
@@ -0,0 +1,302 @@
+#include "lib/system/metrics.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+std::string escape(const std::string& value, bool isLabel) {
+    std::string result;
+    result.reserve(value.size());
+
+    for (const char symbol : value) {
+        if (symbol == '\\') {
+            result += "\\\\";
+        }
+        else if (symbol == '\n') {
+            result += "\\n";
+        }
+        else if (symbol == '"' && isLabel) {
+            result += "\\\"";
+        }
+        else {
+            result += symbol;
+        }
+    }
+
+    return result;
+}
+
+// {a="1",b="2"} or empty string without labels
+std::string format(const cs::metrics::Labels& labels) {
+    if (labels.empty()) {
+        return std::string();
+    }
+
+    std::string result = "{";
+
+    for (const auto& [name, value] : labels) {
+        if (result.size() > 1) {
+            result += ',';
+        }
+
+        result += name + "=\"" + escape(value, true) + '"';
+    }
+
+    return result + '}';
+}
+
+void writeValue(std::ostream& stream, double value) {
+    if (std::isnan(value)) {
+        stream << "NaN";
+    }
+    else if (std::isinf(value)) {
+        stream << (value > 0 ? "+Inf" : "-Inf");
+    }
+    else if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        stream << static_cast<int64_t>(value);
+    }
+    else {
+        stream << std::setprecision(15) << value;
+    }
+}
+
+const char* typeName(cs::metrics::Type type) {
+    switch (type) {
+        case cs::metrics::Type::Counter:
+            return "counter";
+        case cs::metrics::Type::Gauge:
+            return "gauge";
+        case cs::metrics::Type::Histogram:
+            return "histogram";
+    }
+
+    return "untyped";
+}
+}  // namespace
+
+uint64_t cs::metrics::Counter::value() const noexcept {
+    uint64_t result = 0;
+
+    for (const auto& shard : shards_) {
+        result += shard.value.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+std::vector<double> cs::metrics::Histogram::latencyBounds() {
+    return {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+}
+
+cs::metrics::Histogram::Histogram(std::vector<double> bounds)
+: bounds_(std::move(bounds)) {
+    std::sort(bounds_.begin(), bounds_.end());
+    bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+
+    for (auto& shard : shards_) {
+        shard.counts = std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1);
+    }
+}
+
+cs::metrics::Histogram::Snapshot cs::metrics::Histogram::snapshot() const {
+    Snapshot result;
+    result.bounds = bounds_;
+    result.counts.resize(bounds_.size() + 1);
+
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < result.counts.size(); ++i) {
+            const auto count = shard.counts[i].load(std::memory_order_relaxed);
+            result.counts[i] += count;
+            result.count += count;
+        }
+
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+cs::metrics::Probe::Probe(Registry* registry, std::string name, std::string labels, uint64_t id)
+: registry_(registry)
+, name_(std::move(name))
+, labels_(std::move(labels))
+, id_(id) {
+}
+
+cs::metrics::Probe::~Probe() {
+    reset();
+}
+
+cs::metrics::Probe::Probe(Probe&& other) noexcept
+: registry_(other.registry_)
+, name_(std::move(other.name_))
+, labels_(std::move(other.labels_))
+, id_(other.id_) {
+    other.registry_ = nullptr;
+}
+
+cs::metrics::Probe& cs::metrics::Probe::operator=(Probe&& other) noexcept {
+    if (this != &other) {
+        reset();
+
+        registry_ = other.registry_;
+        name_ = std::move(other.name_);
+        labels_ = std::move(other.labels_);
+        id_ = other.id_;
+
+        other.registry_ = nullptr;
+    }
+
+    return *this;
+}
+
+void cs::metrics::Probe::reset() {
+    if (registry_ != nullptr) {
+        registry_->remove(name_, labels_, id_);
+        registry_ = nullptr;
+    }
+}
+
+cs::metrics::Registry& cs::metrics::Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+cs::metrics::Counter& cs::metrics::Registry::counter(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard lock(mutex_);
+    auto& item = series(name, help, Type::Counter, labels);
+
+    if (!item.counter) {
+        item.counter = std::make_unique<Counter>();
+    }
+
+    return *item.counter;
+}
+
+cs::metrics::Gauge& cs::metrics::Registry::gauge(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard lock(mutex_);
+    auto& item = series(name, help, Type::Gauge, labels);
+
+    if (!item.gauge) {
+        item.gauge = std::make_unique<Gauge>();
+    }
+
+    return *item.gauge;
+}
+
+cs::metrics::Histogram& cs::metrics::Registry::histogram(const std::string& name, const std::string& help, std::vector<double> bounds, const Labels& labels) {
+    std::lock_guard lock(mutex_);
+    auto& item = series(name, help, Type::Histogram, labels);
+
+    // bounds of the first registration are kept
+    if (!item.histogram) {
+        item.histogram = std::make_unique<Histogram>(std::move(bounds));
+    }
+
+    return *item.histogram;
+}
+
+cs::metrics::Probe cs::metrics::Registry::probe(const std::string& name, const std::string& help, Type type, std::function<double()> read, const Labels& labels) {
+    if (type == Type::Histogram) {
+        throw std::logic_error("metric " + name + " of histogram type can not be probed");
+    }
+
+    std::lock_guard lock(mutex_);
+    auto& item = series(name, help, type, labels);
+
+    const auto id = ++lastProbeId_;
+    item.probes.emplace(id, std::move(read));
+
+    return Probe(this, name, format(labels), id);
+}
+
+std::string cs::metrics::Registry::exposition() const {
+    std::ostringstream stream;
+    std::lock_guard lock(mutex_);
+
+    for (const auto& [name, family] : families_) {
+        stream << "# HELP " << name << ' ' << escape(family.help, false) << '\n';
+        stream << "# TYPE " << name << ' ' << typeName(family.type) << '\n';
+
+        for (const auto& [labels, item] : family.series) {
+            if (item.histogram) {
+                const auto snapshot = item.histogram->snapshot();
+                uint64_t cumulative = 0;
+
+                for (size_t i = 0; i < snapshot.counts.size(); ++i) {
+                    auto bucketLabels = item.labels;
+                    std::ostringstream bound;
+
+                    if (i < snapshot.bounds.size()) {
+                        writeValue(bound, snapshot.bounds[i]);
+                    }
+                    else {
+                        bound << "+Inf";
+                    }
+
+                    bucketLabels["le"] = bound.str();
+                    cumulative += snapshot.counts[i];
+
+                    stream << name << "_bucket" << format(bucketLabels) << ' ' << cumulative << '\n';
+                }
+
+                stream << name << "_sum" << labels << ' ';
+                writeValue(stream, snapshot.sum);
+                stream << '\n' << name << "_count" << labels << ' ' << snapshot.count << '\n';
+                continue;
+            }
+
+            double value = 0;
+
+            if (item.counter) {
+                value += static_cast<double>(item.counter->value());
+            }
+
+            if (item.gauge) {
+                value += item.gauge->value();
+            }
+
+            for (const auto& [id, read] : item.probes) {
+                value += read();
+            }
+
+            stream << name << labels << ' ';
+            writeValue(stream, value);
+            stream << '\n';
+        }
+    }
+
+    return stream.str();
+}
+
+cs::metrics::Registry::Series& cs::metrics::Registry::series(const std::string& name, const std::string& help, Type type, const Labels& labels) {
+    auto [iterator, isInserted] = families_.try_emplace(name, Family{type, help, {}});
+
+    if (!isInserted && iterator->second.type != type) {
+        throw std::logic_error("metric " + name + " is registered as " + typeName(iterator->second.type));
+    }
+
+    auto& item = iterator->second.series[format(labels)];
+    item.labels = labels;
+
+    return item;
+}
+
+void cs::metrics::Registry::remove(const std::string& name, const std::string& labels, uint64_t id) {
+    std::lock_guard lock(mutex_);
+
+    auto family = families_.find(name);
+
+    if (family == families_.end()) {
+        return;
+    }
+
+    auto item = family->second.series.find(labels);
+
+    if (item != family->second.series.end()) {
+        item->second.probes.erase(id);
+    }
+}
@@ -110,7 +110,7 @@ struct Connection {
         bool needSend = true;
     };
 
-    FixedHashMap<cs::Hash, MsgRel, uint16_t, MaxMessagesToKeep> msgRels;
+    OpenHashMap<cs::Hash, MsgRel> msgRels{MaxMessagesToKeep};
 
     cs::Sequence syncSeqs[BlocksToSync] = {0};
     cs::Sequence syncSeqsRetries[BlocksToSync] = {0};
@@ -132,6 +132,9 @@ public:
     const static uint32_t MinNeighbours = 3;
     const static uint32_t MaxConnectAttempts = 64;
 
+    // sent packs are resent until neighbours inform about them
+    const static uint32_t MaxPacksToKeep = 10000;
+
     explicit Neighbourhood(Transport*);
 
     void chooseNeighbours();
@@ -233,7 +236,7 @@ private:
 
     std::deque<ConnectionPtr> neighbours_;
     std::vector<ConnectionPtr> selection_;
-    FixedHashMap<ip::udp::endpoint, ConnectionPtr, uint16_t, MaxConnections> connections_;
+    OpenHashMap<ip::udp::endpoint, ConnectionPtr> connections_{MaxConnections};
 
     struct SenderInfo {
         uint32_t totalSenders = 0;
@@ -241,9 +244,9 @@ private:
         ConnectionPtr prioritySender;
     };
 
-    FixedHashMap<cs::Hash, SenderInfo, uint16_t, MaxMessagesToKeep> msgSenders_;
-    FixedHashMap<cs::Hash, BroadPackInfo, uint16_t, 10000> msgBroads_;
-    FixedHashMap<cs::Hash, DirectPackInfo, uint16_t, 10000> msgDirects_;
+    OpenHashMap<cs::Hash, SenderInfo> msgSenders_{MaxMessagesToKeep};
+    OpenHashMap<cs::Hash, BroadPackInfo> msgBroads_{MaxPacksToKeep};
+    OpenHashMap<cs::Hash, DirectPackInfo> msgDirects_{MaxPacksToKeep};
 };
 
 #endif  // NEIGHBOURHOOD_HPP
@@ -7,8 +7,11 @@
 #endif
 #include <boost/asio.hpp>
 
+#include <functional>
+
 #include <client/config.hpp>
 #include <lib/system/cache.hpp>
+#include <lib/system/metrics.hpp>
 #include "pacmans.hpp"
 
 using io_context = boost::asio::io_context;
@@ -32,6 +35,37 @@ public:
     bool resendFragment(const cs::Hash&, const uint16_t, const ip::udp::endpoint&);
     void registerMessage(Packet*, const uint32_t size);
 
+    // pacing of outgoing traffic per peer
+    void onDelivered(const ip::udp::endpoint&);
+    void onLoss(const ip::udp::endpoint&);
+    std::vector<OPacMan::PeerStats> getPacingStats() const;
+
+    // receive counters of one input socket
+    struct ReaderStats {
+        size_t index = 0;
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t rejected = 0;
+        uint64_t errors = 0;
+    };
+
+    std::vector<ReaderStats> getReaderStats() const;
+
+    using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+    // updated by the reader of one input socket only
+    struct ReaderCounters {
+        __cacheline_aligned std::atomic<uint64_t> packets = {0};
+        std::atomic<uint64_t> bytes = {0};
+        std::atomic<uint64_t> rejected = {0};
+        std::atomic<uint64_t> errors = {0};
+    };
+
+    // receive loop of one input socket until stop is set, notify is called after every received datagram,
+    // while processing lags behind lastProcessed new datagrams overwrite the allocated task
+    static void readPackets(ip::udp::socket&, IPacMan&, size_t index, ReaderCounters&, const std::atomic<bool>& stop,
+                            const std::atomic<TimePoint>& lastProcessed, const std::function<void()>& notify);
+
     Network(const Network&) = delete;
     Network(Network&&) = delete;
     Network& operator=(const Network&) = delete;
@@ -44,15 +78,21 @@ public:
     };
 
 private:
-    void readerRoutine(const Config&);
+    struct Reader : ReaderCounters {
+        std::thread thread;
+    };
+
+    void registerMetrics();
+
+    void readerRoutine(const Config&, size_t index);
     void writerRoutine(const Config&);
     void processorRoutine();
     inline void processTask(TaskPtr<IPacMan>&);
 
-    ip::udp::socket* getSocketInThread(const bool, const EndpointData&, std::atomic<ThreadStatus>&, const bool useIPv6);
+    ip::udp::socket* getSocketInThread(const bool, const EndpointData&, std::atomic<ThreadStatus>&, const bool useIPv6, const bool reusePort = false);
 
     bool good_;
-    bool stopReaderRoutine = false;
+    std::atomic<bool> stopReaderRoutine = {false};
     bool stopWriterRoutine = false;
     bool stopProcessorRoutine = false;
 
@@ -64,7 +104,12 @@ private:
 
     Transport* transport_;
 
-    FixedHashMap<cs::Hash, uint32_t, uint16_t, 100000> packetMap_;
+    // time of the last processed packet, readers drop input while processing lags
+    std::atomic<TimePoint> lastProcessedTime_{std::chrono::high_resolution_clock::now()};
+
+    // received packets are counted to process every packet once
+    constexpr static uint32_t MaxPacketsToKeep = 100000;
+    OpenHashMap<cs::DedupKey, uint32_t> packetMap_{MaxPacketsToKeep};
 
     // Only needed in a one-socket configuration
     __cacheline_aligned std::atomic<bool> singleSockOpened_ = {false};
@@ -74,7 +119,8 @@ private:
     __cacheline_aligned std::atomic<ThreadStatus> readerStatus_ = {NonInit};
     __cacheline_aligned std::atomic<ThreadStatus> writerStatus_ = {NonInit};
 
-    std::thread readerThread_;
+    // the first reader uses the single socket or opens the input one, others open sockets on the same port
+    std::vector<std::unique_ptr<Reader>> readers_;
     std::thread writerThread_;
     std::thread processorThread_;
 
@@ -97,6 +143,9 @@ private:
     std::atomic_flag readerLock = ATOMIC_FLAG_INIT;
     std::atomic_flag writerLock = ATOMIC_FLAG_INIT;
 #endif
+
+    // read the members above, so they are declared last to be unregistered first
+    std::vector<cs::metrics::Probe> probes_;
 };
 
 #endif  // NETWORK_HPP
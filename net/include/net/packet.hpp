@@ -85,6 +85,15 @@ enum MsgTypes : uint8_t {
     NodeStopRequest = 255
 };
 
+// packets are drained by weights of their priorities on receive and send, consensus first
+enum class PacketPriority : uint8_t {
+    Consensus,
+    Regular,
+    Bulk
+};
+
+constexpr size_t kPacketPrioritiesCount = 3;
+
 class Packet {
 public:
     static const uint32_t MaxSize = 1024;
@@ -131,6 +140,11 @@ public:
         return hash_;
     }
 
+    // local only, see cs::SipHash
+    cs::DedupKey getDedupKey() const {
+        return cs::DedupKey{cs::SipHash::calculate(region_->data(), region_->size())};
+    }
+
     bool addressedToMe(const cs::PublicKey& myKey) const {
         return isNetwork() || isNeighbors() || (isBroadcast() && !(getSender() == myKey)) || getAddressee() == myKey;
     }
@@ -150,6 +164,9 @@ public:
     const cs::Hash& getHeaderHash() const;
     bool isHeaderValid() const;
 
+    // by message type, fragments except the first one do not carry the type and are regular
+    PacketPriority getPriority() const;
+
     const uint16_t& getFragmentId() const {
         return getWithOffset<uint16_t>(Offsets::FragmentId);
     }
@@ -322,6 +339,7 @@ private:
     mutable uint32_t headersLength_ = 0;
 
     friend class IPacMan;
+    friend class OPacMan;
     friend class Message;
 };
 
@@ -355,11 +373,11 @@ public:
     }
 
     size_t getFullSize() const {
-        if (!fullData_) {
-            composeFullData();
+        if (fullData_) {
+            return fullData_->size() - packets_[0].getHeadersLength();
         }
 
-        return fullData_->size() - packets_[0].getHeadersLength();
+        return dataSize(packets_);
     }
 
     Packet extractData() const {
@@ -373,6 +391,10 @@ public:
         return result;
     }
 
+    // payloads of fragments in place without headers, views are valid while fragments are alive
+    static std::vector<cs::BytesView> dataSegments(const std::vector<Packet>& fragments);
+    static size_t dataSize(const std::vector<Packet>& fragments);
+
 private:
     static RegionAllocator allocator_;
 
@@ -407,11 +429,17 @@ public:
 
     MessagePtr getMessage(const Packet&, bool&);
 
+    // fragmented messages being collected or kept for resend
+    size_t size() {
+        cs::Lock lock(mLock_);
+        return map_.size();
+    }
+
 private:
     TypedAllocator<Message> msgAllocator_;
 
     cs::SpinLock mLock_{ATOMIC_FLAG_INIT};
-    FixedHashMap<cs::Hash, MessagePtr, uint16_t, MaxParallelCollections> map_;
+    OpenHashMap<cs::Hash, MessagePtr> map_{MaxParallelCollections};
 
     Message lastMessage_;
     friend class Network;
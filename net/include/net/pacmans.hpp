@@ -2,11 +2,18 @@
 #ifndef PACMANS_HPP
 #define PACMANS_HPP
 
+#include <array>
 #include <atomic>
 #include <boost/asio.hpp>
 #include <chrono>
+#include <deque>
 #include <list>
+#include <map>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "packet.hpp"
 
@@ -68,6 +75,47 @@ struct TaskBody {
 };
 */
 
+// Weighted round robin over packet priorities: while packets of several priorities are queued,
+// every priority takes its weight of turns in a cycle, so bulk traffic is delayed but never starved.
+class PriorityScheduler {
+public:
+    constexpr static std::array<size_t, kPacketPrioritiesCount> Weights = {8, 4, 1};
+
+    // index of the queue to take the next packet from, isEmpty(index) tells whether the queue is empty
+    template <typename IsEmpty>
+    std::optional<size_t> peek(const IsEmpty& isEmpty) const {
+        size_t current = current_;
+        size_t credit = credit_;
+
+        for (size_t i = 0; i <= kPacketPrioritiesCount; ++i) {
+            if (credit > 0 && !isEmpty(current)) {
+                return current;
+            }
+
+            current = (current + 1) % kPacketPrioritiesCount;
+            credit = Weights[current];
+        }
+
+        return std::nullopt;
+    }
+
+    // takes a turn of the queue returned by peek
+    void take(size_t index) {
+        if (index != current_ || credit_ == 0) {
+            current_ = index;
+            credit_ = Weights[index];
+        }
+
+        --credit_;
+    }
+
+private:
+    size_t current_ = 0;
+    size_t credit_ = Weights[0];
+};
+
+// Incoming packets are classified by priority when received and processed by PriorityScheduler,
+// the order of packets of the same priority is kept.
 class IPacMan {
 public:
     IPacMan() {
@@ -78,45 +126,143 @@ public:
         size_t size;
         Packet pack;
         std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
+        PacketPriority priority = PacketPriority::Regular;
     };
 
-    Task& allocNext();
-    void enQueueLast();
+    // every socket reader fills its own last task, so readers do not wait for each other
+    constexpr static size_t MaxReaders = 64;
+
+    Task& allocNext(size_t reader = 0);
+    void enQueueLast(size_t reader = 0);
 
     TaskPtr<IPacMan> getNextTask(bool& is_empty);
 
     using TaskIterator = std::list<Task>::iterator;
     void releaseTask(TaskIterator&);
-    void rejectLast();
+    void rejectLast(size_t reader = 0);
     size_t getSize() {
         return size_.load(std::memory_order_relaxed);
     }
 
+    size_t getSize(PacketPriority priority) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queues_[static_cast<size_t>(priority)].size();
+    }
+
 private:
-    std::list<Task> queue_;
+    // the last allocated task is filled by reader out of lock
+    std::array<std::list<Task>, MaxReaders> pending_;
+
+    std::array<std::list<Task>, kPacketPrioritiesCount> queues_;
+    PriorityScheduler scheduler_;
+
     std::mutex mutex_;
     std::atomic<size_t> size_ = {0};
     RegionAllocator allocator_;
 };
 
+// Outgoing packets are queued per peer. Every peer is paced by a token bucket, the rate of which follows AIMD:
+// it grows while the peer informs about received packets and halves when the peer asks for packets again
+// or the same packet is sent to it once more. Peers with available tokens are served by deficit round robin,
+// so a large broadcast to one peer does not delay others. Packets of one peer are taken by PriorityScheduler,
+// consensus ones are not paced.
 class OPacMan {
 public:
+    using Clock = std::chrono::steady_clock;
+
     struct Task {
         ip::udp::endpoint endpoint;
         Packet pack;
     };
 
-    Task* allocNext();
-    void enQueueLast();
+    struct PeerStats {
+        ip::udp::endpoint endpoint;
+        double rate = 0;  // bytes per second
+        size_t queueDepth = 0;
+        uint64_t sent = 0;
+        uint64_t dropped = 0;
+        uint64_t losses = 0;
+    };
+
+    // rates are in bytes per second
+    constexpr static double InitialRate = 4 << 20;
+    constexpr static double MinRate = 64 << 10;
+    constexpr static double MaxRate = 128 << 20;
+    constexpr static double AdditiveIncrease = 256 << 10;
+    constexpr static double DecreaseFactor = 0.5;
 
-    TaskPtr<OPacMan> getNextTask(bool& is_empty);
+    constexpr static std::chrono::milliseconds IncreaseInterval{100};
+    constexpr static std::chrono::milliseconds DecreaseInterval{200};
 
-    using TaskIterator = std::list<Task>::iterator;
-    void releaseTask(TaskIterator&);
+    // bucket keeps tokens for this time of current rate, but not less than MinBurst bytes
+    constexpr static std::chrono::milliseconds BurstTime{10};
+    constexpr static double MinBurst = 8 * Packet::MaxSize;
+
+    // consensus packets are not limited
+    constexpr static size_t MaxQueueDepth = 8192;
+    constexpr static size_t SentHistory = 4096;
+    constexpr static std::chrono::seconds IdleTimeout{60};
+
+    // returns false if the packet is dropped because of the full peer queue
+    bool enqueue(const ip::udp::endpoint& endpoint, const Packet& pack, Clock::time_point now = Clock::now());
+
+    // takes the next packet allowed to be sent now
+    bool pop(Task& task, Clock::time_point now = Clock::now());
+
+    // time until the next packet may be sent, nullopt if there is nothing to send
+    std::optional<Clock::duration> nextDelay(Clock::time_point now = Clock::now()) const;
+
+    void onDelivered(const ip::udp::endpoint& endpoint, Clock::time_point now = Clock::now());
+    void onLoss(const ip::udp::endpoint& endpoint, Clock::time_point now = Clock::now());
+
+    std::vector<PeerStats> stats() const;
+
+    size_t getSize() const {
+        return size_.load(std::memory_order_relaxed);
+    }
 
 private:
-    std::list<Task> queue_;
-    std::mutex mutex_;
+    struct Peer {
+        std::array<std::deque<Task>, kPacketPrioritiesCount> queues;
+        PriorityScheduler scheduler;
+        size_t size = 0;
+        std::unordered_set<const Region*> queued;
+
+        // region may be freed and its address reused by a new packet, so sent regions are checked to be alive
+        std::deque<const Region*> sentOrder;
+        std::unordered_map<const Region*, std::weak_ptr<Region>> sent;
+
+        double rate = InitialRate;
+        double tokens = MinBurst;
+        int64_t deficit = 0;
+        bool hasTurn = false;
+
+        Clock::time_point updated;
+        Clock::time_point lastIncrease;
+        Clock::time_point lastDecrease;
+        Clock::time_point lastActivity;
+
+        uint64_t sentCount = 0;
+        uint64_t dropped = 0;
+        uint64_t losses = 0;
+    };
+
+    using Peers = std::map<ip::udp::endpoint, Peer>;
+
+    Peer& peer(const ip::udp::endpoint& endpoint, Clock::time_point now);
+
+    static const Task* head(const Peer& peer, std::optional<size_t>& index);
+    static bool isUrgent(size_t index);
+    static void refill(Peer& peer, Clock::time_point now);
+    static void decrease(Peer& peer, Clock::time_point now);
+    static double burst(const Peer& peer);
+    static void rememberSent(Peer& peer, const Packet& pack);
+    static bool wasSent(const Peer& peer, const Packet& pack);
+
+    Peers peers_;
+    Peers::iterator cursor_ = peers_.end();
+
+    mutable std::mutex mutex_;
     std::atomic<size_t> size_ = {0};
 };
 
@@ -67,7 +67,7 @@ enum class SSBootstrapStatus : uint8_t {
 };
 
 template <>
-uint16_t getHashIndex(const ip::udp::endpoint&);
+uint64_t getHashValue(const ip::udp::endpoint&);
 
 class Transport {
 public:
@@ -164,6 +164,9 @@ public:
     bool isPingDone();
     void resetNeighbours();
 
+    std::vector<OPacMan::PeerStats> getPacingStats() const;
+    std::vector<Network::ReaderStats> getReaderStats() const;
+
 public signals:
     PingSignal pingReceived;
 
@@ -176,6 +179,16 @@ private:
 
     void dispatchNodeMessage(const MsgTypes, const cs::RoundNumber, const Packet&, const uint8_t* data, size_t);
 
+    static bool isOutdated(const MsgTypes, const cs::RoundNumber);
+
+    // copies message to the worker lane of its class, handlers pass results back to node thread
+    void postToLane(const MsgTypes, const cs::RoundNumber, const Packet&, const uint8_t* data, size_t);
+
+    // fragmented message is not copied, lane keeps its fragments
+    void postToLane(const MsgTypes, const cs::RoundNumber, const Message&);
+
+    void dispatchLaneMessage(const MsgTypes, const cs::RoundNumber, const cs::PublicKey& sender, cs::IPackStream&);
+
     /* Network packages processing */
     bool gotRegistrationRequest(const TaskPtr<IPacMan>&, RemoteNodePtr&);
 
@@ -194,6 +207,8 @@ private:
     bool gotPackRenounce(const TaskPtr<IPacMan>&, RemoteNodePtr&);
     bool gotPackRequest(const TaskPtr<IPacMan>&, RemoteNodePtr&);
 
+    void reportPacing() const;
+
     bool gotPing(const TaskPtr<IPacMan>&, RemoteNodePtr&);
 
     void askForMissingPackages();
@@ -218,7 +233,7 @@ private:
 
     TypedAllocator<RemoteNode> remoteNodes_;
 
-    FixedHashMap<ip::udp::endpoint, RemoteNodePtr, uint16_t, maxRemoteNodes_> remoteNodesMap_;
+    OpenHashMap<ip::udp::endpoint, RemoteNodePtr> remoteNodesMap_{maxRemoteNodes_};
 
     RegionAllocator netPacksAllocator_;
     cs::PublicKey myPublicKey_;
@@ -270,7 +285,7 @@ private:
     Neighbourhood nh_;
 
     static constexpr uint32_t fragmentsFixedMapSize_ = 10000;
-    FixedHashMap<cs::Hash, cs::RoundNumber, uint16_t, fragmentsFixedMapSize_> fragOnRound_;
+    OpenHashMap<cs::Hash, cs::RoundNumber> fragOnRound_{fragmentsFixedMapSize_};
 
 public:
     inline static size_t cntDirtyAllocs = 0;
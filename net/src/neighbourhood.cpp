@@ -9,6 +9,7 @@
 
 #include <cscrypto/cscrypto.hpp>
 #include <csnode/blockchain.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/random.hpp>
 
 namespace {
@@ -713,11 +714,17 @@ void Neighbourhood::resendPackets() {
     uint32_t cnt1 = 0;
     uint32_t cnt2 = 0;
 
+    // attempts grow only when the packet is sent again
+    uint64_t resentBroadcasts = 0;
+    uint64_t resentDirects = 0;
+
     for (auto& bp : msgBroads_) {
         if (!bp.data.pack) {
             continue;
         }
 
+        const auto attempts = bp.data.attempts;
+
         if (!dispatch(bp.data)) {
             bp.data.pack = Packet();
         }
@@ -725,6 +732,7 @@ void Neighbourhood::resendPackets() {
             ++cnt1;
         }
 
+        resentBroadcasts += bp.data.attempts - attempts;
         bp.data.sentLastTime = false;
     }
 
@@ -733,13 +741,24 @@ void Neighbourhood::resendPackets() {
             continue;
         }
 
+        const auto attempts = dp.data.attempts;
+
         if (!dispatch(dp.data)) {
             dp.data.pack = Packet();
         }
         else {
             ++cnt2;
         }
+
+        resentDirects += dp.data.attempts - attempts;
     }
+
+    static auto& broadcasts = cs::metrics::Registry::instance().counter("cs_neighbourhood_resends_total", "Packets sent to neighbours again",
+                                                                        {{"kind", "broadcast"}});
+    static auto& directs = cs::metrics::Registry::instance().counter("cs_neighbourhood_resends_total", "Packets sent to neighbours again",
+                                                                     {{"kind", "direct"}});
+    broadcasts.add(resentBroadcasts);
+    directs.add(resentDirects);
 }
 
 ConnectionPtr Neighbourhood::getConnection(const RemoteNodePtr node) {
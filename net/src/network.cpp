@@ -5,6 +5,8 @@
 #include <thread>
 
 #ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
 #include <sys/eventfd.h>
 #include <sys/poll.h>
 #include <sys/socket.h>
@@ -32,11 +34,19 @@ using boost::asio::buffer;
 
 const ip::udp::socket::message_flags NO_FLAGS = 0;
 
-static std::atomic<std::chrono::time_point<std::chrono::high_resolution_clock>>
-    last_processed_time{std::chrono::high_resolution_clock::now()};
 const double lag_limit = 1000.;
 
-static ip::udp::socket bindSocket(io_context& context, Network* net, const EndpointData& data, bool ipv6 = true) {
+// writer wakes up to check stop flag when nothing is queued, msec
+constexpr int64_t kWriterIdleTimeout = 50;
+constexpr size_t kWriterBatchSize = 1024;
+
+#ifdef __linux__
+// kernel spreads datagrams over sockets bound to the same port by hash of the sender address,
+// so all packets of one peer are read by the same reader
+using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+static ip::udp::socket bindSocket(io_context& context, Network* net, const EndpointData& data, bool ipv6 = true, bool reusePort = false) {
     try {
         ip::udp::socket sock(context, ipv6 ? ip::udp::v6() : ip::udp::v4());
 
@@ -45,6 +55,13 @@ static ip::udp::socket bindSocket(io_context& context, Network* net, const Endpo
         }
 
         sock.set_option(ip::udp::socket::reuse_address(true));
+#ifdef __linux__
+        if (reusePort) {
+            sock.set_option(reuse_port(true));
+        }
+#else
+        csunused(reusePort);
+#endif
 #ifndef __APPLE__
         sock.set_option(ip::udp::socket::send_buffer_size(1 << 23));
         sock.set_option(ip::udp::socket::receive_buffer_size(1 << 23));
@@ -77,11 +94,41 @@ ip::udp::endpoint Network::resolve(const EndpointData& data) {
     return ip::udp::endpoint(data.ip, data.port);
 }
 
-ip::udp::socket* Network::getSocketInThread(const bool openOwn, const EndpointData& epd, std::atomic<Network::ThreadStatus>& status, const bool ipv6) {
+static size_t getReadersCount(const Config& config) {
+#ifdef __linux__
+    return config.getReadersCount();
+#else
+    if (config.getReadersCount() > 1) {
+        cswarning() << "Several readers of input port are supported on Linux only, the single one is used";
+    }
+
+    return 1;
+#endif
+}
+
+#ifdef __linux__
+static void pinToCore(std::thread& thread, size_t index) {
+    const unsigned cores = std::thread::hardware_concurrency();
+
+    if (cores == 0) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cores, &set);
+
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0) {
+        cswarning() << "Cannot pin reader " << index << " to core " << index % cores;
+    }
+}
+#endif
+
+ip::udp::socket* Network::getSocketInThread(const bool openOwn, const EndpointData& epd, std::atomic<Network::ThreadStatus>& status, const bool ipv6, const bool reusePort) {
     ip::udp::socket* result = nullptr;
 
     if (openOwn) {
-        result = new ip::udp::socket(bindSocket(context_, this, epd, ipv6));
+        result = new ip::udp::socket(bindSocket(context_, this, epd, ipv6, reusePort));
 
         if (!result->is_open()) {
             result = nullptr;
@@ -98,25 +145,66 @@ ip::udp::socket* Network::getSocketInThread(const bool openOwn, const EndpointDa
     return result;
 }  // resolve
 
-void Network::readerRoutine(const Config& config) {
-    ip::udp::socket* sock = getSocketInThread(config.hasTwoSockets(), config.getInputEndpoint(), readerStatus_, config.useIPv6());
+void Network::readerRoutine(const Config& config, size_t index) {
+    const bool reusePort = readers_.size() > 1;
+    std::unique_ptr<ip::udp::socket> ownSocket;
+    ip::udp::socket* sock = nullptr;
+
+    if (index == 0) {
+        sock = getSocketInThread(config.hasTwoSockets(), config.getInputEndpoint(), readerStatus_, config.useIPv6(), reusePort);
+    }
+    else {
+        ownSocket = std::make_unique<ip::udp::socket>(bindSocket(context_, this, config.getInputEndpoint(), config.useIPv6(), reusePort));
+
+        if (ownSocket->is_open()) {
+            sock = ownSocket.get();
+        }
+        else {
+            cswarning() << "Cannot open socket of reader " << index << ", input port is read by other readers";
+        }
+    }
 
     if (!sock) {
         return;
     }
 
+    Reader& reader = *readers_[index];
+
     while (!initFlag_.load()) {
         using namespace std::chrono_literals;
         std::this_thread::sleep_for(1s);
     }
 
+    readPackets(*sock, iPacMan_, index, reader, stopReaderRoutine, lastProcessedTime_, [this] {
+#ifdef __linux__
+        static uint64_t one = 1;
+        [[maybe_unused]] auto res = write(readerEventfd_, &one, sizeof(uint64_t));
+#endif
+#if defined(WIN32) || defined(__APPLE__)
+        while (readerLock.test_and_set(std::memory_order_acquire))  // acquire lock
+            ;                                                       // spin
+        readerTaskCount_.fetch_add(1, std::memory_order_relaxed);
+#ifdef WIN32
+        SetEvent(readerEvent_);
+#else
+        kevent(readerKq_, &readerEvent_, 1, NULL, 0, NULL);
+#endif
+        readerLock.clear(std::memory_order_release);  // release lock
+#endif
+    });
+
+    cswarning() << "readerRoutine STOPPED!!!\n";
+}
+
+void Network::readPackets(ip::udp::socket& sock, IPacMan& pacman, size_t index, ReaderCounters& reader, const std::atomic<bool>& stop,
+                          const std::atomic<TimePoint>& lastProcessed, const std::function<void()>& notify) {
     boost::system::error_code lastError;
     size_t packetSize = 0;
 
-    while (stopReaderRoutine == false) {  // changed from true
-        auto& task = iPacMan_.allocNext();
+    while (stop == false) {  // changed from true
+        auto& task = pacman.allocNext(index);
 
-        if (stopReaderRoutine) {
+        if (stop) {
             return;
         }
 
@@ -129,25 +217,25 @@ void Network::readerRoutine(const Config& config) {
 
         double currentLag = std::chrono::duration<double, std::milli>(
             std::chrono::high_resolution_clock::now() -
-                last_processed_time.load(std::memory_order_relaxed)).count();
+                lastProcessed.load(std::memory_order_relaxed)).count();
 
-        if (currentLag > lag_limit && iPacMan_.getSize() > 2) {
-            while (currentLag > lag_limit && iPacMan_.getSize() > 2) {
+        if (currentLag > lag_limit && pacman.getSize() > 2) {
+            while (currentLag > lag_limit && pacman.getSize() > 2) {
                 std::this_thread::yield();
-                packetSize = sock->receive_from(buffer(task.pack.data(), Packet::MaxSize),
+                packetSize = sock.receive_from(buffer(task.pack.data(), Packet::MaxSize),
                     task.sender, NO_FLAGS, lastError);
                 currentLag = std::chrono::duration<double, std::milli>(
                     std::chrono::high_resolution_clock::now() -
-                        last_processed_time.load(std::memory_order_relaxed)).count();
-                if (currentLag < lag_limit || iPacMan_.getSize() < 2) {
+                        lastProcessed.load(std::memory_order_relaxed)).count();
+                if (currentLag < lag_limit || pacman.getSize() < 2) {
                     task.timestamp = std::chrono::high_resolution_clock::now();
                     break;
                 }
                 csdetails() << "Current lag = " << currentLag << "ms queue size = " <<
-                    iPacMan_.getSize() << " - spin";
+                    pacman.getSize() << " - spin";
             }
         } else {
-            packetSize = sock->receive_from(buffer(task.pack.data(), Packet::MaxSize),
+            packetSize = sock.receive_from(buffer(task.pack.data(), Packet::MaxSize),
                 task.sender, NO_FLAGS, lastError);
             task.timestamp = std::chrono::high_resolution_clock::now();
         }
@@ -180,41 +268,30 @@ void Network::readerRoutine(const Config& config) {
             }
 
             if (reject) {
-                iPacMan_.rejectLast();
+                pacman.rejectLast(index);
+                reader.rejected.fetch_add(1, std::memory_order_relaxed);
             }
             else {
-                iPacMan_.enQueueLast();
+                pacman.enQueueLast(index);
+                reader.packets.fetch_add(1, std::memory_order_relaxed);
+                reader.bytes.fetch_add(packetSize, std::memory_order_relaxed);
 #ifdef LOG_NET
                 csdebug(logger::Net) << "<-- " << packetSize << " bytes from " << task.sender << " " << task.pack;
 #endif
             }
-#ifdef __linux__
-            static uint64_t one = 1;
-            [[maybe_unused]] auto res = write(readerEventfd_, &one, sizeof(uint64_t));
-#endif
-#if defined(WIN32) || defined(__APPLE__)
-            while (readerLock.test_and_set(std::memory_order_acquire))  // acquire lock
-                ;                                                       // spin
-            readerTaskCount_.fetch_add(1, std::memory_order_relaxed);
-#ifdef WIN32
-            SetEvent(readerEvent_);
-#else
-            kevent(readerKq_, &readerEvent_, 1, NULL, 0, NULL);
-#endif
-            readerLock.clear(std::memory_order_release);  // release lock
-#endif
+
+            notify();
         }
         else {
             cserror() << "Cannot receive packet. Error " << lastError;
-            iPacMan_.rejectLast();
+            pacman.rejectLast(index);
+            reader.errors.fetch_add(1, std::memory_order_relaxed);
         }
     }
-
-    cswarning() << "readerRoutine STOPPED!!!\n";
 }
 
 [[maybe_unused]]
-static inline void sendPack(ip::udp::socket& sock, TaskPtr<OPacMan>& task, const ip::udp::endpoint& ep) {
+static inline void sendPack(ip::udp::socket& sock, OPacMan::Task& task, const ip::udp::endpoint& ep) {
     boost::system::error_code lastError;
     size_t size = 0;
     size_t encodedSize = 0;
@@ -224,7 +301,7 @@ static inline void sendPack(ip::udp::socket& sock, TaskPtr<OPacMan>& task, const
     // net code was built on this constant (Packet::MaxSize)
     // and is used it implicitly in a lot of places(
     char packetBuffer[Packet::MaxSize];
-    boost::asio::mutable_buffer encodedPacket = task->pack.encode(buffer(packetBuffer, sizeof(packetBuffer)));
+    boost::asio::mutable_buffer encodedPacket = task.pack.encode(buffer(packetBuffer, sizeof(packetBuffer)));
     encodedSize = encodedPacket.size();
 
     do {
@@ -241,7 +318,7 @@ static inline void sendPack(ip::udp::socket& sock, TaskPtr<OPacMan>& task, const
     }
 #ifdef LOG_NET
     else {
-        csdebug(logger::Net) << "--> " << size << " bytes to " << ep << " " << task->pack;
+        csdebug(logger::Net) << "--> " << size << " bytes to " << ep << " " << task.pack;
     }
 #endif
 }
@@ -258,61 +335,67 @@ void Network::writerRoutine(const Config& config) {
     std::vector<std::array<char, Packet::MaxSize>> packets_buffer;
     std::vector<boost::asio::mutable_buffer> encoded_packets;
     std::vector<ip::udp::endpoint> endpoints;
+
+    msg.resize(kWriterBatchSize);
+    iovecs.resize(kWriterBatchSize);
+    packets_buffer.resize(kWriterBatchSize);
+    endpoints.resize(kWriterBatchSize);
 #endif
+    OPacMan::Task task;
+
     while (stopWriterRoutine == false) {  // changed from true
+        // packets are paced, so wait for a new one or for the time the next queued one is allowed to be sent
+        const auto delay = oPacMan_.nextDelay();
+        const auto timeout = delay.has_value() ? std::chrono::ceil<std::chrono::milliseconds>(delay.value()).count() : kWriterIdleTimeout;
 #ifdef __linux__
-        uint64_t tasks;
-        int s = read(writerEventfd_, &tasks, sizeof(uint64_t));
-        if (s != sizeof(uint64_t)) {
-            continue;
+        struct pollfd pfd {};
+        pfd.fd = writerEventfd_;
+        pfd.events = POLLIN;
+
+        if (poll(&pfd, 1, static_cast<int>(timeout)) > 0) {
+            uint64_t signals;
+            [[maybe_unused]] auto res = read(writerEventfd_, &signals, sizeof(uint64_t));
         }
 
-        if (tasks > 600) {
-            csdetails() << "(informational) current task quantity more then normal: " << tasks;
+        if (oPacMan_.getSize() > 600) {
+            csdetails() << "(informational) current task quantity more then normal: " << oPacMan_.getSize();
         }
 
-        msg.resize(tasks);
-        std::fill(msg.begin(), msg.end(), mmsghdr{});
-        iovecs.resize(tasks);
-        std::fill(iovecs.begin(), iovecs.end(), iovec{});
-        packets_buffer.resize(tasks);
-        endpoints.resize(tasks);
         encoded_packets.clear();
 
         int j = 0;
-        for (uint64_t i = 0; i < tasks; i++) {
-            bool is_empty = false;
-            auto task = oPacMan_.getNextTask(is_empty);
-            if (is_empty) break;
+        while (j < static_cast<int>(kWriterBatchSize) && oPacMan_.pop(task)) {
             std::atomic_thread_fence(std::memory_order_acquire);
-            if (!task->pack.region_.get()) {
-                cswarning() << "net: invalid packet for send!!!!!!!!! " << task->pack.region_.get();
+            if (!task.pack.region_.get()) {
+                cswarning() << "net: invalid packet for send!!!!!!!!! " << task.pack.region_.get();
                 continue;
             }
 
-            if (!(task->pack.isHeaderValid())) {
+            if (!(task.pack.isHeaderValid())) {
                 static constexpr size_t limit = 100;
-                auto size = (task->pack.size() <= limit) ? task->pack.size() : limit;
-                cswarning() << "socket Header is not valid: " << cs::Utils::byteStreamToHex(static_cast<const char*>(task->pack.data()), size);
+                auto size = (task.pack.size() <= limit) ? task.pack.size() : limit;
+                cswarning() << "socket Header is not valid: " << cs::Utils::byteStreamToHex(static_cast<const char*>(task.pack.data()), size);
                 continue;
             }
 
-            encoded_packets.emplace_back(task->pack.encode(buffer(packets_buffer[j].data(), Packet::MaxSize)));
-            endpoints[j] = task->endpoint;
+            encoded_packets.emplace_back(task.pack.encode(buffer(packets_buffer[j].data(), Packet::MaxSize)));
+            endpoints[j] = task.endpoint;
+            msg[j] = mmsghdr{};
+            iovecs[j] = iovec{};
             iovecs[j].iov_base = encoded_packets[j].data();
             iovecs[j].iov_len = encoded_packets[j].size();
             msg[j].msg_hdr.msg_iov = &iovecs[j];
             msg[j].msg_hdr.msg_iovlen = 1;
             msg[j].msg_hdr.msg_name = endpoints[j].data();
             msg[j].msg_hdr.msg_namelen = endpoints[j].size();
-            task.release();
+            task.pack = Packet();
             ++j;
         }
         if (j == 0) {
             continue;
         }
 
-        tasks = j;
+        unsigned int tasks = static_cast<unsigned int>(j);
 
         int sended = 0;
         struct mmsghdr* messages = msg.data();
@@ -322,33 +405,33 @@ void Network::writerRoutine(const Config& config) {
                 cswarning() << "sendmmsg errno = " << errno;
                 if (errno != EAGAIN)
                     break;
+                continue;
             }
             messages += sended;
-            tasks -= sended;
+            tasks -= static_cast<unsigned int>(sended);
         } while (tasks);
 #endif
 #if defined(WIN32) || defined(__APPLE__)
 #ifdef WIN32
-        WaitForSingleObject(writerEvent_, INFINITE);
+        WaitForSingleObject(writerEvent_, static_cast<DWORD>(timeout));
 #else
+        struct timespec waitTime {
+            static_cast<time_t>(timeout / 1000), static_cast<long>((timeout % 1000) * 1000000)
+        };
         struct kevent event;
-        kevent(writerKq_, NULL, 0, &event, 1, NULL);
+        kevent(writerKq_, NULL, 0, &event, 1, &waitTime);
 #endif
         while (writerLock.test_and_set(std::memory_order_acquire))  // acquire lock
             ;                                                       // spin
-        int tasks = writerTaskCount_;
         writerTaskCount_ = 0;
         writerLock.clear(std::memory_order_release);  // release lock
-        for (int i = 0; i < tasks; i++) {
-            bool is_empty = false;
-            auto task = oPacMan_.getNextTask(is_empty);
-            if (is_empty) break;
-            if (!task->pack.region_.get()) {
+        while (oPacMan_.pop(task)) {
+            if (!task.pack.region_.get()) {
                 cswarning() << "net: invalid packet!!!!!!!!!";
                 continue;
             }
-            sendPack(*sock, task, task->endpoint);
-            task.release();
+            sendPack(*sock, task, task.endpoint);
+            task.pack = Packet();
         }
 #endif
     }
@@ -395,7 +478,7 @@ void Network::processorRoutine() {
                 continue;
             }
             processTask(task);
-            last_processed_time.store(task->timestamp, std::memory_order_relaxed);
+            lastProcessedTime_.store(task->timestamp, std::memory_order_relaxed);
             task.release();
         }
 #endif
@@ -430,7 +513,7 @@ void Network::processorRoutine() {
             auto task = iPacMan_.getNextTask(is_empty);
             if (is_empty) break;
             processTask(task);
-            last_processed_time.store(task->timestamp, std::memory_order_relaxed);
+            lastProcessedTime_.store(task->timestamp, std::memory_order_relaxed);
             task.release();
         }
 #endif
@@ -465,7 +548,7 @@ inline void Network::processTask(TaskPtr<IPacMan>& task) {
     }
 
     // Non-network data
-    uint32_t& recCounter = packetMap_.tryStore(task->pack.getHash());
+    uint32_t& recCounter = packetMap_.tryStore(task->pack.getDedupKey());
     if (!recCounter && task->pack.addressedToMe(transport_->getMyPublicKey())) {
         if (task->pack.isFragmented() || task->pack.isCompressed()) {
             bool newFragmentedMsg = false;
@@ -494,8 +577,6 @@ inline void Network::processTask(TaskPtr<IPacMan>& task) {
 }
 
 void Network::sendDirect(const Packet& p, const ip::udp::endpoint& ep) {
-    auto qePtr = oPacMan_.allocNext();
-
     if (ep.size() > 16) {
         cswarning() << "endpoint address too big " << ep.size();
         const uint8_t* ptr = reinterpret_cast<const uint8_t*>(ep.data());
@@ -506,10 +587,12 @@ void Network::sendDirect(const Packet& p, const ip::udp::endpoint& ep) {
     while (!p.region_.get()) {
         cswarning() << "net: invalid packet for sendDirect!!!!!!!!! ";
     }
-    qePtr->endpoint = ep;
-    qePtr->pack = p;
 
-    oPacMan_.enQueueLast();
+    if (!oPacMan_.enqueue(ep, p)) {
+        csdetails() << "net: send queue of " << ep << " is full, packet dropped";
+        return;
+    }
+
 #ifdef __linux__
     static uint64_t one = 1;
     [[maybe_unused]] auto res = write(writerEventfd_, &one, sizeof(uint64_t));
@@ -597,8 +680,17 @@ Network::Network(const Config& config, Transport* transport)
 
     EV_SET(&writerEvent_, 0, EVFILT_USER, EV_DISPATCH | EV_ENABLE, NOTE_FFCOPY | NOTE_TRIGGER, 0, NULL);
 #endif
+    const size_t readersCount = getReadersCount(config);
+
+    for (size_t i = 0; i < readersCount; ++i) {
+        readers_.push_back(std::make_unique<Reader>());
+    }
+
+    // readers are not added after, so probes read them without lock
+    registerMetrics();
+
     if (!config.hasTwoSockets()) {
-        auto sockPtr = new ip::udp::socket(bindSocket(context_, this, config.getInputEndpoint(), config.useIPv6()));
+        auto sockPtr = new ip::udp::socket(bindSocket(context_, this, config.getInputEndpoint(), config.useIPv6(), readersCount > 1));
 
         if (!sockPtr->is_open()) {
             good_ = false;
@@ -609,7 +701,18 @@ Network::Network(const Config& config, Transport* transport)
         singleSockOpened_.store(true);
     }
 
-    readerThread_ = std::thread(&Network::readerRoutine, this, config);
+    for (size_t i = 0; i < readersCount; ++i) {
+        readers_[i]->thread = std::thread(&Network::readerRoutine, this, config, i);
+#ifdef __linux__
+        if (config.pinReaders()) {
+            pinToCore(readers_[i]->thread, i);
+        }
+#endif
+    }
+
+    if (readersCount > 1) {
+        csinfo() << "Input port is read by " << readersCount << " sockets";
+    }
     writerThread_ = std::thread(&Network::writerRoutine, this, config);
     processorThread_ = std::thread(&Network::processorRoutine, this);
 
@@ -629,7 +732,11 @@ bool Network::resendFragment(const cs::Hash& hash, const uint16_t id, const ip::
     MessagePtr msg;
     {
         cs::Lock lock(collector_.mLock_);
-        msg = collector_.map_.tryStore(hash);
+        auto found = collector_.map_.tryGet(hash);
+
+        if (found) {
+            msg = *found;
+        }
     }
 
     if (!msg) {
@@ -640,6 +747,9 @@ bool Network::resendFragment(const cs::Hash& hash, const uint16_t id, const ip::
         cs::Lock l(msg->pLock_);
         if (id < msg->packetsTotal_ && msg->packets_[id]) {
             sendDirect(msg->packets_[id], ep);
+
+            static auto& resent = cs::metrics::Registry::instance().counter("cs_net_fragments_resent_total", "Fragments sent again by request of peers");
+            resent.add();
             return true;
         }
     }
@@ -647,6 +757,37 @@ bool Network::resendFragment(const cs::Hash& hash, const uint16_t id, const ip::
     return false;
 }
 
+void Network::onDelivered(const ip::udp::endpoint& ep) {
+    oPacMan_.onDelivered(ep);
+}
+
+void Network::onLoss(const ip::udp::endpoint& ep) {
+    oPacMan_.onLoss(ep);
+}
+
+std::vector<OPacMan::PeerStats> Network::getPacingStats() const {
+    return oPacMan_.stats();
+}
+
+std::vector<Network::ReaderStats> Network::getReaderStats() const {
+    std::vector<ReaderStats> result;
+    result.reserve(readers_.size());
+
+    for (size_t i = 0; i < readers_.size(); ++i) {
+        const Reader& reader = *readers_[i];
+
+        ReaderStats stats;
+        stats.index = i;
+        stats.packets = reader.packets.load(std::memory_order_relaxed);
+        stats.bytes = reader.bytes.load(std::memory_order_relaxed);
+        stats.rejected = reader.rejected.load(std::memory_order_relaxed);
+        stats.errors = reader.errors.load(std::memory_order_relaxed);
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
 void Network::sendInit() {
     initFlag_.store(true);
 }
@@ -682,11 +823,47 @@ void Network::registerMessage(Packet* pack, const uint32_t size) {
     }
 }
 
+void Network::registerMetrics() {
+    auto& registry = cs::metrics::Registry::instance();
+
+    const std::array<const char*, kPacketPrioritiesCount> priorities = {"consensus", "regular", "bulk"};
+
+    for (size_t i = 0; i < kPacketPrioritiesCount; ++i) {
+        probes_.push_back(registry.probe("cs_net_input_queue_depth", "Received packets waiting for processing", cs::metrics::Type::Gauge,
+                                         [this, i] { return static_cast<double>(iPacMan_.getSize(static_cast<PacketPriority>(i))); },
+                                         {{"priority", priorities[i]}}));
+    }
+
+    probes_.push_back(registry.probe("cs_net_output_queue_depth", "Packets waiting for sending to peers", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(oPacMan_.getSize()); }));
+    probes_.push_back(registry.probe("cs_net_collector_messages", "Fragmented messages kept by packet collector", cs::metrics::Type::Gauge,
+                                     [this] { return static_cast<double>(collector_.size()); }));
+
+    auto sum = [this](std::atomic<uint64_t> Reader::*field) {
+        return [this, field] {
+            uint64_t result = 0;
+
+            for (const auto& reader : readers_) {
+                result += ((*reader).*field).load(std::memory_order_relaxed);
+            }
+
+            return static_cast<double>(result);
+        };
+    };
+
+    probes_.push_back(registry.probe("cs_net_received_packets_total", "Packets read from input sockets", cs::metrics::Type::Counter, sum(&Reader::packets)));
+    probes_.push_back(registry.probe("cs_net_received_bytes_total", "Bytes read from input sockets", cs::metrics::Type::Counter, sum(&Reader::bytes)));
+    probes_.push_back(registry.probe("cs_net_rejected_packets_total", "Received packets rejected before processing", cs::metrics::Type::Counter,
+                                     sum(&Reader::rejected)));
+}
+
 Network::~Network() {
     stopReaderRoutine = true;
 
-    if (readerThread_.joinable()) {
-        readerThread_.join();
+    for (auto& reader : readers_) {
+        if (reader->thread.joinable()) {
+            reader->thread.join();
+        }
     }
 
     stopWriterRoutine = true;
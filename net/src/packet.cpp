@@ -121,6 +121,56 @@ bool Packet::isHeaderValid() const {
     return true;
 }
 
+PacketPriority Packet::getPriority() const {
+    if (size() <= getHeadersLength()) {
+        return PacketPriority::Regular;
+    }
+
+    if (isNetwork()) {
+        return static_cast<NetworkCommand>(getType()) == NetworkCommand::Ping ? PacketPriority::Bulk : PacketPriority::Regular;
+    }
+
+    if (isFragmented() && getFragmentId() != 0) {
+        return PacketPriority::Regular;
+    }
+
+    switch (getType()) {
+        case MsgTypes::RoundTableSS:
+        case MsgTypes::RoundTable:
+        case MsgTypes::RoundTableRequest:
+        case MsgTypes::RoundTableReply:
+        case MsgTypes::BlockHash:
+        case MsgTypes::HashReply:
+        case MsgTypes::FirstStage:
+        case MsgTypes::SecondStage:
+        case MsgTypes::ThirdStage:
+        case MsgTypes::FirstStageRequest:
+        case MsgTypes::SecondStageRequest:
+        case MsgTypes::ThirdStageRequest:
+        case MsgTypes::FirstSmartStage:
+        case MsgTypes::SecondSmartStage:
+        case MsgTypes::ThirdSmartStage:
+        case MsgTypes::SmartFirstStageRequest:
+        case MsgTypes::SmartSecondStageRequest:
+        case MsgTypes::SmartThirdStageRequest:
+        case MsgTypes::BigBang:
+        case MsgTypes::NodeStopRequest:
+            return PacketPriority::Consensus;
+
+        case MsgTypes::Transactions:
+        case MsgTypes::FirstTransaction:
+        case MsgTypes::TransactionPacket:
+        case MsgTypes::BlockRequest:
+        case MsgTypes::RequestedBlock:
+        case MsgTypes::StateRequest:
+        case MsgTypes::StateReply:
+            return PacketPriority::Bulk;
+
+        default:
+            return PacketPriority::Regular;
+    }
+}
+
 uint32_t Packet::getHeadersLength() const {
     if (!headersLength_) {
         headersLength_ = calculateHeadersLength();
@@ -233,6 +283,30 @@ void Message::composeFullData() const {
     }
 }
 
+std::vector<cs::BytesView> Message::dataSegments(const std::vector<Packet>& fragments) {
+    std::vector<cs::BytesView> segments;
+    segments.reserve(fragments.size());
+
+    const uint32_t headersLength = fragments.empty() ? 0 : fragments[0].getHeadersLength();
+
+    for (auto& pack : fragments) {
+        auto data = static_cast<const cs::Byte*>(pack.data());
+        segments.emplace_back(data + headersLength, pack.size() - headersLength);
+    }
+
+    return segments;
+}
+
+size_t Message::dataSize(const std::vector<Packet>& fragments) {
+    size_t size = 0;
+
+    for (auto& pack : fragments) {
+        size += pack.size() - fragments[0].getHeadersLength();
+    }
+
+    return size;
+}
+
 class PacketFlags {
 public:
     PacketFlags(const Packet& packet)
@@ -1,28 +1,37 @@
 /* Send blaming letters to @yrtimd */
 #include "pacmans.hpp"
 
-IPacMan::Task& IPacMan::allocNext() {
+#include <algorithm>
+
+IPacMan::Task& IPacMan::allocNext(size_t reader) {
+    auto& pending = pending_[reader];
+
     std::lock_guard<std::mutex> lock(mutex_);
-    queue_.emplace_back();
-    auto end = queue_.end();
-    Task& task = *(--end);
+    pending.emplace_back();
+    Task& task = pending.back();
     task.pack.region_ = allocator_.allocateNext(Packet::MaxSize);
     return task;
 }
 
-void IPacMan::enQueueLast() {
-    Task& task = queue_.back();
+void IPacMan::enQueueLast(size_t reader) {
+    auto& pending = pending_[reader];
+
+    Task& task = pending.back();
     task.pack.setSize(static_cast<uint32_t>(task.size));
+    task.priority = task.pack.getPriority();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& queue = queues_[static_cast<size_t>(task.priority)];
+        queue.splice(queue.end(), pending, std::prev(pending.end()));
+    }
 
     size_.fetch_add(1, std::memory_order_acq_rel);
-	//if (size_ > 500) {
-	//	csinfo() << __func__ << ": IPackMan queue size = " << queue_.size();
-	//}
 }
 
-void IPacMan::rejectLast() {
+void IPacMan::rejectLast(size_t reader) {
     std::lock_guard<std::mutex> lock(mutex_);
-    queue_.pop_back();
+    pending_[reader].pop_back();
 }
 
 TaskPtr<IPacMan> IPacMan::getNextTask(bool &is_empty) {
@@ -32,58 +41,263 @@ TaskPtr<IPacMan> IPacMan::getNextTask(bool &is_empty) {
         return result;
     }
     std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto index = scheduler_.peek([this](size_t i) { return queues_[i].empty(); });
+    if (!index.has_value()) {
+        is_empty = true;
+        return result;
+    }
+
+    scheduler_.take(index.value());
     result.owner_ = this;
-    result.it_ = queue_.begin();
-	//if (size_ > 500) {
-	//	csinfo() << __func__ << ": IPackMan queue size = " << queue_.size();
-	//}
+    result.it_ = queues_[index.value()].begin();
     return result;
 }
 
 void IPacMan::releaseTask(TaskIterator& it) {
     std::lock_guard<std::mutex> lock(mutex_);
-    queue_.erase(it);
+    queues_[static_cast<size_t>(it->priority)].erase(it);
     size_.fetch_sub(1, std::memory_order_acq_rel);
-	//if (size_ > 500) {
-	//	csinfo() << __func__ << ": IPackMan queue size = " << queue_.size();
-	//}
 }
 
-OPacMan::Task* OPacMan::allocNext() {
+bool OPacMan::enqueue(const ip::udp::endpoint& endpoint, const Packet& pack, Clock::time_point now) {
     std::lock_guard<std::mutex> lock(mutex_);
-    queue_.emplace_back();
-    auto end = queue_.end();
-    Task& task = *(--end);
-    return &task;
-}
+    Peer& receiver = peer(endpoint, now);
+    receiver.lastActivity = now;
+
+    // resent packet is still waiting for its turn
+    if (receiver.queued.count(pack.region_.get())) {
+        return true;
+    }
 
-void OPacMan::enQueueLast() {
+    // the same packet was sent before, the peer has not got it
+    if (wasSent(receiver, pack)) {
+        ++receiver.losses;
+        decrease(receiver, now);
+    }
+
+    const auto priority = pack.getPriority();
+
+    if (receiver.size >= MaxQueueDepth && priority != PacketPriority::Consensus) {
+        ++receiver.dropped;
+        return false;
+    }
+
+    receiver.queues[static_cast<size_t>(priority)].push_back(Task{endpoint, pack});
+    ++receiver.size;
+    receiver.queued.insert(pack.region_.get());
     size_.fetch_add(1, std::memory_order_acq_rel);
-	//if (size_ > 500) {
-	//	csinfo() << __func__ << ": OPackMan queue size = " << queue_.size();
-	//}
+
+    return true;
 }
 
-TaskPtr<OPacMan> OPacMan::getNextTask(bool &is_empty) {
-    TaskPtr<OPacMan> result;
+bool OPacMan::pop(Task& task, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     if (!size_.load(std::memory_order_acquire)) {
-        is_empty = true;
-        return result;
+        return false;
+    }
+
+    for (size_t visits = 0, count = peers_.size(); visits <= count; ++visits) {
+        if (cursor_ == peers_.end()) {
+            cursor_ = peers_.begin();
+        }
+
+        Peer& current = cursor_->second;
+
+        if (!current.size) {
+            current.hasTurn = false;
+            current.deficit = 0;
+
+            if (now - current.lastActivity > IdleTimeout) {
+                cursor_ = peers_.erase(cursor_);
+            }
+            else {
+                ++cursor_;
+            }
+
+            continue;
+        }
+
+        refill(current, now);
+
+        std::optional<size_t> index;
+        const auto size = static_cast<int64_t>(head(current, index)->pack.size());
+
+        // consensus packets are sent in debt of tokens, the following ones wait longer
+        if (isUrgent(index.value()) || current.tokens >= static_cast<double>(size)) {
+            if (!current.hasTurn) {
+                current.deficit += Packet::MaxSize;
+                current.hasTurn = true;
+            }
+
+            if (current.deficit >= size) {
+                auto& queue = current.queues[index.value()];
+                current.scheduler.take(index.value());
+
+                task = std::move(queue.front());
+                queue.pop_front();
+                --current.size;
+
+                current.queued.erase(task.pack.region_.get());
+                rememberSent(current, task.pack);
+
+                current.deficit -= size;
+                current.tokens -= static_cast<double>(size);
+                ++current.sentCount;
+
+                size_.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+
+        // turn is over
+        current.hasTurn = false;
+        ++cursor_;
     }
+
+    return false;
+}
+
+std::optional<OPacMan::Clock::duration> OPacMan::nextDelay(Clock::time_point now) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    result.owner_ = this;
-    result.it_ = queue_.begin();
-	//if (size_ > 500) {
-	//	csinfo() << __func__ << ": OPackMan queue size = " << queue_.size();
-	//}
+    std::optional<Clock::duration> result;
+
+    for (const auto& [endpoint, current] : peers_) {
+        if (!current.size) {
+            continue;
+        }
+
+        const double elapsed = std::chrono::duration<double>(now - current.updated).count();
+        const double tokens = std::min(burst(current), current.tokens + elapsed * current.rate);
+        std::optional<size_t> index;
+        const double lack = static_cast<double>(head(current, index)->pack.size()) - tokens;
+
+        Clock::duration delay = Clock::duration::zero();
+
+        if (lack > 0 && !isUrgent(index.value())) {
+            delay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(lack / current.rate));
+        }
+
+        if (!result.has_value() || delay < result.value()) {
+            result = delay;
+        }
+    }
+
     return result;
 }
 
-void OPacMan::releaseTask(TaskIterator& it) {
+void OPacMan::onDelivered(const ip::udp::endpoint& endpoint, Clock::time_point now) {
     std::lock_guard<std::mutex> lock(mutex_);
-    queue_.erase(it);
-    size_.fetch_sub(1, std::memory_order_acq_rel);
-	//if (size_ > 500) {
-	//	csinfo() << __func__ << ": OPackMan queue size = " << queue_.size();
-	//}
+    auto it = peers_.find(endpoint);
+
+    if (it == peers_.end()) {
+        return;
+    }
+
+    Peer& sender = it->second;
+
+    if (now - sender.lastIncrease >= IncreaseInterval) {
+        sender.rate = std::min(MaxRate, sender.rate + AdditiveIncrease);
+        sender.lastIncrease = now;
+    }
+}
+
+void OPacMan::onLoss(const ip::udp::endpoint& endpoint, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(endpoint);
+
+    if (it == peers_.end()) {
+        return;
+    }
+
+    ++it->second.losses;
+    decrease(it->second, now);
+}
+
+std::vector<OPacMan::PeerStats> OPacMan::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<PeerStats> result;
+    result.reserve(peers_.size());
+
+    for (const auto& [endpoint, current] : peers_) {
+        result.push_back(PeerStats{endpoint, current.rate, current.size, current.sentCount, current.dropped, current.losses});
+    }
+
+    return result;
+}
+
+OPacMan::Peer& OPacMan::peer(const ip::udp::endpoint& endpoint, Clock::time_point now) {
+    auto [it, isInserted] = peers_.try_emplace(endpoint);
+
+    if (isInserted) {
+        it->second.updated = now;
+        it->second.lastIncrease = now;
+        it->second.lastDecrease = now - DecreaseInterval;
+    }
+
+    return it->second;
+}
+
+const OPacMan::Task* OPacMan::head(const Peer& peer, std::optional<size_t>& index) {
+    index = peer.scheduler.peek([&peer](size_t i) { return peer.queues[i].empty(); });
+    return index.has_value() ? &peer.queues[index.value()].front() : nullptr;
+}
+
+bool OPacMan::isUrgent(size_t index) {
+    return index == static_cast<size_t>(PacketPriority::Consensus);
+}
+
+void OPacMan::refill(Peer& peer, Clock::time_point now) {
+    if (now <= peer.updated) {
+        return;
+    }
+
+    const double elapsed = std::chrono::duration<double>(now - peer.updated).count();
+    peer.tokens = std::min(burst(peer), peer.tokens + elapsed * peer.rate);
+    peer.updated = now;
+}
+
+void OPacMan::decrease(Peer& peer, Clock::time_point now) {
+    // losses of one burst are counted once
+    if (now - peer.lastDecrease < DecreaseInterval) {
+        return;
+    }
+
+    peer.rate = std::max(MinRate, peer.rate * DecreaseFactor);
+    peer.tokens = std::min(peer.tokens, burst(peer));
+    peer.lastDecrease = now;
+    peer.lastIncrease = now;
+}
+
+double OPacMan::burst(const Peer& peer) {
+    return std::max(MinBurst, peer.rate * std::chrono::duration<double>(BurstTime).count());
+}
+
+void OPacMan::rememberSent(Peer& peer, const Packet& pack) {
+    const Region* region = pack.region_.get();
+    auto [it, isInserted] = peer.sent.try_emplace(region, pack.region_);
+
+    if (!isInserted) {
+        it->second = pack.region_;
+        return;
+    }
+
+    peer.sentOrder.push_back(region);
+
+    if (peer.sentOrder.size() > SentHistory) {
+        peer.sent.erase(peer.sentOrder.front());
+        peer.sentOrder.pop_front();
+    }
+}
+
+bool OPacMan::wasSent(const Peer& peer, const Packet& pack) {
+    auto it = peer.sent.find(pack.region_.get());
+
+    if (it == peer.sent.end()) {
+        return false;
+    }
+
+    return it->second.lock() == pack.region_;
 }
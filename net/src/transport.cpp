@@ -146,6 +146,7 @@ void Transport::run() {
         bool refreshLimits = ctr % 20 == 0;
         bool checkPending = ctr % 100 == 0;
         bool checkSilent = ctr % 150 == 0;
+        bool logPacing = ctr % 200 == 0;
 
 /*
         if (askMissing) {
@@ -174,6 +175,10 @@ void Transport::run() {
             nh_.refreshLimits();
         }
 
+        if (logPacing) {
+            reportPacing();
+        }
+
         pollSignalFlag();
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
@@ -223,31 +228,17 @@ const char* Transport::networkCommandToString(NetworkCommand command) {
 }
 
 template <>
-uint16_t getHashIndex(const ip::udp::endpoint& ep) {
-    uint16_t result = ep.port();
+uint64_t getHashValue(const ip::udp::endpoint& ep) {
+    // sender address of datagram may be spoofed, so it is hashed by the keyed hash
+    std::array<uint8_t, 18> data;
 
-    if (ep.protocol() == ip::udp::v4()) {
-        uint32_t address = ep.address().to_v4().to_uint();
-        uint16_t lowBits = static_cast<uint16_t>(address);
-        uint16_t highBits = address >> (sizeof(uint16_t) * CHAR_BIT);
-        result ^= lowBits ^ highBits;
-    }
-    else {
-        auto bytes = ep.address().to_v6().to_bytes();
-        auto ptr = reinterpret_cast<uint8_t*>(&result);
-        auto bytesPtr = bytes.data();
-        for (size_t i = 0; i < 8; ++i) {
-            *ptr ^= *(bytesPtr++);
-        }
+    const auto address = ep.address().is_v4() ? ip::make_address_v6(ip::v4_mapped, ep.address().to_v4()).to_bytes() : ep.address().to_v6().to_bytes();
+    const uint16_t port = ep.port();
 
-        ++ptr;
-
-        for (size_t i = 8; i < 16; ++i) {
-            *ptr ^= *(bytesPtr++);
-        }
-    }
+    std::copy(address.begin(), address.end(), data.begin());
+    std::memcpy(data.data() + address.size(), &port, sizeof(port));
 
-    return result;
+    return cs::SipHash::calculate(data.data(), data.size());
 }
 
 RemoteNodePtr Transport::getPackSenderEntry(const ip::udp::endpoint& ep) {
@@ -484,6 +475,11 @@ void Transport::processNodeMessage(const Message& msg) {
 
     switch (node_->chooseMessageAction(rNum, type, msg.getFirstPack().getSender())) {
         case Node::MessageActions::Process:
+            // lane handlers read fragments in place, so the message is not composed here
+            if (cs::DispatchLanes::laneOf(type) != cs::DispatchLanes::Lane::Consensus) {
+                return postToLane(type, rNum, msg);
+            }
+
             return dispatchNodeMessage(type, rNum, msg.getFirstPack(), msg.getFullData() + StrippedDataSize, msg.getFullSize() - StrippedDataSize);
         case Node::MessageActions::Postpone:
             return postponePacket(rNum, type, msg.extractData());
@@ -582,7 +578,7 @@ void Transport::dispatchNodeMessage(const MsgTypes type, const cs::RoundNumber r
         case MsgTypes::BlockRequest:
             return node_->getBlockRequest(data, size, firstPack.getSender());
         case MsgTypes::RequestedBlock:
-            return node_->getBlockReply(data, size);
+            return postToLane(type, rNum, firstPack, data, size);
         case MsgTypes::BigBang:  // any round (in theory) may be set
             return node_->getBigBang(data, size, rNum);
         case MsgTypes::RoundTableRequest:  // old-round node may ask for round info
@@ -598,7 +594,7 @@ void Transport::dispatchNodeMessage(const MsgTypes type, const cs::RoundNumber r
     }
 
     // cut slow packs
-    if ((rNum + getRoundTimeout(type)) < cs::Conveyer::instance().currentRoundNumber()) {
+    if (isOutdated(type, rNum)) {
         csdebug() << "TRANSPORT> Ignore old packs, round " << rNum << ", type " << Packet::messageTypeToString(type) << ", fragments " << firstPack.getFragmentsNum();
         return;
     }
@@ -614,11 +610,11 @@ void Transport::dispatchNodeMessage(const MsgTypes type, const cs::RoundNumber r
         case MsgTypes::HashReply:
             return node_->getHashReply(data, size, rNum, firstPack.getSender());
         case MsgTypes::TransactionPacket:
-            return node_->getTransactionsPacket(data, size);
+            return postToLane(type, rNum, firstPack, data, size);
         case MsgTypes::TransactionsPacketRequest:
             return node_->getPacketHashesRequest(data, size, rNum, firstPack.getSender());
         case MsgTypes::TransactionsPacketReply:
-            return node_->getPacketHashesReply(data, size, rNum, firstPack.getSender());
+            return postToLane(type, rNum, firstPack, data, size);
         case MsgTypes::FirstStage:
             return node_->getStageOne(data, size, firstPack.getSender());
         case MsgTypes::SecondStage:
@@ -632,11 +628,9 @@ void Transport::dispatchNodeMessage(const MsgTypes type, const cs::RoundNumber r
         case MsgTypes::ThirdStage:
             return node_->getStageThree(data, size);
         case MsgTypes::FirstSmartStage:
-            return node_->getSmartStageOne(data, size, rNum, firstPack.getSender());
         case MsgTypes::SecondSmartStage:
-            return node_->getSmartStageTwo(data, size, rNum, firstPack.getSender());
         case MsgTypes::ThirdSmartStage:
-            return node_->getSmartStageThree(data, size, rNum, firstPack.getSender());
+            return postToLane(type, rNum, firstPack, data, size);
         case MsgTypes::SmartFirstStageRequest:
             return node_->getSmartStageRequest(type, data, size, firstPack.getSender());
         case MsgTypes::SmartSecondStageRequest:
@@ -661,6 +655,83 @@ void Transport::dispatchNodeMessage(const MsgTypes type, const cs::RoundNumber r
     }
 }
 
+bool Transport::isOutdated(const MsgTypes type, const cs::RoundNumber rNum) {
+    return (rNum + getRoundTimeout(type)) < cs::Conveyer::instance().currentRoundNumber();
+}
+
+void Transport::postToLane(const MsgTypes type, const cs::RoundNumber rNum, const Packet& firstPack, const uint8_t* data, size_t size) {
+    const auto lane = cs::DispatchLanes::laneOf(type);
+
+    // message memory is reused by receiver after dispatching, lane task keeps own copy
+    auto task = [this, type, rNum, sender = firstPack.getSender(), bytes = cs::Bytes(data, data + size)] {
+        cs::IPackStream stream;
+        stream.init(bytes.data(), bytes.size());
+
+        dispatchLaneMessage(type, rNum, sender, stream);
+    };
+
+    if (!node_->getDispatchLanes().post(lane, std::move(task))) {
+        csdebug() << "TRANSPORT> Dispatch lane is overloaded, drop " << Packet::messageTypeToString(type) << " of round " << rNum;
+    }
+}
+
+void Transport::postToLane(const MsgTypes type, const cs::RoundNumber rNum, const Message& msg) {
+    const auto& firstPack = msg.getFirstPack();
+
+    if (msg.getFullSize() <= StrippedDataSize) {
+        cserror() << "Bad packet size, why is it zero?";
+        return;
+    }
+
+    // the same filters as dispatchNodeMessage applies
+    if (firstPack.getSender() == node_->getNodeIdKey()) {
+        csdebug() << "TRANSPORT> Ignore own packs";
+        return;
+    }
+
+    if (type != MsgTypes::RequestedBlock && isOutdated(type, rNum)) {
+        csdebug() << "TRANSPORT> Ignore old packs, round " << rNum << ", type " << Packet::messageTypeToString(type) << ", fragments " << firstPack.getFragmentsNum();
+        return;
+    }
+
+    const auto lane = cs::DispatchLanes::laneOf(type);
+
+    // fragments share memory with the message, lane reads their payloads in place instead of composed copy
+    auto task = [this, type, rNum, sender = firstPack.getSender(), fragments = msg.packets_] {
+        const auto segments = Message::dataSegments(fragments);
+
+        cs::IPackStream stream;
+        stream.init(segments.data(), segments.size());
+        stream.safeSkip<cs::Byte>(StrippedDataSize);
+
+        dispatchLaneMessage(type, rNum, sender, stream);
+    };
+
+    if (!node_->getDispatchLanes().post(lane, std::move(task))) {
+        csdebug() << "TRANSPORT> Dispatch lane is overloaded, drop " << Packet::messageTypeToString(type) << " of round " << rNum;
+    }
+}
+
+void Transport::dispatchLaneMessage(const MsgTypes type, const cs::RoundNumber rNum, const cs::PublicKey& sender, cs::IPackStream& stream) {
+    switch (type) {
+        case MsgTypes::RequestedBlock:
+            return node_->getBlockReply(stream);
+        case MsgTypes::TransactionPacket:
+            return node_->getTransactionsPacket(stream);
+        case MsgTypes::TransactionsPacketReply:
+            return node_->getPacketHashesReply(stream, rNum, sender);
+        case MsgTypes::FirstSmartStage:
+            return node_->getSmartStageOne(stream, rNum, sender);
+        case MsgTypes::SecondSmartStage:
+            return node_->getSmartStageTwo(stream, rNum, sender);
+        case MsgTypes::ThirdSmartStage:
+            return node_->getSmartStageThree(stream, rNum, sender);
+        default:
+            cserror() << "TRANSPORT> No lane handler for message type " << Packet::messageTypeToString(type);
+            break;
+    }
+}
+
 void Transport::registerTask(Packet* pack, const uint32_t packNum, const bool incrementWhenResend) {
     auto end = pack + packNum;
 
@@ -1125,6 +1196,11 @@ bool Transport::gotPackInform(const TaskPtr<IPacMan>&, RemoteNodePtr& sender) {
     }
 
     nh_.neighbourHasPacket(sender, hHash, isDirect);
+
+    if (ConnectionPtr conn = nh_.getConnection(sender); conn) {
+        net_->onDelivered(conn->getOut());
+    }
+
     return true;
 }
 
@@ -1253,6 +1329,9 @@ bool Transport::gotPackRequest(const TaskPtr<IPacMan>&, RemoteNodePtr& sender) {
         return false;
     }
 
+    // requested fragments are lost on the way to the peer
+    net_->onLoss(ep);
+
     uint32_t reqd = 0, snt = 0;
     uint64_t mask = 1;
 
@@ -1271,6 +1350,26 @@ bool Transport::gotPackRequest(const TaskPtr<IPacMan>&, RemoteNodePtr& sender) {
     return true;
 }
 
+std::vector<OPacMan::PeerStats> Transport::getPacingStats() const {
+    return net_->getPacingStats();
+}
+
+std::vector<Network::ReaderStats> Transport::getReaderStats() const {
+    return net_->getReaderStats();
+}
+
+void Transport::reportPacing() const {
+    for (const auto& peer : net_->getPacingStats()) {
+        csdebug() << "Pacing " << peer.endpoint << ": rate " << static_cast<uint64_t>(peer.rate / 1024) << " KB/s, queue " << peer.queueDepth << ", sent "
+                  << peer.sent << ", dropped " << peer.dropped << ", losses " << peer.losses;
+    }
+
+    for (const auto& reader : net_->getReaderStats()) {
+        csdebug() << "Reader " << reader.index << ": received " << reader.packets << " packets, " << reader.bytes << " bytes, rejected " << reader.rejected
+                  << ", errors " << reader.errors;
+    }
+}
+
 // Turn on testing blockchain ID in PING packets to prevent nodes from confuse alien ones
 #define PING_WITH_BCHID
 
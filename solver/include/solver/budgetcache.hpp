@@ -0,0 +1,151 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace cs {
+
+/**
+ * @class   BudgetCache
+ *
+ * @brief   LRU cache limited by the total size of stored values in bytes rather than by their count.
+ *
+ *          Values are hydrated from a slower storage on demand and evicted least recently used first when the budget
+ *          is exceeded. Pinned values have no copy in the storage, they are counted against the budget but never
+ *          evicted until replaced by unpinned ones. The cache is synchronized, lookups from const methods of owners
+ *          are allowed.
+ */
+
+template <typename Key, typename Value>
+class BudgetCache {
+public:
+    explicit BudgetCache(size_t budget)
+    : budget_(budget) {
+    }
+
+    // returns a copy of value and marks it as recently used
+    std::optional<Value> get(const Key& key) {
+        std::lock_guard lock(mutex_);
+
+        auto it = items_.find(key);
+        if (it == items_.end()) {
+            ++misses_;
+            return std::nullopt;
+        }
+
+        ++hits_;
+        order_.splice(order_.begin(), order_, it->second.position);
+        return it->second.value;
+    }
+
+    // replaces value if the key is already cached, size is the count of bytes to charge against the budget
+    void put(const Key& key, Value value, size_t size, bool isPinned = false) {
+        std::lock_guard lock(mutex_);
+
+        auto it = items_.find(key);
+        if (it != items_.end()) {
+            bytes_ -= it->second.size;
+            it->second.value = std::move(value);
+            it->second.size = size;
+            it->second.isPinned = isPinned;
+            order_.splice(order_.begin(), order_, it->second.position);
+        }
+        else {
+            order_.push_front(key);
+            items_.emplace(key, Item{std::move(value), size, isPinned, order_.begin()});
+        }
+
+        bytes_ += size;
+        shrink();
+    }
+
+    void erase(const Key& key) {
+        std::lock_guard lock(mutex_);
+
+        auto it = items_.find(key);
+        if (it != items_.end()) {
+            bytes_ -= it->second.size;
+            order_.erase(it->second.position);
+            items_.erase(it);
+        }
+    }
+
+    bool contains(const Key& key) const {
+        std::lock_guard lock(mutex_);
+        return items_.find(key) != items_.end();
+    }
+
+    size_t size() const {
+        std::lock_guard lock(mutex_);
+        return items_.size();
+    }
+
+    size_t bytes() const {
+        std::lock_guard lock(mutex_);
+        return bytes_;
+    }
+
+    size_t budget() const {
+        std::lock_guard lock(mutex_);
+        return budget_;
+    }
+
+    // evicts values at once if the new budget is less than bytes stored
+    void setBudget(size_t budget) {
+        std::lock_guard lock(mutex_);
+        budget_ = budget;
+        shrink();
+    }
+
+    uint64_t hits() const {
+        std::lock_guard lock(mutex_);
+        return hits_;
+    }
+
+    uint64_t misses() const {
+        std::lock_guard lock(mutex_);
+        return misses_;
+    }
+
+private:
+    using Order = std::list<Key>;
+
+    struct Item {
+        Value value;
+        size_t size;
+        bool isPinned;
+        typename Order::iterator position;
+    };
+
+    // evicts from the least recently used end skipping pinned values
+    void shrink() {
+        auto it = order_.end();
+
+        while (bytes_ > budget_ && it != order_.begin()) {
+            --it;
+
+            auto item = items_.find(*it);
+            if (item->second.isPinned) {
+                continue;
+            }
+
+            bytes_ -= item->second.size;
+            items_.erase(item);
+            it = order_.erase(it);
+        }
+    }
+
+    size_t budget_;
+
+    mutable std::mutex mutex_;
+    std::map<Key, Item> items_;
+    Order order_;
+    size_t bytes_ = 0;
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+}  // namespace cs
@@ -46,6 +46,9 @@ public:
     /** @brief   Min duration (msec) to collect hashes in stage-1 of consensus */
     constexpr static uint32_t T_min_stage1 = 170;
 
+    /** @brief   Lower bound (msec) of adaptive min duration to collect hashes in stage-1 */
+    constexpr static uint32_t T_min_stage1_lower = 40;
+
     /** @brief   Number of rounds to prevent node from consensus participation */
     constexpr static uint32_t GrayListPunishment = 1000;
 
@@ -58,6 +61,12 @@ public:
     /** @brief   Max timeout (msec) to wait stages (Trusted-2,3) */
     constexpr static uint32_t T_stage_request = 2000;
 
+    /** @brief   Lower bound (msec) of adaptive timeout to wait stages */
+    constexpr static uint32_t T_stage_request_lower = 300;
+
+    /** @brief   Upper bound (msec) of adaptive timeout to wait stages */
+    constexpr static uint32_t T_stage_request_upper = 8000;
+
     /** @brief   Max subround delta */
     constexpr static uint8_t MaxSubroundDelta = 10;
 
@@ -11,6 +11,8 @@
 
 #include <csnode/node.hpp>  // introduce csconnector::connector::ApiExecHandlerPtr at least
 
+#include <solver/budgetcache.hpp>
+
 #include <list>
 #include <mutex>
 #include <optional>
@@ -376,6 +378,23 @@ public:
         return is_locked(absolute_address(addr));
     }
 
+    // last state of known contract, it is read back from DB cache if it has been evicted from memory
+    std::string get_known_contract_state(const csdb::Address& addr) const;
+
+    bool is_state_cached(const csdb::Address& addr) const {
+        cs::Lock lock(public_access_lock);
+        return contract_states.contains(absolute_address(addr));
+    }
+
+    size_t states_cache_bytes() const {
+        return contract_states.bytes();
+    }
+
+    // StatesCacheBudget by default, states which have not reached DB cache yet are kept over the budget
+    void set_states_cache_budget(size_t budget) {
+        contract_states.setBudget(budget);
+    }
+
     bool executionAllowed();
 
     // return true if SmartContracts provide special handling for transaction, so
@@ -461,19 +480,28 @@ private:
         SmartContractRef ref_execute;
         // Reference to execution which state is cached in DB
         SmartContractRef ref_cache;
-        // deploy transaction referenced by ref_deploy
-        csdb::Transaction deploy{};
-        // the last execute transaction referenced by ref_execute
-        csdb::Transaction execute{};
-        // current state which is result of last successful execution / deploy
-        std::string state;
+        // hash of current state which is result of last successful execution / deploy, the state itself is in contract_states;
+        // calculated on the first comparison to new_state hash
+        std::optional<cs::Hash> state_hash;
+        // size of current state, zero until the contract is successfully deployed
+        size_t state_size = 0;
         // using other contracts: [own_method] - [ [other_contract - its_method], ... ], ...
         std::map<std::string, std::map<csdb::Address, std::string>> uses;
     };
 
-    // last contract's state storage
+    // last contract's state storage, metadata only
     std::map<csdb::Address, StateItem> known_contracts;
 
+    // budgets of on demand hydrated contract data
+    constexpr static size_t StatesCacheBudget = 64 * 1024 * 1024;
+    constexpr static size_t TransactionsCacheBudget = 16 * 1024 * 1024;
+
+    // states referenced by known_contracts, states not cached in DB yet are pinned
+    mutable BudgetCache<csdb::Address, std::string> contract_states{ StatesCacheBudget };
+
+    // deploy and last execute transactions referenced by known_contracts
+    mutable BudgetCache<SmartContractRef, csdb::Transaction> contract_transactions{ TransactionsCacheBudget };
+
     std::set<csdb::Address> locked_contracts;
 
     // contract replenish transactions stored during reading from DB on stratup
@@ -583,7 +611,8 @@ private:
     using execution_iterator = std::vector<ExecutionItem>::iterator;
     using execution_const_iterator = std::vector<ExecutionItem>::const_iterator;
 
-    Node* pnode;
+    // nullptr until init(), contracts are not executed without node
+    Node* pnode = nullptr;
 
     queue_const_iterator find_in_queue(const SmartContractRef& item) const {
         for (auto it = exe_queue.cbegin(); it != exe_queue.cend(); ++it) {
@@ -773,6 +802,17 @@ private:
 
     bool dbcache_read(const csdb::Address& abs_addr, SmartContractRef& ref_start /*output*/, std::string& state /*output*/);
 
+    // hydrate contract data referenced by known_contracts
+
+    // stores current state of contract, pinned until the same state reaches cache in DB
+    void set_known_state(const csdb::Address& abs_addr, StateItem& item, std::string state, bool is_cached_in_db);
+
+    // returns current state of contract, empty if not deployed or not available neither in memory nor in DB
+    std::string get_known_state(const csdb::Address& abs_addr, const StateItem& item) const;
+
+    // returns transaction referenced by item, loads it from blockchain if it is not in memory
+    csdb::Transaction get_referenced_transaction(const SmartContractRef& ref) const;
+
     /**
      * block current thread until executor become available test_period_sec
      *
@@ -201,6 +201,18 @@ public:
         return core.scheduler;
     }
 
+    /**
+     * @fn  cs::StageTiming& SolverContext::stage_timing() const;
+     *
+     * @brief   Gets measured timing of hashes and stages arrival.
+     *
+     * @return  A reference to a cs::StageTiming.
+     */
+
+    cs::StageTiming& stage_timing() const {
+        return core.stageTiming_;
+    }
+
     // Access to common state properties.
 
     /**
@@ -5,6 +5,7 @@
 #include "inodestate.hpp"
 #include "smartconsensus.hpp"
 #include "stage.hpp"
+#include "stagetiming.hpp"
 #include "timeouttracking.hpp"
 
 #include <csdb/pool.hpp>
@@ -22,6 +23,7 @@
 
 // forward declarations
 class Node;
+class BlockChain;
 
 namespace cs {
 class WalletsState;
@@ -42,6 +44,9 @@ public:
     SolverCore();
     explicit SolverCore(Node* pNode, csdb::Address GenesisAddress, csdb::Address StartAddress);
 
+    // without node: wallets state and smart contracts of blockchain to validate transactions, contracts are not executed
+    explicit SolverCore(BlockChain& blockchain, csdb::Address GenesisAddress, csdb::Address StartAddress);
+
     ~SolverCore();
 
     void startDefault() {
@@ -197,6 +202,7 @@ private:
     std::vector<cs::StageHash> recv_hash;
 
     Node* pnode;
+    BlockChain* pblockchain;
     std::unique_ptr<cs::WalletsState> pws;
     // smart contracts service
     std::unique_ptr<cs::SmartContracts> psmarts;
@@ -288,6 +294,9 @@ private:
         return nullptr;
     }
 
+    // records arrival of stage from confidant with the sender index for stage timing
+    void trackStage(cs::StageTiming::Kind kind, uint8_t sender);
+
     template <typename StageT>
     StageT* find_stage(const std::vector<StageT>& vec, uint8_t sender) const {
         for (auto it = vec.begin(); it != vec.end(); ++it) {
@@ -326,6 +335,9 @@ private:
 
     // tracks round info missing ("last hope" tool)
     TimeoutTracking track_next_round;
+
+    // measured latency of hashes and stages gives round timing
+    cs::StageTiming stageTiming_;
     std::map<cs::PublicKey, uint16_t> grayList_;
     cs::RoundNumber lastGrayUpdated_ = 0;
     RoundPackage justCreatedRoundPackage;
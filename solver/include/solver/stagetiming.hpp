@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+
+/**
+ * @class   StageTiming
+ *
+ * @brief   Tracks arrival latency of hashes and stages in consensus rounds.
+ *
+ *          Latency of every sender is counted from the moment the node starts to wait for it: round start for hashes,
+ *          entering the corresponding trusted state for stages. Messages came earlier have zero latency. Estimates
+ *          (EWMA per confidant and percentiles over the last samples) give minimum wait of stage-1 and stages
+ *          request timeouts. Until enough samples are collected the constant values are used.
+ */
+
+class StageTiming {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind : uint8_t {
+        Hash,
+        Stage1,
+        Stage2,
+        Stage3
+    };
+
+    constexpr static size_t KindsCount = 4;
+
+    /** @brief   Count of last samples to calculate percentiles of each kind */
+    constexpr static size_t SamplesCount = 256;
+
+    /** @brief   Min count of samples to use estimates instead of constants */
+    constexpr static size_t MinSamples = 32;
+
+    /** @brief   Smoothing factor of confidant latency average */
+    constexpr static double Alpha = 0.125;
+
+    /** @brief   Timeout is greater than the expected latency by this factor */
+    constexpr static double TimeoutMargin = 1.5;
+
+    /** @brief   Confidant averages are forgotten after this count of rounds without messages */
+    constexpr static uint64_t ForgetRounds = 100;
+
+    void startRound(Clock::time_point now = Clock::now());
+    void startWaiting(Kind kind, Clock::time_point now = Clock::now());
+    void onArrival(Kind kind, const cs::PublicKey& sender, Clock::time_point now = Clock::now());
+
+    // msec, within [Consensus::T_min_stage1_lower, Consensus::T_min_stage1]
+    uint32_t minStage1Time() const;
+
+    // msec, within [Consensus::T_stage_request_lower, Consensus::T_stage_request_upper], fallback if not enough samples
+    uint32_t requestTimeout(Kind kind, const std::vector<cs::PublicKey>& confidants, uint32_t fallback) const;
+
+    std::optional<double> percentile(Kind kind, double rank) const;
+    std::optional<double> average(Kind kind, const cs::PublicKey& sender) const;
+    size_t samplesCount(Kind kind) const;
+
+private:
+    struct Samples {
+        std::array<double, SamplesCount> values{};
+        size_t count = 0;
+        size_t next = 0;
+    };
+
+    struct Average {
+        std::array<std::optional<double>, KindsCount> values;
+        uint64_t lastRound = 0;
+    };
+
+    struct Waiting {
+        std::optional<Clock::time_point> start;
+        std::vector<cs::PublicKey> early;
+        std::set<cs::PublicKey> arrived;
+    };
+
+    void record(Kind kind, const cs::PublicKey& sender, double latency);
+
+    static size_t index(Kind kind) {
+        return static_cast<size_t>(kind);
+    }
+
+    std::array<Samples, KindsCount> samples_;
+    std::array<Waiting, KindsCount> waiting_;
+    std::map<cs::PublicKey, Average> averages_;
+    uint64_t rounds_ = 0;
+};
+
+}  // namespace cs
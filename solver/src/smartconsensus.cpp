@@ -9,6 +9,7 @@
 #include <csdb/amount.hpp>
 #include <csdb/currency.hpp>
 #include <csnode/datastream.hpp>
+#include <csnode/roundtrace.hpp>
 #include <solvercore.hpp>
 
 #include <cscrypto/cscrypto.hpp>
@@ -254,6 +255,7 @@ void SmartConsensus::addSmartStageOne(cs::StageOneSmarts& stage, bool send) {
         return;
     }
     csmeta(csdetails) << "start";
+    cs::RoundTrace::instance().instant(send ? "smart stage-1 sent" : "smart stage-1 received", cs::RoundTrace::Track::Smarts, stage.sender);
     if (send) {
         pnode_->sendSmartStageOne(smartConfidants_, stage);
     }
@@ -300,6 +302,7 @@ void SmartConsensus::addSmartStageTwo(cs::StageTwoSmarts& stage, bool send) {
     if (stage.id != id()) {
         return;
     }
+    cs::RoundTrace::instance().instant(send ? "smart stage-2 sent" : "smart stage-2 received", cs::RoundTrace::Track::Smarts, stage.sender);
     if (send) {
         pnode_->sendSmartStageTwo(smartConfidants_, stage);
     }
@@ -456,7 +459,7 @@ void SmartConsensus::processStages() {
     startTimer(3);
     createFinalTransactionSet(finalFees);
     st3.packageSignature =
-        cscrypto::generateSignature(pnode_->getSolver()->getPrivateKey(), finalSmartTransactionPack_.hash().toBinary().data(), finalSmartTransactionPack_.hash().toBinary().size());
+        cscrypto::generateSignature(pnode_->getSolver()->getPrivateKey(), finalSmartTransactionPack_.hash().data(), finalSmartTransactionPack_.hash().size());
     csmeta(csdetails) << "done";
     st3.id = id();
     st3.sender = ownSmartsConfNum_;
@@ -492,6 +495,7 @@ void SmartConsensus::addSmartStageThree(cs::StageThreeSmarts& stage, bool send)
     if (stage.id != id()) {
         return;
     }
+    cs::RoundTrace::instance().instant(send ? "smart stage-3 sent" : "smart stage-3 received", cs::RoundTrace::Track::Smarts, stage.sender);
 
     auto lambda = [this](const cs::StageThreeSmarts& stageFrom, cs::Bytes hash) {
         if (!cscrypto::verifySignature(stageFrom.packageSignature, smartConfidants().at(stageFrom.sender), hash.data(), hash.size())) {
@@ -16,6 +16,11 @@
 namespace {
     const char* kLogPrefix = "Smart: ";
 
+    // bytes charged against transactions cache budget
+    inline size_t cached_size(const csdb::Transaction& t) {
+        return t.to_byte_stream().size();
+    }
+
     inline void print(std::ostream& os, const ::general::Variant& var) {
         os << "Variant(";
         bool print_default = false;
@@ -217,7 +222,7 @@ void SmartContracts::init(const cs::PublicKey& id, Node* node) {
     // validate contract states
     for (const auto& item : known_contracts) {
         const StateItem& val = item.second;
-        if (val.state.empty()) {
+        if (val.state_size == 0) {
             csdetails() << kLogPrefix << "completely unsuccessful " << val.ref_deploy << " found, neither deployed, nor executed";
         }
         if (!val.ref_deploy.is_valid()) {
@@ -531,11 +536,8 @@ csdb::Transaction SmartContracts::get_transaction(const SmartContractRef& contra
     auto it_state = known_contracts.find(abs_addr);
     if (it_state != known_contracts.cend()) {
         const auto& item = it_state->second;
-        if (item.ref_execute == contract && item.execute.is_valid()) {
-            return item.execute;
-        }
-        if (item.ref_deploy == contract && item.deploy.is_valid()) {
-            return item.deploy;
+        if (item.ref_execute == contract || item.ref_deploy == contract) {
+            return get_referenced_transaction(contract);
         }
     }
     return SmartContracts::get_transaction(bc, contract);
@@ -545,14 +547,18 @@ csdb::Transaction SmartContracts::get_deploy_transaction(const csdb::Address& ab
     auto it_state = known_contracts.find(abs_addr);
     if (it_state != known_contracts.cend()) {
         const auto& contract = it_state->second;
-        if (contract.deploy.is_valid()) {
-            return contract.deploy;
+        if (contract.ref_deploy.is_valid()) {
+            return get_referenced_transaction(contract.ref_deploy);
         }
     }
     return csdb::Transaction{};
 }
 
 void SmartContracts::enqueue(const csdb::Pool& block, size_t trx_idx, bool skip_log) {
+    if (pnode == nullptr) {
+        // validation without node, nothing executes contracts
+        return;
+    }
     if (trx_idx >= block.transactions_count()) {
         cserror() << kLogPrefix << "incorrect trx index in block to enqueue smart contract";
         return;
@@ -587,7 +593,6 @@ void SmartContracts::enqueue(const csdb::Pool& block, size_t trx_idx, bool skip_
                 const auto& invoke_info = maybe_invoke_info.value();
                 StateItem& state = known_contracts[abs_addr];
                 state.ref_deploy = new_item;
-                state.deploy = t.clone();
                 if (update_metadata(invoke_info, state, skip_log)) {
                     payable = implements_payable(state.payable);
                 }
@@ -848,7 +853,7 @@ bool SmartContracts::capture_transaction(const csdb::Transaction& tr) {
     const auto it = known_contracts.find(abs_addr);
     if (it != known_contracts.end()) {
         is_contract = true;
-        has_state = !it->second.state.empty();
+        has_state = it->second.state_size != 0;
     }
 
     if (is_contract) {
@@ -988,19 +993,33 @@ csdb::Transaction SmartContracts::get_actual_state(const csdb::Transaction& hash
                 csdb::Address req_abs_addr = absolute_address(hashed_state.target());
                 // test last state in cache
                 if (in_known_contracts(req_abs_addr)) {
-                    const StateItem& item = known_contracts[req_abs_addr];
+                    StateItem& item = known_contracts[req_abs_addr];
                     if (item.ref_execute == ref_start) {
-                        cs::Hash current_hash = cscrypto::calculateHash((cs::Byte*)item.state.data(), item.state.size());
-                        if (current_hash == hash) {
-                            tr_state.add_user_field(new_state::Value, item.state);
+                        std::string state;
+                        if (!item.state_hash.has_value()) {
+                            state = get_known_state(req_abs_addr, item);
+                            if (!state.empty()) {
+                                item.state_hash = cscrypto::calculateHash((cs::Byte*)state.data(), state.size());
+                            }
                         }
-                        else {
-                            cswarning() << kLogPrefix << "incorrect " << ref_start << " state in cache, request from other nodes";
-                            // request correct state in network and return empty new_state transaction as "no valid state available"
-                            if (!reading_db) {
-                                net_request_contract_state(req_abs_addr);
+                        // if state is unavailable it is restored by execution below
+                        if (item.state_hash.has_value()) {
+                            if (item.state_hash.value() == hash) {
+                                if (state.empty()) {
+                                    state = get_known_state(req_abs_addr, item);
+                                }
+                                if (!state.empty()) {
+                                    tr_state.add_user_field(new_state::Value, state);
+                                }
+                            }
+                            else {
+                                cswarning() << kLogPrefix << "incorrect " << ref_start << " state in cache, request from other nodes";
+                                // request correct state in network and return empty new_state transaction as "no valid state available"
+                                if (!reading_db) {
+                                    net_request_contract_state(req_abs_addr);
+                                }
+                                tr_state.add_user_field(new_state::Value, std::string{});
                             }
-                            tr_state.add_user_field(new_state::Value, std::string{});
                         }
                     }
                 }
@@ -1026,7 +1045,7 @@ csdb::Transaction SmartContracts::get_actual_state(const csdb::Transaction& hash
                             if (!SmartContracts::is_deploy(tr_start)) {
                                 if (in_known_contracts(req_abs_addr)) {
                                     const StateItem& item = known_contracts[req_abs_addr];
-                                    exe_data.explicit_last_state = item.state;
+                                    exe_data.explicit_last_state = get_known_state(req_abs_addr, item);
                                 }
                             }
                             while (!execute(exe_data, true /*validationMode*/)) {
@@ -1207,7 +1226,7 @@ void SmartContracts::on_next_block_impl(const csdb::Pool& block, bool reading_db
                             if (!reading_db) {
                                 csdebug() << kLogPrefix << to_base58(abs_addr) << " state is unchanged after " << ref_start;
                             }
-                            if (pnode->isStopRequested()) {
+                            if (pnode != nullptr && pnode->isStopRequested()) {
                                 *should_stop = true;
                                 return;
                             }
@@ -2045,16 +2064,13 @@ bool SmartContracts::update_contract_state(const csdb::Transaction& t, bool read
         }
 
         // there is only one place to update state in "memory cache" and only after successful dbcache_update()!!!
-        item.state = std::move(state_value);
+        // the state stays pinned in memory until DB cache contains the same one
+        set_known_state(abs_addr, item, std::move(state_value), item.ref_cache == ref_start);
         // determine it is the result of whether deploy or execute
         if (!replenish) {
             // deploy is execute also
             if (deploy) {
                 item.ref_deploy = ref_start;
-                // deploy transaction has already stored
-                if (!item.deploy.is_valid()) {
-                    item.deploy = t_start.clone();
-                }
             }
         }
         else {
@@ -2066,8 +2082,11 @@ bool SmartContracts::update_contract_state(const csdb::Transaction& t, bool read
                 }
             }
         }
+        // previous execute transaction is not referenced any more
+        if (item.ref_execute.is_valid() && !(item.ref_execute == item.ref_deploy)) {
+            contract_transactions.erase(item.ref_execute);
+        }
         item.ref_execute = ref_start;
-        item.execute = t_start;
 
         // emits signal
         contract_state_updated(t_state);
@@ -2199,7 +2218,7 @@ void SmartContracts::add_uses_from(const csdb::Address& abs_addr, const std::str
     const auto it = known_contracts.find(abs_addr);
     if (it != known_contracts.cend()) {
         if (!is_metadata_actual(abs_addr)) {
-            const csdb::Transaction& t = it->second.deploy;
+            const csdb::Transaction t = get_deploy_transaction(abs_addr);
             if (t.is_valid()) {
                 auto maybe_invoke_info = get_smart_contract_impl(t);
                 if (maybe_invoke_info.has_value()) {
@@ -2446,6 +2465,64 @@ bool SmartContracts::dbcache_update(const csdb::Address& abs_addr, const SmartCo
     return SmartContracts::dbcache_update(bc, abs_addr, ref_start, state, force_update);
 }
 
+void SmartContracts::set_known_state(const csdb::Address& abs_addr, StateItem& item, std::string state, bool is_cached_in_db) {
+    // the hash is calculated only if get_actual_state() compares this state to new_state
+    item.state_hash.reset();
+    item.state_size = state.size();
+
+    const size_t size = state.size();
+    contract_states.put(abs_addr, std::move(state), size, !is_cached_in_db);
+}
+
+std::string SmartContracts::get_known_state(const csdb::Address& abs_addr, const StateItem& item) const {
+    if (item.state_size == 0) {
+        return std::string{};
+    }
+
+    auto cached = contract_states.get(abs_addr);
+    if (cached.has_value()) {
+        return std::move(cached.value());
+    }
+
+    // only states cached in DB are evicted from memory
+    SmartContractRef ref_db;
+    std::string state;
+    if (SmartContracts::dbcache_read(bc, abs_addr, ref_db /*output*/, state /*output*/)) {
+        if (ref_db == item.ref_execute) {
+            contract_states.put(abs_addr, state, state.size());
+            return state;
+        }
+    }
+
+    cserror() << kLogPrefix << SmartContracts::to_base58(bc, abs_addr) << " state after " << item.ref_execute << " is not found in DB cache";
+    return std::string{};
+}
+
+/*public*/
+std::string SmartContracts::get_known_contract_state(const csdb::Address& addr) const {
+    cs::Lock lock(public_access_lock);
+
+    const csdb::Address abs_addr = absolute_address(addr);
+    const auto it = known_contracts.find(abs_addr);
+    if (it == known_contracts.cend()) {
+        return std::string{};
+    }
+    return get_known_state(abs_addr, it->second);
+}
+
+csdb::Transaction SmartContracts::get_referenced_transaction(const SmartContractRef& ref) const {
+    auto cached = contract_transactions.get(ref);
+    if (cached.has_value()) {
+        return cached.value();
+    }
+
+    csdb::Transaction t = SmartContracts::get_transaction(bc, ref);
+    if (t.is_valid()) {
+        contract_transactions.put(ref, t, cached_size(t));
+    }
+    return t;
+}
+
 bool SmartContracts::wait_until_executor(unsigned int test_freq, unsigned int max_periods /*= std::numeric_limits<unsigned int>::max()*/) {
     if (!exec_handler_ptr) {
         cserror() << kLogPrefix << "executor is unavailable, cannot operate correctly";
@@ -2482,7 +2559,10 @@ void SmartContracts::net_update_contract_state(const csdb::Address& contract_abs
         if (dbcache_update(contract_abs_addr, ref, state, false)) {
             if (in_known_contracts(contract_abs_addr)) {
                 auto& item = known_contracts[contract_abs_addr];
-                item.state = state;
+                if (item.ref_execute.is_valid() && !(item.ref_execute == item.ref_deploy)) {
+                    contract_transactions.erase(item.ref_execute);
+                }
+                set_known_state(contract_abs_addr, item, state, true);
                 item.ref_cache = ref;
                 item.ref_execute = ref;
                 csdebug() << kLogPrefix << to_base58(contract_abs_addr) << " state has updated from net package with " << ref << " state value";
@@ -4,6 +4,7 @@
 
 #include <csnode/conveyer.hpp>
 #include <csnode/node.hpp>
+#include <csnode/roundtrace.hpp>
 #include <lib/system/logger.hpp>
 
 namespace
@@ -14,7 +15,7 @@ namespace
 namespace cs {
 
 BlockChain& SolverContext::blockchain() const {
-    return core.pnode->getBlockChain();
+    return *core.pblockchain;
 }
 
 std::string SolverContext::sender_description(const cs::PublicKey& sender_id) {
@@ -40,6 +41,7 @@ void SolverContext::add_stage1(cs::StageOne& stage, bool send) {
     // core.stageOneStorage.push_back(stage);
     if (send) {
         core.pnode->sendStageOne(stage);
+        cs::RoundTrace::instance().instant("stage-1 sent", cs::RoundTrace::Track::Stages, stage.sender);
     }
     csdetails() << "Context> Stage1 message: " << cs::Utils::byteStreamToHex(stage.messageBytes);
     csdetails() << "Context> Stage1 signature: " << cs::Utils::byteStreamToHex(stage.signature);
@@ -55,6 +57,7 @@ void SolverContext::add_stage2(cs::StageTwo& stage, bool send) {
 
     if (send) {
         core.pnode->sendStageTwo(stage);
+        cs::RoundTrace::instance().instant("stage-2 sent", cs::RoundTrace::Track::Stages, stage.sender);
     }
     /*the order is important! the signature is created in node
     before sending stage and then is inserted in the field .sig
@@ -66,6 +69,7 @@ void SolverContext::add_stage3(cs::StageThree& stage) {
     // core.stageThreeStorage.push_back(stage);
 
     core.pnode->sendStageThree(stage);
+    cs::RoundTrace::instance().instant("stage-3 sent", cs::RoundTrace::Track::Stages, stage.sender);
     /*the order is important! the signature is created in node
     before sending stage and then is inserted in the field .sig
     now we can add it to stages storage*/
@@ -233,6 +237,9 @@ void SolverContext::request_round_info(uint8_t respondent1, uint8_t respondent2)
 }
 
 void SolverContext::send_rejected_smarts(const std::vector<RefExecution>& reject_list) {
+    if (core.pnode == nullptr) {
+        return;
+    }
     csdebug() << kLogPrefix << "sending " << reject_list.size() << " rejected contract calls";
     core.pnode->sendSmartReject(reject_list);
 }
@@ -9,6 +9,7 @@
 #pragma warning(pop)
 
 #include <csnode/datastream.hpp>
+#include <csnode/roundtrace.hpp>
 #include <csnode/walletsstate.hpp>
 #include <lib/system/logger.hpp>
 
@@ -59,6 +60,7 @@ SolverCore::SolverCore()
 , tag_state_expired(CallsQueueScheduler::no_tag)
 , req_stop(true)
 , pnode(nullptr)
+, pblockchain(nullptr)
 , pws(nullptr)
 , psmarts(nullptr)
 
@@ -83,13 +85,17 @@ SolverCore::SolverCore()
 
 // actual constructor
 SolverCore::SolverCore(Node* pNode, csdb::Address GenesisAddress, csdb::Address StartAddress)
+: SolverCore(pNode->getBlockChain(), GenesisAddress, StartAddress) {
+    pnode = pNode;
+}
+
+SolverCore::SolverCore(BlockChain& blockchain, csdb::Address GenesisAddress, csdb::Address StartAddress)
 : SolverCore() {
     addr_genesis = GenesisAddress;
     addr_start = StartAddress;
-    pnode = pNode;
-    auto& bc = pNode->getBlockChain();
-    pws = std::make_unique<cs::WalletsState>(bc.getCacheUpdater());
-    psmarts = std::make_unique<cs::SmartContracts>(bc, scheduler);
+    pblockchain = &blockchain;
+    pws = std::make_unique<cs::WalletsState>(blockchain.getCacheUpdater());
+    psmarts = std::make_unique<cs::SmartContracts>(blockchain, scheduler);
 }
 
 SolverCore::~SolverCore() {
@@ -134,6 +140,7 @@ void SolverCore::setState(const StatePtr& pState) {
     if (pstate) {
         csdetails() << log_prefix << "pstate-off";
         pstate->off(*pcontext);
+        cs::RoundTrace::instance().record(pstate->name(), cs::RoundTrace::Track::Solver, cs::RoundTrace::Phase::End);
     }
     if (Consensus::Log) {
         csdebug() << log_prefix << "switch " << (pstate ? pstate->name() : "null") << " -> " << (pState ? pState->name() : "null");
@@ -142,6 +149,7 @@ void SolverCore::setState(const StatePtr& pState) {
     if (!pstate) {
         return;
     }
+    cs::RoundTrace::instance().record(pstate->name(), cs::RoundTrace::Track::Solver, cs::RoundTrace::Phase::Begin);
     pstate->on(*pcontext);
 
     auto closure = [this]() {
@@ -500,6 +508,7 @@ bool SolverCore::addSignaturesToDeferredBlock(cs::Signatures&& blockSignatures)
     }
     deferredBlock_.set_signatures(blockSignatures);
 
+    cs::RoundTraceScope trace("create block", cs::RoundTrace::Track::Blocks, static_cast<int32_t>(deferredBlock_.sequence()));
     auto resPool = pnode->getBlockChain().createBlock(deferredBlock_);
 
     if (!resPool.has_value()) {
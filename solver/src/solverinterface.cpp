@@ -6,6 +6,7 @@
 #include <csnode/conveyer.hpp>
 #include <csnode/fee.hpp>
 #include <csnode/node.hpp>
+#include <csnode/roundtrace.hpp>
 
 #include <csdb/currency.hpp>
 #include <lib/system/logger.hpp>
@@ -110,6 +111,11 @@ void SolverCore::gotHash(const cs::StageHash&& sHash) {
     }
     recv_hash.push_back(sHash);
 
+    if (sHash.round == rNum) {
+        stageTiming_.onArrival(cs::StageTiming::Kind::Hash, sHash.sender);
+        cs::RoundTrace::instance().instant("hash received", cs::RoundTrace::Track::Stages);
+    }
+
     cs::Sequence delta = cs::Conveyer::instance().currentRoundNumber() - pnode->getBlockChain().getLastSeq();
     if (delta > 1) {
         //recv_hash.push_back(std::make_pair<>(sHash.hash, sHash.sender));
@@ -152,6 +158,7 @@ void SolverCore::nextRound() {
     lastSentSignatures_.poolSignatures.clear();
     lastSentSignatures_.roundSignatures.clear();
     lastSentSignatures_.trustedConfirmation.clear();
+    stageTiming_.startRound();
 
     if (!pstate) {
         return;
@@ -168,6 +175,8 @@ void SolverCore::gotStageOne(const cs::StageOne& stage) {
         return;
     }
     stageOneStorage.push_back(stage);
+    trackStage(cs::StageTiming::Kind::Stage1, stage.sender);
+    cs::RoundTrace::instance().instant("stage-1 received", cs::RoundTrace::Track::Stages, stage.sender);
     csdebug() << "SolverCore: <-- stage-1 [" << static_cast<int>(stage.sender) << "] = " << stageOneStorage.size();
 
     if (!pstate) {
@@ -178,6 +187,14 @@ void SolverCore::gotStageOne(const cs::StageOne& stage) {
     }
 }
 
+void SolverCore::trackStage(cs::StageTiming::Kind kind, uint8_t sender) {
+    const auto key = cs::Conveyer::instance().confidantIfExists(sender);
+
+    if (key.has_value()) {
+        stageTiming_.onArrival(kind, key.value());
+    }
+}
+
 void SolverCore::gotStageOneRequest(uint8_t requester, uint8_t required) {
     csdebug() << "SolverCore: [" << static_cast<int>(requester) << "] asks for stage-1 of [" << static_cast<int>(required) << "]";
 
@@ -221,6 +238,8 @@ void SolverCore::gotStageTwo(const cs::StageTwo& stage) {
     }
 
     stageTwoStorage.push_back(stage);
+    trackStage(cs::StageTiming::Kind::Stage2, stage.sender);
+    cs::RoundTrace::instance().instant("stage-2 received", cs::RoundTrace::Track::Stages, stage.sender);
     csdebug() << "SolverCore: <-- stage-2 [" << static_cast<int>(stage.sender) << "] = " << stageTwoStorage.size();
 
     if (!pstate) {
@@ -242,6 +261,12 @@ void SolverCore::gotStageThree(const cs::StageThree& stage, const uint8_t flagg)
         return;
     }
 
+    if (stage.iteration == currentStage3iteration_) {
+        trackStage(cs::StageTiming::Kind::Stage3, stage.sender);
+    }
+
+    cs::RoundTrace::instance().instant("stage-3 received", cs::RoundTrace::Track::Stages, stage.sender);
+
     auto lamda = [this](const cs::StageThree& stageFrom, const cs::StageThree& stageTo) {
         const cs::Conveyer& conveyer = cs::Conveyer::instance();
         bool markedUntrusted = false;
@@ -0,0 +1,138 @@
+#include <stagetiming.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <consensus.hpp>
+
+namespace cs {
+
+void StageTiming::startRound(Clock::time_point now) {
+    ++rounds_;
+
+    for (auto& waiting : waiting_) {
+        waiting.start.reset();
+        waiting.early.clear();
+        waiting.arrived.clear();
+    }
+
+    for (auto it = averages_.begin(); it != averages_.end();) {
+        if (it->second.lastRound + ForgetRounds < rounds_) {
+            it = averages_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // hashes are awaited from the round start
+    startWaiting(Kind::Hash, now);
+}
+
+void StageTiming::startWaiting(Kind kind, Clock::time_point now) {
+    auto& waiting = waiting_[index(kind)];
+
+    // state may be entered again on the same round, the first entering counts
+    if (waiting.start.has_value()) {
+        return;
+    }
+
+    waiting.start = now;
+
+    for (const auto& sender : waiting.early) {
+        record(kind, sender, 0.0);
+    }
+
+    waiting.early.clear();
+}
+
+void StageTiming::onArrival(Kind kind, const cs::PublicKey& sender, Clock::time_point now) {
+    auto& waiting = waiting_[index(kind)];
+
+    if (!waiting.arrived.insert(sender).second) {
+        return;
+    }
+
+    if (!waiting.start.has_value()) {
+        waiting.early.push_back(sender);
+        return;
+    }
+
+    const auto latency = std::chrono::duration<double, std::milli>(std::max(now - waiting.start.value(), Clock::duration::zero()));
+    record(kind, sender, latency.count());
+}
+
+uint32_t StageTiming::minStage1Time() const {
+    const auto estimate = percentile(Kind::Hash, 0.9);
+
+    if (!estimate.has_value()) {
+        return Consensus::T_min_stage1;
+    }
+
+    const auto value = static_cast<uint32_t>(std::ceil(estimate.value()));
+    return std::clamp(value, Consensus::T_min_stage1_lower, Consensus::T_min_stage1);
+}
+
+uint32_t StageTiming::requestTimeout(Kind kind, const std::vector<cs::PublicKey>& confidants, uint32_t fallback) const {
+    auto estimate = percentile(kind, 0.95);
+
+    if (!estimate.has_value()) {
+        return fallback;
+    }
+
+    // the slowest of current confidants may be slower than the most of senders
+    for (const auto& confidant : confidants) {
+        const auto value = average(kind, confidant);
+
+        if (value.has_value()) {
+            estimate = std::max(estimate.value(), value.value());
+        }
+    }
+
+    const auto value = static_cast<uint32_t>(std::ceil(estimate.value() * TimeoutMargin));
+    return std::clamp(value, Consensus::T_stage_request_lower, Consensus::T_stage_request_upper);
+}
+
+std::optional<double> StageTiming::percentile(Kind kind, double rank) const {
+    const auto& samples = samples_[index(kind)];
+
+    if (samples.count < MinSamples) {
+        return std::nullopt;
+    }
+
+    std::vector<double> values(samples.values.begin(), samples.values.begin() + static_cast<std::ptrdiff_t>(samples.count));
+
+    const auto position = static_cast<size_t>(std::clamp(rank, 0.0, 1.0) * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(position), values.end());
+
+    return values[position];
+}
+
+std::optional<double> StageTiming::average(Kind kind, const cs::PublicKey& sender) const {
+    const auto it = averages_.find(sender);
+
+    if (it == averages_.end()) {
+        return std::nullopt;
+    }
+
+    return it->second.values[index(kind)];
+}
+
+size_t StageTiming::samplesCount(Kind kind) const {
+    return samples_[index(kind)].count;
+}
+
+void StageTiming::record(Kind kind, const cs::PublicKey& sender, double latency) {
+    auto& samples = samples_[index(kind)];
+    samples.values[samples.next] = latency;
+    samples.next = (samples.next + 1) % SamplesCount;
+    samples.count = std::min(samples.count + 1, SamplesCount);
+
+    auto& average = averages_[sender];
+    auto& value = average.values[index(kind)];
+
+    value = value.has_value() ? value.value() + Alpha * (latency - value.value()) : latency;
+    average.lastRound = rounds_;
+}
+
+}  // namespace cs
@@ -12,6 +12,7 @@ namespace cs {
 
 void TrustedPostStageState::on(SolverContext& context) {
     DefaultStateBehavior::on(context);
+    context.stage_timing().startWaiting(StageTiming::Kind::Stage3);
 
     cnt_recv_stages = 0;
     //// decide to write
@@ -39,24 +40,25 @@ void TrustedPostStageState::on(SolverContext& context) {
     }
 
     SolverContext* pctx = &context;
+    const auto dt = context.stage_timing().requestTimeout(StageTiming::Kind::Stage3, context.trusted(), Consensus::T_stage_request);
     csdebug() << name() << ": start track timeout " << 0 << " ms of stages-3 received";
     timeout_request_stage.start(context.scheduler(), 0,
                                 // timeout #1 handler:
-                                [pctx, this]() {
+                                [pctx, this, dt]() {
                                     csdebug() << name() << ": direct request for absent stages-3";
                                     request_stages(*pctx);
                                     // start subsequent track timeout for "wide" request
-                                    csdebug() << name() << ": start subsequent track timeout " << Consensus::T_stage_request << " ms to request neighbors about stages-3";
+                                    csdebug() << name() << ": start subsequent track timeout " << dt << " ms to request neighbors about stages-3";
                                     timeout_request_neighbors.start(
-                                        pctx->scheduler(), Consensus::T_stage_request,
+                                        pctx->scheduler(), dt,
                                         // timeout #2 handler:
-                                        [pctx, this]() {
+                                        [pctx, this, dt]() {
                                             csdebug() << name() << ": timeout for transition is expired, make requests to neighbors";
                                             request_stages_neighbors(*pctx);
                                             // timeout #3 handler
-                                            csdebug() << name() << ": start subsequent track timeout " << Consensus::T_stage_request << " ms to give up in receiving stages-3";
+                                            csdebug() << name() << ": start subsequent track timeout " << dt << " ms to give up in receiving stages-3";
                                             timeout_force_transition.start(
-                                                pctx->scheduler(), Consensus::T_stage_request,
+                                                pctx->scheduler(), dt,
                                                 [pctx, this]() {
                                                     csdebug() << name() << ": timeout for transition is expired, mark silent nodes as outbound and recalculate the signatures";
                                                     mark_outbound_nodes(*pctx);
@@ -7,6 +7,7 @@
 #include <csnode/blockchain.hpp>
 #include <csnode/conveyer.hpp>
 #include <csnode/itervalidator.hpp>
+#include <csnode/roundtrace.hpp>
 #include <csnode/transactionspacket.hpp>
 #include <csnode/walletscache.hpp>
 #include <lib/system/logger.hpp>
@@ -15,6 +16,8 @@
 #include <csnode/datastream.hpp>
 #include <cscrypto/cscrypto.hpp>
 
+#include <algorithm>
+
 namespace cs {
 void TrustedStage1State::on(SolverContext& context) {
     if (!pValidator_) {
@@ -29,7 +32,7 @@ void TrustedStage1State::on(SolverContext& context) {
     min_time_expired = false;
 
     SolverContext* pctx = &context;
-    auto dt = Consensus::T_min_stage1;
+    auto dt = context.stage_timing().minStage1Time();
     csdebug() << name() << ": start track min time " << dt << " ms to get hashes";
 
     cs::Timer::singleShot(dt, cs::RunPolicy::CallQueuePolicy, [this, pctx]() {
@@ -124,18 +127,33 @@ Result TrustedStage1State::onSyncTransactions(SolverContext& context, cs::RoundN
     {
         std::unique_lock<cs::SharedMutex> lock = conveyer.lock();
         const cs::RoundTable& roundTable = conveyer.currentRoundTable();
+        const cs::PacketsHashesSet roundHashes(roundTable.hashes.cbegin(), roundTable.hashes.cend());
+
+        // packets table is not ordered, all trusted nodes propose the least hashes to agree on the same ones,
+        // so the least of them are kept in max heap
+        cs::PacketsHashes candidates;
+        candidates.reserve(Consensus::MaxStageOneHashes + 2);
 
         for (const auto& element : conveyer.transactionsPacketTable()) {
-            const cs::PacketsHashes& hashes = roundTable.hashes;
+            if (candidates.size() > Consensus::MaxStageOneHashes && !(element.first < candidates.front())) {
+                continue;
+            }
 
-            if (std::find(hashes.cbegin(), hashes.cend(), element.first) == hashes.cend()) {
-                stage.hashesCandidates.push_back(element.first);
+            if (roundHashes.find(element.first) != roundHashes.cend()) {
+                continue;
+            }
+
+            candidates.push_back(element.first);
+            std::push_heap(candidates.begin(), candidates.end());
 
-                if (stage.hashesCandidates.size() > Consensus::MaxStageOneHashes) {
-                    break;
-                }
+            if (candidates.size() > Consensus::MaxStageOneHashes + 1) {
+                std::pop_heap(candidates.begin(), candidates.end());
+                candidates.pop_back();
             }
         }
+
+        std::sort_heap(candidates.begin(), candidates.end());
+        stage.hashesCandidates.insert(stage.hashesCandidates.end(), candidates.begin(), candidates.end());
     }
 
     transactions_checked = true;
@@ -178,6 +196,7 @@ cs::Hash TrustedStage1State::build_vector(SolverContext& context, cs::Transactio
     cs::Characteristic characteristic;
 
     if (transactionsCount > 0) {
+        cs::RoundTraceScope trace("iter validation", cs::RoundTrace::Track::Solver, static_cast<int32_t>(transactionsCount));
         characteristic = pValidator_->formCharacteristic(context, packet.transactions(), smartsPackets);
     }
     if (characteristic.mask.size() != transactionsCount) {
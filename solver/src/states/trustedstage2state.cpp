@@ -15,6 +15,7 @@ namespace cs {
 
 void TrustedStage2State::on(SolverContext& context) {
     DefaultStateBehavior::on(context);
+    context.stage_timing().startWaiting(StageTiming::Kind::Stage1);
     cnt_recv_stages = 0;
     context.init_zero(stage);
     stage.sender = context.own_conf_number();
@@ -52,7 +53,7 @@ void TrustedStage2State::on(SolverContext& context) {
 
     SolverContext* pctx = &context;
 
-    auto dt = Consensus::T_stage_request;
+    auto dt = context.stage_timing().requestTimeout(StageTiming::Kind::Stage1, context.trusted(), Consensus::T_stage_request);
     // increase dt in case of large trx amount:
     cs::Conveyer& conveyer = cs::Conveyer::instance();
     const cs::Characteristic * characteristic = conveyer.characteristic(conveyer.currentRoundNumber());
@@ -21,6 +21,7 @@ namespace cs {
 
 void TrustedStage3State::on(SolverContext& context) {
     DefaultStateBehavior::on(context);
+    context.stage_timing().startWaiting(StageTiming::Kind::Stage2);
     if (!context.realTrustedChanged()) {
         stage.iteration = 0;
         stage.realTrustedMask.clear();
@@ -79,7 +80,7 @@ void TrustedStage3State::on(SolverContext& context) {
     //  - create fake stages-2 from outbound nodes and force to next state
 
     SolverContext* pctx = &context;
-    auto dt = 2 * Consensus::T_stage_request;
+    auto dt = context.stage_timing().requestTimeout(StageTiming::Kind::Stage2, context.trusted(), 2 * Consensus::T_stage_request);
     csdebug() << name() << ": start track timeout " << 0 << " ms of stages-2 received";
     timeout_request_stage.start(context.scheduler(), 0,  // no timeout
                                 // timeout #1 handler:
@@ -398,7 +399,7 @@ void TrustedStage3State::trusted_election(SolverContext& context) {
     std::map<cs::PublicKey, uint8_t> candidatesElection;
     size_t myPacks = 0;
     std::vector<cs::TransactionsPacketHash> myHashes;
-    std::map<cs::TransactionsPacketHash, uint8_t> hashesElection;
+    std::unordered_map<cs::TransactionsPacketHash, uint8_t> hashesElection;
     std::vector<cs::TransactionsPacketHash> myRejectedHashes;
     const uint8_t cnt_trusted = std::min(static_cast<uint8_t>(context.cnt_trusted()), static_cast<uint8_t>(Consensus::MaxTrustedNodes));
     uint8_t cr = cnt_trusted / 2;
@@ -438,12 +439,7 @@ void TrustedStage3State::trusted_election(SolverContext& context) {
             csdebug() << "Hashes amount of [" << static_cast<int>(i) << "]: " << static_cast<int>(hashes_amount);
             for (uint32_t j = 0; j < hashes_amount; j++) {
                 // csdebug() << (int)i << "." << j << " " << cs::Utils::byteStreamToHex(stage_i.hashesCandidates.at(j).toBinary().data(), cscrypto::kHashSize);
-                if (hashesElection.count(stage_i.hashesCandidates.at(j)) > 0) {
-                    hashesElection.at(stage_i.hashesCandidates.at(j)) += 1;
-                }
-                else {
-                    hashesElection.emplace(stage_i.hashesCandidates.at(j), uint8_t(1));
-                }
+                ++hashesElection[stage_i.hashesCandidates.at(j)];
             }
         }
         else {
@@ -483,6 +479,9 @@ void TrustedStage3State::trusted_election(SolverContext& context) {
             cs::Conveyer::instance().addRejectedHashToCache(it.first);
         }
     }
+
+    // election table is not ordered, round table hashes must be the same on all trusted nodes
+    std::sort(next_round_hashes.begin(), next_round_hashes.end());
     size_t acceptedPacks = 0;
     for (const auto& hash : myHashes) {
         bool rejectedFound = true;
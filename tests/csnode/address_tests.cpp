@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+
+#include "testutils.hpp"
+
+TEST(Address, IsValueType) {
+    static_assert(std::is_trivially_copyable_v<csdb::Address>);
+
+    const auto address = csdb::Address::from_public_key(makeKey(1));
+    auto copy = address;
+    auto clone = address.clone();
+
+    copy = csdb::Address::from_wallet_id(5);
+
+    ASSERT_EQ(clone, address);
+    ASSERT_NE(copy, address);
+    ASSERT_EQ(address.public_key(), makeKey(1));
+    ASSERT_EQ(copy.wallet_id(), 5);
+}
+
+TEST(Address, HashIsKept) {
+    const auto key = csdb::Address::from_public_key(makeKey(2));
+    const auto id = csdb::Address::from_wallet_id(7);
+
+    ASSERT_EQ(key.calcHash(), boost::hash_value(makeKey(2)));
+    ASSERT_EQ(id.calcHash(), boost::hash_value(csdb::Address::WalletId(7)));
+    ASSERT_EQ(csdb::Address{}.calcHash(), boost::hash_value(cs::PublicKey{}));
+
+    ASSERT_EQ(csdb::Address::from_string(key.to_string()).calcHash(), key.calcHash());
+    ASSERT_EQ(csdb::Address::from_string(id.to_string()).calcHash(), id.calcHash());
+    ASSERT_EQ(csdb::Address::from_string(key.to_string()), key);
+    ASSERT_EQ(csdb::Address::from_string(id.to_string()), id);
+
+    std::unordered_map<csdb::Address, int> hashed{{key, 1}, {id, 2}};
+    std::map<csdb::Address, int> ordered{{key, 1}, {id, 2}};
+
+    ASSERT_EQ(hashed[csdb::Address::from_public_key(makeKey(2))], 1);
+    ASSERT_EQ(hashed[csdb::Address::from_wallet_id(7)], 2);
+    ASSERT_EQ(ordered[csdb::Address::from_public_key(makeKey(2))], 1);
+    ASSERT_EQ(ordered[csdb::Address::from_wallet_id(7)], 2);
+}
+
+TEST(Address, DecodedFromTransaction) {
+    csdb::Transaction transaction;
+    transaction.set_innerID(1);
+    transaction.set_source(csdb::Address::from_public_key(makeKey(3)));
+    transaction.set_target(csdb::Address::from_wallet_id(9));
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(1, 0));
+
+    const auto decoded = csdb::Transaction::from_binary(transaction.to_byte_stream());
+
+    ASSERT_TRUE(decoded.is_valid());
+    ASSERT_EQ(decoded.source(), transaction.source());
+    ASSERT_EQ(decoded.source().calcHash(), transaction.source().calcHash());
+    ASSERT_EQ(decoded.target().wallet_id(), 9);
+    ASSERT_EQ(decoded.target().calcHash(), transaction.target().calcHash());
+    ASSERT_EQ(decoded.to_byte_stream(), transaction.to_byte_stream());
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <csdb/pool.hpp>
+
+#include <csnode/blockscache.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+namespace fs = boost::filesystem;
+
+std::size_t sizeOf(csdb::Pool& pool) {
+    uint32_t size = 0;
+    pool.to_byte_stream(size);
+    return size;
+}
+
+fs::path makeDirectory() {
+    return fs::temp_directory_path() / fs::unique_path("cs-blocks-tests-%%%%-%%%%");
+}
+}  // namespace
+
+TEST(BlocksCache, SpillsBlocksOverMemoryLimit) {
+    constexpr cs::Sequence kCount = 4000;
+    constexpr std::size_t kResident = 100;
+
+    auto chain = makeChain(kCount);
+    const auto directory = makeDirectory();
+
+    {
+        cs::BlocksCache cache(sizeOf(chain.front()) * kResident, directory);
+
+        // the farthest blocks come first like ones got by sync from the tail
+        for (auto sequence = kCount; sequence > 1; --sequence) {
+            ASSERT_TRUE(cache.insert(sequence - 1, chain[sequence - 1], sequence % 2 == 0));
+            ASSERT_LE(cache.memoryBytes(), cache.memoryLimit());
+        }
+
+        ASSERT_FALSE(cache.insert(kCount / 2, chain[kCount / 2], false));
+        ASSERT_EQ(cache.size(), kCount - 1);
+        ASSERT_GT(cache.spilledCount(), kCount - 1 - kResident * 2);
+        ASSERT_TRUE(fs::exists(directory));
+
+        ASSERT_EQ(cache.first().value(), 1);
+        ASSERT_EQ(cache.last().value(), kCount - 1);
+
+        for (cs::Sequence sequence = 1; sequence < kCount; ++sequence) {
+            auto item = cache.extract(sequence);
+
+            ASSERT_TRUE(item.has_value());
+            ASSERT_TRUE(item->pool.is_valid());
+            ASSERT_EQ(item->pool.sequence(), sequence);
+            ASSERT_EQ(item->pool.hash(), chain[sequence].hash());
+            ASSERT_EQ(item->bySync, (sequence + 1) % 2 == 0);
+            ASSERT_LE(cache.memoryBytes(), cache.memoryLimit());
+        }
+
+        ASSERT_TRUE(cache.empty());
+        ASSERT_EQ(cache.memoryBytes(), 0);
+        ASSERT_EQ(cache.spilledCount(), 0);
+        ASSERT_EQ(cache.spilledBytes(), 0);
+    }
+
+    ASSERT_FALSE(fs::exists(directory));
+}
+
+TEST(BlocksCache, RangesIncludeSpilledBlocks) {
+    auto chain = makeChain(200);
+    const auto directory = makeDirectory();
+
+    {
+        cs::BlocksCache cache(sizeOf(chain.back()) * 10, directory);
+
+        for (cs::Sequence sequence = 10; sequence < 50; ++sequence) {
+            cache.insert(sequence, chain[sequence], false);
+        }
+
+        for (cs::Sequence sequence = 100; sequence < 200; ++sequence) {
+            cache.insert(sequence, chain[sequence], true);
+        }
+
+        ASSERT_GT(cache.spilledCount(), 0);
+
+        const auto ranges = cache.ranges();
+        ASSERT_EQ(ranges.size(), 2);
+        ASSERT_EQ(ranges[0], std::make_pair(cs::Sequence(10), cs::Sequence(49)));
+        ASSERT_EQ(ranges[1], std::make_pair(cs::Sequence(100), cs::Sequence(199)));
+
+        // spilled files of removed blocks are deleted, the nearest spilled ones are read back to memory
+        cache.eraseBefore(150);
+        ASSERT_EQ(cache.size(), 50);
+        ASSERT_EQ(cache.first().value(), 150);
+        ASSERT_EQ(cache.spilledCount(), 40);
+        ASSERT_LE(cache.memoryBytes(), cache.memoryLimit());
+
+        ASSERT_FALSE(cache.extract(10).has_value());
+        ASSERT_TRUE(cache.extract(199).has_value());
+        ASSERT_EQ(cache.ranges().back().second, 198);
+
+        // a larger limit loads all blocks back
+        cache.setMemoryLimit(cs::BlocksCache::kDefaultMemoryLimit);
+        ASSERT_EQ(cache.spilledCount(), 0);
+        ASSERT_EQ(cache.spilledBytes(), 0);
+        ASSERT_EQ(cache.size(), 49);
+    }
+
+    ASSERT_FALSE(fs::exists(directory));
+}
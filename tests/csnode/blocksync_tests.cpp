@@ -0,0 +1,349 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <csdb/pool.hpp>
+
+#include <csnode/blockapplier.hpp>
+#include <csnode/syncwindow.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+using Clock = cs::SyncWindow::Clock;
+
+std::set<cs::Sequence> collect(const std::vector<cs::SyncWindow::Request>& requests) {
+    std::set<cs::Sequence> result;
+
+    for (const auto& request : requests) {
+        result.insert(request.sequences.begin(), request.sequences.end());
+    }
+
+    return result;
+}
+}  // namespace
+
+TEST(SyncWindow, SpreadsRequestsAcrossPeers) {
+    cs::SyncWindow window(10, 2.0);
+    window.setPeers({{makeKey(1), 1000}, {makeKey(2), 1000}, {makeKey(3), 1000}});
+    window.setRange(1, 1000);
+
+    const auto requests = window.schedule();
+    ASSERT_EQ(requests.size(), 6);
+
+    for (uint8_t i = 1; i <= 3; ++i) {
+        const auto count = std::count_if(requests.begin(), requests.end(), [&](const auto& request) { return request.peer == makeKey(i); });
+        ASSERT_EQ(count, 2);
+    }
+
+    const auto sequences = collect(requests);
+    ASSERT_EQ(sequences.size(), 60);
+    ASSERT_EQ(*sequences.begin(), 1);
+    ASSERT_EQ(*sequences.rbegin(), 60);
+
+    ASSERT_TRUE(window.schedule().empty());
+}
+
+TEST(SyncWindow, RequestsRespectPeerLastSequence) {
+    cs::SyncWindow window(10, 4.0);
+    window.setPeers({{makeKey(1), 15}, {makeKey(2), 1000}});
+    window.setRange(1, 100);
+
+    for (const auto& request : window.schedule()) {
+        if (request.peer == makeKey(1)) {
+            ASSERT_LE(request.sequences.back(), 15);
+        }
+    }
+}
+
+TEST(SyncWindow, WindowGrowsOnReplyAndHalvesOnTimeout) {
+    const auto peer = makeKey(1);
+    const auto now = Clock::now();
+
+    cs::SyncWindow window(5, 2.0);
+    window.setPeers({{peer, 1000}});
+    window.setRange(1, 1000);
+
+    const auto requests = window.schedule(now);
+    ASSERT_EQ(requests.size(), 2);
+
+    ASSERT_TRUE(window.onReply(requests.front().id, requests.front().sequences, now + std::chrono::milliseconds(10)));
+    ASSERT_DOUBLE_EQ(window.peerState(peer)->window, 3.0);
+    ASSERT_TRUE(window.peerState(peer)->isMeasured);
+
+    // the second one is lost
+    ASSERT_EQ(window.expire(now + std::chrono::seconds(60)), 1);
+    ASSERT_DOUBLE_EQ(window.peerState(peer)->window, 1.5);
+    ASSERT_EQ(window.peerState(peer)->timeouts, 1);
+
+    const auto retry = window.schedule(now + std::chrono::seconds(60));
+    ASSERT_EQ(retry.size(), 1);
+    ASSERT_EQ(retry.front().sequences, requests.back().sequences);
+}
+
+TEST(SyncWindow, LateReplyIsNotRequestedAgain) {
+    const auto now = Clock::now();
+
+    cs::SyncWindow window(5, 1.0);
+    window.setPeers({{makeKey(1), 1000}});
+    window.setRange(1, 10);
+
+    const auto first = window.schedule(now);
+    ASSERT_EQ(first.size(), 1);
+    ASSERT_EQ(window.expire(now + cs::SyncWindow::kInitialTimeout), 1);
+
+    ASSERT_FALSE(window.onReply(first.front().id, first.front().sequences, now + cs::SyncWindow::kInitialTimeout));
+
+    const auto second = window.schedule(now + cs::SyncWindow::kInitialTimeout);
+    ASSERT_EQ(second.size(), 1);
+    ASSERT_EQ(second.front().sequences.front(), 6);
+}
+
+TEST(SyncWindow, RejectedSequenceIsRequestedAgain) {
+    cs::SyncWindow window(5, 1.0);
+    window.setPeers({{makeKey(1), 1000}});
+    window.setRange(1, 10);
+
+    const auto first = window.schedule();
+    ASSERT_TRUE(window.onReply(first.front().id, first.front().sequences));
+
+    window.onRejected(3);
+
+    const auto second = window.schedule();
+    ASSERT_FALSE(second.empty());
+    ASSERT_EQ(second.front().sequences.front(), 3);
+}
+
+TEST(BlockApplier, AppliesOutOfOrderBlocksInOrder) {
+    constexpr cs::Sequence kLength = 200;
+    const auto chain = makeChain(kLength);
+
+    std::vector<cs::Sequence> stored;
+
+    cs::BlockApplier applier([](const csdb::Pool&) { return true; },
+                             [&](csdb::Pool& pool) {
+                                 stored.push_back(pool.sequence());
+                                 return true;
+                             });
+
+    std::vector<cs::Sequence> order(kLength);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    for (const auto sequence : order) {
+        ASSERT_TRUE(applier.push(chain[sequence].clone()));
+    }
+
+    ASSERT_TRUE(applier.wait(kLength - 1, std::chrono::seconds(10)));
+    ASSERT_EQ(applier.appliedCount(), kLength);
+    ASSERT_EQ(applier.size(), 0);
+    ASSERT_TRUE(std::is_sorted(stored.begin(), stored.end()));
+    ASSERT_FALSE(applier.push(chain.front().clone()));
+}
+
+TEST(BlockApplier, RejectedBlockWaitsForNewOne) {
+    const auto chain = makeChain(10);
+
+    std::atomic<bool> isRejected = false;
+    std::atomic<cs::Sequence> rejected = 0;
+
+    cs::BlockApplier applier([&](const csdb::Pool& pool) { return pool.sequence() != 5 || isRejected.exchange(true); },
+                             [](csdb::Pool&) { return true; });
+
+    cs::Connector::connect(&applier.rejected, [&](const cs::Sequence sequence) { rejected = sequence; });
+
+    for (const auto& pool : chain) {
+        applier.push(pool.clone());
+    }
+
+    ASSERT_FALSE(applier.wait(9, std::chrono::milliseconds(200)));
+    ASSERT_EQ(applier.next(), 5);
+    ASSERT_EQ(rejected, 5);
+
+    ASSERT_TRUE(applier.push(chain[5].clone()));
+    ASSERT_TRUE(applier.wait(9, std::chrono::seconds(10)));
+}
+
+TEST(BlockApplier, AdvanceFromStoreKeepsNextBlock) {
+    constexpr cs::Sequence kLength = 10;
+    const auto chain = makeChain(kLength);
+
+    std::vector<cs::Sequence> stored;
+    cs::BlockApplier* self = nullptr;
+
+    // as blockchain store event reports the new last sequence
+    cs::BlockApplier applier([](const csdb::Pool&) { return true; },
+                             [&](csdb::Pool& pool) {
+                                 stored.push_back(pool.sequence());
+                                 self->advance(pool.sequence() + 1);
+                                 return true;
+                             });
+
+    self = &applier;
+
+    for (const auto& pool : chain) {
+        ASSERT_TRUE(applier.push(pool.clone()));
+    }
+
+    ASSERT_TRUE(applier.wait(kLength - 1, std::chrono::seconds(10)));
+    ASSERT_EQ(applier.next(), kLength);
+    ASSERT_EQ(applier.appliedCount(), kLength);
+    ASSERT_EQ(stored.size(), kLength);
+
+    for (cs::Sequence sequence = 0; sequence < kLength; ++sequence) {
+        ASSERT_EQ(stored[sequence], sequence);
+    }
+}
+
+// sync window and reorder buffer against simulated peers with latency and lost requests,
+// virtual clock makes the run deterministic
+TEST(BlockSync, CatchUpFromSimulatedPeers) {
+    constexpr cs::Sequence kLength = 5000;
+    constexpr auto kStep = std::chrono::microseconds(100);
+    constexpr std::size_t kMaxSteps = 1'000'000;
+
+    const auto chain = makeChain(kLength);
+
+    struct PeerLink {
+        cs::PublicKey key;
+        std::chrono::microseconds latency;
+        std::set<std::size_t> lostRequests;
+        std::size_t requests = 0;
+    };
+
+    std::vector<PeerLink> links = {{makeKey(1), std::chrono::microseconds(500), {}},
+                                   {makeKey(2), std::chrono::microseconds(2000), {}},
+                                   {makeKey(3), std::chrono::microseconds(5000), {}},
+                                   {makeKey(4), std::chrono::microseconds(20000), {5, 9}}};
+
+    struct Reply {
+        Clock::time_point due;
+        cs::SyncWindow::RequestId id;
+        cs::PoolsRequestedSequences sequences;
+
+        bool operator>(const Reply& other) const {
+            return due > other.due || (due == other.due && id > other.id);
+        }
+    };
+
+    std::priority_queue<Reply, std::vector<Reply>, std::greater<Reply>> network;
+
+    csdb::PoolHash lastHash = chain.front().hash();
+    std::atomic<uint64_t> outOfOrder = 0;
+
+    cs::BlockApplier applier(
+        [&](const csdb::Pool& pool) {
+            if (pool.previous_hash() != lastHash) {
+                ++outOfOrder;
+                return false;
+            }
+
+            return true;
+        },
+        [&](csdb::Pool& pool) {
+            lastHash = pool.hash();
+            return true;
+        });
+
+    // target node has genesis block only
+    applier.reset(1);
+
+    cs::SyncWindow window(25);
+
+    std::vector<cs::SyncWindow::Peer> peers;
+    for (const auto& link : links) {
+        peers.push_back(cs::SyncWindow::Peer{link.key, kLength - 1});
+    }
+
+    window.setPeers(peers);
+
+    std::set<cs::Sequence> delivered;
+    cs::Sequence contiguous = 0;
+    Clock::time_point now;
+
+    for (std::size_t step = 0; applier.next() < kLength; ++step) {
+        ASSERT_LT(step, kMaxSteps);
+
+        // the same bound as pool synchronizer uses, reorder buffer never overflows
+        const cs::Sequence next = applier.next();
+        window.setRange(next, std::min(kLength - 1, next + cs::BlockApplier::kDefaultCapacity - 1));
+
+        std::map<cs::PublicKey, std::size_t> inFlight;
+        for (const auto& link : links) {
+            inFlight[link.key] = window.peerState(link.key)->inFlight;
+        }
+
+        for (auto& request : window.schedule(now)) {
+            auto link = std::find_if(links.begin(), links.end(), [&](const auto& item) { return item.key == request.peer; });
+            ASSERT_NE(link, links.end());
+
+            // new request is sent only while peer has room in its window
+            const auto state = window.peerState(request.peer);
+            ASSERT_LT(inFlight[request.peer]++, static_cast<std::size_t>(state->window));
+            ASSERT_GE(state->window, cs::SyncWindow::kMinWindow);
+            ASSERT_LE(state->window, cs::SyncWindow::kMaxWindow);
+
+            for (const auto sequence : request.sequences) {
+                ASSERT_GE(sequence, next);
+                ASSERT_LT(sequence, next + cs::BlockApplier::kDefaultCapacity);
+            }
+
+            if (link->lostRequests.count(++link->requests)) {
+                continue;
+            }
+
+            network.push(Reply{now + link->latency, request.id, std::move(request.sequences)});
+        }
+
+        while (!network.empty() && network.top().due <= now) {
+            const Reply reply = network.top();
+            network.pop();
+
+            window.onReply(reply.id, reply.sequences, now);
+
+            // blocks of one reply are shuffled as they come by separate packets
+            auto sequences = reply.sequences;
+            std::shuffle(sequences.begin(), sequences.end(), std::mt19937(static_cast<uint32_t>(reply.id)));
+
+            for (const auto sequence : sequences) {
+                applier.push(chain[sequence].clone());
+                delivered.insert(sequence);
+            }
+
+            ASSERT_LE(applier.size(), cs::BlockApplier::kDefaultCapacity);
+        }
+
+        while (delivered.count(contiguous + 1)) {
+            ++contiguous;
+        }
+
+        // apply thread catches up with every block it can before the next step
+        if (contiguous >= applier.next()) {
+            ASSERT_TRUE(applier.wait(contiguous, std::chrono::seconds(30)));
+        }
+
+        window.expire(now);
+        now += kStep;
+    }
+
+    ASSERT_EQ(applier.appliedCount(), kLength - 1);
+    ASSERT_EQ(outOfOrder, 0);
+    ASSERT_EQ(lastHash, chain.back().hash());
+    ASSERT_EQ(delivered.size(), kLength - 1);
+
+    for (const auto& link : links) {
+        const auto state = window.peerState(link.key);
+        ASSERT_NE(state, nullptr);
+        ASSERT_GT(state->replies, 0);
+    }
+
+    ASSERT_GT(window.peerState(links.back().key)->timeouts, 0);
+}
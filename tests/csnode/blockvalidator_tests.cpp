@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <csdb/address.hpp>
+#include <csdb/pool.hpp>
+
+#include <csnode/blockchain.hpp>
+#include <csnode/blockvalidator.hpp>
+#include <csnode/blockvalidatorplugins.hpp>
+
+namespace {
+namespace fs = boost::filesystem;
+
+const csdb::Address kGenesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address kStartAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+fs::path makeDirectory() {
+    return fs::temp_directory_path() / fs::unique_path("cs-validator-tests-%%%%-%%%%");
+}
+
+// concurrent signatures check which fails after other plugins had time to start
+class FailingSignatures : public cs::ValidationPlugin {
+public:
+    using cs::ValidationPlugin::ValidationPlugin;
+
+    ErrorType validateBlock(const csdb::Pool&) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return ErrorType::error;
+    }
+
+    bool isConcurrent() const override {
+        return true;
+    }
+};
+
+// scheduled as the real stateful plugin, records a call instead of changing wallets state
+template <typename Plugin>
+class StateRecorder : public cs::ValidationPlugin {
+public:
+    template <typename... Args>
+    StateRecorder(cs::BlockValidator& validator, std::atomic<size_t>& calls, Args&&... args)
+    : cs::ValidationPlugin(validator)
+    , plugin_(validator, std::forward<Args>(args)...)
+    , calls_(calls) {
+    }
+
+    ErrorType validateBlock(const csdb::Pool&) override {
+        ++calls_;
+        return ErrorType::noError;
+    }
+
+    cs::BlockValidator::ValidationFlags dependencies() const override {
+        return plugin_.dependencies();
+    }
+
+    bool isConcurrent() const override {
+        return plugin_.isConcurrent();
+    }
+
+private:
+    Plugin plugin_;
+    std::atomic<size_t>& calls_;
+};
+
+void validate(size_t threadsCount, bool signaturesFail, size_t expectedCalls) {
+    const auto directory = makeDirectory();
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+        ASSERT_TRUE(blockchain.init(directory.string()));
+
+        csdb::Pool block(blockchain.getLastHash(), 1);
+        ASSERT_TRUE(block.compose());
+
+        cs::BlockValidator validator(blockchain, threadsCount);
+        std::atomic<size_t> calls = 0;
+
+        if (signaturesFail) {
+            validator.setPlugin(cs::BlockValidator::blockSignatures, std::make_unique<FailingSignatures>(validator));
+        }
+
+        validator.setPlugin(cs::BlockValidator::balances, std::make_unique<StateRecorder<cs::BalanceChecker>>(validator, calls));
+        validator.setPlugin(cs::BlockValidator::accountBalance, std::make_unique<StateRecorder<cs::AccountBalanceChecker>>(
+                                                                    validator, calls, "HtimoDtTYGSVotnQ5Eo4eud3FkDv5r2QYiKSZcdWP7Z8"));
+
+        const cs::BlockValidator::ValidationFlags flags = cs::BlockValidator::hashIntergrity | cs::BlockValidator::blockNum |
+                                                          cs::BlockValidator::blockSignatures | cs::BlockValidator::balances |
+                                                          cs::BlockValidator::accountBalance;
+
+        ASSERT_EQ(validator.validateBlock(block, flags), !signaturesFail);
+        ASSERT_EQ(calls.load(), expectedCalls);
+
+        blockchain.close();
+    }
+
+    fs::remove_all(directory);
+}
+}  // namespace
+
+TEST(BlockValidator, FailedSignaturesLeaveWalletsUntouched) {
+    validate(4, true, 0);
+}
+
+TEST(BlockValidator, FailedSignaturesLeaveWalletsUntouchedSequentially) {
+    validate(1, true, 0);
+}
+
+TEST(BlockValidator, ValidBlockUpdatesWallets) {
+    validate(4, false, 2);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <solver/budgetcache.hpp>
+
+namespace {
+using Cache = cs::BudgetCache<int, std::string>;
+
+void put(Cache& cache, int key, size_t size, bool isPinned = false) {
+    cache.put(key, std::string(size, static_cast<char>('a' + key)), size, isPinned);
+}
+}  // namespace
+
+TEST(BudgetCache, EvictsLeastRecentlyUsed) {
+    Cache cache(300);
+
+    put(cache, 1, 100);
+    put(cache, 2, 100);
+    put(cache, 3, 100);
+    ASSERT_EQ(cache.bytes(), 300);
+
+    // 1 becomes the most recently used one
+    ASSERT_TRUE(cache.get(1).has_value());
+
+    put(cache, 4, 100);
+    ASSERT_EQ(cache.bytes(), 300);
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_TRUE(cache.contains(3));
+    ASSERT_TRUE(cache.contains(4));
+
+    ASSERT_FALSE(cache.get(2).has_value());
+    ASSERT_EQ(cache.hits(), 1);
+    ASSERT_EQ(cache.misses(), 1);
+}
+
+TEST(BudgetCache, ReplacedValueIsRecharged) {
+    Cache cache(300);
+
+    put(cache, 1, 100);
+    put(cache, 2, 100);
+    put(cache, 1, 50);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.bytes(), 150);
+    ASSERT_EQ(cache.get(1).value().size(), 50);
+
+    // a value larger than budget does not stay in cache
+    put(cache, 3, 400);
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.bytes(), 0);
+
+    put(cache, 1, 100);
+    cache.erase(1);
+    ASSERT_EQ(cache.bytes(), 0);
+}
+
+TEST(BudgetCache, PinnedValuesAreKept) {
+    Cache cache(200);
+
+    put(cache, 1, 100, true);
+    put(cache, 2, 100);
+    put(cache, 3, 100);
+
+    // the oldest unpinned value is evicted instead of the pinned one
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_TRUE(cache.contains(3));
+
+    // pinned values may exceed budget
+    put(cache, 4, 300, true);
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_TRUE(cache.contains(4));
+    ASSERT_FALSE(cache.contains(3));
+    ASSERT_EQ(cache.bytes(), 400);
+
+    // replacing value updates its pinned state
+    put(cache, 4, 300);
+    ASSERT_FALSE(cache.contains(4));
+    ASSERT_EQ(cache.bytes(), 100);
+
+    put(cache, 1, 100);
+    put(cache, 5, 150);
+    ASSERT_FALSE(cache.contains(1));
+    ASSERT_EQ(cache.bytes(), 150);
+}
+
+TEST(BudgetCache, LessBudgetEvicts) {
+    Cache cache(300);
+
+    put(cache, 1, 100, true);
+    put(cache, 2, 100);
+    put(cache, 3, 100);
+
+    cache.setBudget(150);
+    ASSERT_EQ(cache.budget(), 150);
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_FALSE(cache.contains(3));
+    ASSERT_EQ(cache.bytes(), 100);
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+
+#include <csnode/dispatchlanes.hpp>
+#include <csnode/packstream.hpp>
+#include <csnode/transactionspacket.hpp>
+
+#include <lib/system/structures.hpp>
+
+namespace {
+using Lane = cs::DispatchLanes::Lane;
+
+constexpr Lane kWorkerLanes[] = {Lane::Transactions, Lane::Sync, Lane::Smart};
+
+// runs calls queue as node thread does until condition is true
+template <typename Condition>
+bool callAllUntil(Condition condition, std::chrono::seconds timeout = std::chrono::seconds(10)) {
+    const auto end = std::chrono::steady_clock::now() + timeout;
+
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > end) {
+            return false;
+        }
+
+        CallsQueue::instance().callAll();
+        std::this_thread::yield();
+    }
+
+    return true;
+}
+
+cs::TransactionsPacket makePacket(int64_t innerId) {
+    csdb::Transaction transaction;
+    transaction.set_source(csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000007"));
+    transaction.set_target(csdb::Address::from_public_key(cs::PublicKey{}));
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10, 0));
+    transaction.set_innerID(innerId);
+
+    cs::TransactionsPacket packet;
+    packet.addTransaction(transaction);
+    packet.makeHash();
+
+    return packet;
+}
+
+// the same layout as OPackStream writes
+cs::Bytes toMessage(const cs::TransactionsPacket& packet) {
+    const cs::Bytes binary = packet.toBinary();
+    const size_t size = binary.size();
+
+    cs::Bytes message(sizeof(size));
+    std::memcpy(message.data(), &size, sizeof(size));
+    message.insert(message.end(), binary.begin(), binary.end());
+
+    return message;
+}
+}  // namespace
+
+TEST(DispatchLanes, MessagesMappedToLanes) {
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::TransactionPacket), Lane::Transactions);
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::TransactionsPacketReply), Lane::Transactions);
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::RequestedBlock), Lane::Sync);
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::SecondSmartStage), Lane::Smart);
+
+    // solver-facing messages stay on processor thread
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::RoundTable), Lane::Consensus);
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::FirstStage), Lane::Consensus);
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::TransactionsPacketRequest), Lane::Consensus);
+    ASSERT_EQ(cs::DispatchLanes::laneOf(MsgTypes::BlockRequest), Lane::Consensus);
+}
+
+TEST(DispatchLanes, LanesKeepOrderOffProcessorThread) {
+    constexpr size_t kTasks = 2000;
+
+    struct Record {
+        std::vector<size_t> order;
+        std::thread::id thread;
+        bool isSingleThread = true;
+        std::atomic<size_t> done = 0;
+    };
+
+    Record records[cs::DispatchLanes::LanesCount];
+
+    cs::DispatchLanes lanes;
+    const auto processor = std::this_thread::get_id();
+
+    for (size_t i = 0; i < kTasks; ++i) {
+        for (size_t lane = 0; lane < cs::DispatchLanes::LanesCount; ++lane) {
+            auto& record = records[lane];
+
+            ASSERT_TRUE(lanes.post(static_cast<Lane>(lane), [&record, i] {
+                if (record.order.empty()) {
+                    record.thread = std::this_thread::get_id();
+                }
+
+                record.isSingleThread = record.isSingleThread && record.thread == std::this_thread::get_id();
+                record.order.push_back(i);
+                ++record.done;
+            }));
+        }
+    }
+
+    // consensus lane runs in place
+    ASSERT_EQ(records[static_cast<size_t>(Lane::Consensus)].done, kTasks);
+    ASSERT_EQ(records[static_cast<size_t>(Lane::Consensus)].thread, processor);
+
+    for (const auto lane : kWorkerLanes) {
+        auto& record = records[static_cast<size_t>(lane)];
+        ASSERT_TRUE(callAllUntil([&] { return record.done == kTasks; }));
+
+        ASSERT_NE(record.thread, processor);
+        ASSERT_TRUE(record.isSingleThread);
+
+        for (size_t i = 0; i < kTasks; ++i) {
+            ASSERT_EQ(record.order[i], i);
+        }
+    }
+}
+
+// Transaction packets are decoded on lanes as node handlers do and delivered to the node thread state,
+// which is not synchronized at all: every delivered call has to run on the node thread in lane order.
+TEST(DispatchLanes, DecodedMessagesDeliveredInOrderToNodeThread) {
+    constexpr int64_t kPackets = 500;
+
+    std::vector<cs::Bytes> messages;
+    std::vector<cs::TransactionsPacketHash> hashes;
+
+    for (int64_t i = 0; i < kPackets; ++i) {
+        const auto packet = makePacket(i + 1);
+        messages.push_back(toMessage(packet));
+        hashes.push_back(packet.hash());
+    }
+
+    cs::DispatchLanes lanes;
+    const auto node = std::this_thread::get_id();
+
+    std::vector<cs::TransactionsPacketHash> received[cs::DispatchLanes::LanesCount];
+    size_t foreignCalls = 0;
+    std::atomic<size_t> decodeThreads = 0;
+
+    std::vector<std::thread> receivers;
+
+    // the processor thread is the only poster in node, concurrent posting is checked as well
+    for (const auto lane : kWorkerLanes) {
+        receivers.emplace_back([&, lane] {
+            for (const auto& message : messages) {
+                const bool isPosted = lanes.post(lane, [&, lane, message] {
+                    if (std::this_thread::get_id() == node) {
+                        ++decodeThreads;
+                    }
+
+                    cs::IPackStream stream;
+                    stream.init(message.data(), message.size());
+
+                    cs::TransactionsPacket packet;
+                    stream >> packet;
+
+                    lanes.deliver(lane, [&, lane, packet = std::move(packet)] {
+                        if (std::this_thread::get_id() != node) {
+                            ++foreignCalls;
+                        }
+
+                        received[static_cast<size_t>(lane)].push_back(packet.hash());
+                    });
+                });
+
+                EXPECT_TRUE(isPosted);
+            }
+        });
+    }
+
+    for (auto& receiver : receivers) {
+        receiver.join();
+    }
+
+    ASSERT_TRUE(callAllUntil([&] {
+        for (const auto lane : kWorkerLanes) {
+            if (received[static_cast<size_t>(lane)].size() != kPackets) {
+                return false;
+            }
+        }
+
+        return true;
+    }));
+
+    ASSERT_EQ(decodeThreads, 0);
+    ASSERT_EQ(foreignCalls, 0);
+
+    for (const auto lane : kWorkerLanes) {
+        ASSERT_EQ(received[static_cast<size_t>(lane)], hashes);
+    }
+}
+
+TEST(DispatchLanes, OverloadedLaneDropsTasks) {
+    cs::DispatchLanes lanes;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isReleased = false;
+    std::atomic<bool> isStarted = false;
+
+    // the first task holds the lane
+    lanes.post(Lane::Sync, [&] {
+        isStarted = true;
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [&] { return isReleased; });
+    });
+
+    while (!isStarted) {
+        std::this_thread::yield();
+    }
+
+    for (size_t i = 0; i < cs::DispatchLanes::MaxQueueSize; ++i) {
+        ASSERT_TRUE(lanes.post(Lane::Sync, [] {}));
+    }
+
+    ASSERT_FALSE(lanes.post(Lane::Sync, [] {}));
+    ASSERT_EQ(lanes.droppedCount(Lane::Sync), 1);
+    ASSERT_EQ(lanes.size(Lane::Sync), cs::DispatchLanes::MaxQueueSize);
+
+    // other lanes are not affected
+    ASSERT_TRUE(lanes.post(Lane::Transactions, [] {}));
+
+    {
+        std::lock_guard lock(mutex);
+        isReleased = true;
+    }
+
+    condition.notify_all();
+}
+
+TEST(DispatchLanes, StoppedLanesIgnoreTasksAndResults) {
+    auto lanes = std::make_unique<cs::DispatchLanes>();
+    std::atomic<bool> isDelivered = false;
+    std::atomic<bool> isPosted = false;
+
+    ASSERT_TRUE(lanes->post(Lane::Smart, [&] {
+        lanes->deliver(Lane::Smart, [&] { isDelivered = true; });
+        isPosted = true;
+    }));
+
+    while (!isPosted) {
+        std::this_thread::yield();
+    }
+
+    // the drain call is still in calls queue when lanes are destroyed
+    lanes.reset();
+    CallsQueue::instance().callAll();
+
+    ASSERT_FALSE(isDelivered);
+
+    cs::DispatchLanes stopped;
+    stopped.stop();
+
+    bool isCalled = false;
+    ASSERT_FALSE(stopped.post(Lane::Transactions, [&] { isCalled = true; }));
+    ASSERT_FALSE(stopped.post(Lane::Consensus, [&] { isCalled = true; }));
+    ASSERT_FALSE(isCalled);
+}
@@ -170,3 +170,73 @@ void displayStreamData(cs::IPackStream& stream, const size_t& size) {
         std::cout << "item " << i << ": " << (int)(*(ptr + i)) << std::endl;
     }
 }
+
+TEST(IPackStream, ReadValuesAcrossSegments) {
+    uint8_t data[] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x01, 0x02, 0x03};
+    const cs::BytesView segments[] = {cs::BytesView(data, 3), cs::BytesView(data + 3, 0), cs::BytesView(data + 3, 6), cs::BytesView(data + 9, 2)};
+
+    cs::IPackStream stream;
+    stream.init(segments, std::size(segments));
+    ASSERT_EQ(stream.remainsBytes(), sizeof data);
+
+    uint32_t value = 0;
+    ASSERT_EQ(stream.peek<uint32_t>(), 0x78563412);
+    stream >> value;
+    ASSERT_EQ(value, 0x78563412);
+
+    cs::ByteArray<6> array;
+    stream >> array;
+    ASSERT_TRUE(stream.good());
+    ASSERT_EQ(array, (cs::ByteArray<6>{0x9A, 0xBC, 0xDE, 0xF0, 0x01, 0x02}));
+
+    uint8_t last = 0;
+    stream >> last;
+    ASSERT_EQ(last, 0x03);
+    ASSERT_TRUE(stream.end());
+
+    stream >> last;
+    ASSERT_FALSE(stream.good());
+}
+
+TEST(IPackStream, ReadViewCopiesOnlyAcrossSegments) {
+    uint8_t data[16];
+    for (uint8_t i = 0; i < sizeof data; ++i) {
+        data[i] = i;
+    }
+
+    const cs::BytesView segments[] = {cs::BytesView(data, 8), cs::BytesView(data + 8, 8)};
+
+    cs::IPackStream stream;
+    stream.init(segments, std::size(segments));
+
+    auto view = stream.readView(4);
+    ASSERT_EQ(view.data(), data);
+    ASSERT_EQ(stream.composedBytes(), 0);
+
+    view = stream.readView(8);
+    ASSERT_TRUE(stream.good());
+    ASSERT_EQ(view.size(), 8);
+    ASSERT_TRUE(std::equal(view.begin(), view.end(), data + 4));
+    ASSERT_EQ(stream.composedBytes(), 8);
+
+    // the rest is in the last segment
+    ASSERT_EQ(stream.readView(4).data(), data + 12);
+    ASSERT_EQ(stream.composedBytes(), 8);
+
+    stream.readView(1);
+    ASSERT_FALSE(stream.good());
+}
+
+TEST(IPackStream, CurrentPointerComposesRestOfSegments) {
+    uint8_t data[] = {1, 2, 3, 4, 5, 6};
+    const cs::BytesView segments[] = {cs::BytesView(data, 2), cs::BytesView(data + 2, 2), cs::BytesView(data + 4, 2)};
+
+    cs::IPackStream stream;
+    stream.init(segments, std::size(segments));
+    stream.skip<uint8_t>();
+
+    auto ptr = stream.getCurrentPtr();
+    ASSERT_EQ(stream.getEndPtr() - ptr, 5);
+    ASSERT_TRUE(std::equal(ptr, ptr + 5, data + 1));
+    ASSERT_EQ(stream.composedBytes(), 5);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <boost/asio.hpp>
+
+#include <csnode/metricsserver.hpp>
+#include <csnode/roundtrace.hpp>
+#include <lib/system/metrics.hpp>
+
+namespace {
+std::string get(uint16_t port, const std::string& request) {
+    boost::asio::io_context context;
+    boost::asio::ip::tcp::socket socket(context);
+    socket.connect({boost::asio::ip::address_v4::loopback(), port});
+
+    boost::asio::write(socket, boost::asio::buffer(request));
+
+    std::string result;
+    boost::system::error_code code;
+    boost::asio::read(socket, boost::asio::dynamic_buffer(result), code);
+
+    return result;
+}
+}  // namespace
+
+TEST(MetricsServer, ServesExposition) {
+    cs::metrics::Registry::instance().counter("test_server_requests_total", "Requests of test").add(4);
+
+    cs::MetricsServer server;
+    ASSERT_TRUE(server.start(0));
+    ASSERT_NE(server.port(), 0);
+
+    const auto metrics = get(server.port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    ASSERT_EQ(metrics.find("HTTP/1.1 200 OK\r\n"), 0);
+    ASSERT_NE(metrics.find("Content-Type: text/plain; version=0.0.4"), std::string::npos);
+    ASSERT_NE(metrics.find("\ntest_server_requests_total 4\n"), std::string::npos);
+
+    ASSERT_EQ(get(server.port(), "GET / HTTP/1.1\r\n\r\n").find("HTTP/1.1 404"), 0);
+    ASSERT_EQ(get(server.port(), "POST /metrics HTTP/1.1\r\n\r\n").find("HTTP/1.1 405"), 0);
+
+    server.stop();
+}
+
+TEST(MetricsServer, ServesRoundTrace) {
+    auto& trace = cs::RoundTrace::instance();
+    trace.enable(64);
+    trace.startRound(3);
+    trace.instant("stage-1 received", cs::RoundTrace::Track::Stages, 2);
+
+    cs::MetricsServer server;
+    ASSERT_TRUE(server.start(0));
+
+    const auto result = get(server.port(), "GET /trace?rounds=1 HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(result.find("HTTP/1.1 200 OK\r\n"), 0);
+    ASSERT_NE(result.find("Content-Type: application/json"), std::string::npos);
+    ASSERT_NE(result.find("{\"name\":\"stage-1 received\""), std::string::npos);
+    ASSERT_NE(result.find("\"args\":{\"round\":3,\"arg\":2}"), std::string::npos);
+
+    server.stop();
+}
@@ -23,7 +23,7 @@ public:
   MOCK_METHOD3(getMatrix, void(const uint8_t*, const size_t, const cs::PublicKey& sender));
   MOCK_METHOD3(getBlock, void(const uint8_t*, const size_t, const cs::PublicKey& sender));
   MOCK_METHOD3(getHash, void(const uint8_t*, const size_t, const cs::PublicKey& sender));
-  MOCK_METHOD2(getTransactionsPacket, void(const uint8_t*, const std::size_t));
+  MOCK_METHOD1(getTransactionsPacket, void(cs::IPackStream&));
 
   // transaction's pack syncro
   MOCK_METHOD3(getPacketHashesRequest, void(const uint8_t*, const std::size_t, const cs::PublicKey& sender));
@@ -37,7 +37,7 @@ public:
 
   /*syncro get functions*/
   MOCK_METHOD3(getBlockRequest, void(const uint8_t*, const size_t, const cs::PublicKey& sender));
-  MOCK_METHOD2(getBlockReply, void(const uint8_t*, const size_t));
+  MOCK_METHOD1(getBlockReply, void(cs::IPackStream&));
   MOCK_METHOD3(getWritingConfirmation, void(const uint8_t* data, const size_t size, const cs::PublicKey& sender));
 
   /* Outcoming requests forming */
@@ -0,0 +1,356 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <net/pacmans.hpp>
+
+namespace {
+using Clock = OPacMan::Clock;
+
+RegionAllocator allocator;
+
+Packet makePacket(uint32_t size = Packet::MaxSize, MsgTypes type = MsgTypes::TransactionPacket) {
+    Packet pack(allocator.allocateNext(Packet::MaxSize));
+    auto data = static_cast<uint8_t*>(pack.data());
+    std::fill(data, data + Packet::MaxSize, 0);
+
+    data[0] = BaseFlags::Broadcast;
+    pack.setSize(size);
+    data[pack.getHeadersLength()] = type;
+
+    return pack;
+}
+
+ip::udp::endpoint makeEndpoint(uint16_t port) {
+    return ip::udp::endpoint(ip::make_address_v4("127.0.0.1"), port);
+}
+
+const OPacMan::PeerStats* find(const std::vector<OPacMan::PeerStats>& stats, const ip::udp::endpoint& endpoint) {
+    auto it = std::find_if(stats.begin(), stats.end(), [&](const auto& item) { return item.endpoint == endpoint; });
+    return it == stats.end() ? nullptr : &(*it);
+}
+}  // namespace
+
+TEST(OPacMan, TokenBucketLimitsRate) {
+    OPacMan pacman;
+    const auto peer = makeEndpoint(1);
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < 8000; ++i) {
+        ASSERT_TRUE(pacman.enqueue(peer, makePacket(), start));
+    }
+
+    OPacMan::Task task;
+    size_t sent = 0;
+
+    for (auto now = start; now < start + std::chrono::seconds(1); now += std::chrono::milliseconds(1)) {
+        while (pacman.pop(task, now)) {
+            ++sent;
+        }
+    }
+
+    const double expected = (OPacMan::InitialRate + OPacMan::MinBurst) / Packet::MaxSize;
+    ASSERT_NEAR(static_cast<double>(sent), expected, expected * 0.01);
+    ASSERT_EQ(pacman.getSize(), 8000 - sent);
+
+    const auto delay = pacman.nextDelay(start + std::chrono::seconds(1));
+    ASSERT_TRUE(delay.has_value());
+    ASSERT_LE(delay.value(), std::chrono::milliseconds(1));
+}
+
+TEST(OPacMan, PeersAreServedFairly) {
+    OPacMan pacman;
+    const auto large = makeEndpoint(1);
+    const auto small = makeEndpoint(2);
+    const auto now = Clock::now();
+
+    for (size_t i = 0; i < 100; ++i) {
+        pacman.enqueue(large, makePacket(), now);
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        pacman.enqueue(small, makePacket(), now);
+    }
+
+    // the small queue is not waiting for the large one
+    OPacMan::Task task;
+    size_t smallSent = 0;
+
+    for (size_t i = 0; i < 8 && pacman.pop(task, now); ++i) {
+        if (task.endpoint == small) {
+            ++smallSent;
+        }
+    }
+
+    ASSERT_EQ(smallSent, 4);
+}
+
+TEST(OPacMan, RateFollowsAimd) {
+    OPacMan pacman;
+    const auto peer = makeEndpoint(1);
+    auto now = Clock::now();
+
+    pacman.enqueue(peer, makePacket(), now);
+
+    for (int i = 0; i < 10; ++i) {
+        now += OPacMan::IncreaseInterval;
+        pacman.onDelivered(peer, now);
+    }
+
+    const double increased = OPacMan::InitialRate + 10 * OPacMan::AdditiveIncrease;
+    ASSERT_DOUBLE_EQ(find(pacman.stats(), peer)->rate, increased);
+
+    // losses of one burst halve the rate once
+    now += OPacMan::DecreaseInterval;
+    pacman.onLoss(peer, now);
+    pacman.onLoss(peer, now + std::chrono::milliseconds(1));
+    ASSERT_DOUBLE_EQ(find(pacman.stats(), peer)->rate, increased * OPacMan::DecreaseFactor);
+    ASSERT_EQ(find(pacman.stats(), peer)->losses, 2);
+
+    for (int i = 0; i < 100; ++i) {
+        now += OPacMan::DecreaseInterval;
+        pacman.onLoss(peer, now);
+    }
+
+    ASSERT_DOUBLE_EQ(find(pacman.stats(), peer)->rate, OPacMan::MinRate);
+}
+
+TEST(OPacMan, ResentPacketSignalsLoss) {
+    OPacMan pacman;
+    const auto peer = makeEndpoint(1);
+    const auto now = Clock::now();
+    const auto pack = makePacket();
+
+    pacman.enqueue(peer, pack, now);
+
+    // still queued, not duplicated
+    pacman.enqueue(peer, pack, now);
+    ASSERT_EQ(pacman.getSize(), 1);
+
+    OPacMan::Task task;
+    ASSERT_TRUE(pacman.pop(task, now));
+    ASSERT_EQ(find(pacman.stats(), peer)->losses, 0);
+
+    pacman.enqueue(peer, pack, now);
+    ASSERT_EQ(find(pacman.stats(), peer)->losses, 1);
+    ASSERT_DOUBLE_EQ(find(pacman.stats(), peer)->rate, OPacMan::InitialRate * OPacMan::DecreaseFactor);
+}
+
+TEST(OPacMan, FullQueueDropsPackets) {
+    OPacMan pacman;
+    const auto peer = makeEndpoint(1);
+    const auto now = Clock::now();
+
+    for (size_t i = 0; i < OPacMan::MaxQueueDepth; ++i) {
+        ASSERT_TRUE(pacman.enqueue(peer, makePacket(64), now));
+    }
+
+    ASSERT_FALSE(pacman.enqueue(peer, makePacket(64), now));
+
+    // consensus is not dropped
+    ASSERT_TRUE(pacman.enqueue(peer, makePacket(64, MsgTypes::FirstStage), now));
+    ASSERT_EQ(pacman.getSize(), OPacMan::MaxQueueDepth + 1);
+
+    const auto stats = find(pacman.stats(), peer);
+    ASSERT_EQ(stats->queueDepth, OPacMan::MaxQueueDepth + 1);
+    ASSERT_EQ(stats->dropped, 1);
+}
+
+// Broadcast of a large message to neighbours through the uplink with a drop-tail buffer and random loss.
+// Neighbours inform about every received packet, unconfirmed packets are resent periodically as neighbourhood does.
+// Unpaced sending puts all fragments to the uplink at once as the writer did before.
+TEST(OPacMan, LossyBroadcast) {
+    constexpr size_t kPeers = 8;
+    constexpr size_t kFragments = 2000;
+
+    constexpr double kLineRate = 100 << 20;   // local interface, bytes per second
+    constexpr double kUplinkRate = 8 << 20;   // bottleneck
+    constexpr size_t kUplinkBuffer = 256;     // packets
+    constexpr double kLossRate = 0.005;
+
+    constexpr auto kStep = std::chrono::microseconds(100);
+    constexpr auto kOneWay = std::chrono::milliseconds(20);
+    constexpr auto kResendPeriod = std::chrono::milliseconds(500);
+    constexpr auto kLimit = std::chrono::seconds(120);
+
+    struct Result {
+        double seconds = 0;
+        double goodput = 0;  // unique bytes per second
+        uint64_t transmissions = 0;
+        uint64_t uplinkDrops = 0;
+    };
+
+    std::vector<Packet> fragments;
+    for (size_t i = 0; i < kFragments; ++i) {
+        fragments.push_back(makePacket());
+    }
+
+    std::vector<ip::udp::endpoint> peers;
+    for (uint16_t i = 0; i < kPeers; ++i) {
+        peers.push_back(makeEndpoint(1000 + i));
+    }
+
+    auto simulate = [&](bool isPaced) {
+        std::mt19937 random(7);
+        std::bernoulli_distribution isLost(kLossRate);
+
+        OPacMan pacman;
+        std::deque<OPacMan::Task> unpaced;
+
+        struct InFlight {
+            Clock::time_point due;
+            size_t peer;
+            size_t fragment;
+        };
+
+        std::deque<std::pair<size_t, size_t>> uplink;
+        std::deque<InFlight> delivering;
+        std::deque<InFlight> informing;
+
+        std::vector<std::vector<bool>> delivered(kPeers, std::vector<bool>(kFragments, false));
+        std::vector<std::vector<bool>> confirmed(kPeers, std::vector<bool>(kFragments, false));
+        size_t confirmedCount = 0;
+
+        std::map<const void*, size_t> fragmentIndex;
+        for (size_t i = 0; i < kFragments; ++i) {
+            fragmentIndex[fragments[i].data()] = i;
+        }
+
+        Result result;
+        const auto start = Clock::now();
+        auto now = start;
+        auto nextResend = start + kResendPeriod;
+
+        double lineBudget = 0;
+        double uplinkBudget = 0;
+        const double stepSeconds = std::chrono::duration<double>(kStep).count();
+
+        auto send = [&](size_t peer, size_t fragment) {
+            if (isPaced) {
+                pacman.enqueue(peers[peer], fragments[fragment], now);
+            }
+            else {
+                unpaced.push_back(OPacMan::Task{peers[peer], fragments[fragment]});
+            }
+        };
+
+        for (size_t fragment = 0; fragment < kFragments; ++fragment) {
+            for (size_t peer = 0; peer < kPeers; ++peer) {
+                send(peer, fragment);
+            }
+        }
+
+        while (confirmedCount < kPeers * kFragments && now - start < kLimit) {
+            now += kStep;
+
+            // writer puts packets to the interface
+            lineBudget = std::min(lineBudget + kLineRate * stepSeconds, 64.0 * Packet::MaxSize);
+            OPacMan::Task task;
+
+            while (lineBudget >= Packet::MaxSize) {
+                if (isPaced) {
+                    if (!pacman.pop(task, now)) {
+                        break;
+                    }
+                }
+                else {
+                    if (unpaced.empty()) {
+                        break;
+                    }
+
+                    task = unpaced.front();
+                    unpaced.pop_front();
+                }
+
+                lineBudget -= Packet::MaxSize;
+                ++result.transmissions;
+
+                const size_t peer = static_cast<size_t>(task.endpoint.port() - 1000);
+                const size_t fragment = fragmentIndex[task.pack.data()];
+
+                if (uplink.size() >= kUplinkBuffer) {
+                    ++result.uplinkDrops;
+                    continue;
+                }
+
+                uplink.emplace_back(peer, fragment);
+            }
+
+            // bottleneck
+            uplinkBudget = std::min(uplinkBudget + kUplinkRate * stepSeconds, 2.0 * Packet::MaxSize);
+
+            while (uplinkBudget >= Packet::MaxSize && !uplink.empty()) {
+                uplinkBudget -= Packet::MaxSize;
+                const auto [peer, fragment] = uplink.front();
+                uplink.pop_front();
+
+                if (!isLost(random)) {
+                    delivering.push_back(InFlight{now + kOneWay, peer, fragment});
+                }
+            }
+
+            while (!delivering.empty() && delivering.front().due <= now) {
+                auto item = delivering.front();
+                delivering.pop_front();
+
+                delivered[item.peer][item.fragment] = true;
+                item.due = now + kOneWay;
+                informing.push_back(item);
+            }
+
+            // pack inform
+            while (!informing.empty() && informing.front().due <= now) {
+                const auto item = informing.front();
+                informing.pop_front();
+
+                if (!confirmed[item.peer][item.fragment]) {
+                    confirmed[item.peer][item.fragment] = true;
+                    ++confirmedCount;
+                }
+
+                if (isPaced) {
+                    pacman.onDelivered(peers[item.peer], now);
+                }
+            }
+
+            if (now >= nextResend) {
+                nextResend = now + kResendPeriod;
+
+                for (size_t fragment = 0; fragment < kFragments; ++fragment) {
+                    for (size_t peer = 0; peer < kPeers; ++peer) {
+                        if (!confirmed[peer][fragment]) {
+                            send(peer, fragment);
+                        }
+                    }
+                }
+            }
+        }
+
+        result.seconds = std::chrono::duration<double>(now - start).count();
+        result.goodput = static_cast<double>(confirmedCount) * Packet::MaxSize / result.seconds;
+
+        EXPECT_EQ(confirmedCount, kPeers * kFragments);
+        return result;
+    };
+
+    const auto unpaced = simulate(false);
+    const auto paced = simulate(true);
+
+    auto print = [](const char* name, const Result& result) {
+        std::cout << name << ": " << result.seconds << " s, goodput " << static_cast<uint64_t>(result.goodput / 1024) << " KB/s, " << result.transmissions
+                  << " transmissions, " << result.uplinkDrops << " uplink drops" << std::endl;
+    };
+
+    print("unpaced", unpaced);
+    print("paced", paced);
+
+    ASSERT_LT(paced.seconds, unpaced.seconds);
+    ASSERT_LT(paced.transmissions, unpaced.transmissions);
+}
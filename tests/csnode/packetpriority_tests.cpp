@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <net/pacmans.hpp>
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+RegionAllocator allocator;
+
+void fill(Packet& pack, uint32_t size, MsgTypes type, uint8_t flags = BaseFlags::Broadcast) {
+    auto data = static_cast<uint8_t*>(pack.data());
+    std::fill(data, data + Packet::MaxSize, 0);
+
+    data[0] = flags;
+    pack.setSize(size);
+    pack.recalculateHeadersLength();
+    data[pack.getHeadersLength()] = type;
+}
+
+Packet makePacket(MsgTypes type, uint8_t flags = BaseFlags::Broadcast) {
+    Packet pack(allocator.allocateNext(Packet::MaxSize));
+    fill(pack, 128, type, flags);
+    return pack;
+}
+
+void busyWait(std::chrono::microseconds duration) {
+    const auto end = Clock::now() + duration;
+
+    while (Clock::now() < end) {
+    }
+}
+}  // namespace
+
+TEST(PacketPriority, ClassifiedByMessageType) {
+    ASSERT_EQ(makePacket(MsgTypes::RoundTable).getPriority(), PacketPriority::Consensus);
+    ASSERT_EQ(makePacket(MsgTypes::FirstStage).getPriority(), PacketPriority::Consensus);
+    ASSERT_EQ(makePacket(MsgTypes::HashReply).getPriority(), PacketPriority::Consensus);
+    ASSERT_EQ(makePacket(MsgTypes::NewCharacteristic).getPriority(), PacketPriority::Regular);
+    ASSERT_EQ(makePacket(MsgTypes::TransactionPacket).getPriority(), PacketPriority::Bulk);
+    ASSERT_EQ(makePacket(MsgTypes::RequestedBlock).getPriority(), PacketPriority::Bulk);
+
+    // missing packets block the current round, they are not queued behind the flood of new ones
+    ASSERT_EQ(makePacket(MsgTypes::TransactionsPacketRequest).getPriority(), PacketPriority::Regular);
+    ASSERT_EQ(makePacket(MsgTypes::TransactionsPacketReply).getPriority(), PacketPriority::Regular);
+
+    // only the first fragment has message type
+    auto fragment = makePacket(MsgTypes::RequestedBlock, BaseFlags::Fragmented | BaseFlags::Broadcast);
+    auto data = static_cast<uint8_t*>(fragment.data());
+    data[Offsets::FragmentsNum] = 2;
+    ASSERT_EQ(fragment.getPriority(), PacketPriority::Bulk);
+
+    data[Offsets::FragmentId] = 1;
+    ASSERT_EQ(fragment.getPriority(), PacketPriority::Regular);
+}
+
+TEST(PacketPriority, SchedulerFollowsWeights) {
+    PriorityScheduler scheduler;
+    std::vector<size_t> taken(kPacketPrioritiesCount, 0);
+
+    size_t cycle = 0;
+    for (const auto weight : PriorityScheduler::Weights) {
+        cycle += weight;
+    }
+
+    for (size_t i = 0; i < cycle * 10; ++i) {
+        const auto index = scheduler.peek([](size_t) { return false; });
+        ASSERT_TRUE(index.has_value());
+
+        scheduler.take(index.value());
+        ++taken[index.value()];
+    }
+
+    for (size_t i = 0; i < kPacketPrioritiesCount; ++i) {
+        ASSERT_EQ(taken[i], PriorityScheduler::Weights[i] * 10);
+    }
+
+    // an empty queue gives its turns to others
+    const auto index = scheduler.peek([](size_t i) { return i != static_cast<size_t>(PacketPriority::Bulk); });
+    ASSERT_EQ(index, static_cast<size_t>(PacketPriority::Bulk));
+}
+
+TEST(PacketPriority, OrderOfPriorityIsKept) {
+    IPacMan pacman;
+
+    for (uint8_t i = 0; i < 10; ++i) {
+        auto& task = pacman.allocNext();
+        fill(task.pack, Packet::MaxSize, i % 2 ? MsgTypes::TransactionPacket : MsgTypes::FirstStage);
+        static_cast<uint8_t*>(task.pack.data())[Packet::MaxSize - 1] = i;
+        task.size = Packet::MaxSize;
+        pacman.enQueueLast();
+    }
+
+    ASSERT_EQ(pacman.getSize(PacketPriority::Consensus), 5);
+    ASSERT_EQ(pacman.getSize(PacketPriority::Bulk), 5);
+
+    std::vector<uint8_t> consensus;
+    std::vector<uint8_t> bulk;
+
+    while (true) {
+        bool isEmpty = false;
+        auto task = pacman.getNextTask(isEmpty);
+
+        if (isEmpty) {
+            break;
+        }
+
+        const auto order = static_cast<const uint8_t*>(task->pack.data())[Packet::MaxSize - 1];
+        (task->priority == PacketPriority::Consensus ? consensus : bulk).push_back(order);
+        task.release();
+    }
+
+    ASSERT_EQ(consensus, std::vector<uint8_t>({0, 2, 4, 6, 8}));
+    ASSERT_EQ(bulk, std::vector<uint8_t>({1, 3, 5, 7, 9}));
+}
+
+namespace {
+// Reader floods transaction packets faster than processor handles them and sends messages of given type between,
+// processor measures the time these messages and transaction packets spent in the queue.
+void flood(MsgTypes type, const char* name) {
+    constexpr size_t kTransactions = 40000;
+    constexpr size_t kPeriod = 200;
+    constexpr auto kProcessingTime = std::chrono::microseconds(5);
+
+    IPacMan pacman;
+    std::atomic<bool> isReaderDone = false;
+
+    std::thread reader([&] {
+        for (size_t i = 0; i < kTransactions; ++i) {
+            const bool isInterleaved = i % kPeriod == 0;
+
+            auto& task = pacman.allocNext();
+            fill(task.pack, 256, isInterleaved ? type : MsgTypes::TransactionPacket);
+            task.size = 256;
+            task.timestamp = Clock::now();
+            pacman.enQueueLast();
+        }
+
+        isReaderDone = true;
+    });
+
+    std::vector<double> latency;
+    std::vector<double> transactionLatency;
+
+    while (!isReaderDone || pacman.getSize()) {
+        bool isEmpty = false;
+        auto task = pacman.getNextTask(isEmpty);
+
+        if (isEmpty) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const double value = std::chrono::duration<double, std::milli>(Clock::now() - task->timestamp).count();
+        (task->priority != PacketPriority::Bulk ? latency : transactionLatency).push_back(value);
+
+        busyWait(kProcessingTime);
+        task.release();
+    }
+
+    reader.join();
+
+    ASSERT_EQ(latency.size(), kTransactions / kPeriod);
+    ASSERT_EQ(latency.size() + transactionLatency.size(), kTransactions);
+
+    std::sort(latency.begin(), latency.end());
+    std::sort(transactionLatency.begin(), transactionLatency.end());
+
+    auto percentile = [](const std::vector<double>& values, double rank) { return values[static_cast<size_t>(rank * static_cast<double>(values.size() - 1))]; };
+
+    std::cout << name << " latency p50 " << percentile(latency, 0.5) << " ms, p99 " << percentile(latency, 0.99) << " ms; transactions latency p50 "
+              << percentile(transactionLatency, 0.5) << " ms, p99 " << percentile(transactionLatency, 0.99) << " ms" << std::endl;
+
+    // without priorities these messages wait as long as transactions do
+    ASSERT_LT(percentile(latency, 0.99), percentile(transactionLatency, 0.5));
+}
+}  // namespace
+
+TEST(PacketPriority, StagesUnderTransactionsFlood) {
+    flood(MsgTypes::SecondStage, "Stage");
+}
+
+TEST(PacketPriority, PacketRequestsUnderTransactionsFlood) {
+    flood(MsgTypes::TransactionsPacketRequest, "Packet request");
+}
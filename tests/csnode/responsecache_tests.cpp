@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <API.h>
+
+#include <responsecache.hpp>
+
+namespace {
+using Cache = api::ResponseCache;
+
+// response of pool list with given number, computed only when cache misses
+size_t get(Cache& cache, Cache::Method method, const std::string& arguments, const Cache::Range& range, int64_t number, size_t& computed) {
+    api::PoolListGetResult result;
+
+    cache.get(result, method, arguments, range, [&](api::PoolListGetResult& value) {
+        ++computed;
+        value.pools.emplace_back();
+        value.pools.back().poolNumber = number;
+        value.pools.back().hash = std::string(64, 'h');
+    });
+
+    return result.pools.empty() ? 0 : static_cast<size_t>(result.pools.front().poolNumber);
+}
+}  // namespace
+
+TEST(ResponseCache, InvalidatesBlocksRange) {
+    Cache cache;
+    size_t computed = 0;
+
+    get(cache, Cache::PoolListStable, "10", {10, 20}, 1, computed);
+    get(cache, Cache::PoolListStable, "30", {30, 40}, 2, computed);
+    get(cache, Cache::PoolList, "tip", {41, cs::kWrongSequence}, 3, computed);
+    ASSERT_EQ(computed, 3u);
+
+    // sequence out of every range keeps all responses
+    cache.invalidate(25);
+    get(cache, Cache::PoolListStable, "10", {10, 20}, 1, computed);
+    get(cache, Cache::PoolListStable, "30", {30, 40}, 2, computed);
+    get(cache, Cache::PoolList, "tip", {41, cs::kWrongSequence}, 3, computed);
+    ASSERT_EQ(computed, 3u);
+
+    // the new block drops tip dependent response only
+    cache.invalidate(41);
+    get(cache, Cache::PoolList, "tip", {42, cs::kWrongSequence}, 3, computed);
+    get(cache, Cache::PoolListStable, "10", {10, 20}, 1, computed);
+    ASSERT_EQ(computed, 4u);
+
+    // removed block from fixed range
+    cache.invalidate(35);
+    get(cache, Cache::PoolListStable, "30", {30, 40}, 2, computed);
+    get(cache, Cache::PoolListStable, "10", {10, 20}, 1, computed);
+    ASSERT_EQ(computed, 5u);
+
+    const auto stats = cache.stats();
+    ASSERT_EQ(stats.methods[Cache::PoolList].invalidations, 1u);
+    ASSERT_EQ(stats.methods[Cache::PoolListStable].invalidations, 1u);
+    ASSERT_EQ(stats.count, 3u);
+}
+
+TEST(ResponseCache, ExpiresByTtl) {
+    Cache cache;
+    cache.setTtl(Cache::Stats, std::chrono::milliseconds(20));
+    cache.setTtl(Cache::WalletData, std::chrono::milliseconds(0));
+
+    size_t computed = 0;
+
+    get(cache, Cache::Stats, "", {1, cs::kWrongSequence}, 1, computed);
+    get(cache, Cache::Stats, "", {1, cs::kWrongSequence}, 1, computed);
+    ASSERT_EQ(computed, 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+    get(cache, Cache::Stats, "", {1, cs::kWrongSequence}, 1, computed);
+    ASSERT_EQ(computed, 2u);
+    ASSERT_EQ(cache.stats().methods[Cache::Stats].expirations, 1u);
+
+    // zero TTL never stores
+    get(cache, Cache::WalletData, "wallet", {1, cs::kWrongSequence}, 1, computed);
+    get(cache, Cache::WalletData, "wallet", {1, cs::kWrongSequence}, 1, computed);
+    ASSERT_EQ(computed, 4u);
+    ASSERT_EQ(cache.stats().methods[Cache::WalletData].hits, 0u);
+}
+
+TEST(ResponseCache, DropsResponseComputedAcrossInvalidation) {
+    Cache cache;
+    size_t computed = 0;
+    api::PoolListGetResult result;
+
+    // block is stored while response of the old tip is being computed
+    cache.get(result, Cache::PoolList, "tip", {11, cs::kWrongSequence}, [&](api::PoolListGetResult& value) {
+        ++computed;
+        value.count = 1;
+        cache.invalidate(11);
+    });
+
+    ASSERT_EQ(result.count, 1);
+    ASSERT_EQ(cache.stats().count, 0u);
+
+    get(cache, Cache::PoolList, "tip", {12, cs::kWrongSequence}, 2, computed);
+    ASSERT_EQ(computed, 2u);
+    ASSERT_EQ(cache.stats().count, 1u);
+}
+
+TEST(ResponseCache, EvictsLeastRecentlyUsed) {
+    Cache cache;
+    size_t computed = 0;
+
+    get(cache, Cache::PoolListStable, "a", {1, 1}, 1, computed);
+    const size_t entryBytes = cache.stats().bytes;
+
+    // room for two entries only
+    cache.setMemoryLimit(entryBytes * 2 + entryBytes / 2);
+
+    get(cache, Cache::PoolListStable, "b", {1, 1}, 2, computed);
+    get(cache, Cache::PoolListStable, "a", {1, 1}, 1, computed);
+    ASSERT_EQ(computed, 2u);
+
+    // "b" is the least recently used
+    get(cache, Cache::PoolListStable, "c", {1, 1}, 3, computed);
+    ASSERT_EQ(computed, 3u);
+    ASSERT_EQ(cache.stats().evictions, 1u);
+    ASSERT_LE(cache.stats().bytes, entryBytes * 2 + entryBytes / 2);
+
+    ASSERT_EQ(get(cache, Cache::PoolListStable, "a", {1, 1}, 1, computed), 1u);
+    ASSERT_EQ(get(cache, Cache::PoolListStable, "c", {1, 1}, 3, computed), 3u);
+    ASSERT_EQ(computed, 3u);
+
+    ASSERT_EQ(get(cache, Cache::PoolListStable, "b", {1, 1}, 2, computed), 2u);
+    ASSERT_EQ(computed, 4u);
+}
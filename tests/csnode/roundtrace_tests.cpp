@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <csnode/roundtrace.hpp>
+
+using Track = cs::RoundTrace::Track;
+using Phase = cs::RoundTrace::Phase;
+
+TEST(RoundTrace, DisabledRecordsNothing) {
+    cs::RoundTrace trace;
+    trace.instant("event", Track::Solver, 1);
+
+    ASSERT_FALSE(trace.isEnabled());
+    ASSERT_TRUE(trace.events(0).empty());
+
+    trace.enable(0);
+    ASSERT_FALSE(trace.isEnabled());
+}
+
+TEST(RoundTrace, RingWrapKeepsLastEvents) {
+    cs::RoundTrace trace;
+    trace.enable(6);
+    ASSERT_EQ(trace.capacity(), 8);
+
+    // ring is never replaced
+    trace.enable(64);
+    ASSERT_EQ(trace.capacity(), 8);
+
+    for (int32_t i = 0; i < 21; ++i) {
+        trace.instant("event", Track::Stages, i);
+    }
+
+    const auto events = trace.events(0);
+    ASSERT_EQ(events.size(), 8);
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        ASSERT_EQ(events[i].index, 13 + i);
+        ASSERT_EQ(events[i].arg, static_cast<int32_t>(13 + i));
+        ASSERT_EQ(events[i].track, Track::Stages);
+        ASSERT_EQ(events[i].phase, Phase::Instant);
+    }
+}
+
+TEST(RoundTrace, LastRounds) {
+    cs::RoundTrace trace;
+    trace.enable(64);
+
+    for (cs::RoundNumber round = 1; round <= 5; ++round) {
+        trace.startRound(round);
+        trace.record("Trusted-1", Track::Solver, Phase::Begin);
+        trace.record("Trusted-1", Track::Solver, Phase::End);
+    }
+
+    const auto events = trace.events(2);
+    ASSERT_EQ(events.size(), 6);
+    ASSERT_EQ(events.front().round, 4);
+    ASSERT_EQ(events.back().round, 5);
+    ASSERT_EQ(trace.events(0).size(), 15);
+}
+
+TEST(RoundTrace, OrderAcrossThreads) {
+    constexpr size_t kThreads = 4;
+    constexpr int32_t kEvents = 20000;
+
+    cs::RoundTrace trace;
+    trace.enable(kThreads * kEvents);
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i] {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            for (int32_t j = 0; j < kEvents; ++j) {
+                trace.instant("event", static_cast<Track>(i), j);
+            }
+        });
+    }
+
+    go = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto events = trace.events(0);
+    ASSERT_EQ(events.size(), kThreads * kEvents);
+
+    std::map<Track, int32_t> lastArg;
+    std::map<Track, cs::RoundTrace::Clock::time_point> lastTime;
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& event = events[i];
+        ASSERT_EQ(event.index, i);
+
+        // events of every thread keep their program order
+        auto [arg, isNew] = lastArg.try_emplace(event.track, event.arg);
+        ASSERT_TRUE(isNew ? event.arg == 0 : event.arg == arg->second + 1);
+        arg->second = event.arg;
+
+        auto [time, isNewTime] = lastTime.try_emplace(event.track, event.time);
+        ASSERT_LE(time->second, event.time);
+        time->second = event.time;
+    }
+}
+
+TEST(RoundTrace, ChromeTrace) {
+    cs::RoundTrace trace;
+    trace.enable(16);
+
+    trace.startRound(7);
+    {
+        cs::RoundTraceScope scope("finalize \"block\"", Track::Blocks, 42, trace);
+    }
+
+    const auto json = trace.chromeTrace(1);
+
+    ASSERT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+    ASSERT_NE(json.find("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"blocks\"}}"), std::string::npos);
+    ASSERT_NE(json.find("{\"name\":\"round\",\"cat\":\"round\",\"ph\":\"i\",\"s\":\"t\",\"ts\":"), std::string::npos);
+    ASSERT_NE(json.find("{\"name\":\"finalize \\\"block\\\"\",\"cat\":\"blocks\",\"ph\":\"B\",\"ts\":"), std::string::npos);
+    ASSERT_NE(json.find("\"ph\":\"E\""), std::string::npos);
+    ASSERT_NE(json.find(",\"pid\":1,\"tid\":3,\"args\":{\"round\":7,\"arg\":42}}"), std::string::npos);
+    ASSERT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
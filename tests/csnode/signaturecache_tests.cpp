@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <csnode/signaturecache.hpp>
+
+#include <cscrypto/cscrypto.hpp>
+
+namespace {
+struct SignedMessage {
+    cs::PublicKey publicKey;
+    cs::Signature signature;
+    cs::Bytes data;
+};
+
+SignedMessage makeMessage(uint32_t id) {
+    static auto seed = cscrypto::keys_derivation::generateMasterSeed();
+    auto keys = cscrypto::keys_derivation::deriveKeyPair(seed, id);
+
+    SignedMessage message;
+    message.publicKey = keys.first;
+    message.data = cs::Bytes(64, static_cast<cs::Byte>(id));
+    message.signature = cscrypto::generateSignature(keys.second, message.data.data(), message.data.size());
+
+    return message;
+}
+
+bool verify(cs::SignatureCache& cache, const SignedMessage& message) {
+    return cache.verify(message.signature, message.publicKey, message.data.data(), message.data.size());
+}
+}  // namespace
+
+TEST(SignatureCache, SecondVerificationIsHit) {
+    cs::SignatureCache cache;
+    const auto message = makeMessage(1);
+
+    ASSERT_TRUE(verify(cache, message));
+    ASSERT_TRUE(verify(cache, message));
+
+    const auto stats = cache.stats();
+    ASSERT_EQ(stats.misses, 1);
+    ASSERT_EQ(stats.hits, 1);
+}
+
+TEST(SignatureCache, InvalidSignatureIsNotCached) {
+    cs::SignatureCache cache;
+    auto message = makeMessage(2);
+
+    ASSERT_TRUE(verify(cache, message));
+
+    message.signature[0] ^= 0xFF;
+    ASSERT_FALSE(verify(cache, message));
+    ASSERT_FALSE(verify(cache, message));
+
+    const auto stats = cache.stats();
+    ASSERT_EQ(stats.hits, 0);
+    ASSERT_EQ(stats.failures, 2);
+}
+
+TEST(SignatureCache, OtherKeyOrDataAreNotHits) {
+    cs::SignatureCache cache;
+    const auto message = makeMessage(3);
+    const auto other = makeMessage(4);
+
+    ASSERT_TRUE(verify(cache, message));
+
+    auto wrongKey = message;
+    wrongKey.publicKey = other.publicKey;
+    ASSERT_FALSE(verify(cache, wrongKey));
+
+    auto wrongData = message;
+    wrongData.data.back() ^= 0xFF;
+    ASSERT_FALSE(verify(cache, wrongData));
+
+    ASSERT_EQ(cache.stats().hits, 0);
+}
+
+TEST(SignatureCache, EntriesExpireAfterRounds) {
+    cs::SignatureCache cache;
+    const auto message = makeMessage(5);
+
+    cache.setRound(10);
+    ASSERT_TRUE(verify(cache, message));
+
+    cache.setRound(10 + cs::SignatureCache::kRoundsToLive);
+    ASSERT_TRUE(verify(cache, message));
+    ASSERT_EQ(cache.stats().hits, 1);
+
+    cache.setRound(11 + cs::SignatureCache::kRoundsToLive);
+    ASSERT_TRUE(verify(cache, message));
+    ASSERT_EQ(cache.stats().hits, 1);
+    ASSERT_EQ(cache.stats().misses, 2);
+}
+
+TEST(SignatureCache, CapacityBoundsEntries) {
+    cs::SignatureCache cache(16);
+
+    for (uint32_t i = 0; i < 200; ++i) {
+        ASSERT_TRUE(verify(cache, makeMessage(100 + i)));
+    }
+
+    ASSERT_GE(cache.stats().evictions, 200 - 16 * 2);
+}
+
+TEST(SignatureCache, ZeroCapacityDisablesCache) {
+    cs::SignatureCache cache(0);
+    const auto message = makeMessage(6);
+
+    ASSERT_TRUE(verify(cache, message));
+    ASSERT_TRUE(verify(cache, message));
+
+    const auto stats = cache.stats();
+    ASSERT_EQ(stats.hits, 0);
+    ASSERT_EQ(stats.misses, 0);
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <apihandler.hpp>
+#include <cscrypto/cscrypto.hpp>
+#include <csdb/address.hpp>
+#include <csdb/pool.hpp>
+#include <csnode/blockchain.hpp>
+#include <lib/system/utils.hpp>
+#include <solver/smartcontracts.hpp>
+#include <solver/solvercore.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+namespace fs = boost::filesystem;
+
+const csdb::Address kGenesisAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
+const csdb::Address kStartAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000002");
+
+constexpr size_t kStateSize = 1024;
+
+fs::path makeDirectory() {
+    return fs::temp_directory_path() / fs::unique_path("cs-contracts-tests-%%%%-%%%%");
+}
+
+std::vector<csdb::Address> makeContracts(size_t count) {
+    std::vector<csdb::Address> contracts;
+
+    for (size_t i = 0; i < count; ++i) {
+        contracts.push_back(csdb::Address::from_public_key(makeKey(static_cast<uint8_t>(i + 1))));
+    }
+
+    return contracts;
+}
+
+std::string makeState(size_t index) {
+    return std::string(kStateSize, static_cast<char>('a' + index));
+}
+
+// deploys of contracts followed by their new states, the only confidant signs every block
+class ContractsChain {
+public:
+    explicit ContractsChain(BlockChain& blockchain)
+    : blockchain_(blockchain) {
+        auto keys = cscrypto::keys_derivation::deriveKeyPair(cscrypto::keys_derivation::generateMasterSeed(), 0);
+        publicKey_ = keys.first;
+        privateKey_ = keys.second;
+    }
+
+    bool deploy(const std::vector<csdb::Address>& contracts) {
+        api::SmartContractInvocation invocation;
+        invocation.smartContractDeploy.byteCodeObjects.emplace_back();
+        invocation.smartContractDeploy.byteCodeObjects.back().byteCode = std::string(256, 'c');
+        const std::string code = serialize(invocation);
+
+        std::vector<csdb::Transaction> deploys;
+
+        for (const auto& contract : contracts) {
+            csdb::Transaction transaction(++innerId_, kStartAddress, contract, 1, csdb::Amount(0), csdb::AmountCommission(1.0), csdb::AmountCommission(0.0),
+                                          cs::Zero::signature);
+            transaction.add_user_field(cs::trx_uf::deploy::Code, code);
+            deploys.push_back(transaction);
+        }
+
+        const auto block = store(deploys);
+        if (!block.has_value()) {
+            return false;
+        }
+
+        std::vector<csdb::Transaction> states;
+
+        for (size_t i = 0; i < contracts.size(); ++i) {
+            csdb::Transaction state(static_cast<int64_t>(i + 1), contracts[i], contracts[i], 1, csdb::Amount(0), csdb::AmountCommission(1.0),
+                                    csdb::AmountCommission(0.0), cs::Zero::signature);
+            state.add_user_field(cs::trx_uf::new_state::Value, makeState(i));
+            state.add_user_field(cs::trx_uf::new_state::RefStart, cs::SmartContractRef(block->hash(), block->sequence(), i).to_user_field());
+            state.add_user_field(cs::trx_uf::new_state::Fee, csdb::Amount{});
+            states.push_back(state);
+        }
+
+        // the last block is deferred until the next one is recorded
+        return store(states).has_value() && store({}).has_value();
+    }
+
+private:
+    std::optional<csdb::Pool> store(const std::vector<csdb::Transaction>& transactions) {
+        csdb::Pool pool;
+
+        for (const auto& transaction : transactions) {
+            pool.add_transaction(transaction);
+        }
+
+        pool.set_sequence(blockchain_.getLastSeq() + 1);
+        pool.set_previous_hash(blockchain_.getLastHash());
+        pool.add_user_field(0, cs::Utils::currentTimestamp());
+        pool.add_number_trusted(1);
+        pool.add_real_trusted(cs::Utils::maskToBits(cs::Bytes(1, 0)));
+        pool.set_confidants(cs::PublicKeys{publicKey_});
+
+        if (pool.sequence() > 1) {
+            pool.add_number_confirmations(0);
+            pool.add_confirmation_mask(cs::Utils::maskToBits(cs::Bytes{}));
+            pool.add_round_confirmations(cs::Signatures{});
+        }
+
+        uint32_t size = 0;
+        pool.to_byte_stream(size);
+
+        cs::Hash hash;
+        const auto binary = pool.hash().to_binary();
+        std::copy(binary.begin(), binary.end(), hash.begin());
+
+        pool.set_signatures(cs::Signatures{cscrypto::generateSignature(privateKey_, hash.data(), hash.size())});
+        return blockchain_.createBlock(pool);
+    }
+
+    BlockChain& blockchain_;
+    cs::PublicKey publicKey_;
+    cscrypto::PrivateKey privateKey_;
+    int64_t innerId_ = 0;
+};
+}  // namespace
+
+TEST(SmartContracts, EvictedStateIsReadFromDbCache) {
+    ASSERT_TRUE(cscrypto::cryptoInit());
+
+    const auto directory = makeDirectory();
+    const auto contracts = makeContracts(3);
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+        ASSERT_TRUE(blockchain.init(directory.string()));
+
+        ContractsChain chain(blockchain);
+        ASSERT_TRUE(chain.deploy(contracts));
+
+        blockchain.close();
+    }
+
+    {
+        // contracts read blocks while blockchain is being opened as in node
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+        cs::SolverCore solver(blockchain, kGenesisAddress, kStartAddress);
+        auto& smarts = solver.smart_contracts();
+        smarts.set_states_cache_budget(2 * kStateSize);
+
+        ASSERT_TRUE(blockchain.init(directory.string()));
+
+        // the first read state is the least recently used one
+        ASSERT_TRUE(smarts.is_known_smart_contract(contracts[0]));
+        ASSERT_FALSE(smarts.is_state_cached(contracts[0]));
+        ASSERT_TRUE(smarts.is_state_cached(contracts[1]));
+        ASSERT_TRUE(smarts.is_state_cached(contracts[2]));
+        ASSERT_EQ(smarts.states_cache_bytes(), 2 * kStateSize);
+
+        ASSERT_EQ(smarts.get_known_contract_state(contracts[0]), makeState(0));
+        ASSERT_TRUE(smarts.is_state_cached(contracts[0]));
+        ASSERT_FALSE(smarts.is_state_cached(contracts[1]));
+
+        ASSERT_EQ(smarts.get_known_contract_state(contracts[1]), makeState(1));
+        ASSERT_EQ(smarts.states_cache_bytes(), 2 * kStateSize);
+
+        blockchain.close();
+    }
+
+    fs::remove_all(directory);
+}
+
+TEST(SmartContracts, StateAheadOfDbCacheStaysPinned) {
+    ASSERT_TRUE(cscrypto::cryptoInit());
+
+    const auto directory = makeDirectory();
+    const auto contracts = makeContracts(3);
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+        ASSERT_TRUE(blockchain.init(directory.string()));
+
+        ContractsChain chain(blockchain);
+        ASSERT_TRUE(chain.deploy(contracts));
+
+        // DB cache of the first contract refers to a later execution, so the state read from block is not cached there
+        const cs::SmartContractRef later(blockchain.getLastHash(), blockchain.getLastSeq() + 1000, 0);
+        ASSERT_TRUE(cs::SmartContracts::dbcache_update(blockchain, contracts[0], later, "later state", false));
+
+        blockchain.close();
+    }
+
+    {
+        BlockChain blockchain(kGenesisAddress, kStartAddress);
+        cs::SolverCore solver(blockchain, kGenesisAddress, kStartAddress);
+        auto& smarts = solver.smart_contracts();
+        smarts.set_states_cache_budget(2 * kStateSize);
+
+        ASSERT_TRUE(blockchain.init(directory.string()));
+
+        // the pinned state is kept over the budget, the next least recently used one is evicted instead
+        ASSERT_TRUE(smarts.is_state_cached(contracts[0]));
+        ASSERT_FALSE(smarts.is_state_cached(contracts[1]));
+        ASSERT_TRUE(smarts.is_state_cached(contracts[2]));
+
+        smarts.set_states_cache_budget(0);
+        ASSERT_TRUE(smarts.is_state_cached(contracts[0]));
+        ASSERT_EQ(smarts.states_cache_bytes(), kStateSize);
+        ASSERT_EQ(smarts.get_known_contract_state(contracts[0]), makeState(0));
+
+        blockchain.close();
+    }
+
+    fs::remove_all(directory);
+}
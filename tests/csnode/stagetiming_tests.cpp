@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <solver/consensus.hpp>
+#include <solver/stagetiming.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+using Clock = cs::StageTiming::Clock;
+using Kind = cs::StageTiming::Kind;
+
+Clock::time_point at(double msec) {
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(msec)));
+}
+
+// every round each sender's stage arrives with the same latency
+void feed(cs::StageTiming& timing, Kind kind, const std::vector<cs::PublicKey>& senders, double latency, size_t rounds) {
+    double now = 0;
+
+    for (size_t round = 0; round < rounds; ++round) {
+        now += 10000;
+        timing.startRound(at(now));
+        timing.startWaiting(kind, at(now));
+
+        for (const auto& sender : senders) {
+            timing.onArrival(kind, sender, at(now + latency));
+        }
+    }
+}
+}  // namespace
+
+TEST(StageTiming, UsesConstantsUntilEnoughSamples) {
+    cs::StageTiming timing;
+    const std::vector<cs::PublicKey> senders = {makeKey(1)};
+
+    feed(timing, Kind::Stage1, senders, 50, cs::StageTiming::MinSamples - 1);
+    feed(timing, Kind::Hash, senders, 10, cs::StageTiming::MinSamples - 1);
+
+    ASSERT_EQ(timing.requestTimeout(Kind::Stage1, senders, Consensus::T_stage_request), Consensus::T_stage_request);
+    ASSERT_EQ(timing.minStage1Time(), Consensus::T_min_stage1);
+
+    feed(timing, Kind::Stage1, senders, 500, 1);
+    ASSERT_EQ(timing.samplesCount(Kind::Stage1), cs::StageTiming::MinSamples);
+    ASSERT_NE(timing.requestTimeout(Kind::Stage1, senders, Consensus::T_stage_request), Consensus::T_stage_request);
+}
+
+TEST(StageTiming, EarlyAndDuplicatedArrivals) {
+    cs::StageTiming timing;
+    const auto sender = makeKey(1);
+
+    timing.startRound(at(0));
+    timing.onArrival(Kind::Stage2, sender, at(100));
+    timing.onArrival(Kind::Stage2, sender, at(200));
+    ASSERT_EQ(timing.samplesCount(Kind::Stage2), 0);
+
+    // stage came before the node started to wait for it
+    timing.startWaiting(Kind::Stage2, at(300));
+    timing.startWaiting(Kind::Stage2, at(400));
+    ASSERT_EQ(timing.samplesCount(Kind::Stage2), 1);
+    ASSERT_DOUBLE_EQ(timing.average(Kind::Stage2, sender).value(), 0.0);
+
+    timing.onArrival(Kind::Stage2, sender, at(500));
+    ASSERT_EQ(timing.samplesCount(Kind::Stage2), 1);
+}
+
+TEST(StageTiming, EstimatesAreBounded) {
+    const std::vector<cs::PublicKey> senders = {makeKey(1), makeKey(2), makeKey(3)};
+
+    cs::StageTiming fast;
+    feed(fast, Kind::Hash, senders, 1, 20);
+    feed(fast, Kind::Stage3, senders, 1, 20);
+
+    ASSERT_EQ(fast.minStage1Time(), Consensus::T_min_stage1_lower);
+    ASSERT_EQ(fast.requestTimeout(Kind::Stage3, senders, Consensus::T_stage_request), Consensus::T_stage_request_lower);
+
+    cs::StageTiming slow;
+    feed(slow, Kind::Hash, senders, 60000, 20);
+    feed(slow, Kind::Stage3, senders, 60000, 20);
+
+    ASSERT_EQ(slow.minStage1Time(), Consensus::T_min_stage1);
+    ASSERT_EQ(slow.requestTimeout(Kind::Stage3, senders, Consensus::T_stage_request), Consensus::T_stage_request_upper);
+}
+
+TEST(StageTiming, SlowConfidantRaisesTimeout) {
+    cs::StageTiming timing;
+
+    std::vector<cs::PublicKey> senders;
+    for (uint8_t i = 1; i <= 50; ++i) {
+        senders.push_back(makeKey(i));
+    }
+
+    feed(timing, Kind::Stage1, senders, 400, 4);
+
+    const auto slow = makeKey(100);
+    feed(timing, Kind::Stage1, {slow}, 3000, 1);
+
+    const auto common = timing.requestTimeout(Kind::Stage1, {senders.front()}, Consensus::T_stage_request);
+    ASSERT_EQ(common, 600);
+
+    const auto withSlow = timing.requestTimeout(Kind::Stage1, {senders.front(), slow}, Consensus::T_stage_request);
+    ASSERT_EQ(withSlow, 4500);
+}
+
+// Consensus rounds with synthetic latency profiles: the node waits min time for hashes and then three stages,
+// every stage absent after timeout is requested and comes after one more latency. Static timing uses constants,
+// adaptive one uses StageTiming estimates.
+TEST(StageTiming, SimulatedRounds) {
+    struct Profile {
+        std::string name;
+        double hashLatency;
+        double stageLatency;
+        double jitter;
+        double lossRate;
+    };
+
+    const std::vector<Profile> profiles = {
+        {"LAN", 3, 15, 5, 0.002},
+        {"WAN", 60, 250, 120, 0.01},
+        {"jitter", 40, 150, 600, 0.005},
+    };
+
+    constexpr size_t kConfidants = 10;
+    constexpr double kMinute = 60000;
+
+    std::vector<cs::PublicKey> confidants;
+    for (uint8_t i = 0; i < kConfidants; ++i) {
+        confidants.push_back(makeKey(i + 1));
+    }
+
+    struct Result {
+        size_t rounds = 0;
+        size_t requests = 0;
+    };
+
+    auto simulate = [&](const Profile& profile, bool isAdaptive) {
+        std::mt19937 random(2019);
+        std::exponential_distribution<double> jitter(1.0 / profile.jitter);
+        std::bernoulli_distribution isLost(profile.lossRate);
+
+        cs::StageTiming timing;
+        Result result;
+        double now = 0;
+
+        auto latency = [&](double base) { return base + jitter(random); };
+
+        // returns time spent to collect stages of all confidants
+        auto stage = [&](Kind kind, uint32_t constant) {
+            const uint32_t timeout = isAdaptive ? timing.requestTimeout(kind, confidants, constant) : constant;
+            timing.startWaiting(kind, at(now));
+
+            double duration = 0;
+
+            for (const auto& confidant : confidants) {
+                double arrival = isLost(random) ? -1 : latency(profile.stageLatency);
+
+                if (arrival < 0 || arrival > timeout) {
+                    ++result.requests;
+                    const double reply = timeout + latency(profile.stageLatency);
+                    arrival = arrival < 0 ? reply : std::min(arrival, reply);
+                }
+
+                timing.onArrival(kind, confidant, at(now + arrival));
+                duration = std::max(duration, arrival);
+            }
+
+            now += duration;
+        };
+
+        while (now < kMinute) {
+            timing.startRound(at(now));
+
+            double hashes = 0;
+            for (const auto& confidant : confidants) {
+                const double arrival = latency(profile.hashLatency);
+                timing.onArrival(Kind::Hash, confidant, at(now + arrival));
+                hashes = std::max(hashes, arrival);
+            }
+
+            // stage-1 is sent when min time is expired, late hashes are not waited for
+            now += isAdaptive ? timing.minStage1Time() : Consensus::T_min_stage1;
+
+            stage(Kind::Stage1, Consensus::T_stage_request);
+            stage(Kind::Stage2, 2 * Consensus::T_stage_request);
+            stage(Kind::Stage3, Consensus::T_stage_request);
+
+            ++result.rounds;
+        }
+
+        return result;
+    };
+
+    for (const auto& profile : profiles) {
+        const auto fixed = simulate(profile, false);
+        const auto adaptive = simulate(profile, true);
+
+        std::cout << profile.name << ": static " << fixed.rounds << " rounds/min, " << fixed.requests << " requests; adaptive " << adaptive.rounds
+                  << " rounds/min, " << adaptive.requests << " requests" << std::endl;
+
+        ASSERT_GE(adaptive.rounds, fixed.rounds);
+        // spurious requests are limited by the timeout margin over p95
+        ASSERT_LE(adaptive.requests, fixed.requests + adaptive.rounds * kConfidants * 3 / 10);
+    }
+}
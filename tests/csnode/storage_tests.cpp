@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <csdb/pool.hpp>
+#include <csdb/storage.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+namespace fs = boost::filesystem;
+
+fs::path makeDirectory() {
+    return fs::temp_directory_path() / fs::unique_path("cs-storage-tests-%%%%-%%%%");
+}
+}  // namespace
+
+TEST(Storage, PoolsCacheKeepsByteBudget) {
+    constexpr cs::Sequence kCount = 200;
+    constexpr size_t kCached = 20;
+
+    const auto chain = makeChain(kCount);
+    const auto directory = makeDirectory();
+
+    {
+        csdb::Storage storage;
+        ASSERT_TRUE(storage.open(directory.string()));
+
+        const size_t limit = chain.back().binary_size() * kCached;
+        storage.set_pools_cache_limit(limit);
+
+        for (const auto& pool : chain) {
+            ASSERT_TRUE(storage.pool_save(pool));
+
+            const auto stats = storage.pools_cache_stats();
+            ASSERT_LE(stats.bytes, limit);
+            ASSERT_EQ(stats.count + stats.evictions, pool.sequence() + 1);
+        }
+
+        const auto saved = storage.pools_cache_stats();
+        ASSERT_GE(saved.count, kCached);
+        ASSERT_GT(saved.evictions, 0);
+
+        // repeated loads of cached and evicted pools by both keys must not change accounting
+        for (size_t round = 0; round < 3; ++round) {
+            for (auto sequence = kCount; sequence > 0; --sequence) {
+                const auto& pool = chain[sequence - 1];
+
+                ASSERT_EQ(storage.pool_load(pool.sequence()).hash(), pool.hash());
+                ASSERT_EQ(storage.pool_load(pool.hash()).sequence(), pool.sequence());
+                ASSERT_LE(storage.pools_cache_stats().bytes, limit);
+            }
+        }
+
+        const auto loaded = storage.pools_cache_stats();
+        ASSERT_GT(loaded.hits, 0);
+        ASSERT_GT(loaded.misses, 0);
+        ASSERT_GE(loaded.count, kCached);
+
+        // all bytes accounted are released by the elements evicted
+        storage.set_pools_cache_limit(0);
+
+        const auto cleared = storage.pools_cache_stats();
+        ASSERT_EQ(cleared.count, 0);
+        ASSERT_EQ(cleared.bytes, 0);
+
+        storage.close();
+    }
+
+    fs::remove_all(directory);
+}
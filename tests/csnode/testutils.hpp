@@ -0,0 +1,37 @@
+#ifndef TESTUTILS_HPP
+#define TESTUTILS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <csdb/pool.hpp>
+#include <lib/system/common.hpp>
+
+// fixtures shared by tests of nodetests binary
+
+// distinct values give distinct keys
+inline cs::PublicKey makeKey(uint8_t value) {
+    cs::PublicKey key;
+    key.fill(value);
+    return key;
+}
+
+// composed empty blocks linked by previous hash, the first one is genesis
+inline std::vector<csdb::Pool> makeChain(cs::Sequence length) {
+    std::vector<csdb::Pool> chain;
+    chain.reserve(length);
+
+    csdb::PoolHash previous;
+
+    for (cs::Sequence sequence = 0; sequence < length; ++sequence) {
+        csdb::Pool pool(previous, sequence);
+        pool.compose();
+
+        previous = pool.hash();
+        chain.push_back(pool);
+    }
+
+    return chain;
+}
+
+#endif  // TESTUTILS_HPP
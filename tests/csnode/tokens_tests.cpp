@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include <csdb/address.hpp>
+#include <csdb/transaction.hpp>
+
+#include <tokens.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+csdb::Address makeHolder(uint8_t value) {
+    return csdb::Address::from_public_key(makeKey(value));
+}
+
+struct TokenSnapshot {
+    uint64_t transactionsCount;
+    uint64_t transfersCount;
+    uint64_t realHoldersCount;
+    std::map<HolderKey, uint64_t> holderTransfers;
+    std::vector<std::pair<uint64_t, HolderKey>> byTransfers;
+
+    explicit TokenSnapshot(const Token& token)
+    : transactionsCount(token.transactionsCount)
+    , transfersCount(token.transfersCount)
+    , realHoldersCount(token.realHoldersCount)
+    , byTransfers(token.holdersByTransfers.begin(), token.holdersByTransfers.end()) {
+        for (const auto& h : token.holders) {
+            holderTransfers[h.first] = h.second.transfersCount;
+        }
+    }
+
+    bool operator==(const TokenSnapshot& other) const {
+        return transactionsCount == other.transactionsCount && transfersCount == other.transfersCount && realHoldersCount == other.realHoldersCount &&
+               holderTransfers == other.holderTransfers && byTransfers == other.byTransfers;
+    }
+};
+}  // namespace
+
+TEST(Tokens, RemovedBlockRollsBackCounters) {
+    const auto alice = makeHolder(1);
+    const auto bob = makeHolder(2);
+    const auto carol = makeHolder(3);
+
+    Token token;
+
+    for (const auto& holder : {alice, bob, carol}) {
+        token.setHolderBalance(holder, "100");
+    }
+
+    // block 10: a transfer and another invocation
+    token.addInvocation(csdb::TransactionID(10, 0), true, alice, bob);
+    token.addInvocation(csdb::TransactionID(10, 1), false);
+
+    const TokenSnapshot applied(token);
+
+    // block 11: transfers including one to oneself
+    token.addInvocation(csdb::TransactionID(11, 0), true, bob, carol);
+    token.addInvocation(csdb::TransactionID(11, 1), true, alice, alice);
+    token.addInvocation(csdb::TransactionID(11, 2), false);
+
+    ASSERT_EQ(token.transactionsCount, 5);
+    ASSERT_EQ(token.transfersCount, 3);
+    ASSERT_EQ(token.holders.at(alice).transfersCount, 2);
+    ASSERT_EQ(token.holders.at(bob).transfersCount, 2);
+    ASSERT_EQ(token.holders.at(carol).transfersCount, 1);
+
+    token.removeFrom(11);
+
+    ASSERT_TRUE(TokenSnapshot(token) == applied);
+    ASSERT_EQ(token.transactions.size(), 2);
+    ASSERT_EQ(token.transfers.size(), 1);
+    ASSERT_EQ(token.holders.at(carol).transfersCount, 0);
+    ASSERT_TRUE(token.holders.at(carol).transfers.empty());
+
+    token.removeFrom(10);
+
+    ASSERT_EQ(token.transactionsCount, 0);
+    ASSERT_EQ(token.transfersCount, 0);
+    ASSERT_EQ(token.realHoldersCount, 3);
+
+    for (const auto& h : token.holders) {
+        ASSERT_EQ(h.second.transfersCount, 0);
+        ASSERT_TRUE(h.second.transfers.empty());
+    }
+}
+
+TEST(Tokens, HoldersIndexIsRanked) {
+    Token token;
+
+    for (uint8_t i = 1; i <= 10; ++i) {
+        token.setHolderBalance(makeHolder(i), std::to_string(i * 10));
+    }
+
+    // zero balance holders are not indexed
+    token.setHolderBalance(makeHolder(3), "0");
+
+    ASSERT_EQ(token.realHoldersCount, 9);
+    ASSERT_EQ(token.holdersByBalance.nth(0)->first, 10.0);
+    ASSERT_EQ(token.holdersByBalance.nth(2)->first, 40.0);
+    ASSERT_EQ(token.holdersByBalance.nth(8)->first, 100.0);
+    ASSERT_EQ(token.holdersByBalance.nth(9), token.holdersByBalance.end());
+    ASSERT_EQ(token.holdersByBalance.rank(token.holdersByBalance.find(std::make_pair(50.0, makeHolder(5)))), 3);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cscrypto/cscrypto.hpp>
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/amount_commission.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/transaction.hpp>
+
+#include "testutils.hpp"
+
+namespace {
+csdb::Transaction makeTransaction() {
+    csdb::Transaction transaction;
+    transaction.set_innerID(1);
+    transaction.set_source(csdb::Address::from_public_key(makeKey(1)));
+    transaction.set_target(csdb::Address::from_public_key(makeKey(2)));
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10, 0));
+    transaction.set_max_fee(csdb::AmountCommission(0.1));
+    transaction.add_user_field(1, std::string("data"));
+    return transaction;
+}
+
+// signed bytes of the same transaction decoded anew, nothing is kept by it
+cs::Bytes freshBytes(const csdb::Transaction& transaction) {
+    return csdb::Transaction::from_binary(transaction.to_byte_stream()).to_byte_stream_for_sig();
+}
+
+void expectRebuilt(const std::function<void(csdb::Transaction&)>& setter, bool isSigned) {
+    auto transaction = makeTransaction();
+
+    const auto bytes = transaction.to_byte_stream_for_sig();
+    const auto hash = transaction.hash_for_sig();
+
+    setter(transaction);
+
+    const auto changed = transaction.to_byte_stream_for_sig();
+    EXPECT_EQ(changed, freshBytes(transaction));
+    EXPECT_EQ(transaction.hash_for_sig(), cscrypto::calculateHash(changed.data(), changed.size()));
+    EXPECT_EQ(changed != bytes, isSigned);
+    EXPECT_EQ(transaction.hash_for_sig() != hash, isSigned);
+}
+}  // namespace
+
+TEST(TransactionSignedBytes, KeptUntilChanged) {
+    auto transaction = makeTransaction();
+
+    const auto bytes = transaction.to_byte_stream_for_sig();
+    ASSERT_FALSE(bytes.empty());
+    ASSERT_EQ(bytes, freshBytes(transaction));
+    ASSERT_EQ(transaction.to_byte_stream_for_sig(), bytes);
+    ASSERT_EQ(transaction.hash_for_sig(), cscrypto::calculateHash(bytes.data(), bytes.size()));
+}
+
+TEST(TransactionSignedBytes, SettersDropKeptBytes) {
+    expectRebuilt([](auto& transaction) { transaction.set_innerID(2); }, true);
+    expectRebuilt([](auto& transaction) { transaction.set_source(csdb::Address::from_public_key(makeKey(3))); }, true);
+    expectRebuilt([](auto& transaction) { transaction.set_source(csdb::Address::from_wallet_id(5)); }, true);
+    expectRebuilt([](auto& transaction) { transaction.set_target(csdb::Address::from_public_key(makeKey(4))); }, true);
+    expectRebuilt([](auto& transaction) { transaction.set_currency(2); }, true);
+    expectRebuilt([](auto& transaction) { transaction.set_amount(csdb::Amount(20, 0)); }, true);
+    expectRebuilt([](auto& transaction) { transaction.set_max_fee(csdb::AmountCommission(1.0)); }, true);
+    expectRebuilt([](auto& transaction) { transaction.add_user_field(2, csdb::Amount(1, 0)); }, true);
+    expectRebuilt([](auto& transaction) { transaction.add_user_field(1, std::string("other")); }, true);
+
+    // not signed
+    expectRebuilt([](auto& transaction) { transaction.set_counted_fee(csdb::AmountCommission(0.5)); }, false);
+    expectRebuilt([](auto& transaction) { transaction.set_counted_fee_unsafe(csdb::AmountCommission(0.5)); }, false);
+    expectRebuilt(
+        [](auto& transaction) {
+            cs::Signature signature;
+            signature.fill(7);
+            transaction.set_signature(signature);
+        },
+        false);
+}
+
+TEST(TransactionSignedBytes, CopiesAreIndependent) {
+    auto transaction = makeTransaction();
+    const auto bytes = transaction.to_byte_stream_for_sig();
+
+    auto copy = transaction;
+    auto clone = transaction.clone();
+
+    ASSERT_EQ(copy.to_byte_stream_for_sig(), bytes);
+    ASSERT_EQ(clone.to_byte_stream_for_sig(), bytes);
+
+    copy.set_amount(csdb::Amount(30, 0));
+    clone.set_innerID(3);
+
+    ASSERT_EQ(transaction.to_byte_stream_for_sig(), bytes);
+    ASSERT_EQ(copy.to_byte_stream_for_sig(), freshBytes(copy));
+    ASSERT_EQ(clone.to_byte_stream_for_sig(), freshBytes(clone));
+    ASSERT_NE(copy.to_byte_stream_for_sig(), bytes);
+    ASSERT_NE(clone.to_byte_stream_for_sig(), bytes);
+}
+
+TEST(TransactionSignedBytes, BuiltConcurrently) {
+    const auto transaction = makeTransaction();
+    const auto expected = freshBytes(transaction);
+
+    std::vector<std::thread> threads;
+    std::atomic<size_t> matches = 0;
+
+    for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            matches += transaction.to_byte_stream_for_sig() == expected;
+            matches += transaction.hash_for_sig() == cscrypto::calculateHash(expected.data(), expected.size());
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(matches, 16);
+}
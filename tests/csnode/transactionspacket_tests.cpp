@@ -2,8 +2,11 @@
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 
+#include "datastream.hpp"
 #include "transactionspacket.hpp"
 
 #include <cscrypto/cscrypto.hpp>
@@ -245,3 +248,223 @@ TEST(TransactionPacketHash, fromBinary) {
 
     ASSERT_EQ(hash, packet.hash());
 }
+
+TEST(TransactionPacketHash, keepsEmptyState) {
+    const cs::TransactionsPacketHash empty;
+
+    ASSERT_TRUE(empty.isEmpty());
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_TRUE(empty.toBinary().empty());
+    ASSERT_TRUE(empty.toString().empty());
+
+    // wrong size is not a hash
+    ASSERT_TRUE(cs::TransactionsPacketHash::fromBinary(cs::Bytes(cscrypto::kHashSize - 1, 1)).isEmpty());
+    ASSERT_TRUE(cs::TransactionsPacketHash::fromString("0102").isEmpty());
+
+    cs::Hash zero{};
+    const cs::TransactionsPacketHash zeroHash(zero);
+
+    ASSERT_FALSE(zeroHash.isEmpty());
+    ASSERT_NE(empty, zeroHash);
+    ASSERT_LT(empty, zeroHash);
+}
+
+TEST(TransactionPacketHash, orderedAsBinary) {
+    std::vector<cs::TransactionsPacketHash> hashes;
+
+    for (int64_t i = 1; i <= 64; ++i) {
+        cs::TransactionsPacket packet;
+        packet.addTransaction(makeTransaction(i));
+        packet.makeHash();
+
+        hashes.push_back(packet.hash());
+    }
+
+    for (const auto& lhs : hashes) {
+        for (const auto& rhs : hashes) {
+            ASSERT_EQ(lhs < rhs, lhs.toBinary() < rhs.toBinary());
+            ASSERT_EQ(lhs == rhs, lhs.toBinary() == rhs.toBinary());
+
+            if (lhs == rhs) {
+                ASSERT_EQ(lhs.key(), rhs.key());
+            }
+        }
+    }
+}
+
+TEST(TransactionPacketHash, serializedAsBytes) {
+    cs::TransactionsPacket packet;
+    packet.addTransaction(makeTransaction(1));
+    packet.makeHash();
+
+    cs::Bytes hashBytes;
+    cs::Bytes vectorBytes;
+
+    {
+        cs::DataStream stream(hashBytes);
+        stream << packet.hash() << cs::TransactionsPacketHash();
+    }
+
+    {
+        cs::DataStream stream(vectorBytes);
+        stream << packet.hash().toBinary() << cs::Bytes();
+    }
+
+    ASSERT_EQ(hashBytes, vectorBytes);
+
+    cs::DataStream stream(hashBytes.data(), hashBytes.size());
+    cs::TransactionsPacketHash hash;
+    cs::TransactionsPacketHash empty;
+    stream >> hash >> empty;
+
+    ASSERT_TRUE(stream.isValid());
+    ASSERT_EQ(hash, packet.hash());
+    ASSERT_TRUE(empty.isEmpty());
+}
+
+namespace {
+cs::TransactionsPacket makeFullPacket(size_t count) {
+    cs::TransactionsPacket packet;
+
+    for (size_t i = 0; i < count; ++i) {
+        auto transaction = makeTransaction(static_cast<int64_t>(i + 1));
+        transaction.add_user_field(0, std::string(16, 'x'));
+        transaction.add_user_field(1, uint64_t(i));
+        transaction.add_user_field(2, csdb::Amount(1, 5));
+        packet.addTransaction(transaction);
+    }
+
+    packet.addStateTransaction(makeTransaction(static_cast<int64_t>(count + 1)));
+
+    cs::Signature signature;
+    signature.fill(0xEE);
+    packet.addSignature(0, signature);
+
+    packet.makeHash();
+    return packet;
+}
+
+std::vector<cs::Bytes> bytesOf(const std::vector<csdb::Transaction>& transactions) {
+    std::vector<cs::Bytes> result;
+
+    for (const auto& transaction : transactions) {
+        result.push_back(transaction.to_byte_stream());
+    }
+
+    return result;
+}
+
+cs::Bytes fieldBytes(int32_t id, char value) {
+    cs::Bytes bytes(reinterpret_cast<const cs::Byte*>(&id), reinterpret_cast<const cs::Byte*>(&id) + sizeof(id));
+    bytes.push_back(static_cast<cs::Byte>(csdb::UserField::String));
+
+    const uint32_t size = 1;
+    bytes.insert(bytes.end(), reinterpret_cast<const cs::Byte*>(&size), reinterpret_cast<const cs::Byte*>(&size) + sizeof(size));
+    bytes.push_back(static_cast<cs::Byte>(value));
+
+    return bytes;
+}
+}  // namespace
+
+TEST(TransactionsPacket, receivedBinaryIsKept) {
+    const auto packet = makeFullPacket(20);
+    const auto received = cs::TransactionsPacket::fromBinary(packet.toBinary());
+
+    // not decoded yet
+    ASSERT_EQ(received.transactionsCount(), packet.transactionsCount());
+    ASSERT_EQ(received.hash(), packet.hash());
+
+    for (auto options : {cs::TransactionsPacket::Transactions, cs::TransactionsPacket::States, cs::TransactionsPacket::Signatures,
+                         cs::TransactionsPacket::SignaturesAndStates, cs::TransactionsPacket::All}) {
+        ASSERT_EQ(received.toBinary(options), packet.toBinary(options));
+    }
+
+    ASSERT_EQ(bytesOf(received.transactions()), bytesOf(packet.transactions()));
+    ASSERT_EQ(bytesOf(received.stateTransactions()), bytesOf(packet.stateTransactions()));
+    ASSERT_EQ(received.signatures(), packet.signatures());
+    ASSERT_EQ(received.transactionsCount(), packet.transactionsCount());
+
+    // forwarded packet is the same
+    const auto forwarded = cs::TransactionsPacket::fromBinary(received.toBinary());
+    ASSERT_EQ(forwarded.toBinary(), packet.toBinary());
+    ASSERT_EQ(forwarded.hash(), packet.hash());
+}
+
+TEST(TransactionsPacket, changedPacketIsSerializedAgain) {
+    const auto packet = makeFullPacket(5);
+    auto received = cs::TransactionsPacket::fromBinary(packet.toBinary());
+
+    cs::Signature signature;
+    signature.fill(0x11);
+    ASSERT_TRUE(received.addSignature(1, signature));
+    ASSERT_FALSE(received.addSignature(1, signature));
+
+    auto expected = packet;
+    expected.addSignature(1, signature);
+
+    ASSERT_EQ(received.signatures().size(), 2);
+    ASSERT_EQ(received.toBinary(), expected.toBinary());
+    ASSERT_EQ(received.hash(), packet.hash());
+
+    received.clear();
+    ASSERT_EQ(received.transactionsCount(), 0);
+    ASSERT_EQ(cs::TransactionsPacket::fromBinary(received.toBinary()).transactionsCount(), 0);
+}
+
+TEST(TransactionsPacket, otherRepresentationIsSerializedAgain) {
+    cs::TransactionsPacket packet;
+    auto transaction = makeTransaction(1);
+    transaction.add_user_field(1, std::string("a"));
+    transaction.add_user_field(2, std::string("b"));
+    packet.addTransaction(transaction);
+    packet.makeHash();
+
+    // user fields are not in map order
+    auto binary = packet.toBinary();
+    const auto first = fieldBytes(1, 'a');
+    const auto second = fieldBytes(2, 'b');
+
+    auto fields = first;
+    fields.insert(fields.end(), second.begin(), second.end());
+
+    auto it = std::search(binary.begin(), binary.end(), fields.begin(), fields.end());
+    ASSERT_NE(it, binary.end());
+
+    std::copy(second.begin(), second.end(), it);
+    std::copy(first.begin(), first.end(), it + static_cast<std::ptrdiff_t>(second.size()));
+
+    const auto received = cs::TransactionsPacket::fromBinary(binary);
+    ASSERT_EQ(received.hash(), packet.hash());
+    ASSERT_EQ(received.toBinary(), packet.toBinary());
+
+    // states and signatures are absent
+    const auto transactionsOnly = cs::TransactionsPacket::fromBinary(packet.toBinary(cs::TransactionsPacket::Transactions));
+    ASSERT_EQ(transactionsOnly.hash(), packet.hash());
+    ASSERT_EQ(transactionsOnly.toBinary(), packet.toBinary());
+
+    // broken representation gives empty packet
+    binary = packet.toBinary();
+    binary.resize(binary.size() / 2);
+    ASSERT_TRUE(cs::TransactionsPacket::fromBinary(binary).isHashEmpty());
+}
+
+TEST(TransactionsPacket, decodedConcurrently) {
+    const auto packet = makeFullPacket(100);
+    const auto received = cs::TransactionsPacket::fromBinary(packet.toBinary());
+
+    std::vector<std::thread> threads;
+    std::atomic<size_t> matches = 0;
+
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            matches += bytesOf(received.transactions()) == bytesOf(packet.transactions());
+            matches += received.toBinary() == packet.toBinary();
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(matches, 8);
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <unordered_set>
+#include <vector>
+
+#include <lib/system/hash.hpp>
+
+namespace {
+const cs::SipHash::Key kReferenceKey{0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL};
+
+std::vector<uint8_t> makeSequence(size_t size) {
+    std::vector<uint8_t> data(size);
+    std::iota(data.begin(), data.end(), static_cast<uint8_t>(0));
+    return data;
+}
+}  // namespace
+
+TEST(SipHash, ReferenceVectors) {
+    // vectors of SipHash-2-4 paper, key 00..0f and message 00..(size - 1)
+    ASSERT_EQ(cs::SipHash::calculate(nullptr, 0, kReferenceKey), 0x726fdb47dd0e0e31ULL);
+
+    auto data = makeSequence(8);
+    ASSERT_EQ(cs::SipHash::calculate(data.data(), data.size(), kReferenceKey), 0x93f5f5799a932462ULL);
+
+    data = makeSequence(15);
+    ASSERT_EQ(cs::SipHash::calculate(data.data(), data.size(), kReferenceKey), 0xa129ca6149be45e5ULL);
+
+    data = makeSequence(63);
+    ASSERT_EQ(cs::SipHash::calculate(data.data(), data.size(), kReferenceKey), 0x958a324ceb064572ULL);
+}
+
+TEST(SipHash, KeyedPerProcess) {
+    const auto data = makeSequence(1024);
+
+    ASSERT_EQ(&cs::SipHash::processKey(), &cs::SipHash::processKey());
+    ASSERT_EQ(cs::SipHash::calculate(data.data(), data.size()), cs::SipHash::calculate(data.data(), data.size(), cs::SipHash::processKey()));
+    ASSERT_NE(cs::SipHash::calculate(data.data(), data.size()), cs::SipHash::calculate(data.data(), data.size(), kReferenceKey));
+}
+
+// Packets of one message differ in a few bytes only: fragment id and a counter in the body
+TEST(SipHash, NoCollisionsOfSimilarPackets) {
+    constexpr size_t kPackets = 1 << 20;
+    constexpr size_t kPacketSize = 1024;
+    constexpr size_t kBuckets = 1 << 16;
+
+    std::vector<uint8_t> packet(kPacketSize, 0xaa);
+    std::unordered_set<uint64_t> keys;
+    std::vector<uint32_t> buckets(kBuckets, 0);
+
+    keys.reserve(kPackets);
+
+    for (uint32_t i = 0; i < kPackets; ++i) {
+        std::memcpy(packet.data() + 1, &i, sizeof(i));
+        packet[kPacketSize - 1] = static_cast<uint8_t>(i);
+
+        const cs::DedupKey key{cs::SipHash::calculate(packet.data(), packet.size())};
+        keys.insert(key.value);
+        ++buckets[getHashValue(key) % kBuckets];
+    }
+
+    // 2^20 values of 64 bits collide with probability of 2^-25
+    ASSERT_EQ(keys.size(), kPackets);
+
+    // 16 values per home slot on average, probe sequences of OpenHashMap stay short
+    const auto [minLoad, maxLoad] = std::minmax_element(buckets.begin(), buckets.end());
+    ASSERT_GT(*minLoad, 0U);
+    ASSERT_LT(*maxLoad, 48U);
+}
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <chrono>
 #include <list>
+#include <map>
 #include <mutex>
 #include <thread>
 #include <type_traits>
@@ -364,12 +366,12 @@ TEST(typed_allocator, inconsistent) {
 }
 
 template <>
-uint16_t getHashIndex(const uint32_t& h) {
-    return static_cast<uint16_t>(h % (1 << 16));
+uint64_t getHashValue(const uint32_t& h) {
+    return h;
 }
 
-TEST(FixedHashMap, base) {
-    FixedHashMap<uint32_t, uint64_t, uint16_t, 100000> hm;
+TEST(OpenHashMap, base) {
+    OpenHashMap<uint32_t, uint64_t> hm(100000);
     const uint32_t COUNT = 100000ll;
     uint32_t hs[COUNT];
 
@@ -383,10 +385,12 @@ TEST(FixedHashMap, base) {
     for (uint32_t i = 0; i < COUNT; ++i) {
         ASSERT_EQ(hm.tryStore(hs[i]), 2);
     }
+
+    ASSERT_EQ(hm.size(), COUNT);
 }
 
-TEST(FixedHashMap, depush) {
-    FixedHashMap<uint32_t, uint64_t, uint16_t, 10> hm;
+TEST(OpenHashMap, depush) {
+    OpenHashMap<uint32_t, uint64_t> hm(10);
     uint32_t hs[1000];
 
     for (uint32_t i = 0; i < 1000; ++i) {
@@ -402,19 +406,19 @@ TEST(FixedHashMap, depush) {
     }
 
     for (uint32_t i = 0; i < 990; ++i) {
-        auto& c = hm.tryStore(hs[i]);
-        ASSERT_EQ(c, 0);
+        ASSERT_EQ(hm.tryGet(hs[i]), nullptr);
     }
 }
 
 template <>
-uint8_t getHashIndex(const uint16_t& h) {
-    return static_cast<uint8_t>(h % (1 << 8));
+uint64_t getHashValue(const uint16_t& h) {
+    // all keys in few home slots
+    return h % 4;
 }
 
-TEST(FixedHashMap, heap) {
+TEST(OpenHashMap, heap) {
     const uint16_t COUNT = 10000;
-    FixedHashMap<uint16_t, uint32_t, uint8_t, COUNT> hm;
+    OpenHashMap<uint16_t, uint32_t> hm(COUNT);
     uint16_t hs[COUNT];
 
     for (uint16_t i = 0; i < COUNT; ++i) {
@@ -430,6 +434,58 @@ TEST(FixedHashMap, heap) {
     }
 }
 
+TEST(OpenHashMap, EvictionKeepsOthersReachable) {
+    OpenHashMap<uint16_t, uint32_t> hm(100);
+    std::map<uint16_t, uint32_t*> stored;
+
+    // evicted elements are taken out of long probe sequences
+    for (uint16_t i = 0; i < 1000; ++i) {
+        auto& c = hm.tryStore(i);
+        c = i;
+        stored[i] = &c;
+
+        for (uint16_t j = (i < 100 ? 0 : i - 99); j <= i; ++j) {
+            ASSERT_EQ(hm.tryGet(j), stored[j]);
+        }
+    }
+
+    uint16_t expected = 900;
+    for (auto& element : hm) {
+        ASSERT_EQ(element.key, expected);
+        ASSERT_EQ(*element, expected);
+        ++expected;
+    }
+
+    hm.resize(10);
+    ASSERT_EQ(hm.size(), 10);
+    ASSERT_EQ(hm.tryGet(989), nullptr);
+    ASSERT_EQ(*hm.tryGet(990), 990);
+    ASSERT_EQ(*hm.tryGet(999), 999);
+
+    hm.resize(50);
+    ASSERT_EQ(hm.tryStore(1), 0);
+    ASSERT_EQ(hm.size(), 11);
+}
+
+TEST(OpenHashMap, ExpiredElementsAreRemoved) {
+    OpenHashMap<uint32_t, uint32_t> hm(100, std::chrono::milliseconds(200));
+
+    hm.tryStore(1) = 1;
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    hm.tryStore(2) = 2;
+
+    ASSERT_EQ(*hm.tryGet(1), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    ASSERT_EQ(hm.tryGet(1), nullptr);
+    ASSERT_EQ(*hm.tryGet(2), 2);
+    ASSERT_EQ(hm.size(), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    ASSERT_EQ(hm.tryGet(2), nullptr);
+    ASSERT_EQ(hm.size(), 0);
+}
+
 struct IntWithCounter {
     static uint32_t counter;
     uint32_t i;
@@ -447,11 +503,11 @@ struct IntWithCounter {
 
 uint32_t IntWithCounter::counter = 0;
 
-TEST(FixedHashMap, destroy) {
+TEST(OpenHashMap, destroy) {
     IntWithCounter::counter = 0;
 
     {
-        FixedHashMap<uint16_t, IntWithCounter, uint8_t, 10> hm;
+        OpenHashMap<uint16_t, IntWithCounter> hm(10);
 
         for (uint16_t i = 0; i < 100; ++i) {
             hm.tryStore(i);
@@ -460,7 +516,6 @@ TEST(FixedHashMap, destroy) {
         ASSERT_EQ(IntWithCounter::counter, 10);
     }
 
-    // Todo: Typed allocator destructor
     ASSERT_EQ(IntWithCounter::counter, 0);
 }
 
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include <lib/system/metrics.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(Metrics, CounterSumsThreadShards) {
+    cs::metrics::Counter counter;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&counter] {
+            for (size_t j = 0; j < 100000; ++j) {
+                counter.add();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter.value(), 800000);
+}
+
+TEST(Metrics, HistogramBuckets) {
+    cs::metrics::Histogram histogram({1, 0.1, 0.5});
+    ASSERT_EQ(histogram.bounds(), std::vector<double>({0.1, 0.5, 1}));
+
+    for (const double value : {0.05, 0.1, 0.2, 0.7, 3.0}) {
+        histogram.observe(value);
+    }
+
+    const auto snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.counts, std::vector<uint64_t>({2, 1, 1, 1}));
+    ASSERT_EQ(snapshot.count, 5);
+    ASSERT_DOUBLE_EQ(snapshot.sum, 4.05);
+}
+
+TEST(Metrics, Exposition) {
+    cs::metrics::Registry registry;
+
+    registry.counter("test_packets_total", "Packets \"sent\"", {{"kind", "direct"}}).add(3);
+    registry.counter("test_packets_total", "Packets \"sent\"", {{"kind", "direct"}}).add(2);
+    registry.gauge("test_depth", "Queue depth").set(7);
+
+    auto& histogram = registry.histogram("test_latency_seconds", "Latency", {0.5, 1});
+    histogram.observe(0.25);
+    histogram.observe(2);
+
+    const std::string expected =
+        "# HELP test_depth Queue depth\n"
+        "# TYPE test_depth gauge\n"
+        "test_depth 7\n"
+        "# HELP test_latency_seconds Latency\n"
+        "# TYPE test_latency_seconds histogram\n"
+        "test_latency_seconds_bucket{le=\"0.5\"} 1\n"
+        "test_latency_seconds_bucket{le=\"1\"} 1\n"
+        "test_latency_seconds_bucket{le=\"+Inf\"} 2\n"
+        "test_latency_seconds_sum 2.25\n"
+        "test_latency_seconds_count 2\n"
+        "# HELP test_packets_total Packets \"sent\"\n"
+        "# TYPE test_packets_total counter\n"
+        "test_packets_total{kind=\"direct\"} 5\n";
+
+    ASSERT_EQ(registry.exposition(), expected);
+}
+
+TEST(Metrics, ProbesAreSummedUntilReset) {
+    cs::metrics::Registry registry;
+
+    auto first = registry.probe("test_queue", "Queue", cs::metrics::Type::Gauge, [] { return 2.0; });
+    auto second = registry.probe("test_queue", "Queue", cs::metrics::Type::Gauge, [] { return 3.0; });
+    ASSERT_NE(registry.exposition().find("test_queue 5\n"), std::string::npos);
+
+    {
+        auto moved = std::move(second);
+    }
+
+    ASSERT_NE(registry.exposition().find("test_queue 2\n"), std::string::npos);
+
+    first.reset();
+    ASSERT_NE(registry.exposition().find("test_queue 0\n"), std::string::npos);
+}
+
+TEST(Metrics, TypeIsKept) {
+    cs::metrics::Registry registry;
+    registry.counter("test_events_total", "Events");
+
+    ASSERT_THROW(registry.gauge("test_events_total", "Events"), std::logic_error);
+    ASSERT_THROW(registry.probe("test_events_total", "Events", cs::metrics::Type::Histogram, [] { return 0.0; }), std::logic_error);
+}
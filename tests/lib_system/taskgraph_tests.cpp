@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include <lib/system/taskgraph.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(TaskGraph, SequentialRunKeepsOrder) {
+    cs::TaskGraph graph;
+    std::vector<size_t> order;
+
+    for (size_t i = 0; i < 5; ++i) {
+        graph.add([&order, i] {
+            order.push_back(i);
+            return true;
+        }, 0, true);
+    }
+
+    ASSERT_TRUE(graph.run());
+    ASSERT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
+TEST(TaskGraph, DependentTaskStartsAfterDependencies) {
+    cs::Threads pool(4);
+    cs::TaskGraph graph;
+
+    std::atomic<size_t> finished = 0;
+    size_t finishedBeforeLast = 0;
+
+    const auto first = graph.add([&finished] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ++finished;
+        return true;
+    }, 0, true);
+
+    const auto second = graph.add([&finished] {
+        ++finished;
+        return true;
+    }, 0, true);
+
+    graph.add([&] {
+        finishedBeforeLast = finished;
+        return true;
+    }, (cs::TaskGraph::Mask(1) << first) | (cs::TaskGraph::Mask(1) << second));
+
+    ASSERT_TRUE(graph.run(&pool));
+    ASSERT_EQ(finishedBeforeLast, 2);
+}
+
+TEST(TaskGraph, ConcurrentTasksRunOnPool) {
+    cs::Threads pool(2);
+    cs::TaskGraph graph;
+
+    const auto mainId = std::this_thread::get_id();
+    std::thread::id concurrentId;
+    std::thread::id exclusiveId;
+
+    graph.add([&concurrentId] {
+        concurrentId = std::this_thread::get_id();
+        return true;
+    }, 0, true);
+
+    graph.add([&exclusiveId] {
+        exclusiveId = std::this_thread::get_id();
+        return true;
+    });
+
+    ASSERT_TRUE(graph.run(&pool));
+    ASSERT_NE(concurrentId, mainId);
+    ASSERT_EQ(exclusiveId, mainId);
+}
+
+TEST(TaskGraph, FailureCancelsNotStartedTasks) {
+    cs::Threads pool(2);
+    cs::TaskGraph graph;
+
+    std::atomic<bool> dependentCalled = false;
+
+    const auto failed = graph.add([] { return false; }, 0, true);
+    graph.add([&dependentCalled] {
+        dependentCalled = true;
+        return true;
+    }, cs::TaskGraph::Mask(1) << failed, true);
+
+    ASSERT_FALSE(graph.run(&pool));
+    ASSERT_TRUE(graph.isCancelled());
+    ASSERT_FALSE(dependentCalled);
+}
+
+TEST(TaskGraph, ExceptionIsRethrown) {
+    cs::Threads pool(2);
+    cs::TaskGraph graph;
+
+    graph.add([]() -> bool { throw std::runtime_error("task failed"); }, 0, true);
+    graph.add([] { return true; }, 0, true);
+
+    ASSERT_THROW(graph.run(&pool), std::runtime_error);
+}
+
+TEST(TaskGraph, RunCanBeRepeated) {
+    cs::Threads pool(2);
+    cs::TaskGraph graph;
+
+    std::atomic<size_t> calls = 0;
+    bool succeed = false;
+
+    const auto counter = graph.add([&calls] {
+        ++calls;
+        return true;
+    }, 0, true);
+
+    graph.add([&succeed] { return succeed; }, cs::TaskGraph::Mask(1) << counter);
+
+    ASSERT_FALSE(graph.run(&pool));
+
+    succeed = true;
+    ASSERT_TRUE(graph.run(&pool));
+    ASSERT_EQ(calls, 2);
+}